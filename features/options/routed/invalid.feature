@@ -16,3 +16,14 @@ Feature: osrm-routed command line options: invalid options
         Then stderr should contain "over-the-rainbow.osrm"
         And stderr should contain "Required files are missing"
         And it should exit with an error
+
+    Scenario: osrm-routed - Missing file of a profile
+        When I try to run "osrm-routed --profile car=over-the-rainbow.osrm"
+        Then stderr should contain "over-the-rainbow.osrm"
+        And stderr should contain "Required files are missing"
+        And it should exit with an error
+
+    Scenario: osrm-routed - Profiles and base path
+        When I try to run "osrm-routed --profile car=over-the-rainbow.osrm over-the-rainbow.osrm"
+        Then stderr should contain "conflict with the base path"
+        And it should exit with an error
@@ -2679,11 +2679,36 @@ osrm.engine.api.fbresult.Table.prototype.fallbackSpeedCellsArray = function() {
   return offset ? new Uint32Array(this.bb.bytes().buffer, this.bb.bytes().byteOffset + this.bb.__vector(this.bb_pos + offset), this.bb.__vector_len(this.bb_pos + offset)) : null;
 };
 
+/**
+ * @param {number} index
+ * @returns {number}
+ */
+osrm.engine.api.fbresult.Table.prototype.sparseCells = function(index) {
+  var offset = this.bb.__offset(this.bb_pos, 16);
+  return offset ? this.bb.readUint32(this.bb.__vector(this.bb_pos + offset) + index * 4) : 0;
+};
+
+/**
+ * @returns {number}
+ */
+osrm.engine.api.fbresult.Table.prototype.sparseCellsLength = function() {
+  var offset = this.bb.__offset(this.bb_pos, 16);
+  return offset ? this.bb.__vector_len(this.bb_pos + offset) : 0;
+};
+
+/**
+ * @returns {Uint32Array}
+ */
+osrm.engine.api.fbresult.Table.prototype.sparseCellsArray = function() {
+  var offset = this.bb.__offset(this.bb_pos, 16);
+  return offset ? new Uint32Array(this.bb.bytes().buffer, this.bb.bytes().byteOffset + this.bb.__vector(this.bb_pos + offset), this.bb.__vector_len(this.bb_pos + offset)) : null;
+};
+
 /**
  * @param {flatbuffers.Builder} builder
  */
 osrm.engine.api.fbresult.Table.startTable = function(builder) {
-  builder.startObject(6);
+  builder.startObject(7);
 };
 
 /**
@@ -2818,6 +2843,35 @@ osrm.engine.api.fbresult.Table.startFallbackSpeedCellsVector = function(builder,
   builder.startVector(4, numElems, 4);
 };
 
+/**
+ * @param {flatbuffers.Builder} builder
+ * @param {flatbuffers.Offset} sparseCellsOffset
+ */
+osrm.engine.api.fbresult.Table.addSparseCells = function(builder, sparseCellsOffset) {
+  builder.addFieldOffset(6, sparseCellsOffset, 0);
+};
+
+/**
+ * @param {flatbuffers.Builder} builder
+ * @param {Array.<number>} data
+ * @returns {flatbuffers.Offset}
+ */
+osrm.engine.api.fbresult.Table.createSparseCellsVector = function(builder, data) {
+  builder.startVector(4, data.length, 4);
+  for (var i = data.length - 1; i >= 0; i--) {
+    builder.addInt32(data[i]);
+  }
+  return builder.endVector();
+};
+
+/**
+ * @param {flatbuffers.Builder} builder
+ * @param {number} numElems
+ */
+osrm.engine.api.fbresult.Table.startSparseCellsVector = function(builder, numElems) {
+  builder.startVector(4, numElems, 4);
+};
+
 /**
  * @param {flatbuffers.Builder} builder
  * @returns {flatbuffers.Offset}
@@ -2835,9 +2889,10 @@ osrm.engine.api.fbresult.Table.endTable = function(builder) {
  * @param {flatbuffers.Offset} distancesOffset
  * @param {flatbuffers.Offset} destinationsOffset
  * @param {flatbuffers.Offset} fallbackSpeedCellsOffset
+ * @param {flatbuffers.Offset} sparseCellsOffset
  * @returns {flatbuffers.Offset}
  */
-osrm.engine.api.fbresult.Table.createTable = function(builder, durationsOffset, rows, cols, distancesOffset, destinationsOffset, fallbackSpeedCellsOffset) {
+osrm.engine.api.fbresult.Table.createTable = function(builder, durationsOffset, rows, cols, distancesOffset, destinationsOffset, fallbackSpeedCellsOffset, sparseCellsOffset) {
   osrm.engine.api.fbresult.Table.startTable(builder);
   osrm.engine.api.fbresult.Table.addDurations(builder, durationsOffset);
   osrm.engine.api.fbresult.Table.addRows(builder, rows);
@@ -2845,6 +2900,7 @@ osrm.engine.api.fbresult.Table.createTable = function(builder, durationsOffset,
   osrm.engine.api.fbresult.Table.addDistances(builder, distancesOffset);
   osrm.engine.api.fbresult.Table.addDestinations(builder, destinationsOffset);
   osrm.engine.api.fbresult.Table.addFallbackSpeedCells(builder, fallbackSpeedCellsOffset);
+  osrm.engine.api.fbresult.Table.addSparseCells(builder, sparseCellsOffset);
   return osrm.engine.api.fbresult.Table.endTable(builder);
 }
 
@@ -24,8 +24,8 @@ struct CustomizationConfig final : storage::IOConfig
                     ".osrm.properties",
                     ".osrm.enw"},
                    {},
-                   {".osrm.cell_metrics", ".osrm.mldgr"}),
-          requested_num_threads(0)
+                   {".osrm.cell_metrics", ".osrm.mldgr", ".osrm.landmarks"}),
+          requested_num_threads(0), num_landmarks(0)
     {
     }
 
@@ -36,6 +36,8 @@ struct CustomizationConfig final : storage::IOConfig
     }
 
     unsigned requested_num_threads;
+    // number of landmarks for the A* potentials of MLD queries, 0 disables them
+    unsigned num_landmarks;
 
     updater::UpdaterConfig updater_config;
 };
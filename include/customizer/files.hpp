@@ -106,6 +106,39 @@ inline void writeGraph(const boost::filesystem::path &path,
     writer.WriteFrom("/mld/connectivity_checksum", connectivity_checksum);
     serialization::write(writer, "/mld/multilevelgraph", graph);
 }
+
+// reads .osrm.landmarks file
+template <typename LandmarksT>
+inline void readLandmarks(const boost::filesystem::path &path,
+                          LandmarksT &landmarks,
+                          std::uint32_t &connectivity_checksum)
+{
+    static_assert(std::is_same<customizer::LandmarksView, LandmarksT>::value ||
+                      std::is_same<customizer::Landmarks, LandmarksT>::value,
+                  "");
+
+    storage::tar::FileReader reader{path, storage::tar::FileReader::VerifyFingerprint};
+
+    reader.ReadInto("/mld/landmarks/connectivity_checksum", connectivity_checksum);
+    serialization::read(reader, "/mld/landmarks", landmarks);
+}
+
+// writes .osrm.landmarks file
+template <typename LandmarksT>
+inline void writeLandmarks(const boost::filesystem::path &path,
+                           const LandmarksT &landmarks,
+                           const std::uint32_t connectivity_checksum)
+{
+    static_assert(std::is_same<customizer::LandmarksView, LandmarksT>::value ||
+                      std::is_same<customizer::Landmarks, LandmarksT>::value,
+                  "");
+
+    storage::tar::FileWriter writer{path, storage::tar::FileWriter::GenerateFingerprint};
+
+    writer.WriteElementCount64("/mld/landmarks/connectivity_checksum", 1);
+    writer.WriteFrom("/mld/landmarks/connectivity_checksum", connectivity_checksum);
+    serialization::write(writer, "/mld/landmarks", landmarks);
+}
 } // namespace files
 } // namespace customizer
 } // namespace osrm
@@ -0,0 +1,199 @@
+#ifndef OSRM_CUSTOMIZER_LANDMARK_CUSTOMIZER_HPP
+#define OSRM_CUSTOMIZER_LANDMARK_CUSTOMIZER_HPP
+
+#include "customizer/landmarks.hpp"
+
+#include "util/query_heap.hpp"
+#include "util/typedefs.hpp"
+
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace customizer
+{
+
+// Computes the landmark weights used for the A* potentials of MLD queries.
+//
+// Selecting the landmarks needs one search per landmark after another. It only depends on the
+// graph topology and is done once, re-customizing with new weights reuses the landmarks and runs
+// all searches in parallel.
+class LandmarkCustomizer
+{
+  private:
+    struct HeapData
+    {
+    };
+
+  public:
+    using Heap =
+        util::QueryHeap<NodeID, NodeID, EdgeWeight, HeapData, util::ArrayStorage<NodeID, int>>;
+    using HeapPtr = tbb::enumerable_thread_specific<Heap>;
+
+    // Farthest selection: every landmark is the node that is the farthest away from the closest
+    // landmark selected before. Fewer landmarks are returned if no node is left to select.
+    template <typename GraphT>
+    std::vector<NodeID> Select(const GraphT &graph, const std::size_t number_of_landmarks) const
+    {
+        const auto number_of_nodes = graph.GetNumberOfNodes();
+        std::vector<NodeID> landmarks;
+        if (number_of_nodes == 0)
+            return landmarks;
+
+        Heap heap(number_of_nodes);
+        std::vector<EdgeWeight> distances(number_of_nodes);
+        std::vector<EdgeWeight> closest_landmark;
+
+        // Start in the largest part of the graph that one node reaches, landmarks on small islands
+        // don't give useful bounds for the rest of the graph.
+        std::vector<bool> visited(number_of_nodes, false);
+        std::size_t most_reached = 0;
+        for (NodeID start = 0; start < number_of_nodes && 2 * most_reached < number_of_nodes;
+             ++start)
+        {
+            if (visited[start])
+                continue;
+
+            Search<true>(graph, heap, start, distances, 0, 1);
+            std::size_t reached = 0;
+            for (NodeID node = 0; node < number_of_nodes; ++node)
+            {
+                if (distances[node] != INVALID_EDGE_WEIGHT)
+                {
+                    visited[node] = true;
+                    ++reached;
+                }
+            }
+
+            if (reached > most_reached)
+            {
+                most_reached = reached;
+                closest_landmark = distances;
+            }
+        }
+
+        while (landmarks.size() < number_of_landmarks)
+        {
+            NodeID farthest = SPECIAL_NODEID;
+            EdgeWeight farthest_weight = 0;
+            for (NodeID node = 0; node < number_of_nodes; ++node)
+            {
+                if (closest_landmark[node] != INVALID_EDGE_WEIGHT &&
+                    closest_landmark[node] > farthest_weight)
+                {
+                    farthest = node;
+                    farthest_weight = closest_landmark[node];
+                }
+            }
+
+            if (farthest == SPECIAL_NODEID)
+                break;
+
+            // the distances from the start node only picked the first landmark
+            if (landmarks.empty())
+                std::fill(closest_landmark.begin(), closest_landmark.end(), INVALID_EDGE_WEIGHT);
+            landmarks.push_back(farthest);
+
+            Search<true>(graph, heap, farthest, distances, 0, 1);
+            for (NodeID node = 0; node < number_of_nodes; ++node)
+                closest_landmark[node] = std::min(closest_landmark[node], distances[node]);
+        }
+
+        return landmarks;
+    }
+
+    template <typename GraphT>
+    Landmarks Customize(const GraphT &graph, std::vector<NodeID> landmarks) const
+    {
+        const std::size_t number_of_nodes = graph.GetNumberOfNodes();
+        const auto number_of_landmarks = landmarks.size();
+
+        std::vector<EdgeWeight> from_landmarks(number_of_nodes * number_of_landmarks,
+                                               INVALID_EDGE_WEIGHT);
+        std::vector<EdgeWeight> to_landmarks(number_of_nodes * number_of_landmarks,
+                                             INVALID_EDGE_WEIGHT);
+
+        Heap heap_exemplar(number_of_nodes);
+        HeapPtr heaps(heap_exemplar);
+
+        // one forward and one backward search per landmark, each writes its own column
+        tbb::parallel_for(tbb::blocked_range<std::size_t>(0, 2 * number_of_landmarks),
+                          [&](const tbb::blocked_range<std::size_t> &range) {
+                              auto &heap = heaps.local();
+                              for (auto id = range.begin(), end = range.end(); id != end; ++id)
+                              {
+                                  const auto index = id / 2;
+                                  if (id % 2 == 0)
+                                      Search<true>(graph,
+                                                   heap,
+                                                   landmarks[index],
+                                                   from_landmarks,
+                                                   index,
+                                                   number_of_landmarks);
+                                  else
+                                      Search<false>(graph,
+                                                    heap,
+                                                    landmarks[index],
+                                                    to_landmarks,
+                                                    index,
+                                                    number_of_landmarks);
+                              }
+                          });
+
+        return Landmarks{
+            std::move(landmarks), std::move(from_landmarks), std::move(to_landmarks)};
+    }
+
+  private:
+    // Plain Dijkstra from (or to) the landmark, the weight of each node is written to
+    // weights[node * stride + offset] and INVALID_EDGE_WEIGHT for nodes that are not reached
+    template <bool FORWARD, typename GraphT>
+    void Search(const GraphT &graph,
+                Heap &heap,
+                const NodeID landmark,
+                std::vector<EdgeWeight> &weights,
+                const std::size_t offset,
+                const std::size_t stride) const
+    {
+        for (std::size_t node = 0; node < graph.GetNumberOfNodes(); ++node)
+            weights[node * stride + offset] = INVALID_EDGE_WEIGHT;
+
+        heap.Clear();
+        heap.Insert(landmark, 0, {});
+
+        while (!heap.Empty())
+        {
+            const NodeID node = heap.DeleteMin();
+            const EdgeWeight weight = heap.GetKey(node);
+            weights[node * stride + offset] = weight;
+
+            for (auto edge : graph.GetAdjacentEdgeRange(node))
+            {
+                const auto &data = graph.GetEdgeData(edge);
+                if (FORWARD ? !data.forward : !data.backward)
+                    continue;
+
+                const NodeID to = graph.GetTarget(edge);
+                const EdgeWeight to_weight = weight + data.weight;
+                if (!heap.WasInserted(to))
+                {
+                    heap.Insert(to, to_weight, {});
+                }
+                else if (!heap.WasRemoved(to) && to_weight < heap.GetKey(to))
+                {
+                    heap.DecreaseKey(to, to_weight);
+                }
+            }
+        }
+    }
+};
+} // namespace customizer
+} // namespace osrm
+
+#endif // OSRM_CUSTOMIZER_LANDMARK_CUSTOMIZER_HPP
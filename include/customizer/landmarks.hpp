@@ -0,0 +1,127 @@
+#ifndef OSRM_CUSTOMIZER_LANDMARKS_HPP
+#define OSRM_CUSTOMIZER_LANDMARKS_HPP
+
+#include "storage/tar_fwd.hpp"
+#include "storage/shared_memory_ownership.hpp"
+
+#include "util/typedefs.hpp"
+#include "util/vector_view.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace osrm
+{
+namespace customizer
+{
+namespace detail
+{
+template <storage::Ownership Ownership> class LandmarksImpl;
+}
+
+namespace serialization
+{
+template <storage::Ownership Ownership>
+inline void read(storage::tar::FileReader &reader,
+                 const std::string &name,
+                 detail::LandmarksImpl<Ownership> &landmarks);
+template <storage::Ownership Ownership>
+inline void write(storage::tar::FileWriter &writer,
+                  const std::string &name,
+                  const detail::LandmarksImpl<Ownership> &landmarks);
+} // namespace serialization
+
+namespace detail
+{
+// Shortest path weights from and to a small set of landmark nodes on the edge-based graph.
+//
+// By the triangle inequality they give lower bounds for the weight between any two nodes:
+//   d(u, v) >= d(L, v) - d(L, u)  and  d(u, v) >= d(u, L) - d(v, L)
+// The weights are computed on the graph without exclude flags. Excluding nodes only makes paths
+// longer, so the bounds stay valid for all exclude classes.
+//
+// Weights are stored node-major, all landmarks of a node are next to each other.
+template <storage::Ownership Ownership> class LandmarksImpl
+{
+    template <typename T> using Vector = util::ViewOrVector<T, Ownership>;
+
+  public:
+    LandmarksImpl() = default;
+
+    LandmarksImpl(Vector<NodeID> landmarks_,
+                  Vector<EdgeWeight> from_landmarks_,
+                  Vector<EdgeWeight> to_landmarks_)
+        : landmarks(std::move(landmarks_)), from_landmarks(std::move(from_landmarks_)),
+          to_landmarks(std::move(to_landmarks_))
+    {
+        BOOST_ASSERT(from_landmarks.size() == to_landmarks.size());
+        BOOST_ASSERT(landmarks.empty() || from_landmarks.size() % landmarks.size() == 0);
+    }
+
+    bool Empty() const { return landmarks.empty(); }
+
+    std::size_t GetNumberOfLandmarks() const { return landmarks.size(); }
+
+    NodeID GetLandmark(const std::size_t index) const { return landmarks[index]; }
+
+    // Lower bound of the weight of the shortest path from -> to.
+    // Returns INVALID_EDGE_WEIGHT if the landmarks prove that there is no such path.
+    EdgeWeight GetLowerBound(const NodeID from, const NodeID to) const
+    {
+        const auto number_of_landmarks = landmarks.size();
+        const auto from_offset = from * number_of_landmarks;
+        const auto to_offset = to * number_of_landmarks;
+        BOOST_ASSERT(from_offset + number_of_landmarks <= from_landmarks.size());
+        BOOST_ASSERT(to_offset + number_of_landmarks <= from_landmarks.size());
+
+        EdgeWeight bound = 0;
+        for (std::size_t index = 0; index < number_of_landmarks; ++index)
+        {
+            const auto landmark_to_from = from_landmarks[from_offset + index];
+            const auto landmark_to_to = from_landmarks[to_offset + index];
+            if (landmark_to_from != INVALID_EDGE_WEIGHT)
+            {
+                // the landmark reaches from but not to
+                if (landmark_to_to == INVALID_EDGE_WEIGHT)
+                    return INVALID_EDGE_WEIGHT;
+                bound = std::max(bound, landmark_to_to - landmark_to_from);
+            }
+
+            const auto from_to_landmark = to_landmarks[from_offset + index];
+            const auto to_to_landmark = to_landmarks[to_offset + index];
+            if (to_to_landmark != INVALID_EDGE_WEIGHT)
+            {
+                // to reaches the landmark but from does not
+                if (from_to_landmark == INVALID_EDGE_WEIGHT)
+                    return INVALID_EDGE_WEIGHT;
+                bound = std::max(bound, from_to_landmark - to_to_landmark);
+            }
+        }
+
+        return bound;
+    }
+
+    friend void serialization::read<Ownership>(storage::tar::FileReader &reader,
+                                               const std::string &name,
+                                               detail::LandmarksImpl<Ownership> &landmarks);
+    friend void serialization::write<Ownership>(storage::tar::FileWriter &writer,
+                                                const std::string &name,
+                                                const detail::LandmarksImpl<Ownership> &landmarks);
+
+  private:
+    Vector<NodeID> landmarks;
+    Vector<EdgeWeight> from_landmarks;
+    Vector<EdgeWeight> to_landmarks;
+};
+} // namespace detail
+
+using Landmarks = detail::LandmarksImpl<storage::Ownership::Container>;
+using LandmarksView = detail::LandmarksImpl<storage::Ownership::View>;
+} // namespace customizer
+} // namespace osrm
+
+#endif
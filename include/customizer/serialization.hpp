@@ -2,6 +2,7 @@
 #define OSRM_CUSTOMIZER_SERIALIZATION_HPP
 
 #include "customizer/edge_based_graph.hpp"
+#include "customizer/landmarks.hpp"
 
 #include "partitioner/cell_storage.hpp"
 
@@ -36,6 +37,26 @@ inline void write(storage::tar::FileWriter &writer,
     storage::serialization::write(writer, name + "/distances", metric.distances);
 }
 
+template <storage::Ownership Ownership>
+inline void read(storage::tar::FileReader &reader,
+                 const std::string &name,
+                 detail::LandmarksImpl<Ownership> &landmarks)
+{
+    storage::serialization::read(reader, name + "/landmarks", landmarks.landmarks);
+    storage::serialization::read(reader, name + "/from_landmarks", landmarks.from_landmarks);
+    storage::serialization::read(reader, name + "/to_landmarks", landmarks.to_landmarks);
+}
+
+template <storage::Ownership Ownership>
+inline void write(storage::tar::FileWriter &writer,
+                  const std::string &name,
+                  const detail::LandmarksImpl<Ownership> &landmarks)
+{
+    storage::serialization::write(writer, name + "/landmarks", landmarks.landmarks);
+    storage::serialization::write(writer, name + "/from_landmarks", landmarks.from_landmarks);
+    storage::serialization::write(writer, name + "/to_landmarks", landmarks.to_landmarks);
+}
+
 template <typename EdgeDataT, storage::Ownership Ownership>
 inline void read(storage::tar::FileReader &reader,
                  const std::string &name,
@@ -59,6 +59,9 @@ template <typename AlgorithmT> struct HasGetTileTurns final : std::false_type
 template <typename AlgorithmT> struct HasExcludeFlags final : std::false_type
 {
 };
+template <typename AlgorithmT> struct HasIsochroneSearch final : std::false_type
+{
+};
 
 // Algorithms supported by Contraction Hierarchies
 template <> struct HasAlternativePathSearch<ch::Algorithm> final : std::true_type
@@ -111,6 +114,9 @@ template <> struct HasGetTileTurns<mld::Algorithm> final : std::true_type
 template <> struct HasExcludeFlags<mld::Algorithm> final : std::true_type
 {
 };
+template <> struct HasIsochroneSearch<mld::Algorithm> final : std::true_type
+{
+};
 } // namespace routing_algorithms
 } // namespace engine
 } // namespace osrm
@@ -1541,6 +1541,7 @@ struct TableT : public flatbuffers::NativeTable {
   std::vector<float> distances;
   std::vector<std::unique_ptr<osrm::engine::api::fbresult::WaypointT>> destinations;
   std::vector<uint32_t> fallback_speed_cells;
+  std::vector<uint32_t> sparse_cells;
   TableT()
       : rows(0),
         cols(0) {
@@ -1555,7 +1556,8 @@ struct Table FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_COLS = 8,
     VT_DISTANCES = 10,
     VT_DESTINATIONS = 12,
-    VT_FALLBACK_SPEED_CELLS = 14
+    VT_FALLBACK_SPEED_CELLS = 14,
+    VT_SPARSE_CELLS = 16
   };
   const flatbuffers::Vector<float> *durations() const {
     return GetPointer<const flatbuffers::Vector<float> *>(VT_DURATIONS);
@@ -1575,6 +1577,9 @@ struct Table FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const flatbuffers::Vector<uint32_t> *fallback_speed_cells() const {
     return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_FALLBACK_SPEED_CELLS);
   }
+  const flatbuffers::Vector<uint32_t> *sparse_cells() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_SPARSE_CELLS);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_DURATIONS) &&
@@ -1588,6 +1593,8 @@ struct Table FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            verifier.VerifyVectorOfTables(destinations()) &&
            VerifyOffset(verifier, VT_FALLBACK_SPEED_CELLS) &&
            verifier.VerifyVector(fallback_speed_cells()) &&
+           VerifyOffset(verifier, VT_SPARSE_CELLS) &&
+           verifier.VerifyVector(sparse_cells()) &&
            verifier.EndTable();
   }
   TableT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
@@ -1616,6 +1623,9 @@ struct TableBuilder {
   void add_fallback_speed_cells(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> fallback_speed_cells) {
     fbb_.AddOffset(Table::VT_FALLBACK_SPEED_CELLS, fallback_speed_cells);
   }
+  void add_sparse_cells(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> sparse_cells) {
+    fbb_.AddOffset(Table::VT_SPARSE_CELLS, sparse_cells);
+  }
   explicit TableBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -1635,8 +1645,10 @@ inline flatbuffers::Offset<Table> CreateTable(
     uint16_t cols = 0,
     flatbuffers::Offset<flatbuffers::Vector<float>> distances = 0,
     flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<osrm::engine::api::fbresult::Waypoint>>> destinations = 0,
-    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> fallback_speed_cells = 0) {
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> fallback_speed_cells = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> sparse_cells = 0) {
   TableBuilder builder_(_fbb);
+  builder_.add_sparse_cells(sparse_cells);
   builder_.add_fallback_speed_cells(fallback_speed_cells);
   builder_.add_destinations(destinations);
   builder_.add_distances(distances);
@@ -1653,11 +1665,13 @@ inline flatbuffers::Offset<Table> CreateTableDirect(
     uint16_t cols = 0,
     const std::vector<float> *distances = nullptr,
     const std::vector<flatbuffers::Offset<osrm::engine::api::fbresult::Waypoint>> *destinations = nullptr,
-    const std::vector<uint32_t> *fallback_speed_cells = nullptr) {
+    const std::vector<uint32_t> *fallback_speed_cells = nullptr,
+    const std::vector<uint32_t> *sparse_cells = nullptr) {
   auto durations__ = durations ? _fbb.CreateVector<float>(*durations) : 0;
   auto distances__ = distances ? _fbb.CreateVector<float>(*distances) : 0;
   auto destinations__ = destinations ? _fbb.CreateVector<flatbuffers::Offset<osrm::engine::api::fbresult::Waypoint>>(*destinations) : 0;
   auto fallback_speed_cells__ = fallback_speed_cells ? _fbb.CreateVector<uint32_t>(*fallback_speed_cells) : 0;
+  auto sparse_cells__ = sparse_cells ? _fbb.CreateVector<uint32_t>(*sparse_cells) : 0;
   return osrm::engine::api::fbresult::CreateTable(
       _fbb,
       durations__,
@@ -1665,7 +1679,8 @@ inline flatbuffers::Offset<Table> CreateTableDirect(
       cols,
       distances__,
       destinations__,
-      fallback_speed_cells__);
+      fallback_speed_cells__,
+      sparse_cells__);
 }
 
 flatbuffers::Offset<Table> CreateTable(flatbuffers::FlatBufferBuilder &_fbb, const TableT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
@@ -2293,6 +2308,7 @@ inline void Table::UnPackTo(TableT *_o, const flatbuffers::resolver_function_t *
   { auto _e = distances(); if (_e) { _o->distances.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->distances[_i] = _e->Get(_i); } } };
   { auto _e = destinations(); if (_e) { _o->destinations.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->destinations[_i] = std::unique_ptr<osrm::engine::api::fbresult::WaypointT>(_e->Get(_i)->UnPack(_resolver)); } } };
   { auto _e = fallback_speed_cells(); if (_e) { _o->fallback_speed_cells.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->fallback_speed_cells[_i] = _e->Get(_i); } } };
+  { auto _e = sparse_cells(); if (_e) { _o->sparse_cells.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->sparse_cells[_i] = _e->Get(_i); } } };
 }
 
 inline flatbuffers::Offset<Table> Table::Pack(flatbuffers::FlatBufferBuilder &_fbb, const TableT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
@@ -2309,6 +2325,7 @@ inline flatbuffers::Offset<Table> CreateTable(flatbuffers::FlatBufferBuilder &_f
   auto _distances = _o->distances.size() ? _fbb.CreateVector(_o->distances) : 0;
   auto _destinations = _o->destinations.size() ? _fbb.CreateVector<flatbuffers::Offset<osrm::engine::api::fbresult::Waypoint>> (_o->destinations.size(), [](size_t i, _VectorArgs *__va) { return CreateWaypoint(*__va->__fbb, __va->__o->destinations[i].get(), __va->__rehasher); }, &_va ) : 0;
   auto _fallback_speed_cells = _o->fallback_speed_cells.size() ? _fbb.CreateVector(_o->fallback_speed_cells) : 0;
+  auto _sparse_cells = _o->sparse_cells.size() ? _fbb.CreateVector(_o->sparse_cells) : 0;
   return osrm::engine::api::fbresult::CreateTable(
       _fbb,
       _durations,
@@ -2316,7 +2333,8 @@ inline flatbuffers::Offset<Table> CreateTable(flatbuffers::FlatBufferBuilder &_f
       _cols,
       _distances,
       _destinations,
-      _fallback_speed_cells);
+      _fallback_speed_cells,
+      _sparse_cells);
 }
 
 inline ErrorT *Error::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
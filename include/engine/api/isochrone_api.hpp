@@ -0,0 +1,89 @@
+#ifndef ENGINE_API_ISOCHRONE_API_HPP
+#define ENGINE_API_ISOCHRONE_API_HPP
+
+#include "engine/api/base_api.hpp"
+#include "engine/api/isochrone_parameters.hpp"
+#include "engine/api/json_factory.hpp"
+
+#include "engine/phantom_node.hpp"
+
+#include "util/coordinate.hpp"
+#include "util/json_container.hpp"
+
+#include <boost/assert.hpp>
+
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace api
+{
+
+class IsochroneAPI final : public BaseAPI
+{
+  public:
+    using Ring = std::vector<util::Coordinate>;
+
+    IsochroneAPI(const datafacade::BaseDataFacade &facade_,
+                 const IsochroneParameters &parameters_)
+        : BaseAPI(facade_, parameters_), parameters(parameters_)
+    {
+    }
+
+    // Only JSON output is supported, the plugin rejects other result types.
+    // Holds the rings of every contour in the order of the parameters.
+    void MakeResponse(const PhantomNode &source_phantom,
+                      const std::vector<std::vector<Ring>> &contour_rings,
+                      util::json::Object &response) const
+    {
+        BOOST_ASSERT(contour_rings.size() == parameters.contours.size());
+
+        if (!parameters.skip_waypoints)
+        {
+            util::json::Array waypoints;
+            waypoints.values.push_back(MakeWaypoint(source_phantom));
+            response.values["waypoints"] = std::move(waypoints);
+        }
+
+        util::json::Array isochrones;
+        isochrones.values.reserve(contour_rings.size());
+        for (std::size_t index = 0; index < contour_rings.size(); ++index)
+        {
+            // every ring is the outer ring of a polygon without holes
+            util::json::Array polygons;
+            for (const auto &ring : contour_rings[index])
+            {
+                util::json::Array coordinates;
+                coordinates.values.reserve(ring.size());
+                for (const auto &coordinate : ring)
+                    coordinates.values.push_back(json::detail::coordinateToLonLat(coordinate));
+
+                util::json::Array polygon;
+                polygon.values.push_back(std::move(coordinates));
+                polygons.values.push_back(std::move(polygon));
+            }
+
+            util::json::Object geometry;
+            geometry.values["type"] = "MultiPolygon";
+            geometry.values["coordinates"] = std::move(polygons);
+
+            util::json::Object isochrone;
+            isochrone.values["duration"] = util::json::Number(parameters.contours[index]);
+            isochrone.values["geometry"] = std::move(geometry);
+            isochrones.values.push_back(std::move(isochrone));
+        }
+        response.values["isochrones"] = std::move(isochrones);
+
+        response.values["code"] = "Ok";
+    }
+
+    const IsochroneParameters &parameters;
+};
+
+} // namespace api
+} // namespace engine
+} // namespace osrm
+
+#endif
@@ -30,6 +30,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "engine/api/route_parameters.hpp"
 
+#include <algorithm>
+#include <string>
 #include <vector>
 
 namespace osrm
@@ -44,6 +46,7 @@ namespace api
  *
  * Holds member attributes:
  *  - timestamps: timestamp(s) for the corresponding input coordinate(s)
+ *  - session: id of a matching session the coordinates continue, empty for a complete trace
  *
  * \see OSRM, Coordinate, Hint, Bearing, RouteParame, RouteParameters, TableParameters,
  *      NearestParameters, TripParameters, MatchParameters and TileParameters
@@ -91,10 +94,16 @@ struct MatchParameters : public RouteParameters
     std::vector<unsigned> timestamps;
     GapsType gaps;
     bool tidy;
+    std::string session;
 
     bool IsValid() const
     {
-        return RouteParameters::IsValid() &&
+        // a session continues a trace that was sent before, a single new coordinate is enough
+        const auto route_parameters_ok =
+            RouteParameters::IsValid() ||
+            (!session.empty() && coordinates.size() == 1 && BaseParameters::IsValid() &&
+             std::all_of(waypoints.begin(), waypoints.end(), [](const auto w) { return w == 0; }));
+        return route_parameters_ok &&
                (timestamps.empty() || timestamps.size() == coordinates.size());
     }
 };
@@ -0,0 +1,75 @@
+#ifndef ENGINE_API_POI_API_HPP
+#define ENGINE_API_POI_API_HPP
+
+#include "engine/api/base_api.hpp"
+#include "engine/api/base_result.hpp"
+#include "engine/api/json_factory.hpp"
+#include "engine/api/poi_parameters.hpp"
+
+#include "engine/phantom_node.hpp"
+#include "engine/routing_algorithms/many_to_many.hpp"
+
+#include "util/json_container.hpp"
+
+#include <boost/assert.hpp>
+
+#include <cmath>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace api
+{
+
+class POIAPI final : public BaseAPI
+{
+  public:
+    POIAPI(const datafacade::BaseDataFacade &facade_, const POIParameters &parameters_)
+        : BaseAPI(facade_, parameters_), parameters(parameters_)
+    {
+    }
+
+    // Only JSON output is supported, the plugin rejects other result types
+    void MakeResponse(const PhantomNode &source_phantom,
+                      const std::vector<PhantomNode> &poi_phantoms,
+                      const std::vector<routing_algorithms::NearestPOI> &nearest_pois,
+                      util::json::Object &response) const
+    {
+        if (!parameters.skip_waypoints)
+        {
+            util::json::Array waypoints;
+            waypoints.values.push_back(MakeWaypoint(source_phantom));
+            response.values["waypoints"] = std::move(waypoints);
+        }
+
+        util::json::Array pois;
+        pois.values.reserve(nearest_pois.size());
+        for (const auto &nearest_poi : nearest_pois)
+        {
+            BOOST_ASSERT(nearest_poi.poi_index < poi_phantoms.size());
+
+            util::json::Object poi;
+            poi.values["index"] = nearest_poi.poi_index;
+            poi.values["location"] =
+                json::detail::coordinateToLonLat(poi_phantoms[nearest_poi.poi_index].location);
+            // durations are in deciseconds, distances are rounded to a single decimal place
+            poi.values["duration"] = util::json::Number(nearest_poi.duration / 10.);
+            poi.values["distance"] =
+                util::json::Number(std::round(nearest_poi.distance * 10) / 10.);
+            pois.values.push_back(std::move(poi));
+        }
+        response.values["pois"] = std::move(pois);
+
+        response.values["code"] = "Ok";
+    }
+
+    const POIParameters &parameters;
+};
+
+} // namespace api
+} // namespace engine
+} // namespace osrm
+
+#endif
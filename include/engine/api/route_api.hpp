@@ -26,6 +26,7 @@
 #include "util/coordinate.hpp"
 #include "util/integer_range.hpp"
 #include "util/json_util.hpp"
+#include "util/monotonic_arena.hpp"
 
 #include <iterator>
 #include <vector>
@@ -333,12 +334,15 @@ class RouteAPI : public BaseAPI
               const std::vector<bool> &source_traversed_in_reverse,
               const std::vector<bool> &target_traversed_in_reverse) const
     {
+        // steps are allocated from the arena of this thread until the route is rendered
+        util::ArenaScope arena_scope;
+
         auto legs_info = MakeLegs(segment_end_coordinates,
                                   unpacked_path_segments,
                                   source_traversed_in_reverse,
                                   target_traversed_in_reverse);
-        std::vector<guidance::RouteLeg> legs = legs_info.first;
-        std::vector<guidance::LegGeometry> leg_geometries = legs_info.second;
+        std::vector<guidance::RouteLeg> legs = std::move(legs_info.first);
+        std::vector<guidance::LegGeometry> leg_geometries = std::move(legs_info.second);
         auto route = guidance::assembleRoute(legs);
 
         // Fill legs
@@ -346,7 +350,7 @@ class RouteAPI : public BaseAPI
         routeLegs.reserve(legs.size());
         for (const auto idx : util::irange<std::size_t>(0UL, legs.size()))
         {
-            auto leg = legs[idx];
+            const auto &leg = legs[idx];
             auto &leg_geometry = leg_geometries[idx];
 
             // Fill steps
@@ -681,7 +685,8 @@ class RouteAPI : public BaseAPI
                 fbresult::Position maneuverPosition{
                     static_cast<float>(util::toFloating(intersection.location.lon).__value),
                     static_cast<float>(util::toFloating(intersection.location.lat).__value)};
-                auto bearings_vector = fb_result.CreateVector(intersection.bearings);
+                auto bearings_vector = fb_result.CreateVector(intersection.bearings.data(),
+                                                              intersection.bearings.size());
                 std::vector<flatbuffers::Offset<flatbuffers::String>> classes;
                 classes.resize(intersection.classes.size());
                 std::transform(
@@ -690,7 +695,9 @@ class RouteAPI : public BaseAPI
                     classes.begin(),
                     [&fb_result](const std::string cls) { return fb_result.CreateString(cls); });
                 auto classes_vector = fb_result.CreateVector(classes);
-                auto entry_vector = fb_result.CreateVector(intersection.entry);
+                auto entry_vector = fb_result.CreateVector<std::uint8_t>(
+                    intersection.entry.size(),
+                    [&intersection](const std::size_t index) { return intersection.entry[index]; });
 
                 fbresult::IntersectionBuilder intersectionBuilder(fb_result);
                 intersectionBuilder.add_location(&maneuverPosition);
@@ -710,12 +717,15 @@ class RouteAPI : public BaseAPI
                                  const std::vector<bool> &source_traversed_in_reverse,
                                  const std::vector<bool> &target_traversed_in_reverse) const
     {
+        // steps are allocated from the arena of this thread until the route is rendered
+        util::ArenaScope arena_scope;
+
         auto legs_info = MakeLegs(segment_end_coordinates,
                                   unpacked_path_segments,
                                   source_traversed_in_reverse,
                                   target_traversed_in_reverse);
-        std::vector<guidance::RouteLeg> legs = legs_info.first;
-        std::vector<guidance::LegGeometry> leg_geometries = legs_info.second;
+        std::vector<guidance::RouteLeg> legs = std::move(legs_info.first);
+        std::vector<guidance::LegGeometry> leg_geometries = std::move(legs_info.second);
 
         auto route = guidance::assembleRoute(legs);
         boost::optional<util::json::Value> json_overview =
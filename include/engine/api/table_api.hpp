@@ -116,18 +116,34 @@ class TableAPI final : public BaseAPI
             }
         }
 
+        std::vector<TableCellRef> reachable_cells;
+        flatbuffers::Offset<flatbuffers::Vector<uint32_t>> sparse_cells;
+        if (parameters.sparse)
+        {
+            reachable_cells = GetReachableCells(tables.first, number_of_destinations);
+            sparse_cells = MakeEstimatesTable(fb_result, reachable_cells);
+        }
+
         bool use_durations = parameters.annotations & TableParameters::AnnotationsType::Duration;
         flatbuffers::Offset<flatbuffers::Vector<float>> durations;
         if (use_durations)
         {
-            durations = MakeDurationTable(fb_result, tables.first);
+            durations = MakeDurationTable(
+                fb_result,
+                parameters.sparse
+                    ? GetSparseValues(tables.first, reachable_cells, number_of_destinations)
+                    : tables.first);
         }
 
         bool use_distances = parameters.annotations & TableParameters::AnnotationsType::Distance;
         flatbuffers::Offset<flatbuffers::Vector<float>> distances;
         if (use_distances)
         {
-            distances = MakeDistanceTable(fb_result, tables.second);
+            distances = MakeDistanceTable(
+                fb_result,
+                parameters.sparse
+                    ? GetSparseValues(tables.second, reachable_cells, number_of_destinations)
+                    : tables.second);
         }
 
         bool have_speed_cells =
@@ -154,6 +170,10 @@ class TableAPI final : public BaseAPI
         {
             table.add_fallback_speed_cells(speed_cells);
         }
+        if (parameters.sparse)
+        {
+            table.add_sparse_cells(sparse_cells);
+        }
         auto table_buffer = table.Finish();
 
         fbresult::FBResultBuilder response(fb_result);
@@ -208,16 +228,41 @@ class TableAPI final : public BaseAPI
             }
         }
 
-        if (parameters.annotations & TableParameters::AnnotationsType::Duration)
+        if (parameters.sparse)
         {
-            response.values["durations"] =
-                MakeDurationTable(tables.first, number_of_sources, number_of_destinations);
-        }
+            // Only the reachable cells are listed, the annotations are flat arrays in cell order
+            const auto reachable_cells = GetReachableCells(tables.first, number_of_destinations);
+            response.values["sparse_cells"] = MakeEstimatesTable(reachable_cells);
 
-        if (parameters.annotations & TableParameters::AnnotationsType::Distance)
+            if (parameters.annotations & TableParameters::AnnotationsType::Duration)
+            {
+                const auto durations =
+                    GetSparseValues(tables.first, reachable_cells, number_of_destinations);
+                response.values["durations"] =
+                    std::move(MakeDurationTable(durations, 1, durations.size()).values.front());
+            }
+
+            if (parameters.annotations & TableParameters::AnnotationsType::Distance)
+            {
+                const auto distances =
+                    GetSparseValues(tables.second, reachable_cells, number_of_destinations);
+                response.values["distances"] =
+                    std::move(MakeDistanceTable(distances, 1, distances.size()).values.front());
+            }
+        }
+        else
         {
-            response.values["distances"] =
-                MakeDistanceTable(tables.second, number_of_sources, number_of_destinations);
+            if (parameters.annotations & TableParameters::AnnotationsType::Duration)
+            {
+                response.values["durations"] =
+                    MakeDurationTable(tables.first, number_of_sources, number_of_destinations);
+            }
+
+            if (parameters.annotations & TableParameters::AnnotationsType::Distance)
+            {
+                response.values["distances"] =
+                    MakeDistanceTable(tables.second, number_of_sources, number_of_destinations);
+            }
         }
 
         if (parameters.fallback_speed != INVALID_FALLBACK_SPEED && parameters.fallback_speed > 0)
@@ -229,6 +274,35 @@ class TableAPI final : public BaseAPI
     }
 
   protected:
+    // Cells of the row-major durations table that have a route
+    std::vector<TableCellRef> GetReachableCells(const std::vector<EdgeDuration> &durations,
+                                                const std::size_t number_of_columns) const
+    {
+        std::vector<TableCellRef> cells;
+        for (std::size_t index = 0; index < durations.size(); ++index)
+        {
+            if (durations[index] != MAXIMAL_EDGE_DURATION)
+            {
+                cells.emplace_back(index / number_of_columns, index % number_of_columns);
+            }
+        }
+        return cells;
+    }
+
+    template <typename T>
+    std::vector<T> GetSparseValues(const std::vector<T> &values,
+                                   const std::vector<TableCellRef> &cells,
+                                   const std::size_t number_of_columns) const
+    {
+        std::vector<T> sparse_values;
+        sparse_values.reserve(cells.size());
+        for (const auto &cell : cells)
+        {
+            sparse_values.push_back(values[cell.row * number_of_columns + cell.column]);
+        }
+        return sparse_values;
+    }
+
     virtual flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<fbresult::Waypoint>>>
     MakeWaypoints(flatbuffers::FlatBufferBuilder &builder,
                   const std::vector<PhantomNode> &phantoms) const
@@ -30,6 +30,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "engine/api/base_parameters.hpp"
 
+#include <boost/optional.hpp>
+
 #include <cstddef>
 
 #include <algorithm>
@@ -51,6 +53,11 @@ namespace api
  *             use all coordinates as sources
  *  - destinations: indices into coordinates indicating destinations for the Table service, no
  *                  destinations means use all coordinates as destinations
+ *  - max_duration: only report pairs with a duration of at most this many seconds, the searches
+ *                  do not expand beyond it
+ *  - max_distance: only report pairs with a distance of at most this many meters, the searches
+ *                  do not expand beyond it
+ *  - sparse: list only the reachable pairs instead of returning full matrices
  *
  * \see OSRM, Coordinate, Hint, Bearing, RouteParame, RouteParameters, TableParameters,
  *      NearestParameters, TripParameters, MatchParameters and TileParameters
@@ -81,6 +88,11 @@ struct TableParameters : public BaseParameters
 
     double scale_factor = 1;
 
+    boost::optional<double> max_duration;
+    boost::optional<double> max_distance;
+
+    bool sparse = false;
+
     TableParameters() = default;
     template <typename... Args>
     TableParameters(std::vector<std::size_t> sources_,
@@ -143,6 +155,16 @@ struct TableParameters : public BaseParameters
         if (scale_factor <= 0)
             return false;
 
+        if (max_duration && *max_duration <= 0)
+            return false;
+
+        if (max_distance && *max_distance <= 0)
+            return false;
+
+        // Cells beyond the bounds are not routes that were not found, don't estimate them
+        if (fallback_speed != INVALID_FALLBACK_SPEED && (max_duration || max_distance))
+            return false;
+
         return true;
     }
 };
@@ -4,10 +4,12 @@
 #include "engine/datafacade/contiguous_internalmem_datafacade.hpp"
 #include "engine/datafacade/shared_memory_allocator.hpp"
 #include "engine/datafacade_factory.hpp"
+#include "engine/metric_checksum.hpp"
 
 #include "storage/shared_datatype.hpp"
 #include "storage/shared_memory.hpp"
 #include "storage/shared_monitor.hpp"
+#include "storage/warmup.hpp"
 
 #include <boost/interprocess/sync/named_upgradable_mutex.hpp>
 #include <boost/thread/lock_types.hpp>
@@ -36,9 +38,17 @@ class DataWatchdogImpl<AlgorithmT, datafacade::ContiguousInternalMemoryDataFacad
     using Facade = datafacade::ContiguousInternalMemoryDataFacade<AlgorithmT>;
 
   public:
-    DataWatchdogImpl(const std::string &dataset_name) : dataset_name(dataset_name), active(true)
+    DataWatchdogImpl(const std::string &dataset_name,
+                     const std::size_t snapping_cache_size,
+                     const std::size_t unpacking_cache_size,
+                     const std::vector<storage::WarmupGroup> &warmup_order,
+                     const bool compute_metric_checksum)
+        : dataset_name(dataset_name), snapping_cache_size(snapping_cache_size),
+          unpacking_cache_size(unpacking_cache_size), warmup_order(warmup_order),
+          compute_metric_checksum(compute_metric_checksum), active(true)
     {
         // create the initial facade before launching the watchdog thread
+        std::shared_ptr<datafacade::SharedMemoryAllocator> allocator;
         {
             boost::interprocess::scoped_lock<mutex_type> current_region_lock(barrier.get_mutex());
 
@@ -55,15 +65,14 @@ class DataWatchdogImpl<AlgorithmT, datafacade::ContiguousInternalMemoryDataFacad
             updatable_shared_region = &shared_register.GetRegion(updatable_region_id);
             static_region = *static_shared_region;
             updatable_region = *updatable_shared_region;
+            allocator = MakeAllocator();
+        }
 
-            {
-                boost::unique_lock<boost::shared_mutex> swap_lock(factory_mutex);
-                facade_factory =
-                    DataFacadeFactory<datafacade::ContiguousInternalMemoryDataFacade, AlgorithmT>(
-                        std::make_shared<datafacade::SharedMemoryAllocator>(
-                            std::vector<storage::SharedRegionRegister::ShmKey>{
-                                static_region.shm_key, updatable_region.shm_key}));
-            }
+        // warming up touches every page of the dataset, so it must not block osrm-datastore
+        auto factory = MakeFactory(std::move(allocator));
+        {
+            boost::unique_lock<boost::shared_mutex> swap_lock(factory_mutex);
+            facade_factory = std::move(factory);
         }
 
         watcher = std::thread(&DataWatchdogImpl::Run, this);
@@ -90,6 +99,37 @@ class DataWatchdogImpl<AlgorithmT, datafacade::ContiguousInternalMemoryDataFacad
     }
 
   private:
+    // The delta region of osrm-datastore --only-changed-blocks comes and goes with updates of
+    // the updatable region, so it is looked up again on every change
+    std::vector<storage::SharedRegionRegister::ShmKey> GetShmKeys() const
+    {
+        std::vector<storage::SharedRegionRegister::ShmKey> shm_keys{static_region.shm_key,
+                                                                   updatable_region.shm_key};
+        const auto &shared_register = barrier.data();
+        const auto delta_region_id = shared_register.Find(dataset_name + "/updatable_delta");
+        if (delta_region_id != storage::SharedRegionRegister::INVALID_REGION_ID)
+        {
+            shm_keys.push_back(shared_register.GetRegion(delta_region_id).shm_key);
+        }
+        return shm_keys;
+    }
+
+    std::shared_ptr<datafacade::SharedMemoryAllocator> MakeAllocator() const
+    {
+        return std::make_shared<datafacade::SharedMemoryAllocator>(GetShmKeys());
+    }
+
+    // Warms up the data and computes its metric checksum, before queries can see it
+    DataFacadeFactory<datafacade::ContiguousInternalMemoryDataFacade, AlgorithmT>
+    MakeFactory(std::shared_ptr<datafacade::SharedMemoryAllocator> allocator) const
+    {
+        storage::warmupBlocks(allocator->GetIndex(), warmup_order);
+        const auto metric_checksum =
+            compute_metric_checksum ? getMetricChecksum(allocator->GetIndex()) : 0;
+        return DataFacadeFactory<datafacade::ContiguousInternalMemoryDataFacade, AlgorithmT>(
+            std::move(allocator), snapping_cache_size, unpacking_cache_size, metric_checksum);
+    }
+
     void Run()
     {
         while (active)
@@ -118,13 +158,15 @@ class DataWatchdogImpl<AlgorithmT, datafacade::ContiguousInternalMemoryDataFacad
                         << (int)updatable_region.shm_key << " with timestamps "
                         << static_region.timestamp << " and " << updatable_region.timestamp;
 
+            // the regions are attached under the register lock, but warmed up without it so
+            // osrm-datastore is not blocked; queries only switch over once warmup is done
+            auto allocator = MakeAllocator();
+            current_region_lock.unlock();
+
+            auto factory = MakeFactory(std::move(allocator));
             {
                 boost::unique_lock<boost::shared_mutex> swap_lock(factory_mutex);
-                facade_factory =
-                    DataFacadeFactory<datafacade::ContiguousInternalMemoryDataFacade, AlgorithmT>(
-                        std::make_shared<datafacade::SharedMemoryAllocator>(
-                            std::vector<storage::SharedRegionRegister::ShmKey>{
-                                static_region.shm_key, updatable_region.shm_key}));
+                facade_factory = std::move(factory);
             }
         }
 
@@ -133,6 +175,10 @@ class DataWatchdogImpl<AlgorithmT, datafacade::ContiguousInternalMemoryDataFacad
 
     mutable boost::shared_mutex factory_mutex;
     const std::string dataset_name;
+    const std::size_t snapping_cache_size;
+    const std::size_t unpacking_cache_size;
+    const std::vector<storage::WarmupGroup> warmup_order;
+    const bool compute_metric_checksum;
     storage::SharedMonitor<storage::SharedRegionRegister> barrier;
     std::thread watcher;
     bool active;
@@ -3,8 +3,10 @@
 
 #include "contractor/query_edge.hpp"
 #include "customizer/edge_based_graph.hpp"
+#include "customizer/landmarks.hpp"
 #include "extractor/edge_based_edge.hpp"
 #include "engine/algorithm.hpp"
+#include "engine/unpacking_cache.hpp"
 
 #include "partitioner/cell_storage.hpp"
 #include "partitioner/multi_level_partition.hpp"
@@ -55,6 +57,9 @@ template <> class AlgorithmDataFacade<CH>
     virtual EdgeID FindSmallestEdge(const NodeID from,
                                     const NodeID to,
                                     const std::function<bool(EdgeData)> filter) const = 0;
+
+    // shortcuts that were unpacked before on this dataset
+    virtual UnpackingCache &GetUnpackingCache() const = 0;
 };
 
 template <> class AlgorithmDataFacade<MLD>
@@ -94,6 +99,9 @@ template <> class AlgorithmDataFacade<MLD>
 
     virtual const customizer::CellMetricView &GetCellMetric() const = 0;
 
+    // empty if the dataset was customized without landmarks
+    virtual const customizer::LandmarksView &GetLandmarks() const = 0;
+
     virtual EdgeRange GetBorderEdgeRange(const LevelID level, const NodeID node) const = 0;
 
     // searches for a specific edge
@@ -50,16 +50,33 @@ class ContiguousInternalMemoryAlgorithmDataFacade<CH> : public datafacade::Algor
     // allocator that keeps the allocation data
     std::shared_ptr<ContiguousBlockAllocator> allocator;
 
+    // Unpacking depends on the exclude class, the cache can't be shared between facades.
+    // It is dropped together with the facade when a new dataset is loaded.
+    std::unique_ptr<UnpackingCache> unpacking_cache;
+
   public:
     ContiguousInternalMemoryAlgorithmDataFacade(
         std::shared_ptr<ContiguousBlockAllocator> allocator_,
         const std::string &metric_name,
-        std::size_t exclude_index)
-        : allocator(std::move(allocator_))
+        std::size_t exclude_index,
+        const std::size_t unpacking_cache_size)
+        : allocator(std::move(allocator_)),
+          unpacking_cache(std::make_unique<UnpackingCache>(unpacking_cache_size))
     {
         InitializeInternalPointers(allocator->GetIndex(), metric_name, exclude_index);
     }
 
+    ~ContiguousInternalMemoryAlgorithmDataFacade()
+    {
+        const auto lookups = unpacking_cache->GetHits() + unpacking_cache->GetMisses();
+        if (lookups > 0)
+        {
+            util::Log(logDEBUG) << "Unpacking cache: " << unpacking_cache->GetHits() << " of "
+                                << lookups << " shortcuts were cached, "
+                                << unpacking_cache->GetSize() << " entries";
+        }
+    }
+
     void InitializeInternalPointers(const storage::SharedDataIndex &index,
                                     const std::string &metric_name,
                                     const std::size_t exclude_index)
@@ -113,6 +130,8 @@ class ContiguousInternalMemoryAlgorithmDataFacade<CH> : public datafacade::Algor
     {
         return m_query_graph.FindSmallestEdge(from, to, filter);
     }
+
+    UnpackingCache &GetUnpackingCache() const override final { return *unpacking_cache; }
 };
 
 /**
@@ -137,6 +156,7 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
     extractor::Datasources *m_datasources;
 
     std::uint32_t m_check_sum;
+    std::uint32_t m_metric_check_sum;
     StringView m_data_timestamp;
     util::vector_view<util::Coordinate> m_coordinate_list;
     extractor::PackedOSMIDsView m_osmnodeid_list;
@@ -170,6 +190,10 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
     // allocator that keeps the allocation data
     std::shared_ptr<ContiguousBlockAllocator> allocator;
 
+    // Snapping depends on the exclude class, the cache can't be shared between facades.
+    // It is dropped together with the facade when a new dataset is loaded.
+    std::unique_ptr<SnappingCache> snapping_cache;
+
     void InitializeInternalPointers(const storage::SharedDataIndex &index,
                                     const std::string &metric_name,
                                     const std::size_t exclude_index)
@@ -224,12 +248,28 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
     // allocator
     ContiguousInternalMemoryDataFacadeBase(std::shared_ptr<ContiguousBlockAllocator> allocator_,
                                            const std::string &metric_name,
-                                           const std::size_t exclude_index)
-        : allocator(std::move(allocator_))
+                                           const std::size_t exclude_index,
+                                           const std::uint32_t metric_check_sum,
+                                           const std::size_t snapping_cache_size)
+        : m_metric_check_sum(metric_check_sum), allocator(std::move(allocator_)),
+          snapping_cache(std::make_unique<SnappingCache>(snapping_cache_size))
     {
         InitializeInternalPointers(allocator->GetIndex(), metric_name, exclude_index);
     }
 
+    ~ContiguousInternalMemoryDataFacadeBase()
+    {
+        const auto lookups = snapping_cache->GetHits() + snapping_cache->GetMisses();
+        if (lookups > 0)
+        {
+            util::Log(logDEBUG) << "Snapping cache: " << snapping_cache->GetHits() << " of "
+                                << lookups << " coordinates were cached, "
+                                << snapping_cache->GetSize() << " entries";
+        }
+    }
+
+    SnappingCache &GetSnappingCache() const override final { return *snapping_cache; }
+
     // node and edge information access
     util::Coordinate GetCoordinateOfNode(const NodeID id) const override final
     {
@@ -285,6 +325,16 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
         return segment_data.GetReverseDatasources(id);
     }
 
+    RankForwardRange GetUncompressedForwardSimplificationRanks(const EdgeID id) const override final
+    {
+        return segment_data.GetForwardSimplificationRanks(id);
+    }
+
+    RankReverseRange GetUncompressedReverseSimplificationRanks(const EdgeID id) const override final
+    {
+        return segment_data.GetReverseSimplificationRanks(id);
+    }
+
     TurnPenalty GetWeightPenaltyForEdgeID(const EdgeID id) const override final
     {
         BOOST_ASSERT(m_turn_weight_penalties.size() > id);
@@ -439,6 +489,8 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
 
     std::uint32_t GetCheckSum() const override final { return m_check_sum; }
 
+    std::uint32_t GetMetricCheckSum() const override final { return m_metric_check_sum; }
+
     std::string GetTimestamp() const override final
     {
         return std::string(m_data_timestamp.begin(), m_data_timestamp.end());
@@ -632,9 +684,14 @@ class ContiguousInternalMemoryDataFacade<CH>
   public:
     ContiguousInternalMemoryDataFacade(std::shared_ptr<ContiguousBlockAllocator> allocator,
                                        const std::string &metric_name,
-                                       const std::size_t exclude_index)
-        : ContiguousInternalMemoryDataFacadeBase(allocator, metric_name, exclude_index),
-          ContiguousInternalMemoryAlgorithmDataFacade<CH>(allocator, metric_name, exclude_index)
+                                       const std::size_t exclude_index,
+                                       const std::uint32_t metric_check_sum,
+                                       const std::size_t snapping_cache_size,
+                                       const std::size_t unpacking_cache_size)
+        : ContiguousInternalMemoryDataFacadeBase(
+              allocator, metric_name, exclude_index, metric_check_sum, snapping_cache_size),
+          ContiguousInternalMemoryAlgorithmDataFacade<CH>(
+              allocator, metric_name, exclude_index, unpacking_cache_size)
     {
     }
 };
@@ -645,6 +702,7 @@ template <> class ContiguousInternalMemoryAlgorithmDataFacade<MLD> : public Algo
     partitioner::MultiLevelPartitionView mld_partition;
     partitioner::CellStorageView mld_cell_storage;
     customizer::CellMetricView mld_cell_metric;
+    customizer::LandmarksView mld_landmarks;
     using QueryGraph = customizer::MultiLevelEdgeBasedGraphView;
     using GraphNode = QueryGraph::NodeArrayEntry;
     using GraphEdge = QueryGraph::EdgeArrayEntry;
@@ -660,6 +718,14 @@ template <> class ContiguousInternalMemoryAlgorithmDataFacade<MLD> : public Algo
             make_filtered_cell_metric_view(index, "/mld/metrics/" + metric_name, exclude_index);
         mld_cell_storage = make_cell_storage_view(index, "/mld/cellstorage");
         query_graph = make_multi_level_graph_view(index, "/mld/multilevelgraph");
+
+        // landmarks are optional
+        std::vector<std::string> landmark_blocks;
+        index.List("/mld/landmarks/", std::back_inserter(landmark_blocks));
+        if (!landmark_blocks.empty())
+        {
+            mld_landmarks = make_landmarks_view(index, "/mld/landmarks");
+        }
     }
 
     // allocator that keeps the allocation data
@@ -684,6 +750,8 @@ template <> class ContiguousInternalMemoryAlgorithmDataFacade<MLD> : public Algo
 
     const customizer::CellMetricView &GetCellMetric() const override { return mld_cell_metric; }
 
+    const customizer::LandmarksView &GetLandmarks() const override { return mld_landmarks; }
+
     // search graph access
     unsigned GetNumberOfNodes() const override final { return query_graph.GetNumberOfNodes(); }
 
@@ -754,8 +822,12 @@ class ContiguousInternalMemoryDataFacade<MLD> final
   public:
     ContiguousInternalMemoryDataFacade(std::shared_ptr<ContiguousBlockAllocator> allocator,
                                        const std::string &metric_name,
-                                       const std::size_t exclude_index)
-        : ContiguousInternalMemoryDataFacadeBase(allocator, metric_name, exclude_index),
+                                       const std::size_t exclude_index,
+                                       const std::uint32_t metric_check_sum,
+                                       const std::size_t snapping_cache_size,
+                                       const std::size_t /*unpacking_cache_size*/)
+        : ContiguousInternalMemoryDataFacadeBase(
+              allocator, metric_name, exclude_index, metric_check_sum, snapping_cache_size),
           ContiguousInternalMemoryAlgorithmDataFacade<MLD>(allocator, metric_name, exclude_index)
     {
     }
@@ -5,6 +5,7 @@
 
 #include "engine/approach.hpp"
 #include "engine/phantom_node.hpp"
+#include "engine/snapping_cache.hpp"
 
 #include "contractor/query_edge.hpp"
 
@@ -69,11 +70,19 @@ class BaseDataFacade
         boost::iterator_range<extractor::SegmentDataView::SegmentDatasourceVector::const_iterator>;
     using DatasourceReverseRange = boost::reversed_range<const DatasourceForwardRange>;
 
+    using RankForwardRange =
+        boost::iterator_range<extractor::SegmentDataView::SegmentRankVector::const_iterator>;
+    using RankReverseRange = boost::reversed_range<const RankForwardRange>;
+
     BaseDataFacade() {}
     virtual ~BaseDataFacade() {}
 
     virtual std::uint32_t GetCheckSum() const = 0;
 
+    virtual std::uint32_t GetMetricCheckSum() const = 0;
+
+    virtual SnappingCache &GetSnappingCache() const = 0;
+
     virtual std::string GetTimestamp() const = 0;
 
     // node and edge information access
@@ -107,6 +116,11 @@ class BaseDataFacade
     virtual DatasourceForwardRange GetUncompressedForwardDatasources(const EdgeID id) const = 0;
     virtual DatasourceReverseRange GetUncompressedReverseDatasources(const EdgeID id) const = 0;
 
+    // Gets the simplification rank of every node in an uncompressed geometry, the lowest zoom
+    // level on which the node is needed in a simplified geometry.
+    virtual RankForwardRange GetUncompressedForwardSimplificationRanks(const EdgeID id) const = 0;
+    virtual RankReverseRange GetUncompressedReverseSimplificationRanks(const EdgeID id) const = 0;
+
     // Gets the name of a datasource
     virtual StringView GetDatasourceName(const DatasourceID id) const = 0;
 
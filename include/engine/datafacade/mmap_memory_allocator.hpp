@@ -3,6 +3,7 @@
 
 #include "engine/datafacade/contiguous_block_allocator.hpp"
 
+#include "storage/huge_pages.hpp"
 #include "storage/storage_config.hpp"
 
 #include "util/vector_view.hpp"
@@ -21,6 +22,7 @@ namespace datafacade
 
 /**
  * This allocator uses file backed mmap memory block as the data location.
+ * Compressed blocks are decompressed into process memory on construction.
  */
 class MMapMemoryAllocator : public ContiguousBlockAllocator
 {
@@ -34,6 +36,7 @@ class MMapMemoryAllocator : public ContiguousBlockAllocator
   private:
     storage::SharedDataIndex index;
     std::vector<boost::iostreams::mapped_file_source> mapped_memory_files;
+    std::vector<std::unique_ptr<storage::AnonymousMemory>> decompressed_memory;
     std::string rtree_filename;
 };
 
@@ -1,9 +1,12 @@
 #ifndef OSRM_ENGINE_DATAFACADE_PROCESS_MEMORY_ALLOCATOR_HPP_
 #define OSRM_ENGINE_DATAFACADE_PROCESS_MEMORY_ALLOCATOR_HPP_
 
+#include "storage/huge_pages.hpp"
 #include "storage/storage_config.hpp"
 #include "engine/datafacade/contiguous_block_allocator.hpp"
 
+#include <boost/optional.hpp>
+
 #include <memory>
 
 namespace osrm
@@ -18,12 +21,17 @@ namespace datafacade
  * data into.  The structure and layout is the same as when using
  * shared memory.
  * This class holds a unique_ptr to the memory block, so it
- * is auto-freed upon destruction.
+ * is auto-freed upon destruction. The block is backed by huge
+ * pages if the storage config asks for them.
+ * A replica copies the loaded block of another allocator into
+ * memory on the given NUMA node.
  */
 class ProcessMemoryAllocator : public ContiguousBlockAllocator
 {
   public:
-    explicit ProcessMemoryAllocator(const storage::StorageConfig &config);
+    explicit ProcessMemoryAllocator(const storage::StorageConfig &config,
+                                    const boost::optional<unsigned> numa_node = boost::none);
+    ProcessMemoryAllocator(const ProcessMemoryAllocator &source, const unsigned numa_node);
     ~ProcessMemoryAllocator() override final;
 
     // interface to give access to the datafacades
@@ -31,7 +39,9 @@ class ProcessMemoryAllocator : public ContiguousBlockAllocator
 
   private:
     storage::SharedDataIndex index;
-    std::unique_ptr<char[]> internal_memory;
+    std::unique_ptr<storage::AnonymousMemory> internal_memory;
+    storage::ContiguousDataLayout layout;
+    storage::HugePages huge_pages;
 };
 
 } // namespace datafacade
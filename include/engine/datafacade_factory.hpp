@@ -13,6 +13,7 @@
 #include "storage/shared_datatype.hpp"
 
 #include <array>
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 
@@ -29,9 +30,20 @@ template <template <typename A> class FacadeT, typename AlgorithmT> class DataFa
     using Facade = FacadeT<AlgorithmT>;
     DataFacadeFactory() = default;
 
+    // The snapping cache size is the byte budget and the unpacking cache size the number of
+    // unpacked shortcuts shared by the facades of all exclude classes. The metric checksum of
+    // the data is computed by the caller when the data is loaded and is 0 when nothing checks it,
+    // see getMetricChecksum.
     template <typename AllocatorT>
-    DataFacadeFactory(std::shared_ptr<AllocatorT> allocator)
-        : DataFacadeFactory(allocator, has_exclude_flags)
+    DataFacadeFactory(std::shared_ptr<AllocatorT> allocator,
+                      const std::size_t snapping_cache_size,
+                      const std::size_t unpacking_cache_size,
+                      const std::uint32_t metric_checksum)
+        : DataFacadeFactory(allocator,
+                            snapping_cache_size,
+                            unpacking_cache_size,
+                            metric_checksum,
+                            has_exclude_flags)
     {
         BOOST_ASSERT_MSG(facades.size() >= 1, "At least one datafacade is needed");
     }
@@ -44,7 +56,11 @@ template <template <typename A> class FacadeT, typename AlgorithmT> class DataFa
   private:
     // Algorithm with exclude flags
     template <typename AllocatorT>
-    DataFacadeFactory(std::shared_ptr<AllocatorT> allocator, std::true_type)
+    DataFacadeFactory(std::shared_ptr<AllocatorT> allocator,
+                      const std::size_t snapping_cache_size,
+                      const std::size_t unpacking_cache_size,
+                      const std::uint32_t metric_checksum,
+                      std::true_type)
     {
         const auto &index = allocator->GetIndex();
         properties = index.template GetBlockPtr<extractor::ProfileProperties>("/common/properties");
@@ -71,7 +87,12 @@ template <template <typename A> class FacadeT, typename AlgorithmT> class DataFa
             std::size_t index =
                 std::stoi(exclude_prefix.substr(index_begin + 1, exclude_prefix.size()));
             BOOST_ASSERT(index < facades.size());
-            facades[index] = std::make_shared<const Facade>(allocator, metric_name, index);
+            facades[index] = std::make_shared<const Facade>(allocator,
+                                                            metric_name,
+                                                            index,
+                                                            metric_checksum,
+                                                            snapping_cache_size / facades.size(),
+                                                            unpacking_cache_size / facades.size());
         }
 
         for (const auto index : util::irange<std::size_t>(0, properties->class_names.size()))
@@ -86,12 +107,17 @@ template <template <typename A> class FacadeT, typename AlgorithmT> class DataFa
 
     // Algorithm without exclude flags
     template <typename AllocatorT>
-    DataFacadeFactory(std::shared_ptr<AllocatorT> allocator, std::false_type)
+    DataFacadeFactory(std::shared_ptr<AllocatorT> allocator,
+                      const std::size_t snapping_cache_size,
+                      const std::size_t unpacking_cache_size,
+                      const std::uint32_t metric_checksum,
+                      std::false_type)
     {
         const auto &index = allocator->GetIndex();
         properties = index.template GetBlockPtr<extractor::ProfileProperties>("/common/properties");
         const auto &metric_name = properties->GetWeightName();
-        facades.push_back(std::make_shared<const Facade>(allocator, metric_name, 0));
+        facades.push_back(std::make_shared<const Facade>(
+            allocator, metric_name, 0, metric_checksum, snapping_cache_size, unpacking_cache_size));
     }
 
     std::shared_ptr<const Facade> Get(const api::TileParameters &, std::false_type) const
@@ -7,6 +7,12 @@
 #include "engine/datafacade/mmap_memory_allocator.hpp"
 #include "engine/datafacade/process_memory_allocator.hpp"
 #include "engine/datafacade_factory.hpp"
+#include "engine/metric_checksum.hpp"
+
+#include "storage/warmup.hpp"
+
+#include "util/log.hpp"
+#include "util/numa.hpp"
 
 namespace osrm
 {
@@ -15,6 +21,15 @@ namespace engine
 namespace detail
 {
 
+// Touches the blocks of the freshly loaded data before the first query
+template <typename AllocatorT>
+std::shared_ptr<AllocatorT> warmupAllocator(std::shared_ptr<AllocatorT> allocator,
+                                            const std::vector<storage::WarmupGroup> &warmup_order)
+{
+    storage::warmupBlocks(allocator->GetIndex(), warmup_order);
+    return allocator;
+}
+
 template <typename AlgorithmT, template <typename A> class FacadeT> class DataFacadeProvider
 {
   public:
@@ -32,9 +47,18 @@ class ExternalProvider final : public DataFacadeProvider<AlgorithmT, FacadeT>
   public:
     using Facade = typename DataFacadeProvider<AlgorithmT, FacadeT>::Facade;
 
-    ExternalProvider(const storage::StorageConfig &config)
-        : facade_factory(std::make_shared<datafacade::MMapMemoryAllocator>(config))
+    ExternalProvider(const storage::StorageConfig &config,
+                     const std::size_t snapping_cache_size,
+                     const std::size_t unpacking_cache_size,
+                     const std::vector<storage::WarmupGroup> &warmup_order,
+                     const bool compute_metric_checksum)
     {
+        const auto allocator = warmupAllocator(
+            std::make_shared<datafacade::MMapMemoryAllocator>(config), warmup_order);
+        const auto metric_checksum =
+            compute_metric_checksum ? getMetricChecksum(allocator->GetIndex()) : 0;
+        facade_factory = DataFacadeFactory<FacadeT, AlgorithmT>(
+            allocator, snapping_cache_size, unpacking_cache_size, metric_checksum);
     }
 
     std::shared_ptr<const Facade> Get(const api::TileParameters &params) const override final
@@ -50,28 +74,80 @@ class ExternalProvider final : public DataFacadeProvider<AlgorithmT, FacadeT>
     DataFacadeFactory<FacadeT, AlgorithmT> facade_factory;
 };
 
+// With NUMA replication every node gets its own copy of the dataset and queries read the copy
+// of the node their thread runs on, instead of half of them crossing the socket interconnect.
 template <typename AlgorithmT, template <typename A> class FacadeT>
 class ImmutableProvider final : public DataFacadeProvider<AlgorithmT, FacadeT>
 {
   public:
     using Facade = typename DataFacadeProvider<AlgorithmT, FacadeT>::Facade;
 
-    ImmutableProvider(const storage::StorageConfig &config)
-        : facade_factory(std::make_shared<datafacade::ProcessMemoryAllocator>(config))
+    ImmutableProvider(const storage::StorageConfig &config,
+                      const std::size_t snapping_cache_size,
+                      const std::size_t unpacking_cache_size,
+                      const std::vector<storage::WarmupGroup> &warmup_order,
+                      const bool compute_metric_checksum,
+                      const bool numa_replication)
     {
+        if (!numa_replication)
+        {
+            const auto allocator = warmupAllocator(
+                std::make_shared<datafacade::ProcessMemoryAllocator>(config), warmup_order);
+            const auto metric_checksum =
+                compute_metric_checksum ? getMetricChecksum(allocator->GetIndex()) : 0;
+            facade_factories.emplace_back(
+                allocator, snapping_cache_size, unpacking_cache_size, metric_checksum);
+            return;
+        }
+
+        const auto nodes = util::getNumaNodes();
+        const auto loaded = warmupAllocator(
+            std::make_shared<datafacade::ProcessMemoryAllocator>(config, nodes.front().id),
+            warmup_order);
+        // the copies hold the same data, so the checksum of the first one holds for all of them
+        const auto metric_checksum =
+            compute_metric_checksum ? getMetricChecksum(loaded->GetIndex()) : 0;
+        for (const auto &node : nodes)
+        {
+            // the copies touch all of their pages, so they need no warm-up
+            auto allocator = facade_factories.empty()
+                                 ? loaded
+                                 : std::make_shared<datafacade::ProcessMemoryAllocator>(
+                                       *loaded, node.id);
+            if (node.id >= factory_of_node.size())
+            {
+                factory_of_node.resize(node.id + 1, 0);
+            }
+            factory_of_node[node.id] = facade_factories.size();
+            facade_factories.emplace_back(
+                std::move(allocator), snapping_cache_size, unpacking_cache_size, metric_checksum);
+        }
+        util::Log() << "Replicated the dataset on " << nodes.size() << " NUMA node(s)";
     }
 
     std::shared_ptr<const Facade> Get(const api::TileParameters &params) const override final
     {
-        return facade_factory.Get(params);
+        return GetFactory().Get(params);
     }
     std::shared_ptr<const Facade> Get(const api::BaseParameters &params) const override final
     {
-        return facade_factory.Get(params);
+        return GetFactory().Get(params);
     }
 
   private:
-    DataFacadeFactory<FacadeT, AlgorithmT> facade_factory;
+    const DataFacadeFactory<FacadeT, AlgorithmT> &GetFactory() const
+    {
+        if (factory_of_node.empty())
+        {
+            return facade_factories.front();
+        }
+        const auto node = util::getCurrentNumaNode();
+        return facade_factories[node < factory_of_node.size() ? factory_of_node[node] : 0];
+    }
+
+    std::vector<DataFacadeFactory<FacadeT, AlgorithmT>> facade_factories;
+    // index of the factory per NUMA node id, empty without replication
+    std::vector<std::size_t> factory_of_node;
 };
 
 template <typename AlgorithmT, template <typename A> class FacadeT>
@@ -82,7 +158,18 @@ class WatchingProvider : public DataFacadeProvider<AlgorithmT, FacadeT>
   public:
     using Facade = typename DataFacadeProvider<AlgorithmT, FacadeT>::Facade;
 
-    WatchingProvider(const std::string &dataset_name) : watchdog(dataset_name) {}
+    WatchingProvider(const std::string &dataset_name,
+                     const std::size_t snapping_cache_size,
+                     const std::size_t unpacking_cache_size,
+                     const std::vector<storage::WarmupGroup> &warmup_order,
+                     const bool compute_metric_checksum)
+        : watchdog(dataset_name,
+                   snapping_cache_size,
+                   unpacking_cache_size,
+                   warmup_order,
+                   compute_metric_checksum)
+    {
+    }
 
     std::shared_ptr<const Facade> Get(const api::TileParameters &params) const override final
     {
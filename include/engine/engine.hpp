@@ -3,6 +3,8 @@
 
 #include "engine/api/match_parameters.hpp"
 #include "engine/api/nearest_parameters.hpp"
+#include "engine/api/isochrone_parameters.hpp"
+#include "engine/api/poi_parameters.hpp"
 #include "engine/api/route_parameters.hpp"
 #include "engine/api/table_parameters.hpp"
 #include "engine/api/tile_parameters.hpp"
@@ -11,6 +13,8 @@
 #include "engine/engine_config.hpp"
 #include "engine/plugins/match.hpp"
 #include "engine/plugins/nearest.hpp"
+#include "engine/plugins/isochrone.hpp"
+#include "engine/plugins/poi.hpp"
 #include "engine/plugins/table.hpp"
 #include "engine/plugins/tile.hpp"
 #include "engine/plugins/trip.hpp"
@@ -36,6 +40,9 @@ class EngineInterface
     virtual Status Table(const api::TableParameters &parameters, api::ResultT &result) const = 0;
     virtual Status Nearest(const api::NearestParameters &parameters,
                            api::ResultT &result) const = 0;
+    virtual Status POI(const api::POIParameters &parameters, api::ResultT &result) const = 0;
+    virtual Status Isochrone(const api::IsochroneParameters &parameters,
+                             api::ResultT &result) const = 0;
     virtual Status Trip(const api::TripParameters &parameters, api::ResultT &result) const = 0;
     virtual Status Match(const api::MatchParameters &parameters, api::ResultT &result) const = 0;
     virtual Status Tile(const api::TileParameters &parameters, api::ResultT &result) const = 0;
@@ -48,16 +55,26 @@ template <typename Algorithm> class Engine final : public EngineInterface
         : route_plugin(config.max_locations_viaroute, config.max_alternatives),            //
           table_plugin(config.max_locations_distance_table),                               //
           nearest_plugin(config.max_results_nearest),                                      //
-          trip_plugin(config.max_locations_trip),                                          //
-          match_plugin(config.max_locations_map_matching, config.max_radius_map_matching), //
-          tile_plugin()                                                                    //
+          poi_plugin(config.poi_sets, config.max_results_nearest),                         //
+          isochrone_plugin(config.max_duration_isochrone),                                 //
+          trip_plugin(config.max_locations_trip, config.max_trip_optimization_time),       //
+          match_plugin(config.max_locations_map_matching,
+                       config.max_radius_map_matching,
+                       config.max_matching_sessions,
+                       config.matching_session_timeout),                                   //
+          tile_plugin(config.baked_tiles_path)                                             //
 
     {
         if (config.use_shared_memory)
         {
             util::Log(logDEBUG) << "Using shared memory with name \"" << config.dataset_name
                                 << "\" with algorithm " << routing_algorithms::name<Algorithm>();
-            facade_provider = std::make_unique<WatchingProvider<Algorithm>>(config.dataset_name);
+            facade_provider = std::make_unique<WatchingProvider<Algorithm>>(
+                config.dataset_name,
+                config.snapping_cache_size,
+                config.unpacking_cache_size,
+                config.warmup_order,
+                !config.baked_tiles_path.empty());
         }
         else if (!config.memory_file.empty() || config.use_mmap)
         {
@@ -68,13 +85,24 @@ template <typename Algorithm> class Engine final : public EngineInterface
             }
             util::Log(logDEBUG) << "Using direct memory mapping with algorithm "
                                 << routing_algorithms::name<Algorithm>();
-            facade_provider = std::make_unique<ExternalProvider<Algorithm>>(config.storage_config);
+            facade_provider = std::make_unique<ExternalProvider<Algorithm>>(
+                config.storage_config,
+                config.snapping_cache_size,
+                config.unpacking_cache_size,
+                config.warmup_order,
+                !config.baked_tiles_path.empty());
         }
         else
         {
             util::Log(logDEBUG) << "Using internal memory with algorithm "
                                 << routing_algorithms::name<Algorithm>();
-            facade_provider = std::make_unique<ImmutableProvider<Algorithm>>(config.storage_config);
+            facade_provider =
+                std::make_unique<ImmutableProvider<Algorithm>>(config.storage_config,
+                                                               config.snapping_cache_size,
+                                                               config.unpacking_cache_size,
+                                                               config.warmup_order,
+                                                               !config.baked_tiles_path.empty(),
+                                                               config.numa_replication);
         }
     }
 
@@ -100,6 +128,17 @@ template <typename Algorithm> class Engine final : public EngineInterface
         return nearest_plugin.HandleRequest(GetAlgorithms(params), params, result);
     }
 
+    Status POI(const api::POIParameters &params, api::ResultT &result) const override final
+    {
+        return poi_plugin.HandleRequest(GetAlgorithms(params), params, result);
+    }
+
+    Status Isochrone(const api::IsochroneParameters &params,
+                     api::ResultT &result) const override final
+    {
+        return isochrone_plugin.HandleRequest(GetAlgorithms(params), params, result);
+    }
+
     Status Trip(const api::TripParameters &params, api::ResultT &result) const override final
     {
         return trip_plugin.HandleRequest(GetAlgorithms(params), params, result);
@@ -126,6 +165,8 @@ template <typename Algorithm> class Engine final : public EngineInterface
     const plugins::ViaRoutePlugin route_plugin;
     const plugins::TablePlugin table_plugin;
     const plugins::NearestPlugin nearest_plugin;
+    const plugins::POIPlugin poi_plugin;
+    const plugins::IsochronePlugin isochrone_plugin;
     const plugins::TripPlugin trip_plugin;
     const plugins::MatchPlugin match_plugin;
     const plugins::TilePlugin tile_plugin;
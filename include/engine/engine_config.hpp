@@ -29,10 +29,15 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define ENGINE_CONFIG_HPP
 
 #include "storage/storage_config.hpp"
+#include "storage/warmup.hpp"
+#include "util/coordinate.hpp"
 
 #include <boost/filesystem/path.hpp>
 
+#include <cstddef>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace osrm
 {
@@ -53,6 +58,23 @@ namespace engine
  *  - Match
  *  - Nearest
  *
+ * and the maximum contour duration in seconds (-1 for unlimited) of the Isochrone service.
+ *
+ * Named sets of points of interest can be registered for the POI service. They are snapped
+ * and indexed once per dataset on their first query.
+ *
+ * The snapped coordinates and, for CH, the unpacked shortcuts of recent queries are cached per
+ * dataset, the caches are shared by the exclude classes and sized with snapping_cache_size and
+ * unpacking_cache_size.
+ *
+ * Vector tiles baked with osrm-tiles for the dataset are served from baked_tiles_path if given.
+ *
+ * The blocks of the groups in warmup_order are touched in that order after loading the dataset
+ * and again after every update of a shared memory dataset, before queries use it.
+ *
+ * With numa_replication a dataset loaded into process memory is copied to every NUMA node and
+ * queries read the copy of the node their thread runs on.
+ *
  * In addition, shared memory can be used for datasets loaded with osrm-datastore.
  *
  * You can chose between three algorithms:
@@ -81,11 +103,17 @@ struct EngineConfig final
 
     storage::StorageConfig storage_config;
     int max_locations_trip = -1;
+    double max_trip_optimization_time = -1.0;
     int max_locations_viaroute = -1;
     int max_locations_distance_table = -1;
     int max_locations_map_matching = -1;
     double max_radius_map_matching = -1.0;
+    int max_matching_sessions = 1000;
+    double matching_session_timeout = 300.0;
+    std::size_t snapping_cache_size = 32 * 1024 * 1024; // bytes, 0 disables the cache
+    std::size_t unpacking_cache_size = 1 << 16; // CH shortcuts, 0 disables the cache
     int max_results_nearest = -1;
+    double max_duration_isochrone = -1.0;
     int max_alternatives = 3; // set an arbitrary upper bound; can be adjusted by user
     bool use_shared_memory = true;
     boost::filesystem::path memory_file;
@@ -93,6 +121,10 @@ struct EngineConfig final
     Algorithm algorithm = Algorithm::CH;
     std::string verbosity;
     std::string dataset_name;
+    std::unordered_map<std::string, std::vector<util::Coordinate>> poi_sets;
+    boost::filesystem::path baked_tiles_path;
+    std::vector<storage::WarmupGroup> warmup_order;
+    bool numa_replication = false;
 };
 } // namespace engine
 } // namespace osrm
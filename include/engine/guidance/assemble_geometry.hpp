@@ -44,6 +44,7 @@ inline LegGeometry assembleGeometry(const datafacade::BaseDataFacade &facade,
     // segment 0 first and last
     geometry.segment_offsets.push_back(0);
     geometry.locations.push_back(source_node.location);
+    geometry.simplification_ranks.push_back(0);
 
     //                          u       *      v
     //                          0 -- 1 -- 2 -- 3
@@ -56,6 +57,10 @@ inline LegGeometry assembleGeometry(const datafacade::BaseDataFacade &facade,
         reversed_source ? source_node.reverse_segment_id.id : source_node.forward_segment_id.id;
     const auto source_geometry_id = facade.GetGeometryIndex(source_node_id).id;
     const auto source_geometry = facade.GetUncompressedForwardGeometry(source_geometry_id);
+    // datasets from before the ranks were precomputed have none, their overview falls back to
+    // Douglas-Peucker
+    const bool has_simplification_ranks =
+        !facade.GetUncompressedForwardSimplificationRanks(source_geometry_id).empty();
 
     geometry.osm_node_ids.push_back(
         facade.GetOSMNodeIDOfNode(source_geometry(source_segment_start_coordinate)));
@@ -100,6 +105,7 @@ inline LegGeometry assembleGeometry(const datafacade::BaseDataFacade &facade,
                 path_point.datasource_id});
             geometry.locations.push_back(std::move(coordinate));
             geometry.osm_node_ids.push_back(osm_node_id);
+            geometry.simplification_ranks.push_back(path_point.simplification_rank);
         }
     }
     current_distance =
@@ -149,6 +155,7 @@ inline LegGeometry assembleGeometry(const datafacade::BaseDataFacade &facade,
 
     geometry.segment_offsets.push_back(geometry.locations.size());
     geometry.locations.push_back(target_node.location);
+    geometry.simplification_ranks.push_back(0);
 
     //                           u       *      v
     //                           0 -- 1 -- 2 -- 3
@@ -164,6 +171,9 @@ inline LegGeometry assembleGeometry(const datafacade::BaseDataFacade &facade,
     BOOST_ASSERT(geometry.segment_distances.size() == geometry.segment_offsets.size() - 1);
     BOOST_ASSERT(geometry.locations.size() > geometry.segment_distances.size());
     BOOST_ASSERT(geometry.annotations.size() == geometry.locations.size() - 1);
+    BOOST_ASSERT(geometry.simplification_ranks.size() == geometry.locations.size());
+    if (!has_simplification_ranks)
+        geometry.simplification_ranks.clear();
 
     return geometry;
 }
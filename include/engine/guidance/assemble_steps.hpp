@@ -37,13 +37,13 @@ std::pair<short, short> getArriveBearings(const LegGeometry &leg_geometry,
                                           const bool traversed_in_reverse);
 } // namespace detail
 
-inline std::vector<RouteStep> assembleSteps(const datafacade::BaseDataFacade &facade,
-                                            const std::vector<PathData> &leg_data,
-                                            const LegGeometry &leg_geometry,
-                                            const PhantomNode &source_node,
-                                            const PhantomNode &target_node,
-                                            const bool source_traversed_in_reverse,
-                                            const bool target_traversed_in_reverse)
+inline RouteSteps assembleSteps(const datafacade::BaseDataFacade &facade,
+                                const std::vector<PathData> &leg_data,
+                                const LegGeometry &leg_geometry,
+                                const PhantomNode &source_node,
+                                const PhantomNode &target_node,
+                                const bool source_traversed_in_reverse,
+                                const bool target_traversed_in_reverse)
 {
     const double weight_multiplier = facade.GetWeightMultiplier();
 
@@ -71,7 +71,7 @@ inline std::vector<RouteStep> assembleSteps(const datafacade::BaseDataFacade &fa
 
     const auto number_of_segments = leg_geometry.GetNumberOfSegments();
 
-    std::vector<RouteStep> steps;
+    RouteSteps steps;
     steps.reserve(number_of_segments);
 
     std::size_t segment_index = 0;
@@ -88,8 +88,8 @@ inline std::vector<RouteStep> assembleSteps(const datafacade::BaseDataFacade &fa
                           0};
 
     IntermediateIntersection intersection{source_node.location,
-                                          std::vector<short>({bearings.second}),
-                                          std::vector<bool>({true}),
+                                          {bearings.second},
+                                          {true},
                                           IntermediateIntersection::NO_INDEX,
                                           0,
                                           util::guidance::LaneTuple(),
@@ -169,10 +169,14 @@ inline std::vector<RouteStep> assembleSteps(const datafacade::BaseDataFacade &fa
                 intersection.bearings.clear();
                 intersection.bearings.reserve(bearing_data.size());
                 intersection.lanes = path_point.lane_data.first;
-                intersection.lane_description =
-                    path_point.lane_data.second != INVALID_LANE_DESCRIPTIONID
-                        ? facade.GetTurnDescription(path_point.lane_data.second)
-                        : extractor::TurnLaneDescription();
+                intersection.lane_description.clear();
+                if (path_point.lane_data.second != INVALID_LANE_DESCRIPTIONID)
+                {
+                    const auto lane_description =
+                        facade.GetTurnDescription(path_point.lane_data.second);
+                    intersection.lane_description.assign(lane_description.begin(),
+                                                         lane_description.end());
+                }
 
                 // Lanes in turn are bound by total number of lanes at the location
                 BOOST_ASSERT(intersection.lanes.lanes_in_turn <=
@@ -281,8 +285,8 @@ inline std::vector<RouteStep> assembleSteps(const datafacade::BaseDataFacade &fa
 
     intersection = {
         target_node.location,
-        std::vector<short>({static_cast<short>(util::bearing::reverse(bearings.first))}),
-        std::vector<bool>({true}),
+        {static_cast<short>(util::bearing::reverse(bearings.first))},
+        {true},
         0,
         IntermediateIntersection::NO_INDEX,
         util::guidance::LaneTuple(),
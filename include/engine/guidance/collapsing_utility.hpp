@@ -17,7 +17,6 @@ namespace engine
 namespace guidance
 {
 
-using RouteSteps = std::vector<RouteStep>;
 using RouteStepIterator = typename RouteSteps::iterator;
 const constexpr std::size_t MIN_END_OF_ROAD_INTERSECTIONS = std::size_t{2};
 const constexpr double MAX_COLLAPSE_DISTANCE = 30.0;
@@ -170,7 +169,7 @@ inline bool areSameSide(const RouteStep &lhs, const RouteStep &rhs)
 
 // do this after invalidating any steps to compress the step array again
 OSRM_ATTR_WARN_UNUSED
-inline std::vector<RouteStep> removeNoTurnInstructions(std::vector<RouteStep> steps)
+inline RouteSteps removeNoTurnInstructions(RouteSteps steps)
 {
     // finally clean up the post-processed instructions.
     // Remove all invalid instructions from the set of instructions.
@@ -19,8 +19,8 @@ namespace guidance
 // the second parameter describes the duration that we feel two segments need to be apart to count
 // as separate maneuvers.
 OSRM_ATTR_WARN_UNUSED
-std::vector<RouteStep> anticipateLaneChange(std::vector<RouteStep> steps,
-                                            const double min_distance_needed_for_lane_change = 200);
+RouteSteps anticipateLaneChange(RouteSteps steps,
+                                const double min_distance_needed_for_lane_change = 200);
 
 } // namespace guidance
 } // namespace engine
@@ -9,6 +9,7 @@
 
 #include <cstddef>
 
+#include <cstdint>
 #include <cstdlib>
 #include <vector>
 
@@ -33,6 +34,8 @@ struct LegGeometry
     std::vector<double> segment_distances;
     // original OSM node IDs for each coordinate
     std::vector<OSMNodeID> osm_node_ids;
+    // lowest zoom level on which each coordinate is needed in a simplified geometry
+    std::vector<std::uint8_t> simplification_ranks;
 
     // Per-coordinate metadata
     struct Annotation
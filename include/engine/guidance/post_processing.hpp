@@ -18,25 +18,25 @@ namespace guidance
 
 // passed as none-reference to modify in-place and move out again
 OSRM_ATTR_WARN_UNUSED
-std::vector<RouteStep> handleRoundabouts(std::vector<RouteStep> steps);
+RouteSteps handleRoundabouts(RouteSteps steps);
 
 // trim initial/final segment of very short length.
 // This function uses in/out parameter passing to modify both steps and geometry in place.
 // We use this method since both steps and geometry are closely coupled logically but
 // are not coupled in the same way in the background. To avoid the additional overhead
 // of introducing intermediate structions, we resolve to the in/out scheme at this point.
-void trimShortSegments(std::vector<RouteStep> &steps, LegGeometry &geometry);
+void trimShortSegments(RouteSteps &steps, LegGeometry &geometry);
 
 // assign relative locations to depart/arrive instructions
 OSRM_ATTR_WARN_UNUSED
-std::vector<RouteStep> assignRelativeLocations(std::vector<RouteStep> steps,
-                                               const LegGeometry &geometry,
-                                               const PhantomNode &source_node,
-                                               const PhantomNode &target_node);
+RouteSteps assignRelativeLocations(RouteSteps steps,
+                                   const LegGeometry &geometry,
+                                   const PhantomNode &source_node,
+                                   const PhantomNode &target_node);
 
 // collapse suppressed instructions remaining into intersections array
 OSRM_ATTR_WARN_UNUSED
-std::vector<RouteStep> buildIntersections(std::vector<RouteStep> steps);
+RouteSteps buildIntersections(RouteSteps steps);
 
 // postProcess will break the connection between the leg geometry
 // for which a segment is supposed to represent exactly the coordinates
@@ -44,7 +44,7 @@ std::vector<RouteStep> buildIntersections(std::vector<RouteStep> steps);
 // If required, we can get both in sync again using this function.
 // Move in LegGeometry for modification in place.
 OSRM_ATTR_WARN_UNUSED
-LegGeometry resyncGeometry(LegGeometry leg_geometry, const std::vector<RouteStep> &steps);
+LegGeometry resyncGeometry(LegGeometry leg_geometry, const RouteSteps &steps);
 
 /**
  * Apply maneuver override relations to the selected route.
@@ -55,7 +55,7 @@ LegGeometry resyncGeometry(LegGeometry leg_geometry, const std::vector<RouteStep
  * @param steps the steps of the route
  */
 void applyOverrides(const datafacade::BaseDataFacade &facade,
-                    std::vector<RouteStep> &steps,
+                    RouteSteps &steps,
                     const LegGeometry &geometry);
 
 } // namespace guidance
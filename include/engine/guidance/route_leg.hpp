@@ -21,7 +21,7 @@ struct RouteLeg
     double duration;
     double weight;
     std::string summary;
-    std::vector<RouteStep> steps;
+    RouteSteps steps;
 };
 } // namespace guidance
 } // namespace engine
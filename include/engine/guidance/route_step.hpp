@@ -6,6 +6,7 @@
 #include "util/coordinate.hpp"
 #include "util/guidance/bearing_class.hpp"
 #include "util/guidance/entry_class.hpp"
+#include "util/monotonic_arena.hpp"
 
 #include "extractor/turn_lane_types.hpp"
 #include "util/guidance/turn_lanes.hpp"
@@ -30,18 +31,22 @@ namespace guidance
 // Arrive: a --> b --> t. The segment (b,t) is already covered by the previous segment.
 
 // A representation of intermediate intersections
+//
+// Steps and intersections are created in bulk for every route with steps, their vectors and
+// the vectors of steps are allocated from the arena of the thread while the route is assembled
+// and post-processed, see util::ArenaScope.
 struct IntermediateIntersection
 {
     static const constexpr std::size_t NO_INDEX = std::numeric_limits<std::size_t>::max();
     util::Coordinate location;
-    std::vector<short> bearings;
-    std::vector<bool> entry;
+    util::ArenaVector<short> bearings;
+    util::ArenaVector<bool> entry;
     std::size_t in;
     std::size_t out;
 
     // turn lane information
     util::guidance::LaneTuple lanes;
-    extractor::TurnLaneDescription lane_description;
+    util::ArenaVector<extractor::TurnLaneType::Mask> lane_description;
     std::vector<std::string> classes;
 };
 
@@ -77,7 +82,7 @@ struct RouteStep
     // indices into the locations array stored the LegGeometry
     std::size_t geometry_begin;
     std::size_t geometry_end;
-    std::vector<IntermediateIntersection> intersections;
+    util::ArenaVector<IntermediateIntersection> intersections;
     bool is_left_hand_driving;
 
     // remove all information from the route step, marking it as invalid (used to indicate empty
@@ -113,6 +118,8 @@ struct RouteStep
     auto LanesToTheRight() const;
 };
 
+using RouteSteps = util::ArenaVector<RouteStep>;
+
 inline void RouteStep::Invalidate()
 {
     name_id = EMPTY_NAMEID;
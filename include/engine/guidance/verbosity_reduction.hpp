@@ -18,7 +18,7 @@ namespace guidance
 // intersection) have to be checked for the length they are active in. If they are active for a
 // short distance only, we don't announce them
 OSRM_ATTR_WARN_UNUSED
-std::vector<RouteStep> suppressShortNameSegments(std::vector<RouteStep> steps);
+RouteSteps suppressShortNameSegments(RouteSteps steps);
 
 } // namespace guidance
 } // namespace engine
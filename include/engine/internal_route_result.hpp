@@ -15,6 +15,7 @@
 #include "util/integer_range.hpp"
 #include "util/typedefs.hpp"
 
+#include <cstdint>
 #include <vector>
 
 namespace osrm
@@ -65,6 +66,9 @@ struct PathData
 
     // Driving side of the turn
     bool is_left_hand_driving;
+
+    // lowest zoom level on which the turn via node is needed in a simplified geometry
+    std::uint8_t simplification_rank = 0;
 };
 
 struct InternalRouteResult
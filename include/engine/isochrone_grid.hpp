@@ -0,0 +1,74 @@
+#ifndef OSRM_ENGINE_ISOCHRONE_GRID_HPP
+#define OSRM_ENGINE_ISOCHRONE_GRID_HPP
+
+#include "util/coordinate.hpp"
+#include "util/typedefs.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+
+// Raster of the earliest arrival times over a bounding box, used to turn the segments reached
+// by an isochrone search into polygons.
+//
+// Each grid cell stores the minimal duration of everything that was drawn into it. A contour is
+// extracted by growing the cells reached within its duration by one cell, so that neighbouring
+// roads merge into an area, and filling all holes that are enclosed by the reached cells.
+class IsochroneGrid
+{
+  public:
+    // Covers the box spanned by the two corners with square cells of cell_size meters
+    IsochroneGrid(const util::Coordinate south_west,
+                  const util::Coordinate north_east,
+                  const double cell_size);
+
+    // Draws a segment whose duration changes linearly from one end to the other.
+    // Parts with a negative duration are skipped.
+    void AddSegment(const util::Coordinate from,
+                    const util::Coordinate to,
+                    const EdgeDuration from_duration,
+                    const EdgeDuration to_duration);
+
+    // Fills the convex hull of the coordinates with a single duration
+    void AddConvexHull(const std::vector<util::Coordinate> &coordinates,
+                       const EdgeDuration duration);
+
+    // Returns the rings of the areas that are reachable within the duration.
+    // Rings are closed, counter-clockwise and have no holes.
+    std::vector<std::vector<util::Coordinate>> GetContour(const EdgeDuration duration) const;
+
+    std::size_t GetWidth() const { return width; }
+    std::size_t GetHeight() const { return height; }
+
+  private:
+    struct Point
+    {
+        double x;
+        double y;
+    };
+
+    Point ToGrid(const util::Coordinate coordinate) const;
+    util::Coordinate FromGrid(const std::size_t x, const std::size_t y) const;
+    void Mark(const Point point, const EdgeDuration duration);
+    void Draw(const Point from,
+              const Point to,
+              const EdgeDuration from_duration,
+              const EdgeDuration to_duration);
+
+    double origin_lon;
+    double origin_lat;
+    double cell_lon;
+    double cell_lat;
+    std::size_t width;
+    std::size_t height;
+    std::vector<EdgeDuration> durations;
+};
+
+} // namespace engine
+} // namespace osrm
+
+#endif
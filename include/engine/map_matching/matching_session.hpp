@@ -0,0 +1,97 @@
+#ifndef MAP_MATCHING_MATCHING_SESSION_HPP
+#define MAP_MATCHING_MATCHING_SESSION_HPP
+
+#include "engine/phantom_node.hpp"
+#include "util/coordinate.hpp"
+
+#include <boost/optional.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace map_matching
+{
+
+// State of an incrementally matched trace between two requests: the candidates of the last trace
+// point that could be matched, which is all the Viterbi recursion needs to continue.
+struct MatchingSession
+{
+    // checksum of the dataset the candidates were snapped on
+    std::uint32_t checksum = 0;
+
+    std::vector<PhantomNodeWithDistance> candidates;
+    std::vector<double> viterbi;
+    std::vector<bool> pruned;
+    // matched distance along the most likely path to each candidate since the session (re)started
+    std::vector<double> matched_distances;
+
+    util::Coordinate coordinate;
+    boost::optional<unsigned> timestamp;
+    // distance between the matched trace points since the session (re)started
+    double trace_distance = 0;
+    // time between the last two matched trace points
+    unsigned sample_time = 1;
+    // trace points that could not be matched since the last one that could
+    unsigned broken_points = 0;
+
+    bool Empty() const { return candidates.empty(); }
+
+    void Clear() { *this = MatchingSession{}; }
+};
+
+// Bounded store of the matching sessions, shared by all threads.
+//
+// Sessions that were not used for longer than the timeout are evicted first, then the least
+// recently used ones. Requests for the same session are not serialized: a session is copied out
+// and stored again after the request, the last request to finish wins.
+class MatchingSessionStore
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    MatchingSessionStore(const std::size_t capacity, const Clock::duration timeout);
+
+    // Returns an empty session for unknown or expired ids
+    MatchingSession Find(const std::string &id, const Clock::time_point now = Clock::now());
+
+    void Store(const std::string &id,
+               MatchingSession session,
+               const Clock::time_point now = Clock::now());
+
+    std::size_t GetCapacity() const { return capacity; }
+    std::size_t GetSize() const;
+
+  private:
+    struct Entry
+    {
+        std::string id;
+        MatchingSession session;
+        Clock::time_point last_used;
+    };
+
+    // Requires the mutex to be held
+    void EvictExpired(const Clock::time_point now);
+
+    const std::size_t capacity;
+    const Clock::duration timeout;
+
+    mutable std::mutex mutex;
+    // most recently used first
+    std::list<Entry> entries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> positions;
+};
+} // namespace map_matching
+} // namespace engine
+} // namespace osrm
+
+#endif // MAP_MATCHING_MATCHING_SESSION_HPP
@@ -0,0 +1,147 @@
+#ifndef MAP_MATCHING_TRACE_BATCH_HPP
+#define MAP_MATCHING_TRACE_BATCH_HPP
+
+#include "util/coordinate.hpp"
+
+#include <boost/filesystem/path.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace map_matching
+{
+
+// A GPS trace to be matched in a batch, timestamps and radiuses are optional
+struct Trace
+{
+    std::uint64_t id;
+    std::vector<util::Coordinate> coordinates;
+    std::vector<unsigned> timestamps;
+    std::vector<double> radiuses;
+};
+
+// Reads traces from a CSV stream with one trace point per line:
+//
+//   trace_id,longitude,latitude[,timestamp[,radius]]
+//
+// The points of a trace are on consecutive lines, a leading header line is skipped.
+class CSVTraceReader
+{
+  public:
+    explicit CSVTraceReader(std::istream &input);
+
+    // Appends up to max_traces traces, returns how many were read: zero at the end of the input
+    std::size_t Read(std::size_t max_traces, std::vector<Trace> &traces);
+
+  private:
+    std::istream &input;
+    // first line of the next trace
+    std::string pending_line;
+    std::size_t line_number;
+};
+
+// Reads traces from a binary stream in host byte order where each trace is
+//
+//   std::uint64_t trace_id
+//   std::uint32_t number_of_points
+//   number_of_points x { std::int32_t longitude, std::int32_t latitude, std::uint32_t timestamp }
+//
+// with coordinates in the fixed point representation of util::Coordinate.
+class BinaryTraceReader
+{
+  public:
+    explicit BinaryTraceReader(std::istream &input);
+
+    // Appends up to max_traces traces, returns how many were read: zero at the end of the input
+    std::size_t Read(std::size_t max_traces, std::vector<Trace> &traces);
+
+  private:
+    std::istream &input;
+};
+
+// Matching results of many traces in columns, ready to be written as one file.
+// Each trace has a range of matchings and each matching a range of segments.
+struct MatchedTraces
+{
+    // per trace
+    std::vector<std::uint64_t> trace_ids;
+    std::vector<std::uint64_t> matching_offsets = {0};
+
+    // per matching
+    std::vector<float> confidences;
+    std::vector<std::uint64_t> segment_offsets = {0};
+
+    // per segment
+    std::vector<std::uint64_t> from_osm_node_ids;
+    std::vector<std::uint64_t> to_osm_node_ids;
+    std::vector<float> durations;
+
+    std::size_t GetNumberOfTraces() const { return trace_ids.size(); }
+
+    // Appends the results of other traces behind the ones already stored
+    void Append(const MatchedTraces &other);
+};
+
+// Writes matched traces batch by batch to a tar file with the blocks /match/traces/*,
+// /match/matchings/* and /match/segments/* that can be read with storage::serialization::read.
+//
+// Every column is spilled to its own temporary file next to the output as the batches arrive
+// and Finish concatenates them, so memory use is bounded by the size of a batch.
+class MatchedTracesWriter
+{
+  public:
+    explicit MatchedTracesWriter(const boost::filesystem::path &path);
+    // removes the temporary files, also if Finish was not reached
+    ~MatchedTracesWriter();
+
+    // Appends the results of the traces behind the ones already written
+    void Append(const MatchedTraces &traces);
+
+    // Writes the output file
+    void Finish();
+
+    std::uint64_t GetNumberOfTraces() const { return columns[TRACE_IDS].count; }
+    std::uint64_t GetNumberOfSegments() const { return columns[DURATIONS].count; }
+
+  private:
+    enum ColumnIndex
+    {
+        TRACE_IDS,
+        MATCHING_OFFSETS,
+        CONFIDENCES,
+        SEGMENT_OFFSETS,
+        FROM_OSM_NODE_IDS,
+        TO_OSM_NODE_IDS,
+        DURATIONS,
+        NUMBER_OF_COLUMNS
+    };
+
+    struct Column
+    {
+        std::string name;
+        boost::filesystem::path path;
+        std::ofstream stream;
+        std::uint64_t count;
+    };
+
+    template <typename T> void Write(const ColumnIndex index, const T *data, std::size_t count);
+
+    boost::filesystem::path path;
+    std::array<Column, NUMBER_OF_COLUMNS> columns;
+    std::uint64_t matching_offset;
+    std::uint64_t segment_offset;
+};
+} // namespace map_matching
+} // namespace engine
+} // namespace osrm
+
+#endif // MAP_MATCHING_TRACE_BATCH_HPP
@@ -0,0 +1,55 @@
+#ifndef OSRM_ENGINE_METRIC_CHECKSUM_HPP
+#define OSRM_ENGINE_METRIC_CHECKSUM_HPP
+
+#include "storage/shared_data_index.hpp"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+
+// Checksum of the blocks that osrm-customize and osrm-contract rewrite on a metric update:
+// segment weights and durations, turn penalties, data sources and the metrics of the
+// algorithms. Unlike the connectivity checksum it changes when only the metric changes, also
+// when osrm-datastore swaps in a delta region. It takes a pass over all these blocks.
+inline std::uint32_t getMetricChecksum(const storage::SharedDataIndex &index)
+{
+    std::vector<std::string> names;
+    for (const auto prefix : {"/common/segment_data",
+                              "/common/turn_penalty",
+                              "/common/data_sources_names",
+                              "/ch/metrics",
+                              "/mld/metrics"})
+    {
+        index.List(prefix, std::back_inserter(names));
+    }
+    std::sort(names.begin(), names.end());
+
+    // crc32 takes at most 4 GiB at once
+    const constexpr std::size_t CHUNK_SIZE = 1u << 30;
+    auto checksum = crc32(0L, Z_NULL, 0);
+    for (const auto &name : names)
+    {
+        checksum = crc32(checksum, reinterpret_cast<const Bytef *>(name.data()), name.size());
+
+        const auto data = index.GetBlockPtr<const unsigned char>(name);
+        const auto size = index.GetBlockSize(name);
+        for (std::size_t offset = 0; offset < size; offset += CHUNK_SIZE)
+        {
+            checksum = crc32(checksum, data + offset, std::min(CHUNK_SIZE, size - offset));
+        }
+    }
+    return checksum;
+}
+} // namespace engine
+} // namespace osrm
+
+#endif
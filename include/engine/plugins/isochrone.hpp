@@ -0,0 +1,36 @@
+#ifndef ISOCHRONE_HPP
+#define ISOCHRONE_HPP
+
+#include "engine/api/isochrone_parameters.hpp"
+#include "engine/plugins/plugin_base.hpp"
+#include "engine/routing_algorithms.hpp"
+#include "osrm/json_container.hpp"
+
+namespace osrm
+{
+namespace engine
+{
+namespace plugins
+{
+
+// Computes the areas reachable from a coordinate within a set of travel times.
+//
+// All contours are taken from a single search bounded by the largest one. The reached segments
+// and cells are drawn on a grid of arrival times which is then traced into polygons.
+class IsochronePlugin final : public BasePlugin
+{
+  public:
+    explicit IsochronePlugin(const double max_duration);
+
+    Status HandleRequest(const RoutingAlgorithmsInterface &algorithms,
+                         const api::IsochroneParameters &params,
+                         osrm::engine::api::ResultT &result) const;
+
+  private:
+    const double max_duration;
+};
+} // namespace plugins
+} // namespace engine
+} // namespace osrm
+
+#endif /* ISOCHRONE_HPP */
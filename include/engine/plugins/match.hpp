@@ -2,11 +2,14 @@
 #define MATCH_HPP
 
 #include "engine/api/match_parameters.hpp"
+#include "engine/map_matching/matching_session.hpp"
 #include "engine/plugins/plugin_base.hpp"
 #include "engine/routing_algorithms.hpp"
 
 #include "util/json_util.hpp"
 
+#include <chrono>
+#include <cstddef>
 #include <vector>
 
 namespace osrm
@@ -24,9 +27,15 @@ class MatchPlugin : public BasePlugin
     using CandidateLists = routing_algorithms::CandidateLists;
     static const constexpr double RADIUS_MULTIPLIER = 3;
 
-    MatchPlugin(const int max_locations_map_matching, const double max_radius_map_matching)
+    MatchPlugin(const int max_locations_map_matching,
+                const double max_radius_map_matching,
+                const std::size_t max_matching_sessions,
+                const double matching_session_timeout)
         : max_locations_map_matching(max_locations_map_matching),
-          max_radius_map_matching(max_radius_map_matching)
+          max_radius_map_matching(max_radius_map_matching),
+          sessions(max_matching_sessions,
+                   std::chrono::duration_cast<map_matching::MatchingSessionStore::Clock::duration>(
+                       std::chrono::duration<double>(matching_session_timeout)))
     {
     }
 
@@ -35,8 +44,13 @@ class MatchPlugin : public BasePlugin
                          osrm::engine::api::ResultT &json_result) const;
 
   private:
+    Status HandleSessionRequest(const RoutingAlgorithmsInterface &algorithms,
+                                const api::MatchParameters &parameters,
+                                osrm::engine::api::ResultT &json_result) const;
+
     const int max_locations_map_matching;
     const double max_radius_map_matching;
+    mutable map_matching::MatchingSessionStore sessions;
 };
 } // namespace plugins
 } // namespace engine
@@ -7,15 +7,19 @@
 #include "engine/datafacade/datafacade_base.hpp"
 #include "engine/phantom_node.hpp"
 #include "engine/routing_algorithms.hpp"
+#include "engine/snapping_cache.hpp"
 #include "engine/status.hpp"
 
 #include "util/coordinate.hpp"
 #include "util/coordinate_calculation.hpp"
+#include "util/hilbert_value.hpp"
 #include "util/integer_range.hpp"
 #include "util/json_container.hpp"
 
 #include <algorithm>
+#include <cstdint>
 #include <iterator>
+#include <numeric>
 #include <string>
 #include <vector>
 
@@ -39,6 +43,28 @@ class BasePlugin
             });
     }
 
+    // Order in which the coordinates are snapped: along the Hilbert curve consecutive
+    // coordinates are close to each other and share most of the R-tree nodes and leaves they
+    // explore while these are still cached.
+    std::vector<std::size_t>
+    GetSnappingOrder(const std::vector<util::Coordinate> &coordinates) const
+    {
+        std::vector<std::size_t> order(coordinates.size());
+        std::iota(order.begin(), order.end(), 0);
+        if (coordinates.size() > 2)
+        {
+            std::vector<std::uint64_t> hilbert_codes(coordinates.size());
+            std::transform(coordinates.begin(),
+                           coordinates.end(),
+                           hilbert_codes.begin(),
+                           util::GetHilbertCode);
+            std::sort(order.begin(), order.end(), [&](const auto lhs, const auto rhs) {
+                return hilbert_codes[lhs] < hilbert_codes[rhs];
+            });
+        }
+        return order;
+    }
+
     bool CheckAlgorithms(const api::BaseParameters &params,
                          const RoutingAlgorithmsInterface &algorithms,
                          osrm::engine::api::ResultT &result) const
@@ -179,7 +205,7 @@ class BasePlugin
         const bool use_bearings = !parameters.bearings.empty();
         const bool use_approaches = !parameters.approaches.empty();
 
-        for (const auto i : util::irange<std::size_t>(0UL, parameters.coordinates.size()))
+        for (const auto i : GetSnappingOrder(parameters.coordinates))
         {
             Approach approach = engine::Approach::UNRESTRICTED;
             if (use_approaches && parameters.approaches[i])
@@ -215,6 +241,7 @@ class BasePlugin
         return phantom_nodes;
     }
 
+    // Coordinates without a fitting node get an empty list
     std::vector<std::vector<PhantomNodeWithDistance>>
     GetPhantomNodes(const datafacade::BaseDataFacade &facade,
                     const api::BaseParameters &parameters,
@@ -229,7 +256,7 @@ class BasePlugin
         const bool use_approaches = !parameters.approaches.empty();
 
         BOOST_ASSERT(parameters.IsValid());
-        for (const auto i : util::irange<std::size_t>(0UL, parameters.coordinates.size()))
+        for (const auto i : GetSnappingOrder(parameters.coordinates))
         {
             Approach approach = engine::Approach::UNRESTRICTED;
             if (use_approaches && parameters.approaches[i])
@@ -281,12 +308,6 @@ class BasePlugin
                         parameters.coordinates[i], number_of_results, approach);
                 }
             }
-
-            // we didn't find a fitting node, return error
-            if (phantom_nodes[i].empty())
-            {
-                break;
-            }
         }
         return phantom_nodes;
     }
@@ -302,8 +323,14 @@ class BasePlugin
         const bool use_approaches = !parameters.approaches.empty();
         const bool use_all_edges = parameters.snapping == api::BaseParameters::SnappingType::Any;
 
+        // first coordinate that could not be snapped
+        std::size_t missing_index = parameters.coordinates.size();
+
+        // recurring coordinates of clients that don't keep hints
+        auto &snapping_cache = facade.GetSnappingCache();
+
         BOOST_ASSERT(parameters.IsValid());
-        for (const auto i : util::irange<std::size_t>(0UL, parameters.coordinates.size()))
+        for (const auto i : GetSnappingOrder(parameters.coordinates))
         {
             Approach approach = engine::Approach::UNRESTRICTED;
             if (use_approaches && parameters.approaches[i])
@@ -317,7 +344,19 @@ class BasePlugin
                 continue;
             }
 
-            if (use_bearings && parameters.bearings[i])
+            const SnappingCache::Key key{
+                parameters.coordinates[i],
+                use_bearings ? parameters.bearings[i] : boost::none,
+                use_radiuses ? parameters.radiuses[i] : boost::none,
+                approach,
+                use_all_edges};
+            const auto cached = snapping_cache.Find(key);
+
+            if (cached)
+            {
+                phantom_node_pairs[i] = *cached;
+            }
+            else if (use_bearings && parameters.bearings[i])
             {
                 if (use_radiuses && parameters.radiuses[i])
                 {
@@ -360,17 +399,25 @@ class BasePlugin
                 }
             }
 
+            // coordinates that can't be snapped are cached as well, they fail again
+            if (!cached)
+            {
+                snapping_cache.Insert(key, phantom_node_pairs[i]);
+            }
+
             // we didn't find a fitting node, return error
             if (!phantom_node_pairs[i].first.IsValid())
             {
-                // This ensures the list of phantom nodes only consists of valid nodes.
-                // We can use this on the call-site to detect an error.
-                phantom_node_pairs.pop_back();
-                break;
+                missing_index = std::min(missing_index, i);
+                continue;
             }
             BOOST_ASSERT(phantom_node_pairs[i].first.IsValid());
             BOOST_ASSERT(phantom_node_pairs[i].second.IsValid());
         }
+
+        // This ensures the list of phantom nodes only consists of valid nodes.
+        // We can use this on the call-site to detect an error.
+        phantom_node_pairs.resize(missing_index);
         return phantom_node_pairs;
     }
 
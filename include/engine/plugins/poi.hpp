@@ -0,0 +1,76 @@
+#ifndef POI_HPP
+#define POI_HPP
+
+#include "engine/api/poi_parameters.hpp"
+#include "engine/plugins/plugin_base.hpp"
+#include "engine/routing_algorithms.hpp"
+#include "osrm/json_container.hpp"
+
+#include "util/coordinate.hpp"
+
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace plugins
+{
+
+// Finds the points of interest of a registered set that are closest by travel time.
+//
+// A set is snapped and indexed the first time it is queried on a dataset. The index is shared
+// by all following queries on the same data facade and dropped once that facade is gone, so
+// it is rebuilt after the data or its metric was reloaded.
+class POIPlugin final : public BasePlugin
+{
+  public:
+    POIPlugin(std::unordered_map<std::string, std::vector<util::Coordinate>> poi_sets,
+              const int max_results);
+
+    Status HandleRequest(const RoutingAlgorithmsInterface &algorithms,
+                         const api::POIParameters &params,
+                         osrm::engine::api::ResultT &result) const;
+
+  private:
+    struct IndexedPOISet
+    {
+        std::vector<PhantomNode> phantom_nodes;
+        routing_algorithms::POIIndex index;
+    };
+
+    // Queries that arrive while a set is indexed wait for the future instead of the lock
+    struct CachedPOISet
+    {
+        std::weak_ptr<const datafacade::BaseDataFacade> facade;
+        std::string name;
+        std::shared_future<std::shared_ptr<const IndexedPOISet>> indexed_set;
+    };
+
+    std::shared_ptr<const IndexedPOISet>
+    IndexPOISet(const RoutingAlgorithmsInterface &algorithms,
+                const std::string &name,
+                const std::vector<util::Coordinate> &coordinates) const;
+
+    std::shared_ptr<const IndexedPOISet>
+    GetIndexedPOISet(const RoutingAlgorithmsInterface &algorithms,
+                     const std::string &name,
+                     const std::vector<util::Coordinate> &coordinates) const;
+
+    const std::unordered_map<std::string, std::vector<util::Coordinate>> poi_sets;
+    const int max_results;
+
+    // only guards the list, the sets are indexed without holding it
+    mutable std::mutex indexed_sets_mutex;
+    mutable std::vector<CachedPOISet> indexed_sets;
+};
+} // namespace plugins
+} // namespace engine
+} // namespace osrm
+
+#endif /* POI_HPP */
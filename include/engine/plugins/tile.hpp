@@ -4,7 +4,11 @@
 #include "engine/api/tile_parameters.hpp"
 #include "engine/plugins/plugin_base.hpp"
 #include "engine/routing_algorithms.hpp"
+#include "engine/tile_store.hpp"
 
+#include <boost/filesystem/path.hpp>
+
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -15,6 +19,9 @@
  * to display maps that show the exact road network that
  * OSRM is routing.  This is very useful for debugging routing
  * errors
+ *
+ * Tiles baked with osrm-tiles for the loaded dataset are served from the
+ * memory mapped tile store instead of being generated again.
  */
 namespace osrm
 {
@@ -26,9 +33,15 @@ namespace plugins
 class TilePlugin final : public BasePlugin
 {
   public:
+    // An empty path generates all tiles on demand
+    explicit TilePlugin(const boost::filesystem::path &baked_tiles_path);
+
     Status HandleRequest(const RoutingAlgorithmsInterface &algorithms,
                          const api::TileParameters &parameters,
                          osrm::engine::api::ResultT &pbf_buffer) const;
+
+  private:
+    std::unique_ptr<const TileStore> baked_tiles;
 };
 } // namespace plugins
 } // namespace engine
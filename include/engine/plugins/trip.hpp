@@ -29,6 +29,7 @@ class TripPlugin final : public BasePlugin
 {
   private:
     const int max_locations_trip;
+    const double max_trip_optimization_time;
 
     InternalRouteResult ComputeRoute(const RoutingAlgorithmsInterface &algorithms,
                                      const std::vector<PhantomNode> &phantom_node_list,
@@ -36,7 +37,11 @@ class TripPlugin final : public BasePlugin
                                      const bool roundtrip) const;
 
   public:
-    explicit TripPlugin(const int max_locations_trip_) : max_locations_trip(max_locations_trip_) {}
+    explicit TripPlugin(const int max_locations_trip_, const double max_trip_optimization_time_)
+        : max_locations_trip(max_locations_trip_),
+          max_trip_optimization_time(max_trip_optimization_time_)
+    {
+    }
 
     Status HandleRequest(const RoutingAlgorithmsInterface &algorithms,
                          const api::TripParameters &parameters,
@@ -6,11 +6,14 @@
 #include "engine/phantom_node.hpp"
 #include "engine/routing_algorithms/alternative_path.hpp"
 #include "engine/routing_algorithms/direct_shortest_path.hpp"
+#include "engine/routing_algorithms/isochrone.hpp"
 #include "engine/routing_algorithms/many_to_many.hpp"
 #include "engine/routing_algorithms/map_matching.hpp"
 #include "engine/routing_algorithms/shortest_path.hpp"
 #include "engine/routing_algorithms/tile_turns.hpp"
 
+#include "util/exception.hpp"
+
 namespace osrm
 {
 namespace engine
@@ -34,7 +37,21 @@ class RoutingAlgorithmsInterface
     ManyToManySearch(const std::vector<PhantomNode> &phantom_nodes,
                      const std::vector<std::size_t> &source_indices,
                      const std::vector<std::size_t> &target_indices,
-                     const bool calculate_distance) const = 0;
+                     const bool calculate_distance,
+                     const EdgeDuration max_duration,
+                     const EdgeDistance max_distance) const = 0;
+
+    virtual routing_algorithms::POIIndex
+    BuildPOIIndex(const std::vector<PhantomNode> &pois) const = 0;
+
+    virtual std::vector<routing_algorithms::NearestPOI>
+    NearestPOISearch(const PhantomNode &source_phantom,
+                     const routing_algorithms::POIIndex &poi_index,
+                     const std::size_t number_of_results) const = 0;
+
+    virtual routing_algorithms::IsochroneSearchSpace
+    IsochroneSearch(const PhantomNode &source_phantom,
+                    const std::vector<EdgeDuration> &contours) const = 0;
 
     virtual routing_algorithms::SubMatchingList
     MapMatching(const routing_algorithms::CandidateLists &candidates_list,
@@ -43,11 +60,21 @@ class RoutingAlgorithmsInterface
                 const std::vector<boost::optional<double>> &trace_gps_precision,
                 const bool allow_splitting) const = 0;
 
+    virtual routing_algorithms::SubMatchingList
+    MapMatchingSession(map_matching::MatchingSession &session,
+                       const routing_algorithms::CandidateLists &candidates_list,
+                       const std::vector<util::Coordinate> &trace_coordinates,
+                       const std::vector<unsigned> &trace_timestamps,
+                       const std::vector<boost::optional<double>> &trace_gps_precision,
+                       const bool allow_splitting) const = 0;
+
     virtual std::vector<routing_algorithms::TurnData>
     GetTileTurns(const std::vector<datafacade::BaseDataFacade::RTreeLeaf> &edges,
                  const std::vector<std::size_t> &sorted_edge_indexes) const = 0;
 
     virtual const DataFacadeBase &GetFacade() const = 0;
+    // Shares ownership of the facade, for data that has to live exactly as long as it
+    virtual std::shared_ptr<const DataFacadeBase> GetSharedFacade() const = 0;
 
     virtual bool HasAlternativePathSearch() const = 0;
     virtual bool HasShortestPathSearch() const = 0;
@@ -57,6 +84,7 @@ class RoutingAlgorithmsInterface
     virtual bool SupportsDistanceAnnotationType() const = 0;
     virtual bool HasGetTileTurns() const = 0;
     virtual bool HasExcludeFlags() const = 0;
+    virtual bool HasIsochroneSearch() const = 0;
     virtual bool IsValid() const = 0;
 };
 
@@ -87,7 +115,28 @@ template <typename Algorithm> class RoutingAlgorithms final : public RoutingAlgo
     ManyToManySearch(const std::vector<PhantomNode> &phantom_nodes,
                      const std::vector<std::size_t> &source_indices,
                      const std::vector<std::size_t> &target_indices,
-                     const bool calculate_distance) const final override;
+                     const bool calculate_distance,
+                     const EdgeDuration max_duration,
+                     const EdgeDistance max_distance) const final override;
+
+    routing_algorithms::POIIndex
+    BuildPOIIndex(const std::vector<PhantomNode> &pois) const final override
+    {
+        return routing_algorithms::buildPOIIndex(heaps, *facade, pois);
+    }
+
+    std::vector<routing_algorithms::NearestPOI>
+    NearestPOISearch(const PhantomNode &source_phantom,
+                     const routing_algorithms::POIIndex &poi_index,
+                     const std::size_t number_of_results) const final override
+    {
+        return routing_algorithms::nearestPOISearch(
+            heaps, *facade, source_phantom, poi_index, number_of_results);
+    }
+
+    routing_algorithms::IsochroneSearchSpace
+    IsochroneSearch(const PhantomNode &source_phantom,
+                    const std::vector<EdgeDuration> &contours) const final override;
 
     routing_algorithms::SubMatchingList
     MapMatching(const routing_algorithms::CandidateLists &candidates_list,
@@ -96,12 +145,25 @@ template <typename Algorithm> class RoutingAlgorithms final : public RoutingAlgo
                 const std::vector<boost::optional<double>> &trace_gps_precision,
                 const bool allow_splitting) const final override;
 
+    routing_algorithms::SubMatchingList
+    MapMatchingSession(map_matching::MatchingSession &session,
+                       const routing_algorithms::CandidateLists &candidates_list,
+                       const std::vector<util::Coordinate> &trace_coordinates,
+                       const std::vector<unsigned> &trace_timestamps,
+                       const std::vector<boost::optional<double>> &trace_gps_precision,
+                       const bool allow_splitting) const final override;
+
     std::vector<routing_algorithms::TurnData>
     GetTileTurns(const std::vector<datafacade::BaseDataFacade::RTreeLeaf> &edges,
                  const std::vector<std::size_t> &sorted_edge_indexes) const final override;
 
     const DataFacadeBase &GetFacade() const final override { return *facade; }
 
+    std::shared_ptr<const DataFacadeBase> GetSharedFacade() const final override
+    {
+        return facade;
+    }
+
     bool HasAlternativePathSearch() const final override
     {
         return routing_algorithms::HasAlternativePathSearch<Algorithm>::value;
@@ -142,6 +204,11 @@ template <typename Algorithm> class RoutingAlgorithms final : public RoutingAlgo
         return routing_algorithms::HasExcludeFlags<Algorithm>::value;
     }
 
+    bool HasIsochroneSearch() const final override
+    {
+        return routing_algorithms::HasIsochroneSearch<Algorithm>::value;
+    }
+
     bool IsValid() const final override { return static_cast<bool>(facade); }
 
   private:
@@ -191,12 +258,33 @@ inline routing_algorithms::SubMatchingList RoutingAlgorithms<Algorithm>::MapMatc
                                            allow_splitting);
 }
 
+template <typename Algorithm>
+inline routing_algorithms::SubMatchingList RoutingAlgorithms<Algorithm>::MapMatchingSession(
+    map_matching::MatchingSession &session,
+    const routing_algorithms::CandidateLists &candidates_list,
+    const std::vector<util::Coordinate> &trace_coordinates,
+    const std::vector<unsigned> &trace_timestamps,
+    const std::vector<boost::optional<double>> &trace_gps_precision,
+    const bool allow_splitting) const
+{
+    return routing_algorithms::mapMatchingSession(heaps,
+                                                  *facade,
+                                                  session,
+                                                  candidates_list,
+                                                  trace_coordinates,
+                                                  trace_timestamps,
+                                                  trace_gps_precision,
+                                                  allow_splitting);
+}
+
 template <typename Algorithm>
 std::pair<std::vector<EdgeDuration>, std::vector<EdgeDistance>>
 RoutingAlgorithms<Algorithm>::ManyToManySearch(const std::vector<PhantomNode> &phantom_nodes,
                                                const std::vector<std::size_t> &_source_indices,
                                                const std::vector<std::size_t> &_target_indices,
-                                               const bool calculate_distance) const
+                                               const bool calculate_distance,
+                                               const EdgeDuration max_duration,
+                                               const EdgeDistance max_distance) const
 {
     BOOST_ASSERT(!phantom_nodes.empty());
 
@@ -214,12 +302,17 @@ RoutingAlgorithms<Algorithm>::ManyToManySearch(const std::vector<PhantomNode> &p
         std::iota(target_indices.begin(), target_indices.end(), 0);
     }
 
-    return routing_algorithms::manyToManySearch(heaps,
-                                                *facade,
-                                                phantom_nodes,
-                                                std::move(source_indices),
-                                                std::move(target_indices),
-                                                calculate_distance);
+    const routing_algorithms::ManyToManyBounds bounds(
+        max_duration, max_distance, phantom_nodes, source_indices);
+
+    auto tables = routing_algorithms::manyToManySearch(heaps,
+                                                       *facade,
+                                                       phantom_nodes,
+                                                       std::move(source_indices),
+                                                       std::move(target_indices),
+                                                       calculate_distance,
+                                                       bounds);
+    return std::make_pair(std::move(tables.durations), std::move(tables.distances));
 }
 
 template <typename Algorithm>
@@ -230,6 +323,23 @@ inline std::vector<routing_algorithms::TurnData> RoutingAlgorithms<Algorithm>::G
     return routing_algorithms::getTileTurns(*facade, edges, sorted_edge_indexes);
 }
 
+template <typename Algorithm>
+inline routing_algorithms::IsochroneSearchSpace
+RoutingAlgorithms<Algorithm>::IsochroneSearch(const PhantomNode &source_phantom,
+                                              const std::vector<EdgeDuration> &contours) const
+{
+    return routing_algorithms::isochroneSearch(heaps, *facade, source_phantom, contours);
+}
+
+// CH has no cell structure to bound the isochrone search with
+template <>
+inline routing_algorithms::IsochroneSearchSpace
+RoutingAlgorithms<routing_algorithms::ch::Algorithm>::IsochroneSearch(
+    const PhantomNode &, const std::vector<EdgeDuration> &) const
+{
+    throw util::exception("IsochroneSearch is not implemented for CH");
+}
+
 } // namespace engine
 } // namespace osrm
 
@@ -0,0 +1,57 @@
+#ifndef OSRM_ENGINE_ROUTING_ALGORITHMS_ISOCHRONE_HPP
+#define OSRM_ENGINE_ROUTING_ALGORITHMS_ISOCHRONE_HPP
+
+#include "engine/algorithm.hpp"
+#include "engine/datafacade.hpp"
+#include "engine/phantom_node.hpp"
+#include "engine/search_engine_data.hpp"
+
+#include "util/typedefs.hpp"
+
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace routing_algorithms
+{
+
+// A node of the base graph settled by an isochrone search. The duration is the time at which
+// the segment of the node is entered, it can be negative for the segment of the source.
+struct IsochroneNode
+{
+    NodeID node;
+    EdgeDuration duration;
+};
+
+// A cell of the overlay graph that was reached as a whole: all of its border nodes were settled
+// and the paths through the cell between them are bounded to one contour band, so the search did
+// not descend into the cell. The duration is the one of the last border node.
+struct IsochroneCell
+{
+    LevelID level;
+    CellID cell;
+    EdgeDuration duration;
+    std::vector<NodeID> border_nodes;
+};
+
+struct IsochroneSearchSpace
+{
+    std::vector<IsochroneNode> nodes;
+    std::vector<IsochroneCell> cells;
+};
+
+// Runs a one-to-all search from the source that is bounded by the largest contour.
+// Contours are durations in ascending order.
+template <typename Algorithm>
+IsochroneSearchSpace isochroneSearch(SearchEngineData<Algorithm> &engine_working_data,
+                                     const DataFacade<Algorithm> &facade,
+                                     const PhantomNode &source_phantom,
+                                     const std::vector<EdgeDuration> &contours);
+
+} // namespace routing_algorithms
+} // namespace engine
+} // namespace osrm
+
+#endif
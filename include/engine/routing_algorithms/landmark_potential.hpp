@@ -0,0 +1,95 @@
+#ifndef OSRM_ENGINE_ROUTING_ALGORITHMS_LANDMARK_POTENTIAL_HPP
+#define OSRM_ENGINE_ROUTING_ALGORITHMS_LANDMARK_POTENTIAL_HPP
+
+#include "util/typedefs.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace routing_algorithms
+{
+
+// Potential of a plain bidirectional Dijkstra search
+struct ZeroPotential
+{
+    EdgeWeight operator()(const NodeID) const { return 0; }
+};
+
+// Average A* potential for bidirectional searches from the landmark lower bounds.
+//
+// With pi_t(v) the lower bound of the weight v -> target and pi_s(v) the lower bound of
+// source -> v, the forward search uses p(v) = (pi_t(v) - pi_s(v)) / 2 and the backward search
+// -p(v). Both are consistent, so the keys of the forward and backward heap still sum up to the
+// weight of the path through a node and the usual meeting and stopping criteria keep working.
+//
+// Sources and targets are added with the weight they are inserted into the heaps with.
+template <typename LandmarksT> class LandmarkPotential
+{
+  public:
+    LandmarkPotential(const LandmarksT &landmarks) : landmarks(landmarks) {}
+
+    void AddSource(const NodeID node, const EdgeWeight weight)
+    {
+        sources.push_back({node, weight});
+    }
+
+    void AddTarget(const NodeID node, const EdgeWeight weight)
+    {
+        targets.push_back({node, weight});
+    }
+
+    // Returns INVALID_EDGE_WEIGHT if the node is on no path from a source to a target
+    EdgeWeight operator()(const NodeID node) const
+    {
+        auto to_targets = UNREACHED;
+        for (const auto &target : targets)
+        {
+            const auto bound = landmarks.GetLowerBound(node, target.node);
+            if (bound != INVALID_EDGE_WEIGHT)
+                to_targets = std::min<std::int64_t>(to_targets, bound + target.weight);
+        }
+
+        auto from_sources = UNREACHED;
+        for (const auto &source : sources)
+        {
+            const auto bound = landmarks.GetLowerBound(source.node, node);
+            if (bound != INVALID_EDGE_WEIGHT)
+                from_sources = std::min<std::int64_t>(from_sources, source.weight + bound);
+        }
+
+        if (to_targets == UNREACHED || from_sources == UNREACHED)
+            return INVALID_EDGE_WEIGHT;
+
+        // rounds down also for negative differences, which keeps the potential consistent
+        const auto difference = to_targets - from_sources;
+        return static_cast<EdgeWeight>(difference >= 0 ? difference / 2 : -((1 - difference) / 2));
+    }
+
+  private:
+    struct Endpoint
+    {
+        NodeID node;
+        EdgeWeight weight;
+    };
+
+    static constexpr std::int64_t UNREACHED = std::numeric_limits<std::int64_t>::max();
+
+    const LandmarksT &landmarks;
+    std::vector<Endpoint> sources;
+    std::vector<Endpoint> targets;
+};
+
+template <typename LandmarksT>
+constexpr std::int64_t LandmarkPotential<LandmarksT>::UNREACHED;
+
+} // namespace routing_algorithms
+} // namespace engine
+} // namespace osrm
+
+#endif // OSRM_ENGINE_ROUTING_ALGORITHMS_LANDMARK_POTENTIAL_HPP
@@ -3,10 +3,15 @@
 
 #include "engine/algorithm.hpp"
 #include "engine/datafacade.hpp"
+#include "engine/routing_algorithms/node_bucket_index.hpp"
 #include "engine/search_engine_data.hpp"
 
 #include "util/typedefs.hpp"
 
+#include <algorithm>
+#include <set>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 namespace osrm
@@ -90,14 +95,213 @@ struct NodeBucket
 };
 } // namespace
 
+// Upper bounds on the weight, duration and distance of the table entries.
+//
+// Paths from a source start with the negated offsets of the source phantom node, so partial
+// paths of a search can be shorter than the final entry by at most the largest source offset.
+// The search bounds are widened by these offsets: a node above them can only lead to entries
+// that exceed the requested bounds and is not expanded.
+struct ManyToManyBounds
+{
+    EdgeWeight max_weight = INVALID_EDGE_WEIGHT;
+    EdgeDuration max_duration = MAXIMAL_EDGE_DURATION;
+    EdgeDistance max_distance = MAXIMAL_EDGE_DISTANCE;
+
+    EdgeWeight search_max_weight = INVALID_EDGE_WEIGHT;
+    EdgeDuration search_max_duration = MAXIMAL_EDGE_DURATION;
+    EdgeDistance search_max_distance = MAXIMAL_EDGE_DISTANCE;
+
+    ManyToManyBounds() = default;
+
+    ManyToManyBounds(const EdgeDuration max_duration,
+                     const EdgeDistance max_distance,
+                     const std::vector<PhantomNode> &phantom_nodes,
+                     const std::vector<std::size_t> &source_indices)
+        : ManyToManyBounds(
+              INVALID_EDGE_WEIGHT, max_duration, max_distance, phantom_nodes, source_indices)
+    {
+    }
+
+    ManyToManyBounds(const EdgeWeight max_weight,
+                     const EdgeDuration max_duration,
+                     const EdgeDistance max_distance,
+                     const std::vector<PhantomNode> &phantom_nodes,
+                     const std::vector<std::size_t> &source_indices)
+        : max_weight(max_weight), max_duration(max_duration), max_distance(max_distance)
+    {
+        EdgeWeight weight_offset = 0;
+        EdgeDuration duration_offset = 0;
+        EdgeDistance distance_offset = 0;
+        for (const auto index : source_indices)
+        {
+            const auto &phantom = phantom_nodes[index];
+            if (phantom.IsValidForwardSource())
+            {
+                weight_offset = std::max(weight_offset, phantom.GetForwardWeightPlusOffset());
+                duration_offset = std::max(duration_offset, phantom.GetForwardDuration());
+                distance_offset = std::max(distance_offset, phantom.GetForwardDistance());
+            }
+            if (phantom.IsValidReverseSource())
+            {
+                weight_offset = std::max(weight_offset, phantom.GetReverseWeightPlusOffset());
+                duration_offset = std::max(duration_offset, phantom.GetReverseDuration());
+                distance_offset = std::max(distance_offset, phantom.GetReverseDistance());
+            }
+        }
+
+        search_max_weight = max_weight >= INVALID_EDGE_WEIGHT - weight_offset
+                                ? INVALID_EDGE_WEIGHT
+                                : max_weight + weight_offset;
+        search_max_duration =
+            max_duration >= MAXIMAL_EDGE_DURATION - duration_offset
+                ? MAXIMAL_EDGE_DURATION
+                : max_duration + duration_offset;
+        search_max_distance = max_distance >= MAXIMAL_EDGE_DISTANCE - distance_offset
+                                  ? MAXIMAL_EDGE_DISTANCE
+                                  : max_distance + distance_offset;
+    }
+
+    bool IsBounded() const
+    {
+        return max_weight != INVALID_EDGE_WEIGHT || max_duration != MAXIMAL_EDGE_DURATION ||
+               max_distance != MAXIMAL_EDGE_DISTANCE;
+    }
+
+    // True if a settled node can not be part of an entry within the bounds
+    bool IsPruned(const EdgeWeight weight,
+                  const EdgeDuration duration,
+                  const EdgeDistance distance) const
+    {
+        return weight > search_max_weight || duration > search_max_duration ||
+               distance > search_max_distance;
+    }
+};
+
+// A registered set of points of interest, prepared once for k-nearest queries.
+//
+// The bucket index holds the search spaces towards the POIs keyed by node, the column of an
+// entry is the index of the POI in the set:
+//  * CH stores the backward search space of every POI
+//  * MLD stores only the segments of the POIs with their phantom offsets and marks for every
+//    level the cells that contain a POI, which is all a forward search needs to pick the
+//    query level of a node
+struct POIIndex
+{
+    NodeBucketIndex buckets;
+    std::vector<std::vector<bool>> cells;
+};
+
+struct NearestPOI
+{
+    unsigned poi_index;
+    EdgeWeight weight;
+    EdgeDuration duration;
+    EdgeDistance distance;
+};
+
+// Tentative and settled results of a k-nearest POI search.
+//
+// Bucket entries are non-negative, so a path found later in a forward search is never shorter
+// than the smallest key left in the heap. A tentative result is settled as soon as that key
+// reaches its weight, and the search can stop once the requested number of POIs are settled.
+class NearestPOIResults
+{
+  public:
+    explicit NearestPOIResults(const std::size_t number_of_results)
+        : number_of_results(number_of_results)
+    {
+    }
+
+    void Update(const unsigned poi_index,
+                const EdgeWeight weight,
+                const EdgeDuration duration,
+                const EdgeDistance distance)
+    {
+        auto iter = tentative.find(poi_index);
+        if (iter == tentative.end())
+        {
+            tentative.emplace(poi_index, NearestPOI{poi_index, weight, duration, distance});
+            queue.emplace(weight, duration, poi_index);
+        }
+        else if (!iter->second.settled &&
+                 std::tie(weight, duration) <
+                     std::tie(iter->second.poi.weight, iter->second.poi.duration))
+        {
+            queue.erase(
+                std::make_tuple(iter->second.poi.weight, iter->second.poi.duration, poi_index));
+            iter->second.poi = NearestPOI{poi_index, weight, duration, distance};
+            queue.emplace(weight, duration, poi_index);
+        }
+    }
+
+    // Settles all tentative results that can not be improved by paths of at least min_weight
+    void Settle(const EdgeWeight min_weight)
+    {
+        while (!Done() && !queue.empty() && std::get<0>(*queue.begin()) <= min_weight)
+        {
+            auto &entry = tentative.at(std::get<2>(*queue.begin()));
+            queue.erase(queue.begin());
+            entry.settled = true;
+            settled.push_back(entry.poi);
+        }
+    }
+
+    bool Done() const { return settled.size() >= number_of_results; }
+
+    // Settles the remaining tentative results once the search space is exhausted
+    std::vector<NearestPOI> Finish()
+    {
+        Settle(INVALID_EDGE_WEIGHT);
+        return std::move(settled);
+    }
+
+  private:
+    struct Entry
+    {
+        Entry(NearestPOI poi) : poi(poi) {}
+
+        NearestPOI poi;
+        bool settled = false;
+    };
+
+    std::size_t number_of_results;
+    std::unordered_map<unsigned, Entry> tentative;
+    std::set<std::tuple<EdgeWeight, EdgeDuration, unsigned>> queue;
+    std::vector<NearestPOI> settled;
+};
+
+// Row major tables of a many-to-many search with one row per source. Unreachable entries and
+// entries pruned by the bounds are INVALID_EDGE_WEIGHT, MAXIMAL_EDGE_DURATION and
+// MAXIMAL_EDGE_DISTANCE, the distances are empty unless they were requested.
+struct ManyToManyTables
+{
+    std::vector<EdgeWeight> weights;
+    std::vector<EdgeDuration> durations;
+    std::vector<EdgeDistance> distances;
+};
+
 template <typename Algorithm>
-std::pair<std::vector<EdgeDuration>, std::vector<EdgeDistance>>
+ManyToManyTables
 manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
                  const DataFacade<Algorithm> &facade,
                  const std::vector<PhantomNode> &phantom_nodes,
                  const std::vector<std::size_t> &source_indices,
                  const std::vector<std::size_t> &target_indices,
-                 const bool calculate_distance);
+                 const bool calculate_distance,
+                 const ManyToManyBounds &bounds);
+
+template <typename Algorithm>
+POIIndex buildPOIIndex(SearchEngineData<Algorithm> &engine_working_data,
+                       const DataFacade<Algorithm> &facade,
+                       const std::vector<PhantomNode> &pois);
+
+// Returns the number_of_results POIs closest to the source ordered by weight
+template <typename Algorithm>
+std::vector<NearestPOI> nearestPOISearch(SearchEngineData<Algorithm> &engine_working_data,
+                                         const DataFacade<Algorithm> &facade,
+                                         const PhantomNode &source_phantom,
+                                         const POIIndex &poi_index,
+                                         const std::size_t number_of_results);
 
 } // namespace routing_algorithms
 } // namespace engine
@@ -3,6 +3,7 @@
 
 #include "engine/algorithm.hpp"
 #include "engine/datafacade.hpp"
+#include "engine/map_matching/matching_session.hpp"
 #include "engine/map_matching/sub_matching.hpp"
 #include "engine/search_engine_data.hpp"
 
@@ -20,6 +21,17 @@ using CandidateLists = std::vector<CandidateList>;
 using SubMatchingList = std::vector<map_matching::SubMatching>;
 static const constexpr double DEFAULT_GPS_PRECISION = 5;
 
+// Network distances of the transitions from every source to every target candidate, row major
+// with one row per source, from one many-to-many search. Transitions with a weight of at least
+// weight_upper_bound are unreachable, std::numeric_limits<double>::max(), like for a
+// point-to-point search up to that bound.
+template <typename Algorithm>
+std::vector<double> getTransitionDistances(SearchEngineData<Algorithm> &engine_working_data,
+                                           const DataFacade<Algorithm> &facade,
+                                           const std::vector<PhantomNode> &sources,
+                                           const std::vector<PhantomNode> &targets,
+                                           const EdgeWeight weight_upper_bound);
+
 //[1] "Hidden Markov Map Matching Through Noise and Sparseness";
 //     P. Newson and J. Krumm; 2009; ACM GIS
 template <typename Algorithm>
@@ -31,6 +43,20 @@ SubMatchingList mapMatching(SearchEngineData<Algorithm> &engine_working_data,
                             const std::vector<boost::optional<double>> &trace_gps_precision,
                             const bool allow_splitting);
 
+// Continues a matching session with new trace points, one step of the Viterbi recursion each.
+// The returned sub matchings end at the most likely candidate of the last matched point, a new
+// one starts whenever the trace had to be split. If the session was not empty, index 0 refers to
+// its last matched point and the new trace points start at index 1.
+template <typename Algorithm>
+SubMatchingList mapMatchingSession(SearchEngineData<Algorithm> &engine_working_data,
+                                   const DataFacade<Algorithm> &facade,
+                                   map_matching::MatchingSession &session,
+                                   const CandidateLists &candidates_list,
+                                   const std::vector<util::Coordinate> &trace_coordinates,
+                                   const std::vector<unsigned> &trace_timestamps,
+                                   const std::vector<boost::optional<double>> &trace_gps_precision,
+                                   const bool allow_splitting);
+
 } // namespace routing_algorithms
 } // namespace engine
 } // namespace osrm
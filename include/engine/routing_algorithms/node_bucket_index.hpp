@@ -0,0 +1,168 @@
+#ifndef OSRM_ENGINE_ROUTING_ALGORITHMS_NODE_BUCKET_INDEX_HPP
+#define OSRM_ENGINE_ROUTING_ALGORITHMS_NODE_BUCKET_INDEX_HPP
+
+#include "util/typedefs.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace routing_algorithms
+{
+
+// Bucket entries of the backward searches of a many-to-many query, grouped by middle node.
+//
+// Entries are collected unordered with Insert() and then grouped with Build() into a
+// compressed sparse row layout keyed by node id: all entries of a node are stored
+// consecutively and the columns, weights, durations and distances of the entries are kept in
+// separate arrays. The forward searches then only read contiguous ranges of the arrays
+// they actually need instead of binary searching over the full bucket structs.
+//
+// Build() uses a stable LSD counting sort on the node ids, so entries of the same node keep
+// their insertion order (the column order of the backward searches).
+class NodeBucketIndex
+{
+  public:
+    using EntryRange = std::pair<std::uint32_t, std::uint32_t>;
+
+    void Clear()
+    {
+        staged_nodes.clear();
+        staged_columns.clear();
+        staged_weights.clear();
+        staged_durations.clear();
+        staged_distances.clear();
+        nodes.clear();
+        offsets.clear();
+        columns.clear();
+        weights.clear();
+        durations.clear();
+        distances.clear();
+    }
+
+    void Insert(const NodeID node,
+                const unsigned column,
+                const EdgeWeight weight,
+                const EdgeDuration duration,
+                const EdgeDistance distance)
+    {
+        staged_nodes.push_back(node);
+        staged_columns.push_back(column);
+        staged_weights.push_back(weight);
+        staged_durations.push_back(duration);
+        staged_distances.push_back(distance);
+    }
+
+    void Build()
+    {
+        const auto number_of_entries = static_cast<std::uint32_t>(staged_nodes.size());
+
+        std::vector<std::uint32_t> permutation(number_of_entries);
+        std::vector<std::uint32_t> sorted_permutation(number_of_entries);
+        for (std::uint32_t index = 0; index < number_of_entries; ++index)
+            permutation[index] = index;
+
+        // Stable counting sort passes over the bytes of the node id, starting with the least
+        // significant one. A pass is skipped if all keys share the same digit.
+        for (std::uint32_t shift = 0; shift < 32; shift += DIGIT_BITS)
+        {
+            std::array<std::uint32_t, DIGIT_RANGE + 1> counts{};
+            for (const auto node : staged_nodes)
+                ++counts[((node >> shift) & DIGIT_MASK) + 1];
+
+            if (std::any_of(counts.begin(), counts.end(), [&](const auto count) {
+                    return count == number_of_entries;
+                }))
+                continue;
+
+            std::partial_sum(counts.begin(), counts.end(), counts.begin());
+            for (const auto index : permutation)
+                sorted_permutation[counts[(staged_nodes[index] >> shift) & DIGIT_MASK]++] = index;
+            permutation.swap(sorted_permutation);
+        }
+
+        columns.resize(number_of_entries);
+        weights.resize(number_of_entries);
+        durations.resize(number_of_entries);
+        distances.resize(number_of_entries);
+        nodes.clear();
+        offsets.clear();
+
+        for (std::uint32_t index = 0; index < number_of_entries; ++index)
+        {
+            const auto source = permutation[index];
+            const auto node = staged_nodes[source];
+            if (nodes.empty() || nodes.back() != node)
+            {
+                nodes.push_back(node);
+                offsets.push_back(index);
+            }
+            columns[index] = staged_columns[source];
+            weights[index] = staged_weights[source];
+            durations[index] = staged_durations[source];
+            distances[index] = staged_distances[source];
+        }
+        offsets.push_back(number_of_entries);
+
+        staged_nodes.clear();
+        staged_columns.clear();
+        staged_weights.clear();
+        staged_durations.clear();
+        staged_distances.clear();
+    }
+
+    // Returns the [begin, end) range of entries stored for the node.
+    // The range is empty if the node was not settled by any backward search.
+    EntryRange Find(const NodeID node) const
+    {
+        const auto iter = std::lower_bound(nodes.begin(), nodes.end(), node);
+        if (iter == nodes.end() || *iter != node)
+            return {0, 0};
+
+        const auto slot = std::distance(nodes.begin(), iter);
+        return {offsets[slot], offsets[slot + 1]};
+    }
+
+    std::size_t GetNumberOfNodes() const { return nodes.size(); }
+    std::size_t GetNumberOfEntries() const { return columns.size(); }
+
+    const std::vector<unsigned> &GetColumns() const { return columns; }
+    const std::vector<EdgeWeight> &GetWeights() const { return weights; }
+    const std::vector<EdgeDuration> &GetDurations() const { return durations; }
+    const std::vector<EdgeDistance> &GetDistances() const { return distances; }
+
+  private:
+    static constexpr std::uint32_t DIGIT_BITS = 8;
+    static constexpr std::uint32_t DIGIT_RANGE = 1u << DIGIT_BITS;
+    static constexpr std::uint32_t DIGIT_MASK = DIGIT_RANGE - 1;
+
+    // unordered entries of the backward searches
+    std::vector<NodeID> staged_nodes;
+    std::vector<unsigned> staged_columns;
+    std::vector<EdgeWeight> staged_weights;
+    std::vector<EdgeDuration> staged_durations;
+    std::vector<EdgeDistance> staged_distances;
+
+    // sorted distinct middle nodes and the offsets of their first entry
+    std::vector<NodeID> nodes;
+    std::vector<std::uint32_t> offsets;
+
+    // entries grouped by middle node
+    std::vector<unsigned> columns;
+    std::vector<EdgeWeight> weights;
+    std::vector<EdgeDuration> durations;
+    std::vector<EdgeDistance> distances;
+};
+
+} // namespace routing_algorithms
+} // namespace engine
+} // namespace osrm
+
+#endif // OSRM_ENGINE_ROUTING_ALGORITHMS_NODE_BUCKET_INDEX_HPP
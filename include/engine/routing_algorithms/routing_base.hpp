@@ -147,6 +147,7 @@ void annotatePath(const FacadeT &facade,
     std::vector<SegmentWeight> weight_vector;
     std::vector<SegmentDuration> duration_vector;
     std::vector<DatasourceID> datasource_vector;
+    std::vector<std::uint8_t> rank_vector;
 
     const auto get_segment_geometry = [&](const auto geometry_index) {
         const auto copy = [](auto &vector, const auto range) {
@@ -160,6 +161,7 @@ void annotatePath(const FacadeT &facade,
             copy(weight_vector, facade.GetUncompressedForwardWeights(geometry_index.id));
             copy(duration_vector, facade.GetUncompressedForwardDurations(geometry_index.id));
             copy(datasource_vector, facade.GetUncompressedForwardDatasources(geometry_index.id));
+            copy(rank_vector, facade.GetUncompressedForwardSimplificationRanks(geometry_index.id));
         }
         else
         {
@@ -167,6 +169,7 @@ void annotatePath(const FacadeT &facade,
             copy(weight_vector, facade.GetUncompressedReverseWeights(geometry_index.id));
             copy(duration_vector, facade.GetUncompressedReverseDurations(geometry_index.id));
             copy(datasource_vector, facade.GetUncompressedReverseDatasources(geometry_index.id));
+            copy(rank_vector, facade.GetUncompressedReverseSimplificationRanks(geometry_index.id));
         }
     };
 
@@ -228,7 +231,8 @@ void annotatePath(const FacadeT &facade,
                          datasource_vector[segment_idx],
                          osrm::guidance::TurnBearing(0),
                          osrm::guidance::TurnBearing(0),
-                         is_left_hand_driving});
+                         is_left_hand_driving,
+                         rank_vector.empty() ? std::uint8_t{0} : rank_vector[segment_idx + 1]});
         }
         BOOST_ASSERT(unpacked_path.size() > 0);
         if (facade.HasLaneData(turn_id))
@@ -303,7 +307,10 @@ void annotatePath(const FacadeT &facade,
                      datasource_vector[segment_idx],
                      guidance::TurnBearing(0),
                      guidance::TurnBearing(0),
-                     is_target_left_hand_driving});
+                     is_target_left_hand_driving,
+                     rank_vector.empty() ? std::uint8_t{0}
+                                         : rank_vector[start_index < end_index ? segment_idx + 1
+                                                                               : segment_idx - 1]});
     }
 
     if (unpacked_path.size() > 0)
@@ -5,11 +5,16 @@
 #include "engine/datafacade.hpp"
 #include "engine/routing_algorithms/routing_base.hpp"
 #include "engine/search_engine_data.hpp"
+#include "engine/unpacking_cache.hpp"
 
 #include "util/typedefs.hpp"
 
 #include <boost/assert.hpp>
 
+#include <cstddef>
+#include <limits>
+#include <stack>
+
 namespace osrm
 {
 namespace engine
@@ -21,6 +26,9 @@ namespace routing_algorithms
 namespace ch
 {
 
+// Shortcuts that unpack to fewer original edges are cheaper to unpack again than to cache
+const constexpr std::size_t MIN_CACHED_UNPACKED_EDGES = 8;
+
 // Stalling
 template <bool DIRECTION, typename HeapT>
 bool stallAtNode(const DataFacade<Algorithm> &facade,
@@ -226,6 +234,9 @@ std::tuple<EdgeWeight, EdgeDistance> getLoopWeight(const DataFacade<Algorithm> &
  * the original route
  * from beginning to end.
  *
+ * Shortcuts that unpack to at least MIN_CACHED_UNPACKED_EDGES original edges are kept in the
+ * unpacking cache of the facade and are not unpacked again by later queries.
+ *
  * @param packed_path_begin iterator pointing to the start of the NodeID list
  * @param packed_path_end iterator pointing to the end of the NodeID list
  * @param callback void(const std::pair<NodeID, NodeID>, const EdgeID &) called for each
@@ -241,24 +252,54 @@ void unpackPath(const DataFacade<Algorithm> &facade,
     if (packed_path_begin == packed_path_end)
         return;
 
-    std::stack<std::pair<NodeID, NodeID>> recursion_stack;
+    auto &unpacking_cache = facade.GetUnpackingCache();
+
+    // A shortcut is visited twice: first to push its halves, then again once both halves
+    // are unpacked to put its original edges into the cache.
+    struct UnpackingFrame
+    {
+        NodeID from;
+        NodeID to;
+        UnpackingCache::Key unpacked_shortcut;
+        std::size_t unpacked_begin;
+    };
+    const constexpr auto NOT_UNPACKED = std::numeric_limits<UnpackingCache::Key>::max();
+
+    std::stack<UnpackingFrame> recursion_stack;
 
     // We have to push the path in reverse order onto the stack because it's LIFO.
     for (auto current = std::prev(packed_path_end); current != packed_path_begin;
          current = std::prev(current))
     {
-        recursion_stack.emplace(*std::prev(current), *current);
+        recursion_stack.push({*std::prev(current), *current, NOT_UNPACKED, 0});
     }
 
+    // all original edges found so far, the unpacked shortcuts are ranges of it
+    UnpackingCache::UnpackedEdges unpacked_edges;
+
     std::pair<NodeID, NodeID> edge;
     while (!recursion_stack.empty())
     {
-        edge = recursion_stack.top();
+        const auto frame = recursion_stack.top();
         recursion_stack.pop();
 
+        if (frame.unpacked_shortcut != NOT_UNPACKED)
+        {
+            if (unpacked_edges.size() - frame.unpacked_begin >= MIN_CACHED_UNPACKED_EDGES)
+            {
+                unpacking_cache.Insert(
+                    frame.unpacked_shortcut,
+                    {unpacked_edges.begin() + frame.unpacked_begin, unpacked_edges.end()});
+            }
+            continue;
+        }
+
+        edge = {frame.from, frame.to};
+
         // Look for an edge on the forward CH graph (.forward)
         EdgeID smaller_edge_id = facade.FindSmallestEdge(
             edge.first, edge.second, [](const auto &data) { return data.forward; });
+        bool reversed = false;
 
         // If we didn't find one there, the we might be looking at a part of the path that
         // was found using the backward search.  Here, we flip the node order (.second, .first)
@@ -267,6 +308,7 @@ void unpackPath(const DataFacade<Algorithm> &facade,
         {
             smaller_edge_id = facade.FindSmallestEdge(
                 edge.second, edge.first, [](const auto &data) { return data.backward; });
+            reversed = true;
         }
 
         // If we didn't find anything *still*, then something is broken and someone has
@@ -279,17 +321,33 @@ void unpackPath(const DataFacade<Algorithm> &facade,
 
         // If the edge is a shortcut, we need to add the two halfs to the stack.
         if (data.shortcut)
-        { // unpack
+        {
+            const auto key = UnpackingCache::MakeKey(smaller_edge_id, reversed);
+            if (const auto cached_edges = unpacking_cache.Find(key))
+            {
+                for (const auto &cached_edge : *cached_edges)
+                {
+                    edge.second = cached_edge.first;
+                    std::forward<Callback>(callback)(edge, cached_edge.second);
+                    unpacked_edges.push_back(cached_edge);
+                    edge.first = cached_edge.first;
+                }
+                continue;
+            }
+
+            // unpack
             const NodeID middle_node_id = data.turn_id;
             // Note the order here - we're adding these to a stack, so we
             // want the first->middle to get visited before middle->second
-            recursion_stack.emplace(middle_node_id, edge.second);
-            recursion_stack.emplace(edge.first, middle_node_id);
+            recursion_stack.push({edge.first, edge.second, key, unpacked_edges.size()});
+            recursion_stack.push({middle_node_id, edge.second, NOT_UNPACKED, 0});
+            recursion_stack.push({edge.first, middle_node_id, NOT_UNPACKED, 0});
         }
         else
         {
             // We found an original edge, call our callback.
             std::forward<Callback>(callback)(edge, smaller_edge_id);
+            unpacked_edges.emplace_back(edge.second, smaller_edge_id);
         }
     }
 }
@@ -3,6 +3,7 @@
 
 #include "engine/algorithm.hpp"
 #include "engine/datafacade.hpp"
+#include "engine/routing_algorithms/landmark_potential.hpp"
 #include "engine/routing_algorithms/routing_base.hpp"
 #include "engine/search_engine_data.hpp"
 
@@ -225,10 +226,22 @@ retrievePackedPathFromHeap(const SearchEngineData<Algorithm>::QueryHeap &forward
     return packed_path;
 }
 
-template <bool DIRECTION, typename Algorithm, typename... Args>
+// The backward search uses the negated potential of the forward search
+template <bool DIRECTION, typename Potential>
+inline EdgeWeight getPotential(const Potential &potential, const NodeID node)
+{
+    const auto value = potential(node);
+    return (DIRECTION == FORWARD_DIRECTION || value == INVALID_EDGE_WEIGHT) ? value : -value;
+}
+
+// Heap keys are the weights plus the potential of the node, nodes without a valid potential
+// can't be on a path between the phantom nodes and are never inserted. The potential of an
+// inserted node is kept in its heap data, so it is evaluated once per node and search.
+template <bool DIRECTION, typename Algorithm, typename Potential, typename... Args>
 void relaxOutgoingEdges(const DataFacade<Algorithm> &facade,
                         typename SearchEngineData<Algorithm>::QueryHeap &forward_heap,
                         const typename SearchEngineData<Algorithm>::QueryHeap::HeapNode &heapNode,
+                        const Potential &potential,
                         Args... args)
 {
     const auto &partition = facade.GetMultiLevelPartition();
@@ -236,6 +249,29 @@ void relaxOutgoingEdges(const DataFacade<Algorithm> &facade,
     const auto &metric = facade.GetCellMetric();
 
     const auto level = getNodeQueryLevel(partition, heapNode.node, args...);
+    BOOST_ASSERT(heapNode.data.potential == getPotential<DIRECTION>(potential, heapNode.node));
+    const auto weight = heapNode.weight - heapNode.data.potential;
+
+    const auto relax = [&](const NodeID to, const EdgeWeight to_weight, const bool from_clique) {
+        const auto toHeapNode = forward_heap.GetHeapNodeIfWasInserted(to);
+        const auto to_potential =
+            toHeapNode ? toHeapNode->data.potential : getPotential<DIRECTION>(potential, to);
+        if (to_potential == INVALID_EDGE_WEIGHT)
+            return;
+
+        const EdgeWeight to_key = to_weight + to_potential;
+        BOOST_ASSERT(to_key >= heapNode.weight);
+        if (!toHeapNode)
+        {
+            forward_heap.Insert(to, to_key, {heapNode.node, from_clique, to_potential});
+        }
+        else if (to_key < toHeapNode->weight)
+        {
+            toHeapNode->data = {heapNode.node, from_clique, to_potential};
+            toHeapNode->weight = to_key;
+            forward_heap.DecreaseKey(*toHeapNode);
+        }
+    };
 
     if (level >= 1 && !heapNode.data.from_clique_arc)
     {
@@ -252,19 +288,7 @@ void relaxOutgoingEdges(const DataFacade<Algorithm> &facade,
 
                 if (shortcut_weight != INVALID_EDGE_WEIGHT && heapNode.node != to)
                 {
-                    const EdgeWeight to_weight = heapNode.weight + shortcut_weight;
-                    BOOST_ASSERT(to_weight >= heapNode.weight);
-                    const auto toHeapNode = forward_heap.GetHeapNodeIfWasInserted(to);
-                    if (!toHeapNode)
-                    {
-                        forward_heap.Insert(to, to_weight, {heapNode.node, true});
-                    }
-                    else if (to_weight < toHeapNode->weight)
-                    {
-                        toHeapNode->data = {heapNode.node, true};
-                        toHeapNode->weight = to_weight;
-                        forward_heap.DecreaseKey(*toHeapNode);
-                    }
+                    relax(to, weight + shortcut_weight, true);
                 }
                 ++destination;
             }
@@ -282,19 +306,7 @@ void relaxOutgoingEdges(const DataFacade<Algorithm> &facade,
 
                 if (shortcut_weight != INVALID_EDGE_WEIGHT && heapNode.node != to)
                 {
-                    const EdgeWeight to_weight = heapNode.weight + shortcut_weight;
-                    BOOST_ASSERT(to_weight >= heapNode.weight);
-                    const auto toHeapNode = forward_heap.GetHeapNodeIfWasInserted(to);
-                    if (!toHeapNode)
-                    {
-                        forward_heap.Insert(to, to_weight, {heapNode.node, true});
-                    }
-                    else if (to_weight < toHeapNode->weight)
-                    {
-                        toHeapNode->data = {heapNode.node, true};
-                        toHeapNode->weight = to_weight;
-                        forward_heap.DecreaseKey(*toHeapNode);
-                    }
+                    relax(to, weight + shortcut_weight, true);
                 }
                 ++source;
             }
@@ -320,25 +332,13 @@ void relaxOutgoingEdges(const DataFacade<Algorithm> &facade,
 
                 // TODO: BOOST_ASSERT(edge_data.weight == node_weight + turn_penalty);
 
-                const EdgeWeight to_weight = heapNode.weight + node_weight + turn_penalty;
-
-                const auto toHeapNode = forward_heap.GetHeapNodeIfWasInserted(to);
-                if (!toHeapNode)
-                {
-                    forward_heap.Insert(to, to_weight, {heapNode.node, false});
-                }
-                else if (to_weight < toHeapNode->weight)
-                {
-                    toHeapNode->data = {heapNode.node, false};
-                    toHeapNode->weight = to_weight;
-                    forward_heap.DecreaseKey(*toHeapNode);
-                }
+                relax(to, weight + node_weight + turn_penalty, false);
             }
         }
     }
 }
 
-template <bool DIRECTION, typename Algorithm, typename... Args>
+template <bool DIRECTION, typename Algorithm, typename Potential, typename... Args>
 void routingStep(const DataFacade<Algorithm> &facade,
                  typename SearchEngineData<Algorithm>::QueryHeap &forward_heap,
                  typename SearchEngineData<Algorithm>::QueryHeap &reverse_heap,
@@ -346,6 +346,7 @@ void routingStep(const DataFacade<Algorithm> &facade,
                  EdgeWeight &path_upper_bound,
                  const bool force_loop_forward,
                  const bool force_loop_reverse,
+                 const Potential &potential,
                  Args... args)
 {
     const auto heapNode = forward_heap.DeleteMinGetHeapNode();
@@ -376,7 +377,7 @@ void routingStep(const DataFacade<Algorithm> &facade,
     }
 
     // Relax outgoing edges from node
-    relaxOutgoingEdges<DIRECTION>(facade, forward_heap, heapNode, args...);
+    relaxOutgoingEdges<DIRECTION>(facade, forward_heap, heapNode, potential, args...);
 }
 
 // With (s, middle, t) we trace back the paths middle -> s and middle -> t.
@@ -396,7 +397,20 @@ UnpackedPath search(SearchEngineData<Algorithm> &engine_working_data,
                     const bool force_loop_forward,
                     const bool force_loop_reverse,
                     EdgeWeight weight_upper_bound,
-                    Args... args)
+                    Args... args);
+
+// Same as search, but the heap keys include the potential. The keys of the nodes already in
+// the heaps must include it as well.
+template <typename Algorithm, typename Potential, typename... Args>
+UnpackedPath searchWithPotential(SearchEngineData<Algorithm> &engine_working_data,
+                                 const DataFacade<Algorithm> &facade,
+                                 typename SearchEngineData<Algorithm>::QueryHeap &forward_heap,
+                                 typename SearchEngineData<Algorithm>::QueryHeap &reverse_heap,
+                                 const bool force_loop_forward,
+                                 const bool force_loop_reverse,
+                                 EdgeWeight weight_upper_bound,
+                                 const Potential &potential,
+                                 Args... args)
 {
     if (forward_heap.Empty() || reverse_heap.Empty())
     {
@@ -425,6 +439,7 @@ UnpackedPath search(SearchEngineData<Algorithm> &engine_working_data,
                                            weight,
                                            force_loop_forward,
                                            force_loop_reverse,
+                                           potential,
                                            args...);
             if (!forward_heap.Empty())
                 forward_heap_min = forward_heap.MinKey();
@@ -438,6 +453,7 @@ UnpackedPath search(SearchEngineData<Algorithm> &engine_working_data,
                                            weight,
                                            force_loop_reverse,
                                            force_loop_forward,
+                                           potential,
                                            args...);
             if (!reverse_heap.Empty())
                 reverse_heap_min = reverse_heap.MinKey();
@@ -516,6 +532,134 @@ UnpackedPath search(SearchEngineData<Algorithm> &engine_working_data,
     return std::make_tuple(weight, std::move(unpacked_nodes), std::move(unpacked_edges));
 }
 
+template <typename Algorithm, typename... Args>
+UnpackedPath search(SearchEngineData<Algorithm> &engine_working_data,
+                    const DataFacade<Algorithm> &facade,
+                    typename SearchEngineData<Algorithm>::QueryHeap &forward_heap,
+                    typename SearchEngineData<Algorithm>::QueryHeap &reverse_heap,
+                    const bool force_loop_forward,
+                    const bool force_loop_reverse,
+                    EdgeWeight weight_upper_bound,
+                    Args... args)
+{
+    return searchWithPotential(engine_working_data,
+                               facade,
+                               forward_heap,
+                               reverse_heap,
+                               force_loop_forward,
+                               force_loop_reverse,
+                               weight_upper_bound,
+                               ZeroPotential{},
+                               args...);
+}
+
+// Search between the phantom nodes that were inserted into the heaps before
+template <typename Algorithm>
+UnpackedPath pointToPointSearch(SearchEngineData<Algorithm> &engine_working_data,
+                                const DataFacade<Algorithm> &facade,
+                                typename SearchEngineData<Algorithm>::QueryHeap &forward_heap,
+                                typename SearchEngineData<Algorithm>::QueryHeap &reverse_heap,
+                                const bool force_loop_forward,
+                                const bool force_loop_reverse,
+                                const EdgeWeight weight_upper_bound,
+                                const PhantomNodes &phantom_nodes)
+{
+    return search(engine_working_data,
+                  facade,
+                  forward_heap,
+                  reverse_heap,
+                  force_loop_forward,
+                  force_loop_reverse,
+                  weight_upper_bound,
+                  phantom_nodes);
+}
+
+// Datasets customized with landmarks are searched with A*. The phantom nodes in the heaps are
+// inserted again with the potential added to their keys and stored in their data.
+inline UnpackedPath pointToPointSearch(SearchEngineData<Algorithm> &engine_working_data,
+                                       const DataFacade<Algorithm> &facade,
+                                       SearchEngineData<Algorithm>::QueryHeap &forward_heap,
+                                       SearchEngineData<Algorithm>::QueryHeap &reverse_heap,
+                                       const bool force_loop_forward,
+                                       const bool force_loop_reverse,
+                                       const EdgeWeight weight_upper_bound,
+                                       const PhantomNodes &phantom_nodes)
+{
+    const auto &landmarks = facade.GetLandmarks();
+    if (landmarks.Empty() || forward_heap.Empty() || reverse_heap.Empty())
+    {
+        return search(engine_working_data,
+                      facade,
+                      forward_heap,
+                      reverse_heap,
+                      force_loop_forward,
+                      force_loop_reverse,
+                      weight_upper_bound,
+                      phantom_nodes);
+    }
+
+    using QueryHeap = SearchEngineData<Algorithm>::QueryHeap;
+    struct Seed
+    {
+        NodeID node;
+        EdgeWeight weight;
+        QueryHeap::DataType data;
+    };
+    const auto collect_seeds = [](const QueryHeap &heap, const PhantomNode &phantom) {
+        std::vector<Seed> seeds;
+        for (const auto &segment : {phantom.forward_segment_id, phantom.reverse_segment_id})
+        {
+            if (segment.enabled && heap.WasInserted(segment.id))
+                seeds.push_back({segment.id, heap.GetKey(segment.id), heap.GetData(segment.id)});
+        }
+        return seeds;
+    };
+    const auto forward_seeds = collect_seeds(forward_heap, phantom_nodes.source_phantom);
+    const auto reverse_seeds = collect_seeds(reverse_heap, phantom_nodes.target_phantom);
+    BOOST_ASSERT(forward_seeds.size() == forward_heap.Size());
+    BOOST_ASSERT(reverse_seeds.size() == reverse_heap.Size());
+
+    LandmarkPotential<customizer::LandmarksView> potential(landmarks);
+    for (const auto &seed : forward_seeds)
+        potential.AddSource(seed.node, seed.weight);
+    for (const auto &seed : reverse_seeds)
+        potential.AddTarget(seed.node, seed.weight);
+
+    forward_heap.Clear();
+    for (const auto &seed : forward_seeds)
+    {
+        const auto seed_potential = getPotential<FORWARD_DIRECTION>(potential, seed.node);
+        if (seed_potential != INVALID_EDGE_WEIGHT)
+            forward_heap.Insert(seed.node,
+                                seed.weight + seed_potential,
+                                {seed.data.parent, seed.data.from_clique_arc, seed_potential});
+    }
+    reverse_heap.Clear();
+    for (const auto &seed : reverse_seeds)
+    {
+        const auto seed_potential = getPotential<REVERSE_DIRECTION>(potential, seed.node);
+        if (seed_potential != INVALID_EDGE_WEIGHT)
+            reverse_heap.Insert(seed.node,
+                                seed.weight + seed_potential,
+                                {seed.data.parent, seed.data.from_clique_arc, seed_potential});
+    }
+
+    if (forward_heap.Empty() || reverse_heap.Empty())
+    {
+        return std::make_tuple(INVALID_EDGE_WEIGHT, std::vector<NodeID>(), std::vector<EdgeID>());
+    }
+
+    return searchWithPotential(engine_working_data,
+                               facade,
+                               forward_heap,
+                               reverse_heap,
+                               force_loop_forward,
+                               force_loop_reverse,
+                               weight_upper_bound,
+                               potential,
+                               phantom_nodes);
+}
+
 // Alias to be compatible with the CH-based search
 template <typename Algorithm>
 inline void search(SearchEngineData<Algorithm> &engine_working_data,
@@ -530,14 +674,14 @@ inline void search(SearchEngineData<Algorithm> &engine_working_data,
                    const EdgeWeight weight_upper_bound = INVALID_EDGE_WEIGHT)
 {
     // TODO: change search calling interface to use unpacked_edges result
-    std::tie(weight, unpacked_nodes, std::ignore) = search(engine_working_data,
-                                                           facade,
-                                                           forward_heap,
-                                                           reverse_heap,
-                                                           force_loop_forward,
-                                                           force_loop_reverse,
-                                                           weight_upper_bound,
-                                                           phantom_nodes);
+    std::tie(weight, unpacked_nodes, std::ignore) = pointToPointSearch(engine_working_data,
+                                                                       facade,
+                                                                       forward_heap,
+                                                                       reverse_heap,
+                                                                       force_loop_forward,
+                                                                       force_loop_reverse,
+                                                                       weight_upper_bound,
+                                                                       phantom_nodes);
 }
 
 // TODO: refactor CH-related stub to use unpacked_edges
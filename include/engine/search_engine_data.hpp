@@ -37,16 +37,22 @@ struct ManyToManyHeapData : HeapData
     }
 };
 
+// The heap policies and index storages are compared by heap-bench. Dense index storages are
+// faster but need memory for all nodes in every heap of every thread. The radix heap needs
+// monotone weights, which not all searches guarantee.
+
 template <> struct SearchEngineData<routing_algorithms::ch::Algorithm>
 {
-    using QueryHeap = util::
-        QueryHeap<NodeID, NodeID, EdgeWeight, HeapData, util::UnorderedMapStorage<NodeID, int>>;
+    // CH searches settle few nodes of large graphs: a dense storage halves the heap time on a
+    // contracted grid but takes 6 bytes per node in each of the seven heaps of every thread
+    using HeapPolicy = util::DAryHeapPolicy<4>;
+    using IndexStorage = util::UnorderedMapStorage<NodeID, int>;
 
-    using ManyToManyQueryHeap = util::QueryHeap<NodeID,
-                                                NodeID,
-                                                EdgeWeight,
-                                                ManyToManyHeapData,
-                                                util::UnorderedMapStorage<NodeID, int>>;
+    using QueryHeap =
+        util::QueryHeap<NodeID, NodeID, EdgeWeight, HeapData, IndexStorage, HeapPolicy>;
+
+    using ManyToManyQueryHeap =
+        util::QueryHeap<NodeID, NodeID, EdgeWeight, ManyToManyHeapData, IndexStorage, HeapPolicy>;
 
     using SearchEngineHeapPtr = boost::thread_specific_ptr<QueryHeap>;
     using ManyToManyHeapPtr = boost::thread_specific_ptr<ManyToManyQueryHeap>;
@@ -72,8 +78,17 @@ struct MultiLayerDijkstraHeapData
 {
     NodeID parent;
     bool from_clique_arc;
-    MultiLayerDijkstraHeapData(NodeID p) : parent(p), from_clique_arc(false) {}
-    MultiLayerDijkstraHeapData(NodeID p, bool from) : parent(p), from_clique_arc(from) {}
+    // A* potential of the node in the direction of the heap, evaluated once per query
+    EdgeWeight potential;
+    MultiLayerDijkstraHeapData(NodeID p) : parent(p), from_clique_arc(false), potential(0) {}
+    MultiLayerDijkstraHeapData(NodeID p, bool from)
+        : parent(p), from_clique_arc(from), potential(0)
+    {
+    }
+    MultiLayerDijkstraHeapData(NodeID p, bool from, EdgeWeight potential)
+        : parent(p), from_clique_arc(from), potential(potential)
+    {
+    }
 };
 
 struct ManyToManyMultiLayerDijkstraHeapData : MultiLayerDijkstraHeapData
@@ -95,17 +110,22 @@ struct ManyToManyMultiLayerDijkstraHeapData : MultiLayerDijkstraHeapData
 
 template <> struct SearchEngineData<routing_algorithms::mld::Algorithm>
 {
+    using HeapPolicy = util::DAryHeapPolicy<4>;
+    using IndexStorage = util::TwoLevelStorage<NodeID, int>;
+
     using QueryHeap = util::QueryHeap<NodeID,
                                       NodeID,
                                       EdgeWeight,
                                       MultiLayerDijkstraHeapData,
-                                      util::TwoLevelStorage<NodeID, int>>;
+                                      IndexStorage,
+                                      HeapPolicy>;
 
     using ManyToManyQueryHeap = util::QueryHeap<NodeID,
                                                 NodeID,
                                                 EdgeWeight,
                                                 ManyToManyMultiLayerDijkstraHeapData,
-                                                util::TwoLevelStorage<NodeID, int>>;
+                                                IndexStorage,
+                                                HeapPolicy>;
 
     using SearchEngineHeapPtr = boost::thread_specific_ptr<QueryHeap>;
     using ManyToManyHeapPtr = boost::thread_specific_ptr<ManyToManyQueryHeap>;
@@ -0,0 +1,79 @@
+#ifndef OSRM_ENGINE_SNAPPING_CACHE_HPP
+#define OSRM_ENGINE_SNAPPING_CACHE_HPP
+
+#include "engine/approach.hpp"
+#include "engine/bearing.hpp"
+#include "engine/phantom_node.hpp"
+
+#include "util/coordinate.hpp"
+#include "util/sharded_clock_cache.hpp"
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace osrm
+{
+namespace engine
+{
+
+// Bounded cache of the phantom nodes that coordinates of requests were snapped to.
+//
+// Requests often reuse the same coordinates, e.g. depots or customer addresses, that are snapped
+// again on every request if clients don't keep their hints. The cache is shared by all threads
+// querying the same dataset and exclude class and is dropped together with the facade when a new
+// dataset is loaded.
+class SnappingCache
+{
+  public:
+    // Everything the snapped phantom nodes depend on. Input coordinates are fixed point already,
+    // so equal coordinates snap to exactly the same phantom nodes.
+    struct Key
+    {
+        util::Coordinate coordinate;
+        boost::optional<Bearing> bearing;
+        boost::optional<double> radius;
+        Approach approach;
+        bool use_all_edges;
+
+        bool operator==(const Key &other) const
+        {
+            return coordinate == other.coordinate && bearing == other.bearing &&
+                   radius == other.radius && approach == other.approach &&
+                   use_all_edges == other.use_all_edges;
+        }
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(const Key &key) const;
+    };
+
+    // Approximate memory used by an entry and its node and bucket in the hash map
+    static constexpr std::size_t ENTRY_SIZE =
+        sizeof(Key) + sizeof(PhantomNodePair) + sizeof(Key) + 4 * sizeof(void *);
+
+    // Keeps as many entries as fit into the given number of bytes, 0 disables the cache
+    explicit SnappingCache(const std::size_t byte_budget);
+
+    boost::optional<PhantomNodePair> Find(const Key &key) { return cache.Find(key); }
+
+    void Insert(const Key &key, const PhantomNodePair &phantom_nodes)
+    {
+        cache.Insert(key, phantom_nodes);
+    }
+
+    std::size_t GetCapacity() const { return cache.GetCapacity(); }
+    std::size_t GetSize() const { return cache.GetSize(); }
+    std::size_t GetByteSize() const { return GetSize() * ENTRY_SIZE; }
+    std::uint64_t GetHits() const { return cache.GetHits(); }
+    std::uint64_t GetMisses() const { return cache.GetMisses(); }
+
+  private:
+    util::ShardedClockCache<Key, PhantomNodePair, KeyHash> cache;
+};
+} // namespace engine
+} // namespace osrm
+
+#endif
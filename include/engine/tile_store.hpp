@@ -0,0 +1,92 @@
+#ifndef OSRM_ENGINE_TILE_STORE_HPP
+#define OSRM_ENGINE_TILE_STORE_HPP
+
+#include "storage/tar.hpp"
+
+#include "util/string_view.hpp"
+#include "util/vector_view.hpp"
+
+#include <boost/filesystem/path.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/optional.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+
+// Vector tiles baked by osrm-tiles, stored in a single tar file with the entries
+//
+//   /tiles/data                   encoded tiles back to back
+//   /tiles/keys                   sorted keys of the tiles, see GetTileKey
+//   /tiles/offsets                offset of every tile in /tiles/data and the end of the last one
+//   /tiles/connectivity_checksum  checksum of the dataset the tiles were baked from
+//   /tiles/metric_checksum        checksum of its metric, see getMetricChecksum
+//
+// The tiles are only valid for the dataset and the metric they were baked from, both checksums
+// are compared to the ones of the data facade before a tile is served.
+inline std::uint64_t GetTileKey(const unsigned x, const unsigned y, const unsigned z)
+{
+    // zoom levels are below 32, so x and y have less than 28 bits
+    return (static_cast<std::uint64_t>(z) << 56) | (static_cast<std::uint64_t>(x) << 28) | y;
+}
+
+// Read access to a memory mapped tile store
+class TileStore
+{
+  public:
+    explicit TileStore(const boost::filesystem::path &path);
+
+    std::uint32_t GetConnectivityChecksum() const { return connectivity_checksum; }
+
+    std::uint32_t GetMetricChecksum() const { return metric_checksum; }
+
+    std::size_t GetNumberOfTiles() const { return keys.size(); }
+
+    // Returns the encoded tile, which points into the mapped file, or none if it wasn't baked
+    boost::optional<util::StringView> Find(unsigned x, unsigned y, unsigned z) const;
+
+  private:
+    boost::iostreams::mapped_file_source region;
+    std::uint32_t connectivity_checksum;
+    std::uint32_t metric_checksum;
+    util::vector_view<const std::uint64_t> keys;
+    util::vector_view<const std::uint64_t> offsets;
+    const char *data;
+};
+
+// Writes a tile store incrementally, tiles need to be appended in ascending key order
+class TileStoreWriter
+{
+  public:
+    TileStoreWriter(const boost::filesystem::path &path,
+                    std::uint32_t connectivity_checksum,
+                    std::uint32_t metric_checksum);
+
+    void Append(unsigned x, unsigned y, unsigned z, const std::string &tile);
+
+    // Writes the remaining tiles and the index, no tiles can be appended afterwards
+    void Finish();
+
+    std::size_t GetNumberOfTiles() const { return keys.size(); }
+
+  private:
+    void Flush();
+
+    std::unique_ptr<storage::tar::FileWriter> writer;
+    const std::uint32_t connectivity_checksum;
+    const std::uint32_t metric_checksum;
+    std::vector<std::uint64_t> keys;
+    std::vector<std::uint64_t> offsets;
+    // tiles that were not written yet
+    std::string pending;
+};
+} // namespace engine
+} // namespace osrm
+
+#endif
@@ -0,0 +1,349 @@
+#ifndef TRIP_LOCAL_SEARCH_HPP
+#define TRIP_LOCAL_SEARCH_HPP
+
+#include "engine/trip/trip_farthest_insertion.hpp"
+#include "util/dist_table_wrapper.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace trip
+{
+
+// Round trips are improved with 2-opt and Or-opt moves. The weight table does not need to be
+// symmetric: reversing a part of the trip accounts for the weights in the other direction.
+//
+// The weights of one move against all positions in the trip are gathered into contiguous
+// arrays first, the loops computing the changes over them have no branches and are vectorized
+// by the compiler.
+
+using TripDeadline = std::chrono::steady_clock::time_point;
+
+// Number of farthest insertion trips that are improved independently
+const constexpr std::size_t NUMBER_OF_TRIP_STARTS = 16;
+// Longest part of the trip that an Or-opt move relocates
+const constexpr std::size_t MAX_OR_OPT_SEGMENT_LENGTH = 3;
+
+namespace detail
+{
+// Weight of the trip in tour order with all prefix sums needed to evaluate moves
+class TripWeights
+{
+  public:
+    TripWeights(const util::DistTableWrapper<EdgeWeight> &dist_table,
+                const std::vector<NodeID> &route)
+        : dist_table(dist_table), route(route)
+    {
+        Update();
+    }
+
+    void Update()
+    {
+        const auto size = route.size();
+        forward.resize(size);
+        forward_sum.resize(size + 1);
+        backward_sum.resize(size + 1);
+        forward_sum[0] = 0;
+        backward_sum[0] = 0;
+        for (std::size_t position = 0; position < size; ++position)
+        {
+            const auto next = route[(position + 1) % size];
+            forward[position] = dist_table(route[position], next);
+            forward_sum[position + 1] = forward_sum[position] + forward[position];
+            backward_sum[position + 1] =
+                backward_sum[position] + dist_table(next, route[position]);
+        }
+    }
+
+    // weight of the edge from the node at position to the next one
+    std::int64_t GetForward(const std::size_t position) const { return forward[position]; }
+
+    // weight of the edges between the positions first and last in both directions
+    std::int64_t GetForward(const std::size_t first, const std::size_t last) const
+    {
+        return forward_sum[last] - forward_sum[first];
+    }
+    std::int64_t GetBackward(const std::size_t first, const std::size_t last) const
+    {
+        return backward_sum[last] - backward_sum[first];
+    }
+
+    // weights from the node to every node of the trip
+    void GatherFrom(const NodeID node, std::vector<std::int64_t> &weights) const
+    {
+        weights.resize(route.size());
+        for (std::size_t position = 0; position < route.size(); ++position)
+            weights[position] = dist_table(node, route[position]);
+    }
+
+    // weights from every node of the trip to the node
+    void GatherTo(const NodeID node, std::vector<std::int64_t> &weights) const
+    {
+        weights.resize(route.size());
+        for (std::size_t position = 0; position < route.size(); ++position)
+            weights[position] = dist_table(route[position], node);
+    }
+
+  private:
+    const util::DistTableWrapper<EdgeWeight> &dist_table;
+    const std::vector<NodeID> &route;
+    std::vector<std::int64_t> forward;
+    std::vector<std::int64_t> forward_sum;
+    std::vector<std::int64_t> backward_sum;
+};
+
+// Returns the position in [first, last) with the smallest change and the change
+inline std::pair<std::size_t, std::int64_t>
+FindBestMove(const std::vector<std::int64_t> &changes, std::size_t first, std::size_t last)
+{
+    std::pair<std::size_t, std::int64_t> best{first, std::numeric_limits<std::int64_t>::max()};
+    for (auto position = first; position < last; ++position)
+    {
+        if (changes[position] < best.second)
+            best = {position, changes[position]};
+    }
+    return best;
+}
+} // namespace detail
+
+// Reverses the part of the trip between two positions if that makes the trip shorter.
+// Returns true if the trip was changed.
+inline bool TwoOptPass(const util::DistTableWrapper<EdgeWeight> &dist_table,
+                       std::vector<NodeID> &route,
+                       const TripDeadline deadline)
+{
+    const auto size = route.size();
+    if (size < 4)
+        return false;
+
+    detail::TripWeights weights(dist_table, route);
+    std::vector<std::int64_t> from_first, from_second, changes(size);
+    bool improved = false;
+
+    // the part after `first` up to `last` is reversed: the edges (first, first + 1) and
+    // (last, last + 1) are replaced by (first, last) and (first + 1, last + 1)
+    for (std::size_t first = 0; first + 2 < size; ++first)
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+            break;
+
+        const auto second = first + 1;
+        weights.GatherFrom(route[first], from_first);
+        weights.GatherFrom(route[second], from_second);
+        const auto removed = weights.GetForward(first);
+
+        for (std::size_t last = second + 1; last < size; ++last)
+        {
+            const auto after_last = (last + 1) % size;
+            changes[last] = from_first[last] + from_second[after_last] - removed -
+                            weights.GetForward(last) + weights.GetBackward(second, last) -
+                            weights.GetForward(second, last);
+        }
+
+        // last == second would not change anything
+        const auto best = detail::FindBestMove(changes, second + 1, size);
+        if (best.second < 0)
+        {
+            std::reverse(route.begin() + second, route.begin() + best.first + 1);
+            weights.Update();
+            improved = true;
+        }
+    }
+
+    return improved;
+}
+
+// Moves a part of up to MAX_OR_OPT_SEGMENT_LENGTH nodes to a different place in the trip, in the
+// same or in the reverse order, if that makes the trip shorter.
+// Returns true if the trip was changed.
+inline bool OrOptPass(const util::DistTableWrapper<EdgeWeight> &dist_table,
+                      std::vector<NodeID> &route,
+                      const TripDeadline deadline)
+{
+    const auto size = route.size();
+    if (size < 4)
+        return false;
+
+    detail::TripWeights weights(dist_table, route);
+    std::vector<std::int64_t> to_first, from_last, to_last, from_first;
+    std::vector<std::int64_t> changes(size), reversed_changes(size);
+    bool improved = false;
+
+    for (std::size_t length = 1; length <= MAX_OR_OPT_SEGMENT_LENGTH && length + 2 < size;
+         ++length)
+    {
+        // the node at position 0 stays in place, the segment starts at begin
+        for (std::size_t begin = 1; begin + length <= size; ++begin)
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+                return improved;
+
+            const auto end = begin + length;
+            const auto first = route[begin];
+            const auto last = route[end - 1];
+            const auto before = route[begin - 1];
+            const auto after = route[end % size];
+
+            const std::int64_t removal_gain = weights.GetForward(begin - 1) +
+                                              weights.GetForward(end - 1) -
+                                              dist_table(before, after);
+            const std::int64_t reversal_change =
+                weights.GetBackward(begin, end - 1) - weights.GetForward(begin, end - 1);
+
+            weights.GatherTo(first, to_first);
+            weights.GatherFrom(last, from_last);
+            weights.GatherTo(last, to_last);
+            weights.GatherFrom(first, from_first);
+
+            // insert between the node at position and the next one
+            for (std::size_t position = 0; position < size; ++position)
+            {
+                const auto next = (position + 1) % size;
+                changes[position] =
+                    to_first[position] + from_last[next] - weights.GetForward(position);
+                reversed_changes[position] = to_last[position] + from_first[next] -
+                                             weights.GetForward(position) + reversal_change;
+            }
+
+            // the segment can't go between any of its own nodes or its neighbours
+            auto best = detail::FindBestMove(changes, 0, begin - 1);
+            auto best_after = detail::FindBestMove(changes, end, size);
+            auto reversed_best = detail::FindBestMove(reversed_changes, 0, begin - 1);
+            auto reversed_best_after = detail::FindBestMove(reversed_changes, end, size);
+            bool reverse = false;
+            if (best_after.second < best.second)
+                best = best_after;
+            if (reversed_best_after.second < reversed_best.second)
+                reversed_best = reversed_best_after;
+            if (reversed_best.second < best.second)
+            {
+                best = reversed_best;
+                reverse = true;
+            }
+
+            if (best.second == std::numeric_limits<std::int64_t>::max() ||
+                best.second - removal_gain >= 0)
+                continue;
+
+            std::vector<NodeID> segment(route.begin() + begin, route.begin() + end);
+            if (reverse)
+                std::reverse(segment.begin(), segment.end());
+
+            std::vector<NodeID> moved;
+            moved.reserve(size);
+            for (std::size_t position = 0; position < size; ++position)
+            {
+                if (position >= begin && position < end)
+                    continue;
+                moved.push_back(route[position]);
+                if (position == best.first)
+                    moved.insert(moved.end(), segment.begin(), segment.end());
+            }
+            BOOST_ASSERT(moved.size() == size);
+            route = std::move(moved);
+            weights.Update();
+            improved = true;
+        }
+    }
+
+    return improved;
+}
+
+// Applies 2-opt and Or-opt passes until neither improves the trip or the deadline is reached
+inline void ImproveTrip(const util::DistTableWrapper<EdgeWeight> &dist_table,
+                        std::vector<NodeID> &route,
+                        const TripDeadline deadline)
+{
+    bool improved = true;
+    while (improved && std::chrono::steady_clock::now() <= deadline)
+    {
+        improved = TwoOptPass(dist_table, route, deadline);
+        improved = OrOptPass(dist_table, route, deadline) || improved;
+    }
+}
+
+inline std::int64_t GetTripWeight(const util::DistTableWrapper<EdgeWeight> &dist_table,
+                                  const std::vector<NodeID> &route)
+{
+    std::int64_t weight = 0;
+    for (std::size_t position = 0; position < route.size(); ++position)
+        weight += dist_table(route[position], route[(position + 1) % route.size()]);
+    return weight;
+}
+
+// Builds farthest insertion trips from several pairs of start locations and improves each
+// with local search, in parallel. Starts that did not begin before the deadline are skipped,
+// the first one is always computed.
+inline std::vector<NodeID> LocalSearchTrip(const std::size_t number_of_locations,
+                                           const util::DistTableWrapper<EdgeWeight> &dist_table,
+                                           const TripDeadline deadline)
+{
+    BOOST_ASSERT(number_of_locations > 0);
+    BOOST_ASSERT_MSG(number_of_locations * number_of_locations == dist_table.size(),
+                     "number_of_locations and dist_table size do not match");
+
+    const auto number_of_starts = std::min(NUMBER_OF_TRIP_STARTS, number_of_locations);
+    std::vector<std::vector<NodeID>> trips(number_of_starts);
+    std::vector<std::int64_t> trip_weights(number_of_starts,
+                                           std::numeric_limits<std::int64_t>::max());
+
+    tbb::parallel_for(
+        tbb::blocked_range<std::size_t>(0, number_of_starts, 1),
+        [&](const tbb::blocked_range<std::size_t> &range) {
+            for (auto start = range.begin(); start != range.end(); ++start)
+            {
+                if (start > 0 && std::chrono::steady_clock::now() > deadline)
+                    continue;
+
+                std::vector<NodeID> trip;
+                if (start == 0)
+                {
+                    trip = FarthestInsertionTrip(number_of_locations, dist_table);
+                }
+                else
+                {
+                    // the other starts begin at a location and the one farthest away from it
+                    const NodeID first = start * number_of_locations / number_of_starts;
+                    NodeID second = first == 0 ? 1 : 0;
+                    for (NodeID location = 0; location < number_of_locations; ++location)
+                    {
+                        const auto weight = dist_table(first, location);
+                        if (location != first && weight != INVALID_EDGE_WEIGHT &&
+                            weight > dist_table(first, second))
+                            second = location;
+                    }
+                    trip = FindRoute(number_of_locations, dist_table, first, second);
+                }
+
+                ImproveTrip(dist_table, trip, deadline);
+                trip_weights[start] = GetTripWeight(dist_table, trip);
+                trips[start] = std::move(trip);
+            }
+        });
+
+    // ties go to the earlier start to keep the result independent of the scheduling
+    const auto best = std::min_element(trip_weights.begin(), trip_weights.end());
+    return std::move(trips[std::distance(trip_weights.begin(), best)]);
+}
+
+} // namespace trip
+} // namespace engine
+} // namespace osrm
+
+#endif // TRIP_LOCAL_SEARCH_HPP
@@ -0,0 +1,58 @@
+#ifndef OSRM_ENGINE_UNPACKING_CACHE_HPP
+#define OSRM_ENGINE_UNPACKING_CACHE_HPP
+
+#include "util/sharded_clock_cache.hpp"
+#include "util/typedefs.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+
+// Bounded cache of the original edges that CH shortcuts unpack to, shared by all threads
+// querying the same dataset and exclude class.
+class UnpackingCache
+{
+  public:
+    // A shortcut is unpacked in the direction it was used in. The key is the edge id of the
+    // shortcut and whether it was found on the backward edges, i.e. the nodes are flipped.
+    using Key = std::uint64_t;
+    // Original edges in path order as the node they lead to and their edge id.
+    // The first edge starts at the start node of the shortcut.
+    using UnpackedEdges = std::vector<std::pair<NodeID, EdgeID>>;
+    using UnpackedEdgesPtr = std::shared_ptr<const UnpackedEdges>;
+
+    static Key MakeKey(const EdgeID shortcut, const bool reversed)
+    {
+        return static_cast<Key>(shortcut) << 1 | static_cast<Key>(reversed);
+    }
+
+    explicit UnpackingCache(const std::size_t capacity) : cache(capacity) {}
+
+    // Returns nullptr if the shortcut is not cached
+    UnpackedEdgesPtr Find(const Key key) { return cache.Find(key).value_or(nullptr); }
+
+    void Insert(const Key key, UnpackedEdges edges)
+    {
+        if (cache.GetCapacity() > 0)
+            cache.Insert(key, std::make_shared<const UnpackedEdges>(std::move(edges)));
+    }
+
+    std::size_t GetCapacity() const { return cache.GetCapacity(); }
+    std::size_t GetSize() const { return cache.GetSize(); }
+    std::uint64_t GetHits() const { return cache.GetHits(); }
+    std::uint64_t GetMisses() const { return cache.GetMisses(); }
+
+  private:
+    util::ShardedClockCache<Key, UnpackedEdgesPtr> cache;
+};
+} // namespace engine
+} // namespace osrm
+
+#endif // OSRM_ENGINE_UNPACKING_CACHE_HPP
@@ -8,12 +8,14 @@
 #include "storage/shared_memory_ownership.hpp"
 #include "storage/tar_fwd.hpp"
 
+#include <boost/assert.hpp>
 #include <boost/filesystem/path.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 #include <boost/range/iterator_range.hpp>
 
 #include <unordered_map>
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -59,6 +61,7 @@ template <storage::Ownership Ownership> class SegmentDataContainerImpl
     using SegmentWeightVector = PackedVector<SegmentWeight, SEGMENT_WEIGHT_BITS>;
     using SegmentDurationVector = PackedVector<SegmentDuration, SEGMENT_DURATION_BITS>;
     using SegmentDatasourceVector = Vector<DatasourceID>;
+    using SegmentRankVector = Vector<std::uint8_t>;
 
     SegmentDataContainerImpl() = default;
 
@@ -69,11 +72,13 @@ template <storage::Ownership Ownership> class SegmentDataContainerImpl
                              SegmentDurationVector fwd_durations_,
                              SegmentDurationVector rev_durations_,
                              SegmentDatasourceVector fwd_datasources_,
-                             SegmentDatasourceVector rev_datasources_)
+                             SegmentDatasourceVector rev_datasources_,
+                             SegmentRankVector simplification_ranks_)
         : index(std::move(index_)), nodes(std::move(nodes_)), fwd_weights(std::move(fwd_weights_)),
           rev_weights(std::move(rev_weights_)), fwd_durations(std::move(fwd_durations_)),
           rev_durations(std::move(rev_durations_)), fwd_datasources(std::move(fwd_datasources_)),
-          rev_datasources(std::move(rev_datasources_))
+          rev_datasources(std::move(rev_datasources_)),
+          simplification_ranks(std::move(simplification_ranks_))
     {
     }
 
@@ -199,9 +204,34 @@ template <storage::Ownership Ownership> class SegmentDataContainerImpl
         return boost::adaptors::reverse(boost::make_iterator_range(begin, end));
     }
 
+    // One rank per node of the geometry, see extractor::computeSimplificationRanks. Empty if
+    // the dataset was built without ranks.
+    auto GetForwardSimplificationRanks(const DirectionalGeometryID id) const
+    {
+        if (simplification_ranks.empty())
+            return boost::make_iterator_range(simplification_ranks.cbegin(),
+                                              simplification_ranks.cend());
+
+        const auto begin = simplification_ranks.cbegin() + index[id];
+        const auto end = simplification_ranks.cbegin() + index[id + 1];
+
+        return boost::make_iterator_range(begin, end);
+    }
+
+    auto GetReverseSimplificationRanks(const DirectionalGeometryID id) const
+    {
+        return boost::adaptors::reverse(GetForwardSimplificationRanks(id));
+    }
+
     auto GetNumberOfGeometries() const { return index.size() - 1; }
     auto GetNumberOfSegments() const { return fwd_weights.size(); }
 
+    void SetSimplificationRanks(SegmentRankVector ranks)
+    {
+        BOOST_ASSERT(ranks.size() == nodes.size());
+        simplification_ranks = std::move(ranks);
+    }
+
     friend void
     serialization::read<Ownership>(storage::tar::FileReader &reader,
                                    const std::string &name,
@@ -220,6 +250,7 @@ template <storage::Ownership Ownership> class SegmentDataContainerImpl
     SegmentDurationVector rev_durations;
     SegmentDatasourceVector fwd_datasources;
     SegmentDatasourceVector rev_datasources;
+    SegmentRankVector simplification_ranks;
 };
 } // namespace detail
 
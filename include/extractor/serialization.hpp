@@ -92,6 +92,12 @@ inline void read(storage::tar::FileReader &reader,
         reader, name + "/forward_data_sources", segment_data.fwd_datasources);
     storage::serialization::read(
         reader, name + "/reverse_data_sources", segment_data.rev_datasources);
+    // optional, datasets from before the ranks were precomputed have none
+    if (reader.HasEntry(name + "/simplification_ranks"))
+        storage::serialization::read(
+            reader, name + "/simplification_ranks", segment_data.simplification_ranks);
+    else
+        segment_data.simplification_ranks.clear();
 }
 
 template <storage::Ownership Ownership>
@@ -109,6 +115,8 @@ inline void write(storage::tar::FileWriter &writer,
         writer, name + "/forward_data_sources", segment_data.fwd_datasources);
     storage::serialization::write(
         writer, name + "/reverse_data_sources", segment_data.rev_datasources);
+    storage::serialization::write(
+        writer, name + "/simplification_ranks", segment_data.simplification_ranks);
 }
 
 template <storage::Ownership Ownership>
@@ -0,0 +1,28 @@
+#ifndef OSRM_EXTRACTOR_SIMPLIFICATION_RANKS_HPP_
+#define OSRM_EXTRACTOR_SIMPLIFICATION_RANKS_HPP_
+
+#include "extractor/segment_data_container.hpp"
+#include "util/coordinate.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace osrm
+{
+namespace extractor
+{
+
+// The rank of a coordinate is the lowest zoom level at which engine::douglasPeucker keeps it when
+// simplifying the geometry on its own. The first and last coordinate have rank 0, coordinates
+// that are not needed on any zoom level have rank engine::detail::DOUGLAS_PEUCKER_THRESHOLDS_SIZE.
+// Simplifying a geometry for zoom level z means keeping all coordinates with a rank <= z.
+std::vector<std::uint8_t> computeSimplificationRanks(const std::vector<util::Coordinate> &geometry);
+
+// Ranks of all nodes of all compressed geometries, in the order of the nodes in the segment data
+std::vector<std::uint8_t>
+computeSimplificationRanks(const SegmentDataContainer &segment_data,
+                           const std::vector<util::Coordinate> &coordinates);
+} // namespace extractor
+} // namespace osrm
+
+#endif // OSRM_EXTRACTOR_SIMPLIFICATION_RANKS_HPP_
@@ -1375,6 +1375,64 @@ argumentsToTableParameter(const Nan::FunctionCallbackInfo<v8::Value> &args,
         params->scale_factor = Nan::To<double>(scale_factor).FromJust();
     }
 
+    if (Nan::Has(obj, Nan::New("max_duration").ToLocalChecked()).FromJust())
+    {
+        auto max_duration =
+            Nan::Get(obj, Nan::New("max_duration").ToLocalChecked()).ToLocalChecked();
+
+        if (!max_duration->IsNumber())
+        {
+            Nan::ThrowError("max_duration must be a number");
+            return table_parameters_ptr();
+        }
+        else if (Nan::To<double>(max_duration).FromJust() <= 0)
+        {
+            Nan::ThrowError("max_duration must be > 0");
+            return table_parameters_ptr();
+        }
+
+        params->max_duration = Nan::To<double>(max_duration).FromJust();
+    }
+
+    if (Nan::Has(obj, Nan::New("max_distance").ToLocalChecked()).FromJust())
+    {
+        auto max_distance =
+            Nan::Get(obj, Nan::New("max_distance").ToLocalChecked()).ToLocalChecked();
+
+        if (!max_distance->IsNumber())
+        {
+            Nan::ThrowError("max_distance must be a number");
+            return table_parameters_ptr();
+        }
+        else if (Nan::To<double>(max_distance).FromJust() <= 0)
+        {
+            Nan::ThrowError("max_distance must be > 0");
+            return table_parameters_ptr();
+        }
+
+        params->max_distance = Nan::To<double>(max_distance).FromJust();
+    }
+
+    if (params->fallback_speed != INVALID_FALLBACK_SPEED &&
+        (params->max_duration || params->max_distance))
+    {
+        Nan::ThrowError("fallback_speed can not be combined with max_duration or max_distance");
+        return table_parameters_ptr();
+    }
+
+    if (Nan::Has(obj, Nan::New("sparse").ToLocalChecked()).FromJust())
+    {
+        auto sparse = Nan::Get(obj, Nan::New("sparse").ToLocalChecked()).ToLocalChecked();
+
+        if (!sparse->IsBoolean())
+        {
+            Nan::ThrowError("sparse must be of type Boolean");
+            return table_parameters_ptr();
+        }
+
+        params->sparse = Nan::To<bool>(sparse).FromJust();
+    }
+
     return params;
 }
 
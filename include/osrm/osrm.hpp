@@ -39,8 +39,10 @@ namespace osrm
 {
 namespace json = util::json;
 using engine::EngineConfig;
+using engine::api::IsochroneParameters;
 using engine::api::MatchParameters;
 using engine::api::NearestParameters;
+using engine::api::POIParameters;
 using engine::api::RouteParameters;
 using engine::api::TableParameters;
 using engine::api::TileParameters;
@@ -54,6 +56,8 @@ using engine::api::TripParameters;
  *  - Route: shortest path queries for coordinates
  *  - Table: distance tables for coordinates
  *  - Nearest: nearest street segment for coordinate
+ *  - POI: points of interest of a registered set closest by travel time to a coordinate
+ *  - Isochrone: areas reachable from a coordinate within given travel times
  *  - Trip: shortest round trip between coordinates
  *  - Match: snaps noisy coordinate traces to the road network
  *  - Tile: vector tiles with internal graph representation
@@ -107,6 +111,26 @@ class OSRM final
     Status Nearest(const NearestParameters &parameters, json::Object &result) const;
     Status Nearest(const NearestParameters &parameters, engine::api::ResultT &result) const;
 
+    /**
+     * POI: points of interest of a registered set closest by travel time to a coordinate
+     *
+     * \param parameters POI query specific parameters
+     * \return Status indicating success for the query or failure
+     * \see Status, POIParameters, EngineConfig and json::Object
+     */
+    Status POI(const POIParameters &parameters, json::Object &result) const;
+    Status POI(const POIParameters &parameters, engine::api::ResultT &result) const;
+
+    /**
+     * Isochrone: areas reachable from a coordinate within given travel times
+     *
+     * \param parameters isochrone query specific parameters
+     * \return Status indicating success for the query or failure
+     * \see Status, IsochroneParameters and json::Object
+     */
+    Status Isochrone(const IsochroneParameters &parameters, json::Object &result) const;
+    Status Isochrone(const IsochroneParameters &parameters, engine::api::ResultT &result) const;
+
     /**
      * Trip: shortest round trip between coordinates.
      *
@@ -49,6 +49,8 @@ namespace api
 struct RouteParameters;
 struct TableParameters;
 struct NearestParameters;
+struct POIParameters;
+struct IsochroneParameters;
 struct TripParameters;
 struct MatchParameters;
 struct TileParameters;
@@ -0,0 +1,48 @@
+#ifndef ISOCHRONE_PARAMETERS_GRAMMAR_HPP
+#define ISOCHRONE_PARAMETERS_GRAMMAR_HPP
+
+#include "server/api/base_parameters_grammar.hpp"
+#include "engine/api/isochrone_parameters.hpp"
+
+#include <boost/spirit/include/phoenix.hpp>
+#include <boost/spirit/include/qi.hpp>
+
+namespace osrm
+{
+namespace server
+{
+namespace api
+{
+
+namespace
+{
+namespace ph = boost::phoenix;
+namespace qi = boost::spirit::qi;
+} // namespace
+
+template <typename Iterator = std::string::iterator,
+          typename Signature = void(engine::api::IsochroneParameters &)>
+struct IsochroneParametersGrammar final : public BaseParametersGrammar<Iterator, Signature>
+{
+    using BaseGrammar = BaseParametersGrammar<Iterator, Signature>;
+
+    IsochroneParametersGrammar() : BaseGrammar(root_rule)
+    {
+        contours_rule =
+            qi::lit("contours=") >
+            (qi::double_ % ';')[ph::bind(&engine::api::IsochroneParameters::contours, qi::_r1) =
+                                    qi::_1];
+
+        root_rule = BaseGrammar::query_rule(qi::_r1) > BaseGrammar::format_rule(qi::_r1) >
+                    -('?' > (contours_rule(qi::_r1) | BaseGrammar::base_rule(qi::_r1)) % '&');
+    }
+
+  private:
+    qi::rule<Iterator, Signature> root_rule;
+    qi::rule<Iterator, Signature> contours_rule;
+};
+} // namespace api
+} // namespace server
+} // namespace osrm
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef POI_PARAMETERS_GRAMMAR_HPP
+#define POI_PARAMETERS_GRAMMAR_HPP
+
+#include "server/api/base_parameters_grammar.hpp"
+#include "engine/api/poi_parameters.hpp"
+
+#include <boost/spirit/include/phoenix.hpp>
+#include <boost/spirit/include/qi.hpp>
+
+namespace osrm
+{
+namespace server
+{
+namespace api
+{
+
+namespace
+{
+namespace ph = boost::phoenix;
+namespace qi = boost::spirit::qi;
+} // namespace
+
+template <typename Iterator = std::string::iterator,
+          typename Signature = void(engine::api::POIParameters &)>
+struct POIParametersGrammar final : public BaseParametersGrammar<Iterator, Signature>
+{
+    using BaseGrammar = BaseParametersGrammar<Iterator, Signature>;
+
+    POIParametersGrammar() : BaseGrammar(root_rule)
+    {
+        set_rule = qi::lit("set=") >
+                   qi::as_string[+qi::char_("a-zA-Z0-9--_")]
+                                [ph::bind(&engine::api::POIParameters::set, qi::_r1) = qi::_1];
+
+        number_rule =
+            (qi::lit("number=") >
+             qi::uint_)[ph::bind(&engine::api::POIParameters::number_of_results, qi::_r1) = qi::_1];
+
+        root_rule =
+            BaseGrammar::query_rule(qi::_r1) > BaseGrammar::format_rule(qi::_r1) >
+            -('?' > (set_rule(qi::_r1) | number_rule(qi::_r1) | BaseGrammar::base_rule(qi::_r1)) %
+                        '&');
+    }
+
+  private:
+    qi::rule<Iterator, Signature> root_rule;
+    qi::rule<Iterator, Signature> set_rule;
+    qi::rule<Iterator, Signature> number_rule;
+};
+} // namespace api
+} // namespace server
+} // namespace osrm
+
+#endif
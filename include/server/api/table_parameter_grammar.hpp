@@ -60,11 +60,23 @@ struct TableParametersGrammar : public BaseParametersGrammar<Iterator, Signature
             qi::lit("scale_factor=") >
             (double_)[ph::bind(&engine::api::TableParameters::scale_factor, qi::_r1) = qi::_1];
 
+        max_duration_rule =
+            qi::lit("max_duration=") >
+            (double_)[ph::bind(&engine::api::TableParameters::max_duration, qi::_r1) = qi::_1];
+
+        max_distance_rule =
+            qi::lit("max_distance=") >
+            (double_)[ph::bind(&engine::api::TableParameters::max_distance, qi::_r1) = qi::_1];
+
+        sparse_rule = qi::lit("sparse=") >
+                      qi::bool_[ph::bind(&engine::api::TableParameters::sparse, qi::_r1) = qi::_1];
+
         table_rule = destinations_rule(qi::_r1) | sources_rule(qi::_r1);
 
         root_rule = BaseGrammar::query_rule(qi::_r1) > BaseGrammar::format_rule(qi::_r1) >
                     -('?' > (table_rule(qi::_r1) | base_rule(qi::_r1) | scale_factor_rule(qi::_r1) |
-                             fallback_speed_rule(qi::_r1) |
+                             fallback_speed_rule(qi::_r1) | max_duration_rule(qi::_r1) |
+                             max_distance_rule(qi::_r1) | sparse_rule(qi::_r1) |
                              (qi::lit("fallback_coordinate=") >
                               fallback_coordinate_type
                                   [ph::bind(&engine::api::TableParameters::fallback_coordinate_type,
@@ -99,6 +111,9 @@ struct TableParametersGrammar : public BaseParametersGrammar<Iterator, Signature
     qi::rule<Iterator, Signature> destinations_rule;
     qi::rule<Iterator, Signature> fallback_speed_rule;
     qi::rule<Iterator, Signature> scale_factor_rule;
+    qi::rule<Iterator, Signature> max_duration_rule;
+    qi::rule<Iterator, Signature> max_distance_rule;
+    qi::rule<Iterator, Signature> sparse_rule;
     qi::rule<Iterator, std::size_t()> size_t_;
     qi::symbols<char, engine::api::TableParameters::AnnotationsType> annotations;
     qi::rule<Iterator, engine::api::TableParameters::AnnotationsType()> annotations_list;
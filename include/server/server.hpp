@@ -7,6 +7,7 @@
 
 #include "util/integer_range.hpp"
 #include "util/log.hpp"
+#include "util/numa.hpp"
 
 #include <boost/asio.hpp>
 #include <boost/bind.hpp>
@@ -33,17 +34,25 @@ class Server
 {
   public:
     // Note: returns a shared instead of a unique ptr as it is captured in a lambda somewhere else
-    static std::shared_ptr<Server>
-    CreateServer(std::string &ip_address, int ip_port, unsigned requested_num_threads)
+    static std::shared_ptr<Server> CreateServer(std::string &ip_address,
+                                                int ip_port,
+                                                unsigned requested_num_threads,
+                                                const bool pin_to_numa_nodes = false)
     {
         util::Log() << "http 1.1 compression handled by zlib version " << zlibVersion();
         const unsigned hardware_threads = std::max(1u, std::thread::hardware_concurrency());
         const unsigned real_num_threads = std::min(hardware_threads, requested_num_threads);
-        return std::make_shared<Server>(ip_address, ip_port, real_num_threads);
+        return std::make_shared<Server>(ip_address, ip_port, real_num_threads, pin_to_numa_nodes);
     }
 
-    explicit Server(const std::string &address, const int port, const unsigned thread_pool_size)
-        : thread_pool_size(thread_pool_size), acceptor(io_context),
+    // Pinning spreads the threads round robin over the NUMA nodes, so each of them reads the
+    // dataset replica of its own node
+    explicit Server(const std::string &address,
+                    const int port,
+                    const unsigned thread_pool_size,
+                    const bool pin_to_numa_nodes = false)
+        : thread_pool_size(thread_pool_size), pin_to_numa_nodes(pin_to_numa_nodes),
+          acceptor(io_context),
           new_connection(std::make_shared<Connection>(io_context, request_handler))
     {
         const auto port_string = std::to_string(port);
@@ -70,11 +79,17 @@ class Server
 
     void Run()
     {
+        const auto nodes = pin_to_numa_nodes ? util::getNumaNodes() : std::vector<util::NumaNode>{};
         std::vector<std::shared_ptr<std::thread>> threads;
         for (unsigned i = 0; i < thread_pool_size; ++i)
         {
-            std::shared_ptr<std::thread> thread = std::make_shared<std::thread>(
-                boost::bind(&boost::asio::io_context::run, &io_context));
+            std::shared_ptr<std::thread> thread = std::make_shared<std::thread>([this, &nodes, i] {
+                if (!nodes.empty())
+                {
+                    util::pinThreadToNumaNode(nodes[i % nodes.size()]);
+                }
+                io_context.run();
+            });
             threads.push_back(thread);
         }
         for (auto thread : threads)
@@ -108,6 +123,7 @@ class Server
     }
 
     unsigned thread_pool_size;
+    bool pin_to_numa_nodes;
     boost::asio::io_context io_context;
     boost::asio::ip::tcp::acceptor acceptor;
     std::shared_ptr<Connection> new_connection;
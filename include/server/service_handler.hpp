@@ -4,8 +4,11 @@
 #include "server/service/base_service.hpp"
 
 #include "engine/api/base_api.hpp"
+#include "osrm/engine_config.hpp"
 #include "osrm/osrm.hpp"
 
+#include <memory>
+#include <string>
 #include <unordered_map>
 
 namespace osrm
@@ -32,17 +35,31 @@ class ServiceHandlerInterface
                                     osrm::engine::api::ResultT &result) = 0;
 };
 
+// Dispatches the queries to the dataset of the {profile} in the URL. All datasets share the
+// threads and connections of the server.
 class ServiceHandler final : public ServiceHandlerInterface
 {
   public:
+    // Serves the dataset for every profile
     ServiceHandler(osrm::EngineConfig &config);
+    // Serves one dataset per profile. The dataset of the empty profile, if any, serves all
+    // profiles without their own dataset.
+    ServiceHandler(std::unordered_map<std::string, osrm::EngineConfig> &profile_configs);
     using ResultT = osrm::engine::api::ResultT;
 
     virtual engine::Status RunQuery(api::ParsedURL parsed_url, ResultT &result) override;
 
   private:
-    std::unordered_map<std::string, std::unique_ptr<service::BaseService>> service_map;
-    OSRM routing_machine;
+    struct Dataset
+    {
+        // the services keep a reference, so the engine must not move
+        std::unique_ptr<OSRM> routing_machine;
+        std::unordered_map<std::string, std::unique_ptr<service::BaseService>> service_map;
+    };
+
+    void AddDataset(const std::string &profile, osrm::EngineConfig &config);
+
+    std::unordered_map<std::string, Dataset> datasets;
 };
 } // namespace server
 } // namespace osrm
@@ -0,0 +1,48 @@
+#ifndef OSRM_STORAGE_BLOCK_READER_HPP
+#define OSRM_STORAGE_BLOCK_READER_HPP
+
+#include "storage/shared_data_index.hpp"
+
+#include <boost/filesystem/path.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace storage
+{
+
+// Copies the entries of tar files into the blocks of the same name, see populateLayoutFromFile.
+//
+// The on-disk format of all blocks equals their in-memory format, so the entries are read in
+// large chunks directly to their final position in the data region instead of going through
+// the typed readers of every file. The chunks of a file are read by several threads at once.
+// Chunks of compressed entries consist of whole frames, which the threads decompress straight
+// into the blocks.
+class BlockReader
+{
+  public:
+    // With direct_io the files are read with O_DIRECT through an aligned buffer, bypassing
+    // the page cache, where the platform and the file system support it.
+    BlockReader(unsigned io_threads, bool direct_io);
+
+    // Reads all entries of the file that have a block in the index and returns the number of
+    // bytes that were loaded into the blocks. Throws if a block doesn't have the size of its
+    // entry or if a compressed entry is corrupt.
+    std::uint64_t Read(const boost::filesystem::path &path, const SharedDataIndex &index) const;
+
+    // Returns the names of the entries of the file whose contents differ from the block of the
+    // same name, including entries without a block or with a block of another size.
+    std::vector<std::string> FindChangedEntries(const boost::filesystem::path &path,
+                                                const SharedDataIndex &index) const;
+
+  private:
+    const unsigned io_threads;
+    const bool direct_io;
+};
+} // namespace storage
+} // namespace osrm
+
+#endif
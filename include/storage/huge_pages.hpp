@@ -0,0 +1,62 @@
+#ifndef OSRM_STORAGE_HUGE_PAGES_HPP
+#define OSRM_STORAGE_HUGE_PAGES_HPP
+
+#include <boost/optional.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace osrm
+{
+namespace storage
+{
+
+// Which pages back the memory of a dataset. Searches access the graph at random, so with
+// regular 4 KiB pages a good share of the query time goes to TLB misses on large datasets.
+enum class HugePages
+{
+    // regular pages
+    Off,
+    // regular pages the kernel may collapse into transparent huge pages
+    Transparent,
+    // pages reserved in /sys/kernel/mm/hugepages/hugepages-2048kB
+    Size2MiB,
+    // pages reserved in /sys/kernel/mm/hugepages/hugepages-1048576kB, usually at boot time
+    Size1GiB
+};
+
+// Parses off, transparent, 2M and 1G
+boost::optional<HugePages> parseHugePages(const std::string &name);
+
+// Size of the reserved huge pages, 0 for Off and Transparent
+std::uint64_t getHugePageSize(const HugePages huge_pages);
+
+// Asks the kernel to back an existing mapping with transparent huge pages
+void adviseHugePages(void *address, const std::uint64_t size);
+
+// Creates a XSI shared memory segment of reserved huge pages, which a following shmget of
+// the same key only opens. Returns false if huge_pages doesn't ask for reserved pages or
+// if none are available.
+bool createHugePageSegment(const int key, const std::uint64_t size, const HugePages huge_pages);
+
+// Zero initialized memory of a process local dataset. Falls back to transparent huge pages if
+// no reserved huge pages are available.
+class AnonymousMemory
+{
+  public:
+    AnonymousMemory(const std::uint64_t size, const HugePages huge_pages);
+    ~AnonymousMemory();
+
+    AnonymousMemory(const AnonymousMemory &) = delete;
+    AnonymousMemory &operator=(const AnonymousMemory &) = delete;
+
+    char *Ptr() const { return address; }
+
+  private:
+    char *address = nullptr;
+    std::uint64_t mapped_size = 0;
+};
+} // namespace storage
+} // namespace osrm
+
+#endif
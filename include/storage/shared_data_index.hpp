@@ -7,6 +7,7 @@
 
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace osrm
 {
@@ -14,7 +15,8 @@ namespace storage
 {
 
 // This class wraps one or more shared memory regions with the associated data layout
-// to abstract away in which region a block of memory is stored.
+// to abstract away in which region a block of memory is stored. A block in a later region
+// replaces the block of the same name in an earlier one.
 class SharedDataIndex
 {
   public:
@@ -39,9 +41,19 @@ class SharedDataIndex
 
     template <typename OutIter> void List(const std::string &name_prefix, OutIter out) const
     {
-        for (const auto &region : regions)
+        // directories and replaced blocks may be listed by several regions
+        std::unordered_set<std::string> returned_names;
+        for (auto index : util::irange<std::uint32_t>(0, regions.size()))
         {
-            region.layout->List(name_prefix, out);
+            regions[index].layout->List(
+                name_prefix, boost::make_function_output_iterator([&](const auto &name) {
+                    const auto iter = block_to_region.find(name);
+                    const auto replaced = iter != block_to_region.end() && iter->second != index;
+                    if (!replaced && returned_names.insert(name).second)
+                    {
+                        *out++ = name;
+                    }
+                }));
         }
     }
 
@@ -69,6 +81,11 @@ class SharedDataIndex
         return reinterpret_cast<T *>(region.layout->GetBlockPtr(region.memory_ptr, name));
     }
 
+    bool HasBlock(const std::string &name) const
+    {
+        return block_to_region.find(name) != block_to_region.end();
+    }
+
     std::size_t GetBlockEntries(const std::string &name) const
     {
         const auto &region = GetBlockRegion(name);
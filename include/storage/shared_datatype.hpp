@@ -257,6 +257,8 @@ struct SharedRegionRegister
         }
     }
 
+    void Deregister(const RegionID key) { regions[key] = SharedRegion{}; }
+
     template <typename OutIter> void List(OutIter out) const
     {
         for (const auto &region : regions)
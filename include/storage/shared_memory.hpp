@@ -25,6 +25,7 @@
 #include <exception>
 #include <thread>
 
+#include "storage/huge_pages.hpp"
 #include "storage/shared_memory_ownership.hpp"
 
 namespace osrm
@@ -55,7 +56,8 @@ class SharedMemory
     template <typename IdentifierT>
     SharedMemory(const boost::filesystem::path &lock_file,
                  const IdentifierT id,
-                 const uint64_t size = 0)
+                 const uint64_t size = 0,
+                 const HugePages huge_pages = HugePages::Off)
         : key(lock_file.string().c_str(), id)
     {
         // open only
@@ -70,6 +72,9 @@ class SharedMemory
         // open or create
         else
         {
+            // a segment of huge pages has to be created by hand, boost then only opens it
+            const auto huge_page_segment =
+                createHugePageSegment(key.get_key(), size, huge_pages);
             shm = boost::interprocess::xsi_shared_memory(
                 boost::interprocess::open_or_create, key, size);
             util::Log(logDEBUG) << "opening/creating " << shm.get_shmid() << " from id " << id
@@ -84,6 +89,10 @@ class SharedMemory
             }
 #endif
             region = boost::interprocess::mapped_region(shm, boost::interprocess::read_write);
+            if (huge_pages != HugePages::Off && !huge_page_segment)
+            {
+                adviseHugePages(region.get_address(), region.get_size());
+            }
         }
     }
 
@@ -203,7 +212,10 @@ class SharedMemory
     void *Ptr() const { return region.get_address(); }
     std::size_t Size() const { return region.get_size(); }
 
-    SharedMemory(const boost::filesystem::path &lock_file, const int id, const uint64_t size = 0)
+    SharedMemory(const boost::filesystem::path &lock_file,
+                 const int id,
+                 const uint64_t size = 0,
+                 const HugePages /*huge_pages*/ = HugePages::Off)
     {
         sprintf(key, "%s.%d", "osrm.lock", id);
         if (0 == size)
@@ -285,7 +297,9 @@ class SharedMemory
 #endif
 
 template <typename IdentifierT, typename LockFileT = OSRMLockFile>
-std::unique_ptr<SharedMemory> makeSharedMemory(const IdentifierT &id, const uint64_t size = 0)
+std::unique_ptr<SharedMemory> makeSharedMemory(const IdentifierT &id,
+                                               const uint64_t size = 0,
+                                               const HugePages huge_pages = HugePages::Off)
 {
     static_assert(sizeof(id) == sizeof(std::uint16_t), "Key type is not 16 bits");
     try
@@ -302,7 +316,7 @@ std::unique_ptr<SharedMemory> makeSharedMemory(const IdentifierT &id, const uint
                 boost::filesystem::ofstream ofs(lock_file(id));
             }
         }
-        return std::make_unique<SharedMemory>(lock_file(id), id, size);
+        return std::make_unique<SharedMemory>(lock_file(id), id, size, huge_pages);
     }
     catch (const boost::interprocess::interprocess_exception &e)
     {
@@ -49,7 +49,9 @@ class Storage
   public:
     Storage(StorageConfig config);
 
-    int Run(int max_wait, const std::string &name, bool only_metric);
+    // With only_changed_blocks the blocks of the updatable files that differ from the loaded
+    // ones are put into a delta region, falling back to an update of the full metric
+    int Run(int max_wait, const std::string &name, bool only_metric, bool only_changed_blocks);
     void PopulateStaticData(const SharedDataIndex &index);
     void PopulateUpdatableData(const SharedDataIndex &index);
     void PopulateLayout(storage::BaseDataLayout &layout,
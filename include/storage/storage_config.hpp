@@ -30,6 +30,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <boost/filesystem/path.hpp>
 
+#include "storage/huge_pages.hpp"
 #include "storage/io_config.hpp"
 
 namespace osrm
@@ -37,6 +38,17 @@ namespace osrm
 namespace storage
 {
 
+// Where the leaves of the R-tree are kept while serving queries
+enum class RTreeLeafStorage
+{
+    // mmap'd from the .fileIndex file on demand
+    MMap,
+    // loaded into the dataset
+    Memory,
+    // loaded into the dataset delta compressed, see util::CompressedLeaves
+    Compressed
+};
+
 /**
  * Configures OSRM's file storage paths.
  *
@@ -68,12 +80,21 @@ struct StorageConfig final : IOConfig
                     ".osrm.cells",
                     ".osrm.cell_metrics",
                     ".osrm.mldgr",
+                    ".osrm.landmarks",
                     ".osrm.tld",
                     ".osrm.tls",
                     ".osrm.partition"},
                    {})
     {
     }
+
+    RTreeLeafStorage rtree_leaf_storage = RTreeLeafStorage::MMap;
+    // number of threads that read the data files, see BlockReader
+    unsigned io_threads = 4;
+    // read the data files bypassing the page cache
+    bool direct_io = false;
+    // pages backing the memory of the dataset, falls back to regular pages if unavailable
+    HugePages huge_pages = HugePages::Off;
 };
 } // namespace storage
 } // namespace osrm
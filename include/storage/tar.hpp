@@ -1,6 +1,7 @@
 #ifndef OSRM_STORAGE_TAR_HPP
 #define OSRM_STORAGE_TAR_HPP
 
+#include "util/block_compression.hpp"
 #include "util/exception.hpp"
 #include "util/exception_utils.hpp"
 #include "util/fingerprint.hpp"
@@ -9,6 +10,11 @@
 
 #include <boost/filesystem/path.hpp>
 
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 extern "C"
 {
 #include "microtar.h"
@@ -71,8 +77,29 @@ checkMTarError(int error_code, const boost::filesystem::path &filepath, const st
         throw util::exception(filepath.string() + " : " + name + ":" + mtar_strerror(error_code));
     }
 }
+
+// A compressed entry is preceded by an entry of this suffix that holds its CompressedBlockHeader.
+// The entry itself holds the stored block, see util::compressBlock.
+const constexpr char COMPRESSED_SUFFIX[] = ".compressed.meta";
+
+inline bool isMetaName(const std::string &name)
+{
+    const std::string suffix = ".meta";
+    return name.size() >= suffix.size() &&
+           name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+inline bool isCompressedMarkerName(const std::string &name)
+{
+    const std::string suffix = COMPRESSED_SUFFIX;
+    return name.size() > suffix.size() &&
+           name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
 } // namespace detail
 
+// Entries smaller than this are not worth the frame table
+constexpr std::uint64_t MIN_COMPRESSED_ENTRY_SIZE = 64 * 1024;
+
 class FileReader
 {
   public:
@@ -95,6 +122,12 @@ class FileReader
 
     ~FileReader() { mtar_close(&handle); }
 
+    bool HasEntry(const std::string &name)
+    {
+        mtar_header_t header;
+        return mtar_find(&handle, name.c_str(), &header) == MTAR_ESUCCESS;
+    }
+
     std::uint64_t ReadElementCount64(const std::string &name)
     {
         std::uint64_t size;
@@ -109,6 +142,15 @@ class FileReader
 
     template <typename T, typename OutIter> void ReadStreaming(const std::string &name, OutIter out)
     {
+        if (const auto compressed = FindCompressedBlock(name))
+        {
+            const auto number_of_elements = compressed->uncompressed_size / sizeof(T);
+            std::vector<T> data(number_of_elements);
+            ReadInto(name, data.data(), number_of_elements);
+            std::copy(data.begin(), data.end(), out);
+            return;
+        }
+
         mtar_header_t header;
         auto ret = mtar_find(&handle, name.c_str(), &header);
         detail::checkMTarError(ret, path, name);
@@ -136,37 +178,69 @@ class FileReader
     template <typename T>
     void ReadInto(const std::string &name, T *data, const std::size_t number_of_elements)
     {
+        const auto compressed = FindCompressedBlock(name);
+
         mtar_header_t header;
         auto ret = mtar_find(&handle, name.c_str(), &header);
         detail::checkMTarError(ret, path, name);
 
+        const auto size = compressed ? compressed->uncompressed_size : header.size;
         auto expected_size = sizeof(T) * number_of_elements;
-        if (header.size != expected_size)
+        if (size != expected_size)
         {
             throw util::RuntimeError(name + ": Datatype size does not match file size.",
                                      ErrorCode::UnexpectedEndOfFile,
                                      SOURCE_REF);
         }
 
-        ret = mtar_read_data(&handle, reinterpret_cast<char *>(data), header.size);
+        if (!compressed)
+        {
+            ret = mtar_read_data(&handle, reinterpret_cast<char *>(data), header.size);
+            detail::checkMTarError(ret, path, name);
+            return;
+        }
+
+        std::vector<char> stored(header.size);
+        ret = mtar_read_data(&handle, stored.data(), header.size);
         detail::checkMTarError(ret, path, name);
+        try
+        {
+            util::decompressBlock(
+                *compressed, stored.data(), stored.size(), reinterpret_cast<char *>(data));
+        }
+        catch (const util::exception &error)
+        {
+            throw util::RuntimeError(
+                name + ": " + error.what(), ErrorCode::FileIOError, SOURCE_REF);
+        }
     }
 
     struct FileEntry
     {
         std::string name;
+        // of the data, which may be stored compressed
         std::size_t size;
         std::size_t offset;
+        // equals size for entries that are not compressed
+        std::size_t stored_size = 0;
+        bool compressed = false;
     };
 
+    // Lists the entries of the file. Compressed entries are listed with their uncompressed size
+    // and without the entries that mark them as compressed.
     template <typename OutIter> void List(OutIter out)
     {
+        const auto &compressed_blocks = GetCompressedBlocks();
+
+        auto ret = mtar_rewind(&handle);
+        detail::checkMTarError(ret, path, "");
+
         mtar_header_t header;
         while (mtar_read_header(&handle, &header) != MTAR_ENULLRECORD)
         {
-            if (header.type == MTAR_TREG)
+            if (header.type == MTAR_TREG && !detail::isCompressedMarkerName(header.name))
             {
-                int ret = mtar_read_data(&handle, nullptr, 0);
+                ret = mtar_read_data(&handle, nullptr, 0);
                 detail::checkMTarError(ret, path, header.name);
 
                 auto offset = handle.pos;
@@ -175,13 +249,112 @@ class FileReader
                 ret = mtar_seek(&handle, handle.last_header);
                 detail::checkMTarError(ret, path, header.name);
 
-                *out++ = FileEntry{header.name, header.size, offset};
+                const auto compressed = compressed_blocks.find(header.name);
+                if (compressed == compressed_blocks.end())
+                {
+                    *out++ = FileEntry{header.name, header.size, offset, header.size, false};
+                }
+                else
+                {
+                    *out++ = FileEntry{header.name,
+                                       compressed->second.uncompressed_size,
+                                       offset,
+                                       header.size,
+                                       true};
+                }
             }
             mtar_next(&handle);
         }
     }
 
+    // Reads the header and the table of frames of a compressed entry
+    void ReadCompressedBlockHeader(const std::string &name,
+                                   util::CompressedBlockHeader &block_header,
+                                   std::vector<util::CompressedFrame> &frames)
+    {
+        const auto compressed = FindCompressedBlock(name);
+        if (!compressed)
+        {
+            throw util::RuntimeError(
+                name + ": Entry is not compressed.", ErrorCode::FileIOError, SOURCE_REF);
+        }
+        block_header = *compressed;
+
+        mtar_header_t header;
+        auto ret = mtar_find(&handle, name.c_str(), &header);
+        detail::checkMTarError(ret, path, name);
+
+        if (block_header.number_of_frames > header.size / sizeof(util::CompressedFrame))
+        {
+            throw util::RuntimeError(
+                name + ": Truncated compressed entry.", ErrorCode::UnexpectedEndOfFile, SOURCE_REF);
+        }
+        frames.resize(block_header.number_of_frames);
+        ret = mtar_read_data(&handle,
+                             reinterpret_cast<char *>(frames.data()),
+                             frames.size() * sizeof(util::CompressedFrame));
+        detail::checkMTarError(ret, path, name);
+
+        try
+        {
+            util::checkCompressedBlock(block_header, frames, header.size);
+        }
+        catch (const util::exception &error)
+        {
+            throw util::RuntimeError(
+                name + ": " + error.what(), ErrorCode::FileIOError, SOURCE_REF);
+        }
+    }
+
   private:
+    // Meta entries are never compressed, which keeps reading them free of the extra pass
+    const util::CompressedBlockHeader *FindCompressedBlock(const std::string &name)
+    {
+        if (detail::isMetaName(name))
+        {
+            return nullptr;
+        }
+        const auto &blocks = GetCompressedBlocks();
+        const auto block = blocks.find(name);
+        return block == blocks.end() ? nullptr : &block->second;
+    }
+
+    // Collects the headers of all compressed entries on first use
+    const std::unordered_map<std::string, util::CompressedBlockHeader> &GetCompressedBlocks()
+    {
+        if (compressed_blocks_listed)
+        {
+            return compressed_blocks;
+        }
+
+        auto ret = mtar_rewind(&handle);
+        detail::checkMTarError(ret, path, "");
+
+        mtar_header_t header;
+        while (mtar_read_header(&handle, &header) != MTAR_ENULLRECORD)
+        {
+            if (header.type == MTAR_TREG && detail::isCompressedMarkerName(header.name))
+            {
+                std::string name = header.name;
+                if (header.size != sizeof(util::CompressedBlockHeader))
+                {
+                    throw util::RuntimeError(name + ": Datatype size does not match file size.",
+                                             ErrorCode::UnexpectedEndOfFile,
+                                             SOURCE_REF);
+                }
+                util::CompressedBlockHeader block_header;
+                ret = mtar_read_data(&handle, &block_header, sizeof(block_header));
+                detail::checkMTarError(ret, path, name);
+
+                name.resize(name.size() - (sizeof(detail::COMPRESSED_SUFFIX) - 1));
+                compressed_blocks[name] = block_header;
+            }
+            mtar_next(&handle);
+        }
+        compressed_blocks_listed = true;
+        return compressed_blocks;
+    }
+
     bool ReadAndCheckFingerprint()
     {
         util::FingerPrint loaded_fingerprint;
@@ -210,6 +383,8 @@ class FileReader
 
     boost::filesystem::path path;
     mtar_t handle;
+    std::unordered_map<std::string, util::CompressedBlockHeader> compressed_blocks;
+    bool compressed_blocks_listed = false;
 };
 
 class FileWriter
@@ -221,7 +396,17 @@ class FileWriter
         HasNoFingerprint
     };
 
-    FileWriter(const boost::filesystem::path &path, FingerprintFlag flag) : path(path)
+    // Compresses all entries but the meta entries and the small ones
+    enum CompressionFlag
+    {
+        NoCompression,
+        CompressEntries
+    };
+
+    FileWriter(const boost::filesystem::path &path,
+               FingerprintFlag flag,
+               CompressionFlag compression = NoCompression)
+        : path(path), compression(compression)
     {
         auto ret = mtar_open(&handle, path.string().c_str(), "w");
         detail::checkMTarError(ret, path, "");
@@ -251,6 +436,15 @@ class FileWriter
     template <typename T, typename Iter>
     void WriteStreaming(const std::string &name, Iter iter, const std::uint64_t number_of_elements)
     {
+        if (compression == CompressEntries && !detail::isMetaName(name))
+        {
+            // the frames are compressed from memory
+            std::vector<T> data(number_of_elements);
+            std::copy_n(iter, number_of_elements, data.begin());
+            WriteFrom(name, data.data(), data.size());
+            return;
+        }
+
         auto number_of_bytes = number_of_elements * sizeof(T);
 
         auto ret = mtar_write_file_header(&handle, name.c_str(), number_of_bytes);
@@ -269,6 +463,12 @@ class FileWriter
     template <typename T>
     void ContinueFrom(const std::string &name, const T *data, const std::size_t number_of_elements)
     {
+        if (compression == CompressEntries)
+        {
+            throw util::exception(path.string() + " : " + name +
+                                  ": Compressed entries can't be continued" + SOURCE_REF);
+        }
+
         auto number_of_bytes = number_of_elements * sizeof(T);
 
         mtar_header_t header;
@@ -295,14 +495,32 @@ class FileWriter
     {
         auto number_of_bytes = number_of_elements * sizeof(T);
 
+        if (compression == CompressEntries && !detail::isMetaName(name) &&
+            number_of_bytes >= MIN_COMPRESSED_ENTRY_SIZE)
+        {
+            util::CompressedBlockHeader block_header;
+            const auto stored = util::compressBlock(
+                reinterpret_cast<const char *>(data), number_of_bytes, block_header);
+            WriteEntry(name + detail::COMPRESSED_SUFFIX,
+                       reinterpret_cast<const char *>(&block_header),
+                       sizeof(block_header));
+            WriteEntry(name, stored.data(), stored.size());
+            return;
+        }
+
+        WriteEntry(name, reinterpret_cast<const char *>(data), number_of_bytes);
+    }
+
+  private:
+    void WriteEntry(const std::string &name, const char *data, const std::size_t number_of_bytes)
+    {
         auto ret = mtar_write_file_header(&handle, name.c_str(), number_of_bytes);
         detail::checkMTarError(ret, path, name);
 
-        ret = mtar_write_data(&handle, reinterpret_cast<const char *>(data), number_of_bytes);
+        ret = mtar_write_data(&handle, data, number_of_bytes);
         detail::checkMTarError(ret, path, name);
     }
 
-  private:
     void WriteFingerprint()
     {
         const auto fingerprint = util::FingerPrint::GetValid();
@@ -310,6 +528,7 @@ class FileWriter
     }
 
     boost::filesystem::path path;
+    CompressionFlag compression;
     mtar_t handle;
 };
 } // namespace tar
@@ -7,6 +7,7 @@
 #include "contractor/query_graph.hpp"
 
 #include "customizer/edge_based_graph.hpp"
+#include "customizer/landmarks.hpp"
 
 #include "extractor/class_data.hpp"
 #include "extractor/compressed_edge_container.hpp"
@@ -160,6 +161,12 @@ inline auto make_segment_data_view(const SharedDataIndex &index, const std::stri
     auto rev_datasources_list =
         make_vector_view<DatasourceID>(index, name + "/reverse_data_sources");
 
+    // optional, datasets from before the ranks were precomputed have none
+    auto simplification_ranks_list =
+        index.HasBlock(name + "/simplification_ranks")
+            ? make_vector_view<std::uint8_t>(index, name + "/simplification_ranks")
+            : util::vector_view<std::uint8_t>();
+
     return extractor::SegmentDataView{std::move(geometry_begin_indices),
                                       std::move(node_list),
                                       std::move(fwd_weight_list),
@@ -167,7 +174,8 @@ inline auto make_segment_data_view(const SharedDataIndex &index, const std::stri
                                       std::move(fwd_duration_list),
                                       std::move(rev_duration_list),
                                       std::move(fwd_datasources_list),
-                                      std::move(rev_datasources_list)};
+                                      std::move(rev_datasources_list),
+                                      std::move(simplification_ranks_list)};
 }
 
 inline auto make_coordinates_view(const SharedDataIndex &index, const std::string &name)
@@ -209,6 +217,33 @@ inline auto make_search_tree_view(const SharedDataIndex &index, const std::strin
 
     const auto coordinates = make_coordinates_view(index, "/common/nbn_data/coordinates");
 
+    // the leaves were loaded into the dataset by osrm-datastore --rtree-leaves
+    if (index.HasBlock(name + "/leaves"))
+    {
+        const auto leaves = make_vector_view<RTreeLeaf>(index, name + "/leaves");
+        return util::StaticRTree<RTreeLeaf, storage::Ownership::View>{
+            std::move(search_tree),
+            std::move(rtree_level_starts),
+            util::vector_view<const RTreeLeaf>(leaves.data(), leaves.size()),
+            std::move(coordinates)};
+    }
+    if (index.HasBlock(name + "/compressed_leaves/pages"))
+    {
+        const auto page_offsets =
+            make_vector_view<std::uint64_t>(index, name + "/compressed_leaves/page_offsets");
+        const auto pages = make_vector_view<std::uint8_t>(index, name + "/compressed_leaves/pages");
+        const auto number_of_objects = *index.template GetBlockPtr<std::uint64_t>(
+            name + "/compressed_leaves/number_of_objects");
+        return util::StaticRTree<RTreeLeaf, storage::Ownership::View>{
+            std::move(search_tree),
+            std::move(rtree_level_starts),
+            util::CompressedLeaves<RTreeLeaf>{
+                util::vector_view<const std::uint64_t>(page_offsets.data(), page_offsets.size()),
+                util::vector_view<const std::uint8_t>(pages.data(), pages.size()),
+                number_of_objects},
+            std::move(coordinates)};
+    }
+
     const char *path = index.template GetBlockPtr<char>(name + "/file_index_path");
 
     if (!boost::filesystem::exists(boost::filesystem::path{path}))
@@ -309,6 +344,16 @@ inline auto make_filtered_cell_metric_view(const SharedDataIndex &index,
         std::move(weights), std::move(durations), std::move(distances)};
 }
 
+inline auto make_landmarks_view(const SharedDataIndex &index, const std::string &name)
+{
+    auto landmarks = make_vector_view<NodeID>(index, name + "/landmarks");
+    auto from_landmarks = make_vector_view<EdgeWeight>(index, name + "/from_landmarks");
+    auto to_landmarks = make_vector_view<EdgeWeight>(index, name + "/to_landmarks");
+
+    return customizer::LandmarksView{
+        std::move(landmarks), std::move(from_landmarks), std::move(to_landmarks)};
+}
+
 inline auto make_cell_metric_view(const SharedDataIndex &index, const std::string &name)
 {
     std::vector<customizer::CellMetricView> cell_metric_excludes;
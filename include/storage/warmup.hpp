@@ -0,0 +1,55 @@
+#ifndef OSRM_STORAGE_WARMUP_HPP
+#define OSRM_STORAGE_WARMUP_HPP
+
+#include "storage/shared_data_index.hpp"
+
+#include <boost/optional.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace storage
+{
+
+// Groups of blocks that are touched before the first query. Freshly mapped data faults in
+// page by page on first access, which triples the tail latency of the first minutes of traffic.
+enum class WarmupGroup
+{
+    // the upper levels of the R-tree that every snapping descends through, and its leaves if
+    // osrm-datastore loaded them into the dataset
+    RTree,
+    // the partition and the cells of the MLD overlay
+    Cells,
+    // the search graph of CH or MLD
+    Graph,
+    // the coordinates and segment data unpacked for every route
+    Geometry,
+    // the street names of the route steps
+    Names
+};
+
+// Parses a comma separated list of rtree, cells, graph, geometry and names, in the order the
+// groups are warmed up. An empty list disables the warm-up.
+boost::optional<std::vector<WarmupGroup>> parseWarmupOrder(const std::string &order);
+
+struct PageFaults
+{
+    // served from the page cache or the shared memory segment
+    std::uint64_t minor;
+    // served from disk
+    std::uint64_t major;
+};
+
+// Page faults of the process so far
+PageFaults getPageFaults();
+
+// Advises the kernel to read ahead the blocks of the groups and touches every page of them,
+// group after group. Logs the size, duration and page faults per group.
+void warmupBlocks(const SharedDataIndex &index, const std::vector<WarmupGroup> &order);
+} // namespace storage
+} // namespace osrm
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef OSRM_UTIL_BLOCK_COMPRESSION_HPP
+#define OSRM_UTIL_BLOCK_COMPRESSION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace osrm
+{
+namespace util
+{
+
+// Byte oriented LZ77 codec in the style of LZ4: sequences of literals and matches of at least
+// four bytes within the last 64 KiB. Trades ratio for decompression at memory speed.
+namespace lz
+{
+// Returns the compressed size or 0 if it doesn't fit into capacity
+std::size_t compress(const char *source,
+                     const std::size_t size,
+                     char *destination,
+                     const std::size_t capacity);
+
+// Returns false if the input is corrupt or doesn't decompress to exactly size bytes
+bool decompress(const char *source,
+                const std::size_t compressed_size,
+                char *destination,
+                const std::size_t size);
+} // namespace lz
+
+// XXH64 of the data
+std::uint64_t checksum64(const char *data, const std::size_t size, const std::uint64_t seed = 0);
+
+// A compressed block is split into frames that are compressed and checksummed on their own, so
+// they can be decompressed in parallel and straight into the destination memory. The stored
+// block starts with the table of frames, followed by the data of the frames.
+struct CompressedBlockHeader
+{
+    std::uint64_t uncompressed_size;
+    std::uint64_t frame_size;
+    std::uint64_t number_of_frames;
+};
+
+struct CompressedFrame
+{
+    // from the start of the stored block
+    std::uint64_t offset;
+    // equals the uncompressed size of the frame if the frame didn't compress
+    std::uint64_t stored_size;
+    // of the uncompressed frame
+    std::uint64_t checksum;
+};
+
+constexpr std::uint64_t COMPRESSED_FRAME_SIZE = 1024 * 1024;
+
+// Compresses the frames of the data in parallel and returns the stored block
+std::vector<char>
+compressBlock(const char *data, const std::uint64_t size, CompressedBlockHeader &header);
+
+// Throws if the header and the frame table don't describe a stored block of the size
+void checkCompressedBlock(const CompressedBlockHeader &header,
+                          const std::vector<CompressedFrame> &frames,
+                          const std::uint64_t stored_size);
+
+// Decompresses a frame and verifies its checksum, throws if the frame is corrupt
+void decompressFrame(const CompressedBlockHeader &header,
+                     const std::uint64_t frame_index,
+                     const CompressedFrame &frame,
+                     const char *stored_frame,
+                     char *destination);
+
+// Decompresses the frames of a stored block in parallel
+void decompressBlock(const CompressedBlockHeader &header,
+                     const char *stored,
+                     const std::uint64_t stored_size,
+                     char *destination);
+} // namespace util
+} // namespace osrm
+
+#endif
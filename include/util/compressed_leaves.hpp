@@ -0,0 +1,155 @@
+#ifndef OSRM_UTIL_COMPRESSED_LEAVES_HPP
+#define OSRM_UTIL_COMPRESSED_LEAVES_HPP
+
+#include "util/vector_view.hpp"
+
+#include <boost/assert.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace osrm
+{
+namespace util
+{
+
+/**
+ * Leaf pages of a StaticRTree, delta compressed to keep them in memory.
+ *
+ * Every object is read as a sequence of 32 bit words. Each word is stored as the zig-zag encoded
+ * varint of its difference to the same word of the previous object in the page, the first object
+ * of a page is stored relative to zero. The objects of a leaf are neighbours on the Hilbert curve
+ * and have similar node and segment ids, so most words take one or two bytes.
+ *
+ * The pages are stored back to back, page_offsets holds the byte offset of every page and the
+ * end of the last page. The caller knows the number of objects in a page.
+ */
+template <typename ObjectT> class CompressedLeaves
+{
+    static_assert(std::is_trivially_copyable<ObjectT>::value,
+                  "compressed objects need to be trivially copyable");
+    static_assert(sizeof(ObjectT) % sizeof(std::uint32_t) == 0,
+                  "compressed objects need to consist of 32 bit words");
+
+    static constexpr std::size_t WORDS_PER_OBJECT = sizeof(ObjectT) / sizeof(std::uint32_t);
+    using Words = std::array<std::uint32_t, WORDS_PER_OBJECT>;
+
+  public:
+    // a varint of a 32 bit value takes at most five bytes
+    static constexpr std::size_t MAX_ENCODED_OBJECT_SIZE = WORDS_PER_OBJECT * 5;
+
+    CompressedLeaves() : number_of_objects(0) {}
+
+    CompressedLeaves(util::vector_view<const std::uint64_t> page_offsets_,
+                     util::vector_view<const std::uint8_t> pages_,
+                     const std::uint64_t number_of_objects)
+        : page_offsets(std::move(page_offsets_)), pages(std::move(pages_)),
+          number_of_objects(number_of_objects)
+    {
+        BOOST_ASSERT(!page_offsets.empty());
+        BOOST_ASSERT(page_offsets.back() == pages.size());
+    }
+
+    bool empty() const { return page_offsets.empty(); }
+
+    std::uint64_t GetNumberOfObjects() const { return number_of_objects; }
+
+    std::size_t GetNumberOfPages() const
+    {
+        return page_offsets.empty() ? 0 : page_offsets.size() - 1;
+    }
+
+    // Decodes the count objects of a page
+    void Decode(const std::size_t page, const std::size_t count, ObjectT *objects) const
+    {
+        BOOST_ASSERT(page + 1 < page_offsets.size());
+
+        const auto *input = pages.data() + page_offsets[page];
+        Words words{};
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            for (auto &word : words)
+            {
+                word += unzigzag(readVarint(input));
+            }
+            std::memcpy(static_cast<void *>(objects + index), words.data(), sizeof(ObjectT));
+        }
+        BOOST_ASSERT(input == pages.data() + page_offsets[page + 1]);
+    }
+
+    /**
+     * Encodes count objects as one page into output, which needs to hold count times
+     * MAX_ENCODED_OBJECT_SIZE bytes. If output is null only the size is computed.
+     * Returns the number of bytes of the page.
+     */
+    static std::size_t Encode(const ObjectT *objects, const std::size_t count, std::uint8_t *output)
+    {
+        std::size_t size = 0;
+        Words previous{};
+        Words words;
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            std::memcpy(words.data(), objects + index, sizeof(ObjectT));
+            for (std::size_t word = 0; word < WORDS_PER_OBJECT; ++word)
+            {
+                size += writeVarint(zigzag(words[word] - previous[word]),
+                                    output == nullptr ? nullptr : output + size);
+            }
+            previous = words;
+        }
+        return size;
+    }
+
+  private:
+    static std::uint32_t zigzag(const std::uint32_t delta)
+    {
+        return (delta << 1) ^ static_cast<std::uint32_t>(static_cast<std::int32_t>(delta) >> 31);
+    }
+
+    static std::uint32_t unzigzag(const std::uint32_t value)
+    {
+        return (value >> 1) ^ (0u - (value & 1u));
+    }
+
+    static std::size_t writeVarint(std::uint32_t value, std::uint8_t *output)
+    {
+        std::size_t size = 1;
+        while (value >= 0x80)
+        {
+            if (output)
+                *output++ = static_cast<std::uint8_t>(value | 0x80);
+            value >>= 7;
+            ++size;
+        }
+        if (output)
+            *output = static_cast<std::uint8_t>(value);
+        return size;
+    }
+
+    static std::uint32_t readVarint(const std::uint8_t *&input)
+    {
+        std::uint32_t value = *input++;
+        if (value < 0x80)
+            return value;
+
+        value &= 0x7f;
+        for (unsigned shift = 7;; shift += 7)
+        {
+            const std::uint32_t byte = *input++;
+            value |= (byte & 0x7f) << shift;
+            if (byte < 0x80)
+                return value;
+        }
+    }
+
+    util::vector_view<const std::uint64_t> page_offsets;
+    util::vector_view<const std::uint8_t> pages;
+    std::uint64_t number_of_objects;
+};
+} // namespace util
+} // namespace osrm
+
+#endif
@@ -132,7 +132,7 @@ inline std::ostream &operator<<(std::ostream &out, const Mask lane_type)
 namespace std
 {
 inline std::ostream &operator<<(std::ostream &out,
-                                const std::vector<osrm::engine::guidance::RouteStep> &steps)
+                                const osrm::engine::guidance::RouteSteps &steps)
 {
     out << "{";
     int segment = 0;
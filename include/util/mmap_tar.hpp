@@ -3,6 +3,8 @@
 
 #include "storage/tar.hpp"
 
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
 #include "util/mmap_file.hpp"
 
 #include <boost/iostreams/device/mapped_file.hpp>
@@ -31,6 +33,11 @@ inline DataMap mmapTarFile(const boost::filesystem::path &path,
 
     for (const auto &entry : entries)
     {
+        if (entry.compressed)
+        {
+            throw util::exception(path.string() + " : " + entry.name +
+                                  ": Compressed entries can't be mapped" + SOURCE_REF);
+        }
         auto begin = raw_file.data() + entry.offset;
         auto end = begin + entry.size;
         map[entry.name] = DataRange{begin, end};
@@ -0,0 +1,123 @@
+#ifndef OSRM_UTIL_MONOTONIC_ARENA_HPP
+#define OSRM_UTIL_MONOTONIC_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace osrm
+{
+namespace util
+{
+
+// Hands out memory from a few large blocks and releases all of it at once.
+//
+// Route assembly creates many small vectors per step that all die together once the response
+// was rendered. Every thread owns an arena that containers with an ArenaAllocator use while an
+// ArenaScope is active, so these vectors don't go through malloc and free one by one.
+class MonotonicArena
+{
+  public:
+    MonotonicArena() = default;
+    MonotonicArena(const MonotonicArena &) = delete;
+    MonotonicArena &operator=(const MonotonicArena &) = delete;
+
+    void *Allocate(std::size_t bytes, std::size_t alignment);
+
+    // Makes the memory of all blocks available again, large peaks are returned to the system
+    void Reset();
+
+    std::uint64_t GetNumberOfAllocations() const { return number_of_allocations; }
+    std::size_t GetAllocatedBytes() const { return allocated_bytes; }
+    std::size_t GetCapacity() const;
+
+    // Arena of the calling thread while an ArenaScope is active, nullptr otherwise
+    static MonotonicArena *Current();
+
+  private:
+    static constexpr std::size_t MIN_BLOCK_SIZE = 64 * 1024;
+    // blocks beyond this capacity are freed on Reset
+    static constexpr std::size_t MAX_RETAINED_CAPACITY = 16 * 1024 * 1024;
+
+    struct Block
+    {
+        std::unique_ptr<char[]> data;
+        std::size_t size;
+    };
+
+    std::vector<Block> blocks;
+    std::size_t current_block = 0;
+    std::size_t offset = 0;
+    std::uint64_t number_of_allocations = 0;
+    std::size_t allocated_bytes = 0;
+};
+
+// Activates the arena of the calling thread. The outermost scope resets it when it ends, so
+// everything allocated from the arena needs to be destroyed before.
+class ArenaScope
+{
+  public:
+    ArenaScope();
+    ~ArenaScope();
+    ArenaScope(const ArenaScope &) = delete;
+    ArenaScope &operator=(const ArenaScope &) = delete;
+
+    MonotonicArena &GetArena() const { return arena; }
+
+  private:
+    MonotonicArena &arena;
+};
+
+// Allocates from the arena that was active when the allocator was created, or from the heap
+// outside of an ArenaScope. Deallocation is a no-op for arena memory.
+template <typename T> class ArenaAllocator
+{
+  public:
+    using value_type = T;
+
+    ArenaAllocator() noexcept : arena(MonotonicArena::Current()) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) noexcept : arena(other.arena)
+    {
+    }
+
+    T *allocate(const std::size_t count)
+    {
+        if (arena)
+            return static_cast<T *>(arena->Allocate(count * sizeof(T), alignof(T)));
+        return static_cast<T *>(::operator new(count * sizeof(T)));
+    }
+
+    void deallocate(T *pointer, const std::size_t) noexcept
+    {
+        if (!arena)
+            ::operator delete(pointer);
+    }
+
+    // copies made after the scope ended must not point into the arena
+    ArenaAllocator select_on_container_copy_construction() const { return ArenaAllocator{}; }
+
+    template <typename U> bool operator==(const ArenaAllocator<U> &other) const
+    {
+        return arena == other.arena;
+    }
+
+    template <typename U> bool operator!=(const ArenaAllocator<U> &other) const
+    {
+        return arena != other.arena;
+    }
+
+  private:
+    template <typename U> friend class ArenaAllocator;
+
+    MonotonicArena *arena;
+};
+
+template <typename T> using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+} // namespace util
+} // namespace osrm
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef OSRM_UTIL_NUMA_HPP
+#define OSRM_UTIL_NUMA_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace util
+{
+
+// A NUMA node with the CPUs that access its memory without crossing the socket interconnect
+struct NumaNode
+{
+    unsigned id;
+    std::vector<unsigned> cpus;
+};
+
+// Parses a kernel CPU list like "0-15,32-47". Throws on malformed lists.
+std::vector<unsigned> parseCPUList(const std::string &cpu_list);
+
+// The NUMA nodes with CPUs from /sys/devices/system/node, a single node if the platform has
+// no NUMA information
+std::vector<NumaNode> getNumaNodes();
+
+// The node of the CPU the calling thread runs on, or the node it was pinned to
+unsigned getCurrentNumaNode();
+
+// Restricts the calling thread to the CPUs of the node. Returns false if the kernel refused.
+bool pinThreadToNumaNode(const NumaNode &node);
+
+// Places the pages of an untouched mapping on the node when they are first written. Returns
+// false if the kernel refused or the platform has no NUMA support.
+bool bindMemoryToNumaNode(void *address, const std::uint64_t size, const unsigned node);
+} // namespace util
+} // namespace osrm
+
+#endif
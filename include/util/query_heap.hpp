@@ -1,14 +1,24 @@
 #ifndef OSRM_UTIL_QUERY_HEAP_HPP
 #define OSRM_UTIL_QUERY_HEAP_HPP
 
+#include "util/msb.hpp"
+
 #include <boost/assert.hpp>
 #include <boost/heap/d_ary_heap.hpp>
 #include <boost/optional.hpp>
 
 #include <algorithm>
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
 #include <limits>
 #include <map>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace osrm
@@ -16,19 +26,21 @@ namespace osrm
 namespace util
 {
 
+// Dense index that is cleared in constant time: an entry is only valid if it was written
+// since the last Clear(). The stamps are reset only when the generation counter wraps around.
 template <typename NodeID, typename Key> class GenerationArrayStorage
 {
     using GenerationCounter = std::uint16_t;
 
   public:
     explicit GenerationArrayStorage(std::size_t size)
-        : positions(size, 0), generation(1), generations(size, 0)
+        : generation(1), generations(size, 0), positions(size, 0)
     {
     }
 
     Key &operator[](NodeID node)
     {
-        generation[node] = generation;
+        generations[node] = generation;
         return positions[node];
     }
 
@@ -188,20 +200,379 @@ class TwoLevelStorage
     OverlayIndexStorage<NodeID, Key> overlay;
 };
 
+// Heap policies order the nodes of a QueryHeap by weight. The heaps only see the position of a
+// node in the insertion order, these keys are dense and start at 0 after every Clear().
+// Entries with the same weight are popped in insertion order, except for the radix heap.
+
+// Mutable boost::heap::d_ary_heap, every entry is reached through a handle
+template <unsigned Arity> struct BoostDAryHeapPolicy
+{
+    template <typename Weight, typename Key> class Heap
+    {
+        using HeapData = std::pair<Weight, Key>;
+        using HeapContainer = boost::heap::d_ary_heap<HeapData,
+                                                      boost::heap::arity<Arity>,
+                                                      boost::heap::mutable_<true>,
+                                                      boost::heap::compare<std::greater<HeapData>>>;
+        using HeapHandle = typename HeapContainer::handle_type;
+
+      public:
+        void Clear()
+        {
+            heap.clear();
+            handles.clear();
+        }
+
+        std::size_t Size() const { return heap.size(); }
+
+        void Push(const Key key, const Weight weight)
+        {
+            BOOST_ASSERT(static_cast<std::size_t>(key) == handles.size());
+            handles.push_back(heap.push(std::make_pair(weight, key)));
+        }
+
+        Key Top() const { return heap.top().second; }
+
+        Weight TopWeight() const { return heap.top().first; }
+
+        void Pop()
+        {
+            const auto key = heap.top().second;
+            heap.pop();
+            handles[key] = NoneHandle();
+        }
+
+        void DecreaseKey(const Key key, const Weight weight)
+        {
+            heap.increase(handles[key], std::make_pair(weight, key));
+        }
+
+        bool Contains(const Key key) const { return handles[key] != NoneHandle(); }
+
+        void RemoveAll()
+        {
+            const auto none_handle = NoneHandle();
+            std::fill(handles.begin(), handles.end(), none_handle);
+            heap.clear();
+        }
+
+      private:
+        HeapHandle NoneHandle() const
+        {
+            // Use end iterator as a reliable "non-existent" handle.
+            // Default-constructed handles are singular and
+            // can only be checked-compared to another singular instance.
+            // Behaviour investigated at https://lists.boost.org/boost-users/2017/08/87787.php,
+            // eventually confirmation at https://stackoverflow.com/a/45622940/151641.
+            // Corrected in https://github.com/Project-OSRM/osrm-backend/pull/4396
+            auto const end_it = const_cast<HeapContainer &>(heap).end(); // non-const iterator
+            return heap.s_handle_from_iterator(end_it);                  // from non-const iterator
+        }
+
+        HeapContainer heap;
+        std::vector<HeapHandle> handles;
+    };
+};
+
+// d-ary heap that keeps the weights inline with the keys and the heap position of every key in
+// a flat array, a decrease-key needs no indirection through handles.
+template <unsigned Arity> struct DAryHeapPolicy
+{
+    static_assert(Arity >= 2, "A heap needs at least two children per node");
+
+    template <typename Weight, typename Key> class Heap
+    {
+        using HeapData = std::pair<Weight, Key>;
+        static constexpr std::size_t NOT_IN_HEAP = std::numeric_limits<std::size_t>::max();
+
+      public:
+        void Clear()
+        {
+            heap.clear();
+            positions.clear();
+        }
+
+        std::size_t Size() const { return heap.size(); }
+
+        void Push(const Key key, const Weight weight)
+        {
+            BOOST_ASSERT(static_cast<std::size_t>(key) == positions.size());
+            positions.push_back(heap.size());
+            heap.emplace_back(weight, key);
+            SiftUp(heap.size() - 1);
+        }
+
+        Key Top() const { return heap.front().second; }
+
+        Weight TopWeight() const { return heap.front().first; }
+
+        void Pop()
+        {
+            positions[heap.front().second] = NOT_IN_HEAP;
+            if (heap.size() > 1)
+            {
+                heap.front() = heap.back();
+                heap.pop_back();
+                SiftDown(0);
+            }
+            else
+            {
+                heap.pop_back();
+            }
+        }
+
+        void DecreaseKey(const Key key, const Weight weight)
+        {
+            const auto position = positions[key];
+            BOOST_ASSERT(position != NOT_IN_HEAP);
+            BOOST_ASSERT(weight <= heap[position].first);
+            heap[position].first = weight;
+            SiftUp(position);
+        }
+
+        bool Contains(const Key key) const { return positions[key] != NOT_IN_HEAP; }
+
+        void RemoveAll()
+        {
+            for (const auto &entry : heap)
+                positions[entry.second] = NOT_IN_HEAP;
+            heap.clear();
+        }
+
+      private:
+        void SiftUp(std::size_t position)
+        {
+            const auto entry = heap[position];
+            while (position > 0)
+            {
+                const auto parent = (position - 1) / Arity;
+                if (!(entry < heap[parent]))
+                    break;
+                heap[position] = heap[parent];
+                positions[heap[position].second] = position;
+                position = parent;
+            }
+            heap[position] = entry;
+            positions[entry.second] = position;
+        }
+
+        void SiftDown(std::size_t position)
+        {
+            const auto entry = heap[position];
+            const auto size = heap.size();
+            while (true)
+            {
+                const auto first_child = position * Arity + 1;
+                if (first_child >= size)
+                    break;
+                const auto last_child = std::min(first_child + Arity, size);
+                auto smallest_child = first_child;
+                for (auto child = first_child + 1; child < last_child; ++child)
+                {
+                    if (heap[child] < heap[smallest_child])
+                        smallest_child = child;
+                }
+                if (!(heap[smallest_child] < entry))
+                    break;
+                heap[position] = heap[smallest_child];
+                positions[heap[position].second] = position;
+                position = smallest_child;
+            }
+            heap[position] = entry;
+            positions[entry.second] = position;
+        }
+
+        std::vector<HeapData> heap;
+        std::vector<std::size_t> positions;
+    };
+};
+
+// Radix heap for integer weights. Entries are kept in buckets by the highest bit in which their
+// weight differs from the current minimum, so a pop only redistributes the entries of one
+// bucket. A decrease-key inserts the entry again and the outdated one is skipped later.
+//
+// The weights have to be monotone: nothing can be inserted with a smaller weight than the last
+// one popped. This holds for Dijkstra searches with non-negative edge weights. Inserting below
+// the current minimum is allowed but redistributes all entries. Entries with the same weight
+// are popped in any order.
+struct RadixHeapPolicy
+{
+    template <typename Weight, typename Key> class Heap
+    {
+        static_assert(std::is_integral<Weight>::value, "Radix heaps need integer weights");
+        using Radix = typename std::make_unsigned<Weight>::type;
+        static constexpr std::size_t NUMBER_OF_BITS = sizeof(Radix) * CHAR_BIT;
+        // maps the weights to unsigned integers in the same order
+        static constexpr Radix SIGN_BIT =
+            std::is_signed<Weight>::value ? Radix{1} << (NUMBER_OF_BITS - 1) : Radix{0};
+
+        struct Entry
+        {
+            Weight weight;
+            Key key;
+        };
+
+      public:
+        void Clear()
+        {
+            for (auto &bucket : buckets)
+                bucket.clear();
+            weights.clear();
+            removed.clear();
+            size = 0;
+            last = 0;
+            popped = 0;
+        }
+
+        std::size_t Size() const { return size; }
+
+        void Push(const Key key, const Weight weight)
+        {
+            BOOST_ASSERT(static_cast<std::size_t>(key) == weights.size());
+            weights.push_back(weight);
+            removed.push_back(false);
+            ++size;
+            Insert(key, weight);
+        }
+
+        Key Top() const { return buckets.front().back().key; }
+
+        Weight TopWeight() const { return buckets.front().back().weight; }
+
+        void Pop()
+        {
+            popped = last;
+            removed[buckets.front().back().key] = true;
+            buckets.front().pop_back();
+            --size;
+            Normalize();
+        }
+
+        void DecreaseKey(const Key key, const Weight weight)
+        {
+            BOOST_ASSERT(!removed[key]);
+            BOOST_ASSERT(weight <= weights[key]);
+            weights[key] = weight;
+            Insert(key, weight);
+        }
+
+        bool Contains(const Key key) const { return !removed[key]; }
+
+        void RemoveAll()
+        {
+            for (auto &bucket : buckets)
+            {
+                for (const auto &entry : bucket)
+                    removed[entry.key] = true;
+                bucket.clear();
+            }
+            size = 0;
+            last = popped;
+        }
+
+      private:
+        static Radix ToRadix(const Weight weight) { return static_cast<Radix>(weight) ^ SIGN_BIT; }
+
+        std::size_t GetBucket(const Weight weight) const
+        {
+            const auto radix = ToRadix(weight);
+            return radix == last ? 0 : msb(static_cast<Radix>(radix ^ last)) + 1;
+        }
+
+        bool IsOutdated(const Entry &entry) const
+        {
+            return removed[entry.key] || weights[entry.key] != entry.weight;
+        }
+
+        void Insert(const Key key, const Weight weight)
+        {
+            BOOST_ASSERT_MSG(ToRadix(weight) >= popped, "Radix heap weights need to be monotone");
+            if (ToRadix(weight) < last)
+                Rebase(ToRadix(weight));
+            buckets[GetBucket(weight)].push_back({weight, key});
+            Normalize();
+        }
+
+        // Lowers the minimum all buckets are relative to
+        void Rebase(const Radix minimum)
+        {
+            std::vector<Entry> entries;
+            for (auto &bucket : buckets)
+            {
+                for (const auto &entry : bucket)
+                {
+                    if (!IsOutdated(entry))
+                        entries.push_back(entry);
+                }
+                bucket.clear();
+            }
+
+            last = minimum;
+            for (const auto &entry : entries)
+                buckets[GetBucket(entry.weight)].push_back(entry);
+        }
+
+        // Makes sure the last entry of the first bucket is the minimum if the heap is not empty
+        void Normalize()
+        {
+            auto &first_bucket = buckets.front();
+            while (true)
+            {
+                while (!first_bucket.empty() && IsOutdated(first_bucket.back()))
+                    first_bucket.pop_back();
+                if (!first_bucket.empty() || size == 0)
+                    return;
+
+                auto bucket = std::find_if(std::next(buckets.begin()),
+                                           buckets.end(),
+                                           [](const auto &bucket) { return !bucket.empty(); });
+                BOOST_ASSERT(bucket != buckets.end());
+
+                auto minimum = std::numeric_limits<Radix>::max();
+                bool found = false;
+                for (const auto &entry : *bucket)
+                {
+                    if (!IsOutdated(entry))
+                    {
+                        minimum = std::min(minimum, ToRadix(entry.weight));
+                        found = true;
+                    }
+                }
+
+                if (found)
+                {
+                    // all entries of the bucket go into smaller buckets
+                    last = minimum;
+                    for (const auto &entry : *bucket)
+                    {
+                        if (!IsOutdated(entry))
+                            buckets[GetBucket(entry.weight)].push_back(entry);
+                    }
+                }
+                bucket->clear();
+            }
+        }
+
+        std::array<std::vector<Entry>, NUMBER_OF_BITS + 1> buckets;
+        std::vector<Weight> weights;
+        std::vector<bool> removed;
+        std::size_t size = 0;
+        // weight that all buckets are relative to, the minimum if the heap is not empty
+        Radix last = 0;
+        Radix popped = 0;
+    };
+};
+
 template <typename NodeID,
           typename Key,
           typename Weight,
           typename Data,
-          typename IndexStorage = ArrayStorage<NodeID, NodeID>>
+          typename IndexStorage = ArrayStorage<NodeID, NodeID>,
+          typename HeapPolicy = DAryHeapPolicy<4>>
 class QueryHeap
 {
   private:
-    using HeapData = std::pair<Weight, Key>;
-    using HeapContainer = boost::heap::d_ary_heap<HeapData,
-                                                  boost::heap::arity<4>,
-                                                  boost::heap::mutable_<true>,
-                                                  boost::heap::compare<std::greater<HeapData>>>;
-    using HeapHandle = typename HeapContainer::handle_type;
+    using HeapContainer = typename HeapPolicy::template Heap<Weight, Key>;
 
   public:
     using WeightType = Weight;
@@ -209,7 +580,6 @@ class QueryHeap
 
     struct HeapNode
     {
-        HeapHandle handle;
         NodeID node;
         Weight weight;
         Data data;
@@ -222,12 +592,12 @@ class QueryHeap
 
     void Clear()
     {
-        heap.clear();
+        heap.Clear();
         inserted_nodes.clear();
         node_index.Clear();
     }
 
-    std::size_t Size() const { return heap.size(); }
+    std::size_t Size() const { return heap.Size(); }
 
     bool Empty() const { return 0 == Size(); }
 
@@ -235,8 +605,8 @@ class QueryHeap
     {
         BOOST_ASSERT(node < std::numeric_limits<NodeID>::max());
         const auto index = static_cast<Key>(inserted_nodes.size());
-        const auto handle = heap.push(std::make_pair(weight, index));
-        inserted_nodes.emplace_back(HeapNode{handle, node, weight, data});
+        heap.Push(index, weight);
+        inserted_nodes.emplace_back(HeapNode{node, weight, data});
         node_index[node] = index;
     }
 
@@ -271,16 +641,7 @@ class QueryHeap
     {
         BOOST_ASSERT(WasInserted(node));
         const Key index = node_index.peek_index(node);
-
-        // Use end iterator as a reliable "non-existent" handle.
-        // Default-constructed handles are singular and
-        // can only be checked-compared to another singular instance.
-        // Behaviour investigated at https://lists.boost.org/boost-users/2017/08/87787.php,
-        // eventually confirmation at https://stackoverflow.com/a/45622940/151641.
-        // Corrected in https://github.com/Project-OSRM/osrm-backend/pull/4396
-        auto const end_it = const_cast<HeapContainer &>(heap).end();  // non-const iterator
-        auto const none_handle = heap.s_handle_from_iterator(end_it); // from non-const iterator
-        return inserted_nodes[index].handle == none_handle;
+        return !heap.Contains(index);
     }
 
     bool WasInserted(const NodeID node) const
@@ -317,56 +678,50 @@ class QueryHeap
 
     NodeID Min() const
     {
-        BOOST_ASSERT(!heap.empty());
-        return inserted_nodes[heap.top().second].node;
+        BOOST_ASSERT(!Empty());
+        return inserted_nodes[heap.Top()].node;
     }
 
     Weight MinKey() const
     {
-        BOOST_ASSERT(!heap.empty());
-        return heap.top().first;
+        BOOST_ASSERT(!Empty());
+        return heap.TopWeight();
     }
 
     NodeID DeleteMin()
     {
-        BOOST_ASSERT(!heap.empty());
-        const Key removedIndex = heap.top().second;
-        heap.pop();
-        inserted_nodes[removedIndex].handle = heap.s_handle_from_iterator(heap.end());
+        BOOST_ASSERT(!Empty());
+        const Key removedIndex = heap.Top();
+        heap.Pop();
         return inserted_nodes[removedIndex].node;
     }
 
     HeapNode &DeleteMinGetHeapNode()
     {
-        BOOST_ASSERT(!heap.empty());
-        const Key removedIndex = heap.top().second;
-        heap.pop();
-        inserted_nodes[removedIndex].handle = heap.s_handle_from_iterator(heap.end());
+        BOOST_ASSERT(!Empty());
+        const Key removedIndex = heap.Top();
+        heap.Pop();
         return inserted_nodes[removedIndex];
     }
 
-    void DeleteAll()
-    {
-        auto const none_handle = heap.s_handle_from_iterator(heap.end());
-        std::for_each(inserted_nodes.begin(), inserted_nodes.end(), [&none_handle](auto &node) {
-            node.handle = none_handle;
-        });
-        heap.clear();
-    }
+    void DeleteAll() { heap.RemoveAll(); }
 
     void DecreaseKey(NodeID node, Weight weight)
     {
         BOOST_ASSERT(!WasRemoved(node));
         const auto index = node_index.peek_index(node);
-        auto &reference = inserted_nodes[index];
-        reference.weight = weight;
-        heap.increase(reference.handle, std::make_pair(weight, index));
+        inserted_nodes[index].weight = weight;
+        heap.DecreaseKey(index, weight);
     }
 
     void DecreaseKey(const HeapNode &heapNode)
     {
         BOOST_ASSERT(!WasRemoved(heapNode.node));
-        heap.increase(heapNode.handle, std::make_pair(heapNode.weight, (*heapNode.handle).second));
+        // heap nodes are only handed out by reference, their position is their index
+        BOOST_ASSERT(&heapNode >= inserted_nodes.data() &&
+                     &heapNode < inserted_nodes.data() + inserted_nodes.size());
+        const auto index = static_cast<Key>(&heapNode - inserted_nodes.data());
+        heap.DecreaseKey(index, heapNode.weight);
     }
 
   private:
@@ -0,0 +1,150 @@
+#ifndef OSRM_UTIL_SHARDED_CLOCK_CACHE_HPP
+#define OSRM_UTIL_SHARDED_CLOCK_CACHE_HPP
+
+#include <boost/optional.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace util
+{
+
+// Bounded cache that is shared by all threads querying a dataset.
+//
+// Entries are spread over shards that are locked independently, each shard evicts entries with
+// the CLOCK algorithm: an entry that was used since the clock hand passed it last gets a second
+// chance. Values are copied out of the cache, large values should be shared pointers.
+//
+// Hits and misses are counted per shard under its lock, every shard has its own cache lines, so
+// lookups of different shards don't write to shared memory.
+template <typename Key, typename Value, typename Hash = std::hash<Key>> class ShardedClockCache
+{
+  public:
+    static constexpr std::size_t NUMBER_OF_SHARDS = 16;
+
+    // The capacity is rounded up to a multiple of the number of shards, 0 disables the cache
+    explicit ShardedClockCache(const std::size_t capacity)
+        : shard_capacity((capacity + NUMBER_OF_SHARDS - 1) / NUMBER_OF_SHARDS)
+    {
+        for (auto &shard : shards)
+            shard.entries.reserve(shard_capacity);
+    }
+
+    boost::optional<Value> Find(const Key &key)
+    {
+        if (shard_capacity == 0)
+            return boost::none;
+
+        auto &shard = GetShard(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        const auto position = shard.positions.find(key);
+        if (position == shard.positions.end())
+        {
+            ++shard.misses;
+            return boost::none;
+        }
+
+        auto &entry = shard.entries[position->second];
+        entry.referenced = true;
+        ++shard.hits;
+        return entry.value;
+    }
+
+    // Keeps the entry that is cached already if another thread inserted the same key
+    void Insert(const Key &key, Value value)
+    {
+        if (shard_capacity == 0)
+            return;
+
+        auto &shard = GetShard(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        if (shard.positions.count(key) > 0)
+            return;
+
+        if (shard.entries.size() < shard_capacity)
+        {
+            shard.positions.emplace(key, shard.entries.size());
+            shard.entries.push_back({key, false, std::move(value)});
+            return;
+        }
+
+        while (shard.entries[shard.hand].referenced)
+        {
+            shard.entries[shard.hand].referenced = false;
+            shard.hand = (shard.hand + 1) % shard.entries.size();
+        }
+
+        auto &victim = shard.entries[shard.hand];
+        shard.positions.erase(victim.key);
+        shard.positions.emplace(key, shard.hand);
+        victim = {key, false, std::move(value)};
+        shard.hand = (shard.hand + 1) % shard.entries.size();
+    }
+
+    std::size_t GetCapacity() const { return NUMBER_OF_SHARDS * shard_capacity; }
+
+    std::size_t GetSize() const
+    {
+        return Sum([](const Shard &shard) { return shard.entries.size(); });
+    }
+
+    std::uint64_t GetHits() const
+    {
+        return Sum([](const Shard &shard) { return shard.hits; });
+    }
+
+    std::uint64_t GetMisses() const
+    {
+        return Sum([](const Shard &shard) { return shard.misses; });
+    }
+
+  private:
+    struct Entry
+    {
+        Key key;
+        bool referenced;
+        Value value;
+    };
+
+    struct alignas(64) Shard
+    {
+        mutable std::mutex mutex;
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::vector<Entry> entries;
+        std::unordered_map<Key, std::size_t, Hash> positions;
+        std::size_t hand = 0;
+    };
+
+    Shard &GetShard(const Key &key) { return shards[Hash{}(key) % NUMBER_OF_SHARDS]; }
+
+    template <typename Accessor> std::uint64_t Sum(Accessor accessor) const
+    {
+        std::uint64_t sum = 0;
+        for (const auto &shard : shards)
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            sum += accessor(shard);
+        }
+        return sum;
+    }
+
+    const std::size_t shard_capacity;
+    std::array<Shard, NUMBER_OF_SHARDS> shards;
+};
+
+template <typename Key, typename Value, typename Hash>
+constexpr std::size_t ShardedClockCache<Key, Value, Hash>::NUMBER_OF_SHARDS;
+} // namespace util
+} // namespace osrm
+
+#endif // OSRM_UTIL_SHARDED_CLOCK_CACHE_HPP
@@ -4,6 +4,7 @@
 #include "storage/tar_fwd.hpp"
 
 #include "util/bearing.hpp"
+#include "util/compressed_leaves.hpp"
 #include "util/coordinate_calculation.hpp"
 #include "util/deallocating_vector.hpp"
 #include "util/exception.hpp"
@@ -13,6 +14,7 @@
 #include "util/rectangle.hpp"
 #include "util/typedefs.hpp"
 #include "util/vector_view.hpp"
+#include "util/vectorized_distance.hpp"
 #include "util/web_mercator.hpp"
 
 #include "osrm/coordinate.hpp"
@@ -23,6 +25,7 @@
 #include <boost/filesystem.hpp>
 #include <boost/format.hpp>
 #include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/thread/tss.hpp>
 
 #include <tbb/blocked_range.h>
 #include <tbb/parallel_for.h>
@@ -30,8 +33,10 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <limits>
 #include <memory>
+#include <numeric>
 #include <queue>
 #include <string>
 #include <vector>
@@ -241,8 +246,8 @@ class StaticRTree
 
         inline bool operator<(const QueryCandidate &other) const
         {
-            // Attn: this is reversed order. std::priority_queue is a
-            // max pq (biggest item at the front)!
+            // Attn: this is reversed order. std::push_heap builds a
+            // max heap (biggest item at the front)!
             return other.squared_min_dist < squared_min_dist;
         }
 
@@ -252,6 +257,31 @@ class StaticRTree
         std::uint32_t segment_index;
     };
 
+    /**
+     * State reused by all nearest queries of a thread: the storage of the traversal queue and
+     * the projected segments of the leaves explored last, indexed by their offset. Leaves are
+     * packed along the Hilbert curve, so queries close to each other, e.g. the coordinates of a
+     * request snapped in Hilbert order, find most of their leaves projected already.
+     */
+    struct NearestQueryCache
+    {
+        static constexpr std::size_t NUMBER_OF_LEAVES = 16;
+
+        struct Leaf
+        {
+            std::uint64_t tree_id = std::numeric_limits<std::uint64_t>::max();
+            std::uint32_t offset = 0;
+            // points into the tree or into decoded_objects for compressed leaves
+            const EdgeDataT *objects = nullptr;
+            std::vector<EdgeDataT> decoded_objects;
+            vectorized::ProjectedSegments segments;
+        };
+
+        std::vector<QueryCandidate> traversal_queue;
+        std::array<Leaf, NUMBER_OF_LEAVES> leaves;
+        vectorized::SegmentDistances segment_distances;
+    };
+
     // Representation of the in-memory search tree
     Vector<TreeNode> m_search_tree;
     // Reference to the actual lon/lat data we need for doing math
@@ -260,8 +290,12 @@ class StaticRTree
     Vector<std::uint64_t> m_tree_level_starts;
     // mmap'd .fileIndex file
     boost::iostreams::mapped_file_source m_objects_region;
-    // This is a view of the EdgeDataT data mmap'd from the .fileIndex file
+    // This is a view of the EdgeDataT data mmap'd from the .fileIndex file or loaded into memory
     util::vector_view<const EdgeDataT> m_objects;
+    // Replaces m_objects if the leaves were loaded into memory compressed
+    CompressedLeaves<EdgeDataT> m_compressed_leaves;
+    // Identifies the tree in the per thread query caches
+    std::uint64_t m_id = GetNextId();
 
   public:
     StaticRTree() = default;
@@ -484,6 +518,95 @@ class StaticRTree
         m_objects = mmapFile<EdgeDataT>(on_disk_file_name, m_objects_region);
     }
 
+    /**
+     * Constructs an r-tree from blocks of memory loaded by someone else
+     * that also contain the leaves (osrm-datastore --rtree-leaves memory)
+     */
+    explicit StaticRTree(Vector<TreeNode> search_tree_,
+                         Vector<std::uint64_t> tree_level_starts,
+                         util::vector_view<const EdgeDataT> objects,
+                         const Vector<Coordinate> &coordinate_list)
+        : m_search_tree(std::move(search_tree_)),
+          m_coordinate_list(coordinate_list.data(), coordinate_list.size()),
+          m_tree_level_starts(std::move(tree_level_starts)), m_objects(std::move(objects))
+    {
+        BOOST_ASSERT(m_tree_level_starts.size() >= 2);
+    }
+
+    /**
+     * Constructs an r-tree from blocks of memory loaded by someone else
+     * that also contain the compressed leaves (osrm-datastore --rtree-leaves compressed)
+     */
+    explicit StaticRTree(Vector<TreeNode> search_tree_,
+                         Vector<std::uint64_t> tree_level_starts,
+                         CompressedLeaves<EdgeDataT> compressed_leaves,
+                         const Vector<Coordinate> &coordinate_list)
+        : m_search_tree(std::move(search_tree_)),
+          m_coordinate_list(coordinate_list.data(), coordinate_list.size()),
+          m_tree_level_starts(std::move(tree_level_starts)),
+          m_compressed_leaves(std::move(compressed_leaves))
+    {
+        BOOST_ASSERT(m_tree_level_starts.size() >= 2);
+    }
+
+    /**
+     * Constructs an empty RTree with compressed leaves for de-serialization.
+     */
+    template <typename = std::enable_if<Ownership == storage::Ownership::Container>>
+    explicit StaticRTree(CompressedLeaves<EdgeDataT> compressed_leaves,
+                         const Vector<Coordinate> &coordinate_list)
+        : m_coordinate_list(coordinate_list.data(), coordinate_list.size()),
+          m_compressed_leaves(std::move(compressed_leaves))
+    {
+    }
+
+    /**
+     * Computes the offsets of the leaves compressed page by page, see CompressedLeaves.
+     * Fills page_offsets with the offset of every leaf and the end of the last leaf,
+     * returns the size of all compressed leaves.
+     */
+    static std::uint64_t GetCompressedLeafOffsets(const util::vector_view<const EdgeDataT> &objects,
+                                                  std::vector<std::uint64_t> &page_offsets)
+    {
+        const std::size_t number_of_pages = (objects.size() + LEAF_NODE_SIZE - 1) / LEAF_NODE_SIZE;
+        page_offsets.resize(number_of_pages + 1);
+        page_offsets.front() = 0;
+        tbb::parallel_for(
+            tbb::blocked_range<std::size_t>(0, number_of_pages),
+            [&objects, &page_offsets](const tbb::blocked_range<std::size_t> &range) {
+                for (auto page = range.begin(), end = range.end(); page != end; ++page)
+                {
+                    const auto first = page * LEAF_NODE_SIZE;
+                    const auto count =
+                        std::min<std::size_t>(LEAF_NODE_SIZE, objects.size() - first);
+                    page_offsets[page + 1] =
+                        CompressedLeaves<EdgeDataT>::Encode(objects.data() + first, count, nullptr);
+                }
+            });
+        std::partial_sum(page_offsets.begin(), page_offsets.end(), page_offsets.begin());
+        return page_offsets.back();
+    }
+
+    // Compresses the leaves into pages at the offsets computed by GetCompressedLeafOffsets
+    static void CompressLeaves(const util::vector_view<const EdgeDataT> &objects,
+                               const std::vector<std::uint64_t> &page_offsets,
+                               std::uint8_t *pages)
+    {
+        BOOST_ASSERT(!page_offsets.empty());
+        tbb::parallel_for(
+            tbb::blocked_range<std::size_t>(0, page_offsets.size() - 1),
+            [&objects, &page_offsets, pages](const tbb::blocked_range<std::size_t> &range) {
+                for (auto page = range.begin(), end = range.end(); page != end; ++page)
+                {
+                    const auto first = page * LEAF_NODE_SIZE;
+                    const auto count =
+                        std::min<std::size_t>(LEAF_NODE_SIZE, objects.size() - first);
+                    CompressedLeaves<EdgeDataT>::Encode(
+                        objects.data() + first, count, pages + page_offsets[page]);
+                }
+            });
+    }
+
     /* Returns all features inside the bounding box.
        Rectangle needs to be projected!*/
     std::vector<EdgeDataT> SearchInBox(const Rectangle &search_rectangle) const
@@ -499,6 +622,7 @@ class StaticRTree
 
         std::queue<TreeIndex> traversal_queue;
         traversal_queue.push(TreeIndex{});
+        std::vector<EdgeDataT> decoded_objects;
 
         while (!traversal_queue.empty())
         {
@@ -512,9 +636,11 @@ class StaticRTree
 
                 // Note: irange is [start,finish), so we need to +1 to make sure we visit the
                 // last
-                for (const auto current_child_index : child_indexes(current_tree_index))
+                const auto number_of_objects = child_indexes(current_tree_index).size();
+                const auto *objects = GetLeafObjects(current_tree_index, decoded_objects);
+                for (const auto object_index : irange<std::size_t>(0, number_of_objects))
                 {
-                    const auto &current_edge = m_objects[current_child_index];
+                    const auto &current_edge = objects[object_index];
 
                     // we don't need to project the coordinates here,
                     // because we use the unprojected rectangle to test against
@@ -573,17 +699,26 @@ class StaticRTree
                                    const FilterT filter,
                                    const TerminationT terminate) const
     {
+        static boost::thread_specific_ptr<NearestQueryCache> thread_cache;
+        if (!thread_cache.get())
+        {
+            thread_cache.reset(new NearestQueryCache());
+        }
+        auto &cache = *thread_cache;
+
         std::vector<EdgeDataT> results;
         auto projected_coordinate = web_mercator::fromWGS84(input_coordinate);
         Coordinate fixed_projected_coordinate{projected_coordinate};
-        // initialize queue with root element
-        std::priority_queue<QueryCandidate> traversal_queue;
-        traversal_queue.push(QueryCandidate{0, TreeIndex{}});
+        // initialize queue with root element, the queue is a heap in the reused storage
+        auto traversal_queue = std::move(cache.traversal_queue);
+        traversal_queue.clear();
+        traversal_queue.push_back(QueryCandidate{0, TreeIndex{}});
 
         while (!traversal_queue.empty())
         {
-            QueryCandidate current_query_node = traversal_queue.top();
-            traversal_queue.pop();
+            std::pop_heap(traversal_queue.begin(), traversal_queue.end());
+            QueryCandidate current_query_node = traversal_queue.back();
+            traversal_queue.pop_back();
 
             const TreeIndex &current_tree_index = current_query_node.tree_index;
             if (!current_query_node.is_segment())
@@ -593,6 +728,8 @@ class StaticRTree
                     ExploreLeafNode(current_tree_index,
                                     fixed_projected_coordinate,
                                     projected_coordinate,
+                                    GetCachedLeaf(current_tree_index, cache).segments,
+                                    cache.segment_distances,
                                     traversal_queue);
                 }
                 else
@@ -604,7 +741,9 @@ class StaticRTree
             else
             { // current candidate is an actual road segment
                 // We deliberatly make a copy here, we mutate the value below
-                auto edge_data = m_objects[current_query_node.segment_index];
+                const auto &leaf = GetCachedLeaf(current_tree_index, cache);
+                auto edge_data = leaf.objects[current_query_node.segment_index -
+                                              current_tree_index.offset * LEAF_NODE_SIZE];
                 const auto &current_candidate =
                     CandidateSegment{current_query_node.fixed_projected_coordinate, edge_data};
 
@@ -629,6 +768,7 @@ class StaticRTree
             }
         }
 
+        cache.traversal_queue = std::move(traversal_queue);
         return results;
     }
 
@@ -639,37 +779,94 @@ class StaticRTree
      * by the value of LEAF_NODE_SIZE, as we'll calculate the euclidean distance
      * for every child of each leaf node visited.
      */
-    template <typename QueueT>
     void ExploreLeafNode(const TreeIndex &leaf_id,
                          const Coordinate &projected_input_coordinate_fixed,
                          const FloatCoordinate &projected_input_coordinate,
-                         QueueT &traversal_queue) const
+                         const vectorized::ProjectedSegments &projected_segments,
+                         vectorized::SegmentDistances &distances,
+                         std::vector<QueryCandidate> &traversal_queue) const
     {
         // Check that we're actually looking at the bottom level of the tree
         BOOST_ASSERT(is_leaf(leaf_id));
 
-        for (const auto i : child_indexes(leaf_id))
+        const auto segment_indexes = child_indexes(leaf_id);
+        BOOST_ASSERT(projected_segments.size() == segment_indexes.size());
+
+        // the distances of all segments of the leaf at once
+        vectorized::projectOnSegments(projected_segments,
+                                      projected_input_coordinate,
+                                      projected_input_coordinate_fixed,
+                                      distances);
+
+        for (const auto i : segment_indexes)
+        {
+            const auto offset = i - segment_indexes.front();
+            BOOST_ASSERT(i < std::numeric_limits<std::uint32_t>::max());
+            traversal_queue.push_back(
+                QueryCandidate{distances.squared_distances[offset],
+                               leaf_id,
+                               static_cast<std::uint32_t>(i),
+                               Coordinate{FixedLongitude{distances.nearest_lon[offset]},
+                                          FixedLatitude{distances.nearest_lat[offset]}}});
+            std::push_heap(traversal_queue.begin(), traversal_queue.end());
+        }
+    }
+
+    /**
+     * Returns the objects of a leaf, compressed leaves are decoded into decoded_objects.
+     */
+    const EdgeDataT *GetLeafObjects(const TreeIndex &leaf_id,
+                                    std::vector<EdgeDataT> &decoded_objects) const
+    {
+        BOOST_ASSERT(is_leaf(leaf_id));
+
+        const auto indexes = child_indexes(leaf_id);
+        if (m_compressed_leaves.empty())
         {
-            const auto &current_edge = m_objects[i];
+            return m_objects.data() + indexes.front();
+        }
+
+        decoded_objects.resize(indexes.size());
+        m_compressed_leaves.Decode(leaf_id.offset, indexes.size(), decoded_objects.data());
+        return decoded_objects.data();
+    }
 
-            const auto projected_u = web_mercator::fromWGS84(m_coordinate_list[current_edge.u]);
-            const auto projected_v = web_mercator::fromWGS84(m_coordinate_list[current_edge.v]);
+    /**
+     * Returns the objects and projected segments of a leaf from the cache, fills them on a miss.
+     * The first pass over the leaf only reads the coordinates of the segment end points so that
+     * the page of the leaf is read in one go before any projection is computed.
+     */
+    const typename NearestQueryCache::Leaf &GetCachedLeaf(const TreeIndex &leaf_id,
+                                                          NearestQueryCache &cache) const
+    {
+        BOOST_ASSERT(is_leaf(leaf_id));
 
-            FloatCoordinate projected_nearest;
-            std::tie(std::ignore, projected_nearest) =
-                coordinate_calculation::projectPointOnSegment(
-                    projected_u, projected_v, projected_input_coordinate);
+        auto &leaf = cache.leaves[leaf_id.offset % NearestQueryCache::NUMBER_OF_LEAVES];
+        if (leaf.tree_id == m_id && leaf.offset == leaf_id.offset)
+        {
+            return leaf;
+        }
 
-            const auto squared_distance = coordinate_calculation::squaredEuclideanDistance(
-                projected_input_coordinate_fixed, projected_nearest);
-            // distance must be non-negative
-            BOOST_ASSERT(0. <= squared_distance);
-            BOOST_ASSERT(i < std::numeric_limits<std::uint32_t>::max());
-            traversal_queue.push(QueryCandidate{squared_distance,
-                                                leaf_id,
-                                                static_cast<std::uint32_t>(i),
-                                                Coordinate{projected_nearest}});
+        leaf.tree_id = m_id;
+        leaf.offset = leaf_id.offset;
+        leaf.objects = GetLeafObjects(leaf_id, leaf.decoded_objects);
+        auto &segments = leaf.segments;
+        segments.clear();
+        for (const auto index : irange<std::size_t>(0, child_indexes(leaf_id).size()))
+        {
+            const auto &current_edge = leaf.objects[index];
+            segments.push_back(m_coordinate_list[current_edge.u],
+                               m_coordinate_list[current_edge.v]);
         }
+        // web mercator keeps the longitude
+        for (std::size_t index = 0; index < segments.size(); ++index)
+        {
+            segments.source_lat[index] =
+                web_mercator::latToYapprox(FloatLatitude{segments.source_lat[index]});
+            segments.target_lat[index] =
+                web_mercator::latToYapprox(FloatLatitude{segments.target_lat[index]});
+        }
+        return leaf;
     }
 
     /**
@@ -679,30 +876,44 @@ class StaticRTree
      * The closests distance to a box from our point is also the closest distance
      * to the closest line in that box (assuming the boxes hug their contents).
      */
-    template <class QueueT>
     void ExploreTreeNode(const TreeIndex &parent,
                          const Coordinate &fixed_projected_input_coordinate,
-                         QueueT &traversal_queue) const
+                         std::vector<QueryCandidate> &traversal_queue) const
     {
         // Figure out which_id level the parent is on, and it's offset
         // in that level.
         // Check that we're actually looking at the bottom level of the tree
         BOOST_ASSERT(!is_leaf(parent));
 
-        for (const auto child_index : child_indexes(parent))
+        const auto children = child_indexes(parent);
+        const auto first_child = children.front();
+        const auto number_of_children = children.size();
+        BOOST_ASSERT(number_of_children <= BRANCHING_FACTOR);
+
+        // the lower bounds of all children at once, the rectangles are strided by the nodes
+        std::array<std::uint64_t, BRANCHING_FACTOR> squared_lower_bounds;
+        vectorized::squaredRectangleDistances(
+            &m_search_tree[first_child].minimum_bounding_rectangle,
+            sizeof(TreeNode),
+            number_of_children,
+            fixed_projected_input_coordinate,
+            squared_lower_bounds.data());
+
+        for (const auto child_index : children)
         {
-            const auto &child = m_search_tree[child_index];
-
-            const auto squared_lower_bound_to_element =
-                child.minimum_bounding_rectangle.GetMinSquaredDist(
-                    fixed_projected_input_coordinate);
-
-            traversal_queue.push(QueryCandidate{
-                squared_lower_bound_to_element,
+            traversal_queue.push_back(QueryCandidate{
+                squared_lower_bounds[child_index - first_child],
                 TreeIndex(parent.level + 1, child_index - m_tree_level_starts[parent.level + 1])});
+            std::push_heap(traversal_queue.begin(), traversal_queue.end());
         }
     }
 
+    static std::uint64_t GetNextId()
+    {
+        static std::atomic<std::uint64_t> next_id{0};
+        return next_id++;
+    }
+
     std::uint64_t GetLevelSize(const std::size_t level) const
     {
         BOOST_ASSERT(m_tree_level_starts.size() > level + 1);
@@ -726,17 +937,17 @@ class StaticRTree
      */
     range<std::size_t> child_indexes(const TreeIndex &parent) const
     {
-        // If we're looking at a leaf node, the index is from 0 to m_objects.size(),
+        // If we're looking at a leaf node, the index is from 0 to the number of objects,
         // there is only 1 level of object data in the m_objects array
         if (is_leaf(parent))
         {
             const std::uint64_t first_child_index = parent.offset * LEAF_NODE_SIZE;
-            const std::uint64_t end_child_index = std::min(
-                first_child_index + LEAF_NODE_SIZE, static_cast<std::uint64_t>(m_objects.size()));
+            const std::uint64_t end_child_index =
+                std::min(first_child_index + LEAF_NODE_SIZE, GetNumberOfObjects());
 
             BOOST_ASSERT(first_child_index < std::numeric_limits<std::uint32_t>::max());
             BOOST_ASSERT(end_child_index < std::numeric_limits<std::uint32_t>::max());
-            BOOST_ASSERT(end_child_index <= m_objects.size());
+            BOOST_ASSERT(end_child_index <= GetNumberOfObjects());
 
             return irange<std::size_t>(first_child_index, end_child_index);
         }
@@ -757,6 +968,12 @@ class StaticRTree
         }
     }
 
+    std::uint64_t GetNumberOfObjects() const
+    {
+        return m_compressed_leaves.empty() ? m_objects.size()
+                                           : m_compressed_leaves.GetNumberOfObjects();
+    }
+
     bool is_leaf(const TreeIndex &treeindex) const
     {
         BOOST_ASSERT(m_tree_level_starts.size() >= 2);
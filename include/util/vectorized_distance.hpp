@@ -0,0 +1,338 @@
+#ifndef OSRM_UTIL_VECTORIZED_DISTANCE_HPP
+#define OSRM_UTIL_VECTORIZED_DISTANCE_HPP
+
+#include "util/coordinate.hpp"
+#include "util/rectangle.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define OSRM_VECTORIZED_DISTANCE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace osrm
+{
+namespace util
+{
+namespace vectorized
+{
+
+// Segments in structure-of-arrays layout with their end points in web mercator
+struct ProjectedSegments
+{
+    std::vector<double> source_lon;
+    std::vector<double> source_lat;
+    std::vector<double> target_lon;
+    std::vector<double> target_lat;
+
+    std::size_t size() const { return source_lon.size(); }
+
+    void clear()
+    {
+        source_lon.clear();
+        source_lat.clear();
+        target_lon.clear();
+        target_lat.clear();
+    }
+
+    void push_back(const FloatCoordinate &source, const FloatCoordinate &target)
+    {
+        source_lon.push_back(static_cast<double>(source.lon));
+        source_lat.push_back(static_cast<double>(source.lat));
+        target_lon.push_back(static_cast<double>(target.lon));
+        target_lat.push_back(static_cast<double>(target.lat));
+    }
+};
+
+// Nearest points on segments in fixed representation and their squared distances to a location
+struct SegmentDistances
+{
+    std::vector<std::uint64_t> squared_distances;
+    std::vector<std::int32_t> nearest_lon;
+    std::vector<std::int32_t> nearest_lat;
+
+    void resize(const std::size_t size)
+    {
+        squared_distances.resize(size);
+        nearest_lon.resize(size);
+        nearest_lat.resize(size);
+    }
+};
+
+namespace detail
+{
+inline std::uint64_t squaredDistance(const std::int32_t d_lon, const std::int32_t d_lat)
+{
+    return static_cast<std::uint64_t>(static_cast<std::int64_t>(d_lon) * d_lon +
+                                      static_cast<std::int64_t>(d_lat) * d_lat);
+}
+
+inline std::int32_t axisDistance(const std::int32_t value,
+                                 const std::int32_t min_value,
+                                 const std::int32_t max_value)
+{
+    return value < min_value ? min_value - value : (value > max_value ? value - max_value : 0);
+}
+
+// Rounds like toFixed does
+inline std::int32_t toFixed(const double value)
+{
+    return static_cast<std::int32_t>(std::round(value * COORDINATE_PRECISION));
+}
+
+#ifdef OSRM_VECTORIZED_DISTANCE_SSE2
+inline __m128i max_epi32(const __m128i lhs, const __m128i rhs)
+{
+    const auto greater = _mm_cmpgt_epi32(lhs, rhs);
+    return _mm_or_si128(_mm_and_si128(greater, lhs), _mm_andnot_si128(greater, rhs));
+}
+
+inline __m128i abs_epi32(const __m128i value)
+{
+    const auto sign = _mm_srai_epi32(value, 31);
+    return _mm_sub_epi32(_mm_xor_si128(value, sign), sign);
+}
+
+// Squares of four non-negative lanes of lon and lat and their sums as two pairs of 64 bit lanes
+inline void squaredDistances(const __m128i d_lon, const __m128i d_lat, std::uint64_t *out)
+{
+    const auto even = _mm_add_epi64(_mm_mul_epu32(d_lon, d_lon), _mm_mul_epu32(d_lat, d_lat));
+    const auto odd_lon = _mm_srli_epi64(d_lon, 32);
+    const auto odd_lat = _mm_srli_epi64(d_lat, 32);
+    const auto odd =
+        _mm_add_epi64(_mm_mul_epu32(odd_lon, odd_lon), _mm_mul_epu32(odd_lat, odd_lat));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_unpacklo_epi64(even, odd));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 2), _mm_unpackhi_epi64(even, odd));
+}
+
+// std::round of two lanes that fit into 32 bit: rounds halfway cases away from zero
+inline __m128i round_epi32(const __m128d value)
+{
+    const auto truncated = _mm_cvttpd_epi32(value);
+    const auto remainder = _mm_sub_pd(value, _mm_cvtepi32_pd(truncated));
+    const auto round_up = _mm_cmpge_pd(remainder, _mm_set1_pd(0.5));
+    const auto round_down = _mm_cmple_pd(remainder, _mm_set1_pd(-0.5));
+    // the comparisons are 64 bit masks, their low halves select the 32 bit lanes
+    const auto up = _mm_shuffle_epi32(_mm_castpd_si128(round_up), _MM_SHUFFLE(3, 3, 2, 0));
+    const auto down = _mm_shuffle_epi32(_mm_castpd_si128(round_down), _MM_SHUFFLE(3, 3, 2, 0));
+    // masks are -1 where set
+    return _mm_add_epi32(_mm_sub_epi32(truncated, up), down);
+}
+#endif
+} // namespace detail
+
+/**
+ * Computes RectangleInt2D::GetMinSquaredDist for count consecutive rectangles, the first one
+ * at rectangles and each one stride bytes after the previous one.
+ */
+inline void squaredRectangleDistancesScalar(const RectangleInt2D *rectangles,
+                                            const std::size_t stride,
+                                            const std::size_t count,
+                                            const Coordinate location,
+                                            std::uint64_t *squared_distances)
+{
+    const auto *bytes = reinterpret_cast<const char *>(rectangles);
+    const auto lon = static_cast<std::int32_t>(location.lon);
+    const auto lat = static_cast<std::int32_t>(location.lat);
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        const auto &rectangle = *reinterpret_cast<const RectangleInt2D *>(bytes + index * stride);
+        squared_distances[index] = detail::squaredDistance(
+            detail::axisDistance(lon,
+                                 static_cast<std::int32_t>(rectangle.min_lon),
+                                 static_cast<std::int32_t>(rectangle.max_lon)),
+            detail::axisDistance(lat,
+                                 static_cast<std::int32_t>(rectangle.min_lat),
+                                 static_cast<std::int32_t>(rectangle.max_lat)));
+    }
+}
+
+inline void squaredRectangleDistances(const RectangleInt2D *rectangles,
+                                      const std::size_t stride,
+                                      const std::size_t count,
+                                      const Coordinate location,
+                                      std::uint64_t *squared_distances)
+{
+#ifdef OSRM_VECTORIZED_DISTANCE_SSE2
+    static_assert(sizeof(RectangleInt2D) == 4 * sizeof(std::int32_t),
+                  "rectangles need to be four packed 32 bit integers");
+
+    const auto *bytes = reinterpret_cast<const char *>(rectangles);
+    const auto lon = _mm_set1_epi32(static_cast<std::int32_t>(location.lon));
+    const auto lat = _mm_set1_epi32(static_cast<std::int32_t>(location.lat));
+    const auto zero = _mm_setzero_si128();
+
+    std::size_t index = 0;
+    for (; index + 4 <= count; index += 4)
+    {
+        // transpose four rectangles of min_lon, max_lon, min_lat, max_lat into lanes
+        const auto load = [&](const std::size_t offset) {
+            return _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(bytes + (index + offset) * stride));
+        };
+        const auto r0 = load(0), r1 = load(1), r2 = load(2), r3 = load(3);
+        const auto t0 = _mm_unpacklo_epi32(r0, r1);
+        const auto t1 = _mm_unpacklo_epi32(r2, r3);
+        const auto t2 = _mm_unpackhi_epi32(r0, r1);
+        const auto t3 = _mm_unpackhi_epi32(r2, r3);
+        const auto min_lon = _mm_unpacklo_epi64(t0, t1);
+        const auto max_lon = _mm_unpackhi_epi64(t0, t1);
+        const auto min_lat = _mm_unpacklo_epi64(t2, t3);
+        const auto max_lat = _mm_unpackhi_epi64(t2, t3);
+
+        const auto d_lon = detail::max_epi32(
+            detail::max_epi32(_mm_sub_epi32(min_lon, lon), _mm_sub_epi32(lon, max_lon)), zero);
+        const auto d_lat = detail::max_epi32(
+            detail::max_epi32(_mm_sub_epi32(min_lat, lat), _mm_sub_epi32(lat, max_lat)), zero);
+        detail::squaredDistances(d_lon, d_lat, squared_distances + index);
+    }
+
+    squaredRectangleDistancesScalar(
+        reinterpret_cast<const RectangleInt2D *>(bytes + index * stride),
+        stride,
+        count - index,
+        location,
+        squared_distances + index);
+#else
+    squaredRectangleDistancesScalar(rectangles, stride, count, location, squared_distances);
+#endif
+}
+
+namespace detail
+{
+inline void projectOnSegments(const ProjectedSegments &segments,
+                              const FloatCoordinate &location,
+                              const Coordinate fixed_location,
+                              const std::size_t begin,
+                              const std::size_t end,
+                              SegmentDistances &distances)
+{
+    const auto lon = static_cast<double>(location.lon);
+    const auto lat = static_cast<double>(location.lat);
+    for (std::size_t index = begin; index < end; ++index)
+    {
+        const auto source_lon = segments.source_lon[index];
+        const auto source_lat = segments.source_lat[index];
+        const auto target_lon = segments.target_lon[index];
+        const auto target_lat = segments.target_lat[index];
+
+        const auto slope_lon = target_lon - source_lon;
+        const auto slope_lat = target_lat - source_lat;
+        const auto unnormed_ratio = slope_lon * (lon - source_lon) + slope_lat * (lat - source_lat);
+        const auto squared_length = slope_lon * slope_lon + slope_lat * slope_lat;
+
+        auto ratio = 0.;
+        if (squared_length >= std::numeric_limits<double>::epsilon())
+        {
+            ratio = std::min(std::max(unnormed_ratio / squared_length, 0.), 1.);
+        }
+
+        const auto nearest_lon = toFixed((1.0 - ratio) * source_lon + target_lon * ratio);
+        const auto nearest_lat = toFixed((1.0 - ratio) * source_lat + target_lat * ratio);
+        distances.nearest_lon[index] = nearest_lon;
+        distances.nearest_lat[index] = nearest_lat;
+        distances.squared_distances[index] =
+            squaredDistance(static_cast<std::int32_t>(fixed_location.lon) - nearest_lon,
+                            static_cast<std::int32_t>(fixed_location.lat) - nearest_lat);
+    }
+}
+} // namespace detail
+
+/**
+ * Projects the location onto all segments like coordinate_calculation::projectPointOnSegment
+ * and computes the squared euclidean distance of the fixed location to the fixed nearest point.
+ */
+inline void projectOnSegmentsScalar(const ProjectedSegments &segments,
+                                    const FloatCoordinate &location,
+                                    const Coordinate fixed_location,
+                                    SegmentDistances &distances)
+{
+    distances.resize(segments.size());
+    detail::projectOnSegments(segments, location, fixed_location, 0, segments.size(), distances);
+}
+
+inline void projectOnSegments(const ProjectedSegments &segments,
+                              const FloatCoordinate &location,
+                              const Coordinate fixed_location,
+                              SegmentDistances &distances)
+{
+#ifdef OSRM_VECTORIZED_DISTANCE_SSE2
+    const auto count = segments.size();
+    distances.resize(count);
+
+    const auto lon = _mm_set1_pd(static_cast<double>(location.lon));
+    const auto lat = _mm_set1_pd(static_cast<double>(location.lat));
+    const auto fixed_lon = _mm_set1_epi32(static_cast<std::int32_t>(fixed_location.lon));
+    const auto fixed_lat = _mm_set1_epi32(static_cast<std::int32_t>(fixed_location.lat));
+    const auto zero = _mm_setzero_pd();
+    const auto one = _mm_set1_pd(1.);
+    const auto epsilon = _mm_set1_pd(std::numeric_limits<double>::epsilon());
+    const auto precision = _mm_set1_pd(COORDINATE_PRECISION);
+
+    // nearest points in fixed representation of two segments
+    const auto project = [&](const std::size_t index, __m128i &nearest_lon, __m128i &nearest_lat) {
+        const auto source_lon = _mm_loadu_pd(segments.source_lon.data() + index);
+        const auto source_lat = _mm_loadu_pd(segments.source_lat.data() + index);
+        const auto target_lon = _mm_loadu_pd(segments.target_lon.data() + index);
+        const auto target_lat = _mm_loadu_pd(segments.target_lat.data() + index);
+
+        const auto slope_lon = _mm_sub_pd(target_lon, source_lon);
+        const auto slope_lat = _mm_sub_pd(target_lat, source_lat);
+        const auto unnormed_ratio =
+            _mm_add_pd(_mm_mul_pd(slope_lon, _mm_sub_pd(lon, source_lon)),
+                       _mm_mul_pd(slope_lat, _mm_sub_pd(lat, source_lat)));
+        const auto squared_length =
+            _mm_add_pd(_mm_mul_pd(slope_lon, slope_lon), _mm_mul_pd(slope_lat, slope_lat));
+
+        // degenerated segments project onto their source
+        const auto is_segment = _mm_cmpge_pd(squared_length, epsilon);
+        const auto clamped_ratio =
+            _mm_min_pd(_mm_max_pd(_mm_div_pd(unnormed_ratio, squared_length), zero), one);
+        const auto ratio = _mm_and_pd(is_segment, clamped_ratio);
+        const auto inverse_ratio = _mm_sub_pd(one, ratio);
+
+        nearest_lon = detail::round_epi32(_mm_mul_pd(
+            _mm_add_pd(_mm_mul_pd(inverse_ratio, source_lon), _mm_mul_pd(target_lon, ratio)),
+            precision));
+        nearest_lat = detail::round_epi32(_mm_mul_pd(
+            _mm_add_pd(_mm_mul_pd(inverse_ratio, source_lat), _mm_mul_pd(target_lat, ratio)),
+            precision));
+    };
+
+    std::size_t index = 0;
+    for (; index + 4 <= count; index += 4)
+    {
+        __m128i low_lon, low_lat, high_lon, high_lat;
+        project(index, low_lon, low_lat);
+        project(index + 2, high_lon, high_lat);
+        const auto nearest_lon = _mm_unpacklo_epi64(low_lon, high_lon);
+        const auto nearest_lat = _mm_unpacklo_epi64(low_lat, high_lat);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(distances.nearest_lon.data() + index),
+                         nearest_lon);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(distances.nearest_lat.data() + index),
+                         nearest_lat);
+        detail::squaredDistances(detail::abs_epi32(_mm_sub_epi32(fixed_lon, nearest_lon)),
+                                 detail::abs_epi32(_mm_sub_epi32(fixed_lat, nearest_lat)),
+                                 distances.squared_distances.data() + index);
+    }
+
+    detail::projectOnSegments(segments, location, fixed_location, index, count, distances);
+#else
+    projectOnSegmentsScalar(segments, location, fixed_location, distances);
+#endif
+}
+
+} // namespace vectorized
+} // namespace util
+} // namespace osrm
+
+#endif // OSRM_UTIL_VECTORIZED_DISTANCE_HPP
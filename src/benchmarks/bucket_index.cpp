@@ -0,0 +1,144 @@
+#include "engine/routing_algorithms/many_to_many.hpp"
+#include "engine/routing_algorithms/node_bucket_index.hpp"
+
+#include "util/integer_range.hpp"
+#include "util/log.hpp"
+#include "util/timing_util.hpp"
+
+#include <boost/range/iterator_range_core.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace osrm;
+using namespace osrm::engine::routing_algorithms;
+
+// Replays synthetic many-to-many bucket workloads against the sorted NodeBucket vector and the
+// CSR NodeBucketIndex. Search spaces are drawn with a bias towards high node ids to mimic the
+// overlap of CH search spaces in the upper levels of the hierarchy.
+
+constexpr std::size_t NUMBER_OF_NODES = 5000000;
+constexpr std::size_t NUMBER_OF_SOURCES = 1000;
+constexpr std::size_t NUMBER_OF_TARGETS = 1000;
+constexpr std::size_t SEARCH_SPACE_SIZE = 800;
+
+struct SettledNode
+{
+    NodeID node;
+    EdgeWeight weight;
+};
+
+std::vector<std::vector<SettledNode>> generateSearchSpaces(std::size_t number_of_searches,
+                                                           std::mt19937 &generator)
+{
+    std::uniform_real_distribution<double> rank_distribution(0., 1.);
+    std::uniform_int_distribution<EdgeWeight> weight_distribution(1, 100000);
+
+    std::vector<std::vector<SettledNode>> search_spaces(number_of_searches);
+    for (auto &search_space : search_spaces)
+    {
+        std::vector<NodeID> nodes;
+        nodes.reserve(SEARCH_SPACE_SIZE);
+        for (auto index : util::irange<std::size_t>(0, SEARCH_SPACE_SIZE))
+        {
+            (void)index;
+            const auto rank = std::pow(rank_distribution(generator), 4);
+            nodes.push_back(static_cast<NodeID>(NUMBER_OF_NODES - 1 - rank * (NUMBER_OF_NODES - 1)));
+        }
+        std::sort(nodes.begin(), nodes.end());
+        nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+        std::shuffle(nodes.begin(), nodes.end(), generator);
+
+        for (const auto node : nodes)
+            search_space.push_back({node, weight_distribution(generator)});
+    }
+    return search_spaces;
+}
+
+int main(int, char **)
+{
+    util::LogPolicy::GetInstance().Unmute();
+
+    std::mt19937 generator(1337);
+    const auto backward_spaces = generateSearchSpaces(NUMBER_OF_TARGETS, generator);
+    const auto forward_spaces = generateSearchSpaces(NUMBER_OF_SOURCES, generator);
+
+    std::vector<EdgeWeight> vector_table(NUMBER_OF_SOURCES * NUMBER_OF_TARGETS,
+                                         INVALID_EDGE_WEIGHT);
+    std::vector<EdgeWeight> index_table(NUMBER_OF_SOURCES * NUMBER_OF_TARGETS,
+                                        INVALID_EDGE_WEIGHT);
+
+    // Sorted vector of bucket structs with a binary search per settled node
+    TIMER_START(vector_build);
+    std::vector<NodeBucket> buckets;
+    for (auto column : util::irange<std::size_t>(0, NUMBER_OF_TARGETS))
+    {
+        for (const auto &settled : backward_spaces[column])
+            buckets.emplace_back(settled.node, settled.node, column, settled.weight, 0, 0);
+    }
+    std::sort(buckets.begin(), buckets.end());
+    TIMER_STOP(vector_build);
+
+    TIMER_START(vector_scan);
+    for (auto row : util::irange<std::size_t>(0, NUMBER_OF_SOURCES))
+    {
+        for (const auto &settled : forward_spaces[row])
+        {
+            const auto range = std::equal_range(
+                buckets.begin(), buckets.end(), settled.node, NodeBucket::Compare());
+            for (const auto &bucket : boost::make_iterator_range(range))
+            {
+                auto &current = vector_table[row * NUMBER_OF_TARGETS + bucket.column_index];
+                current = std::min(current, settled.weight + bucket.weight);
+            }
+        }
+    }
+    TIMER_STOP(vector_scan);
+
+    // CSR index with structure-of-arrays entries
+    TIMER_START(index_build);
+    NodeBucketIndex bucket_index;
+    for (auto column : util::irange<std::size_t>(0, NUMBER_OF_TARGETS))
+    {
+        for (const auto &settled : backward_spaces[column])
+            bucket_index.Insert(settled.node, column, settled.weight, 0, 0);
+    }
+    bucket_index.Build();
+    TIMER_STOP(index_build);
+
+    TIMER_START(index_scan);
+    const auto &columns = bucket_index.GetColumns();
+    const auto &weights = bucket_index.GetWeights();
+    for (auto row : util::irange<std::size_t>(0, NUMBER_OF_SOURCES))
+    {
+        for (const auto &settled : forward_spaces[row])
+        {
+            const auto range = bucket_index.Find(settled.node);
+            for (auto bucket = range.first; bucket < range.second; ++bucket)
+            {
+                auto &current = index_table[row * NUMBER_OF_TARGETS + columns[bucket]];
+                current = std::min(current, settled.weight + weights[bucket]);
+            }
+        }
+    }
+    TIMER_STOP(index_scan);
+
+    if (vector_table != index_table)
+    {
+        util::Log(logERROR) << "Bucket layouts computed different tables";
+        return EXIT_FAILURE;
+    }
+
+    util::Log() << NUMBER_OF_SOURCES << "x" << NUMBER_OF_TARGETS << " table, " << buckets.size()
+                << " buckets on " << bucket_index.GetNumberOfNodes() << " nodes";
+    util::Log() << "sorted std::vector<NodeBucket>: build " << TIMER_MSEC(vector_build)
+                << " ms, scan " << TIMER_MSEC(vector_scan) << " ms";
+    util::Log() << "NodeBucketIndex:                build " << TIMER_MSEC(index_build)
+                << " ms, scan " << TIMER_MSEC(index_scan) << " ms";
+    util::Log() << "scan speedup: " << TIMER_MSEC(vector_scan) / TIMER_MSEC(index_scan);
+
+    return EXIT_SUCCESS;
+}
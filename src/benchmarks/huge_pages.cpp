@@ -0,0 +1,135 @@
+#include "storage/huge_pages.hpp"
+#include "util/timing_util.hpp"
+
+#include "osrm/route_parameters.hpp"
+#include "osrm/table_parameters.hpp"
+
+#include "osrm/coordinate.hpp"
+#include "osrm/engine_config.hpp"
+#include "osrm/json_container.hpp"
+
+#include "osrm/osrm.hpp"
+#include "osrm/status.hpp"
+
+#include <exception>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cstdlib>
+
+int main(int argc, const char *argv[])
+try
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " data.osrm [off|transparent|2M|1G] [CH|MLD] "
+                  << "[min_lon,min_lat,max_lon,max_lat]\n"
+                  << "Compares the latency of route and table queries on a dataset in process "
+                     "memory backed by regular and by huge pages. The coordinates are drawn "
+                     "from the bounding box, which defaults to monaco.\n";
+        return EXIT_FAILURE;
+    }
+
+    using namespace osrm;
+
+    const auto huge_pages = storage::parseHugePages(argc > 2 ? argv[2] : "2M");
+    if (!huge_pages)
+    {
+        throw std::runtime_error("unknown huge pages " + std::string(argv[2]));
+    }
+    const std::string algorithm = argc > 3 ? argv[3] : "CH";
+    if (algorithm != "CH" && algorithm != "MLD")
+    {
+        throw std::runtime_error("unknown algorithm " + algorithm);
+    }
+    double min_lon = 7.409, min_lat = 43.725, max_lon = 7.439, max_lat = 43.751;
+    if (argc > 4)
+    {
+        std::istringstream bbox(argv[4]);
+        char separator;
+        bbox >> min_lon >> separator >> min_lat >> separator >> max_lon >> separator >> max_lat;
+        if (bbox.fail())
+        {
+            throw std::runtime_error("invalid bounding box " + std::string(argv[4]));
+        }
+    }
+
+    // the same coordinates for both runs
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> lon_distribution(min_lon, max_lon);
+    std::uniform_real_distribution<double> lat_distribution(min_lat, max_lat);
+    std::vector<util::Coordinate> coordinates(1000);
+    for (auto &coordinate : coordinates)
+    {
+        coordinate = {util::FloatLongitude{lon_distribution(generator)},
+                      util::FloatLatitude{lat_distribution(generator)}};
+    }
+
+    const auto benchmark = [&](const storage::HugePages pages) {
+        EngineConfig config;
+        config.storage_config = {argv[1]};
+        config.storage_config.huge_pages = pages;
+        config.use_shared_memory = false;
+        config.algorithm =
+            algorithm == "MLD" ? EngineConfig::Algorithm::MLD : EngineConfig::Algorithm::CH;
+        OSRM osrm{config};
+
+        RouteParameters route_params;
+        route_params.overview = RouteParameters::OverviewType::False;
+        route_params.coordinates.resize(2);
+
+        TIMER_START(routes);
+        for (std::size_t i = 0; i + 1 < coordinates.size(); i += 2)
+        {
+            route_params.coordinates[0] = coordinates[i];
+            route_params.coordinates[1] = coordinates[i + 1];
+            // some pairs may not be connected, the search is timed all the same
+            engine::api::ResultT result = json::Object();
+            osrm.Route(route_params, result);
+        }
+        TIMER_STOP(routes);
+
+        // 25x25 tables
+        TableParameters table_params;
+        const auto table_size = 25;
+        const auto num_tables = coordinates.size() / table_size;
+
+        TIMER_START(tables);
+        for (std::size_t i = 0; i < num_tables; ++i)
+        {
+            table_params.coordinates.assign(coordinates.begin() + i * table_size,
+                                            coordinates.begin() + (i + 1) * table_size);
+            engine::api::ResultT result = json::Object();
+            if (osrm.Table(table_params, result) != Status::Ok)
+            {
+                throw std::runtime_error("table request failed");
+            }
+        }
+        TIMER_STOP(tables);
+
+        return std::make_pair(TIMER_MSEC(routes) / (coordinates.size() / 2),
+                              TIMER_MSEC(tables) / num_tables);
+    };
+
+    // run once to warm up the page cache with the data files
+    benchmark(storage::HugePages::Off);
+    const auto regular = benchmark(storage::HugePages::Off);
+    const auto huge = benchmark(*huge_pages);
+
+    std::cout << "regular pages: " << regular.first << "ms/route " << regular.second
+              << "ms/table" << std::endl;
+    std::cout << "huge pages:    " << huge.first << "ms/route " << huge.second << "ms/table"
+              << std::endl;
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
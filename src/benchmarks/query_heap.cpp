@@ -0,0 +1,404 @@
+#include "contractor/files.hpp"
+#include "contractor/graph_contractor.hpp"
+#include "contractor/graph_contractor_adaptors.hpp"
+#include "contractor/query_graph.hpp"
+#include "extractor/edge_based_edge.hpp"
+
+#include "util/integer_range.hpp"
+#include "util/log.hpp"
+#include "util/query_heap.hpp"
+#include "util/timing_util.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace osrm;
+
+// Records the heap operations of bidirectional searches and replays them on every heap policy
+// and index storage, so only the cost of the heaps is measured.
+//
+// CH searches are recorded on the .osrm.hsgr of a dataset if one is given, otherwise on a
+// synthetic grid that is contracted like osrm-contract does. MLD searches are recorded on a
+// synthetic grid: the base graph weights of MLD datasets only exist after the customization,
+// but the searches inside cells are plain Dijkstra searches like on the grid.
+
+constexpr unsigned RANDOM_SEED = 42;
+constexpr std::size_t DEFAULT_NUMBER_OF_QUERIES = 200;
+constexpr std::size_t GRID_SIZE = 1000;
+// contracting a grid adds many shortcuts, a smaller one keeps the contraction under a minute
+constexpr std::size_t CH_GRID_SIZE = 200;
+constexpr std::size_t GRID_QUERY_RADIUS = 100;
+// MLD numbers the border nodes of the cells first, the two-level storage keeps them in an array
+constexpr std::size_t GRID_BORDER_NODE_RATIO = 10;
+
+struct HeapOperation
+{
+    std::uint8_t heap;
+    bool pop;
+    NodeID node;
+    EdgeWeight weight;
+};
+using Trace = std::vector<HeapOperation>;
+
+struct HeapData
+{
+};
+
+struct Graph
+{
+    std::size_t number_of_nodes;
+    std::vector<std::size_t> offsets;
+    std::vector<NodeID> targets;
+    std::vector<EdgeWeight> weights;
+    std::vector<bool> forward;
+    std::vector<bool> backward;
+};
+
+Graph loadCHGraph(const boost::filesystem::path &path)
+{
+    std::string metric_name;
+    {
+        storage::tar::FileReader reader{path, storage::tar::FileReader::VerifyFingerprint};
+        std::vector<storage::tar::FileReader::FileEntry> entries;
+        reader.List(std::back_inserter(entries));
+        const std::string prefix = "/ch/metrics/";
+        for (const auto &entry : entries)
+        {
+            if (entry.name.compare(0, prefix.size(), prefix) == 0)
+            {
+                metric_name = entry.name.substr(
+                    prefix.size(), entry.name.find('/', prefix.size()) - prefix.size());
+                break;
+            }
+        }
+    }
+
+    std::unordered_map<std::string, contractor::ContractedMetric> metrics = {
+        {metric_name, contractor::ContractedMetric{}}};
+    std::uint32_t connectivity_checksum;
+    contractor::files::readGraph(path, metrics, connectivity_checksum);
+    const auto &query_graph = metrics[metric_name].graph;
+
+    Graph graph;
+    graph.number_of_nodes = query_graph.GetNumberOfNodes();
+    graph.offsets.push_back(0);
+    for (const auto node : util::irange<NodeID>(0, query_graph.GetNumberOfNodes()))
+    {
+        for (const auto edge : query_graph.GetAdjacentEdgeRange(node))
+        {
+            const auto &data = query_graph.GetEdgeData(edge);
+            graph.targets.push_back(query_graph.GetTarget(edge));
+            graph.weights.push_back(data.weight);
+            graph.forward.push_back(data.forward);
+            graph.backward.push_back(data.backward);
+        }
+        graph.offsets.push_back(graph.targets.size());
+    }
+    return graph;
+}
+
+Graph makeGridGraph(const std::size_t grid_size, std::mt19937 &generator)
+{
+    std::uniform_int_distribution<EdgeWeight> weight_distribution(10, 100);
+
+    Graph graph;
+    graph.number_of_nodes = grid_size * grid_size;
+    graph.offsets.push_back(0);
+    for (const auto y : util::irange<std::size_t>(0, grid_size))
+    {
+        for (const auto x : util::irange<std::size_t>(0, grid_size))
+        {
+            const auto add_edge = [&](const std::size_t to_x, const std::size_t to_y) {
+                graph.targets.push_back(static_cast<NodeID>(to_y * grid_size + to_x));
+                graph.weights.push_back(weight_distribution(generator));
+                graph.forward.push_back(true);
+                graph.backward.push_back(true);
+            };
+            if (x > 0)
+                add_edge(x - 1, y);
+            if (x + 1 < grid_size)
+                add_edge(x + 1, y);
+            if (y > 0)
+                add_edge(x, y - 1);
+            if (y + 1 < grid_size)
+                add_edge(x, y + 1);
+            graph.offsets.push_back(graph.targets.size());
+        }
+    }
+    return graph;
+}
+
+// Every node keeps the edges to the nodes contracted after it, like the .osrm.hsgr graph
+Graph makeContractedGridGraph(std::mt19937 &generator)
+{
+    const auto grid = makeGridGraph(CH_GRID_SIZE, generator);
+
+    std::vector<extractor::EdgeBasedEdge> edges;
+    for (const auto node : util::irange<NodeID>(0, grid.number_of_nodes))
+    {
+        for (const auto edge : util::irange(grid.offsets[node], grid.offsets[node + 1]))
+        {
+            const auto weight = grid.weights[edge];
+            edges.emplace_back(
+                node, grid.targets[edge], node, weight, weight, weight, true, false);
+        }
+    }
+
+    auto contractor_graph = contractor::toContractorGraph(grid.number_of_nodes, std::move(edges));
+    contractor::contractGraph(contractor_graph,
+                              std::vector<EdgeWeight>(grid.number_of_nodes, INVALID_EDGE_WEIGHT));
+
+    Graph graph;
+    graph.number_of_nodes = grid.number_of_nodes;
+    graph.offsets.push_back(0);
+    for (const auto node : util::irange<NodeID>(0, grid.number_of_nodes))
+    {
+        for (const auto edge : contractor_graph.GetAdjacentEdgeRange(node))
+        {
+            const auto &data = contractor_graph.GetEdgeData(edge);
+            graph.targets.push_back(contractor_graph.GetTarget(edge));
+            graph.weights.push_back(data.weight);
+            graph.forward.push_back(data.forward);
+            graph.backward.push_back(data.backward);
+        }
+        graph.offsets.push_back(graph.targets.size());
+    }
+    return graph;
+}
+
+// Bidirectional search that stops once the heaps can't improve the best path anymore.
+// On a CH graph both directions only go upwards, on the grid this is a plain Dijkstra.
+template <typename HeapT>
+void recordSearch(const Graph &graph,
+                  HeapT &forward_heap,
+                  HeapT &reverse_heap,
+                  const NodeID source,
+                  const NodeID target,
+                  Trace &trace)
+{
+    forward_heap.Clear();
+    reverse_heap.Clear();
+    forward_heap.Insert(source, 0, {});
+    reverse_heap.Insert(target, 0, {});
+    trace.push_back({0, false, source, 0});
+    trace.push_back({1, false, target, 0});
+
+    HeapT *heaps[] = {&forward_heap, &reverse_heap};
+    EdgeWeight upper_bound = INVALID_EDGE_WEIGHT;
+    while (!forward_heap.Empty() || !reverse_heap.Empty())
+    {
+        const std::uint8_t direction =
+            reverse_heap.Empty() ||
+                    (!forward_heap.Empty() && forward_heap.MinKey() <= reverse_heap.MinKey())
+                ? 0
+                : 1;
+        auto &heap = *heaps[direction];
+        auto &other_heap = *heaps[1 - direction];
+
+        const auto weight = heap.MinKey();
+        if (weight >= upper_bound)
+            break;
+
+        const auto node = heap.DeleteMin();
+        trace.push_back({direction, true, node, weight});
+
+        if (other_heap.WasInserted(node))
+            upper_bound = std::min(upper_bound, weight + other_heap.GetKey(node));
+
+        for (const auto edge : util::irange(graph.offsets[node], graph.offsets[node + 1]))
+        {
+            if (direction == 0 ? !graph.forward[edge] : !graph.backward[edge])
+                continue;
+
+            const auto to = graph.targets[edge];
+            const auto to_weight = weight + graph.weights[edge];
+            trace.push_back({direction, false, to, to_weight});
+            if (!heap.WasInserted(to))
+                heap.Insert(to, to_weight, {});
+            else if (!heap.WasRemoved(to) && to_weight < heap.GetKey(to))
+                heap.DecreaseKey(to, to_weight);
+        }
+    }
+}
+
+// Draws the source and target of each search with make_query(generator)
+template <typename MakeQuery>
+std::vector<Trace> recordSearches(const Graph &graph,
+                                  const std::size_t number_of_queries,
+                                  std::mt19937 &generator,
+                                  MakeQuery make_query)
+{
+    using RecordingHeap = util::
+        QueryHeap<NodeID, NodeID, EdgeWeight, HeapData, util::ArrayStorage<NodeID, NodeID>>;
+    RecordingHeap forward_heap(graph.number_of_nodes);
+    RecordingHeap reverse_heap(graph.number_of_nodes);
+
+    std::vector<Trace> traces(number_of_queries);
+    for (auto &trace : traces)
+    {
+        const auto query = make_query(generator);
+        recordSearch(graph, forward_heap, reverse_heap, query.first, query.second, trace);
+    }
+    return traces;
+}
+
+// Replays the traces and returns the sum of all popped weights to compare the policies
+template <typename HeapT>
+std::int64_t replay(const std::vector<Trace> &traces, HeapT &forward_heap, HeapT &reverse_heap)
+{
+    HeapT *heaps[] = {&forward_heap, &reverse_heap};
+    std::int64_t checksum = 0;
+    for (const auto &trace : traces)
+    {
+        forward_heap.Clear();
+        reverse_heap.Clear();
+        for (const auto &operation : trace)
+        {
+            auto &heap = *heaps[operation.heap];
+            if (operation.pop)
+            {
+                checksum += heap.MinKey();
+                heap.DeleteMin();
+            }
+            else if (!heap.WasInserted(operation.node))
+            {
+                heap.Insert(operation.node, operation.weight, {});
+            }
+            else if (!heap.WasRemoved(operation.node) &&
+                     operation.weight < heap.GetKey(operation.node))
+            {
+                heap.DecreaseKey(operation.node, operation.weight);
+            }
+        }
+    }
+    return checksum;
+}
+
+template <typename IndexStorage, typename HeapPolicy, typename... StorageArgs>
+std::int64_t benchmarkHeap(const std::vector<Trace> &traces,
+                           const std::string &name,
+                           const StorageArgs... storage_args)
+{
+    using Heap = util::QueryHeap<NodeID, NodeID, EdgeWeight, HeapData, IndexStorage, HeapPolicy>;
+    Heap forward_heap(storage_args...);
+    Heap reverse_heap(storage_args...);
+
+    // the first run allocates the heaps
+    replay(traces, forward_heap, reverse_heap);
+
+    TIMER_START(replay);
+    const auto checksum = replay(traces, forward_heap, reverse_heap);
+    TIMER_STOP(replay);
+
+    util::Log() << "  " << name << ": " << TIMER_MSEC(replay) << " ms";
+    return checksum;
+}
+
+template <typename IndexStorage, typename... StorageArgs>
+bool benchmarkPolicies(const std::vector<Trace> &traces,
+                       const std::string &storage_name,
+                       const StorageArgs... storage_args)
+{
+    const auto reference = benchmarkHeap<IndexStorage, util::BoostDAryHeapPolicy<4>>(
+        traces, storage_name + " + boost 4-ary heap", storage_args...);
+    const auto four_ary = benchmarkHeap<IndexStorage, util::DAryHeapPolicy<4>>(
+        traces, storage_name + " + 4-ary heap", storage_args...);
+    const auto eight_ary = benchmarkHeap<IndexStorage, util::DAryHeapPolicy<8>>(
+        traces, storage_name + " + 8-ary heap", storage_args...);
+    const auto radix = benchmarkHeap<IndexStorage, util::RadixHeapPolicy>(
+        traces, storage_name + " + radix heap", storage_args...);
+
+    // all searches settle the same weights, ties are broken differently by the radix heap
+    return four_ary == reference && eight_ary == reference && radix == reference;
+}
+
+int main(int argc, char **argv)
+{
+    util::LogPolicy::GetInstance().Unmute();
+
+    if (argc > 3)
+    {
+        std::cout << "./heap-bench [<file.osrm>] [number of queries]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const std::size_t number_of_queries =
+        argc == 3 ? std::stoul(argv[2]) : DEFAULT_NUMBER_OF_QUERIES;
+    std::mt19937 generator(RANDOM_SEED);
+    bool consistent = true;
+
+    {
+        const auto graph =
+            argc >= 2 ? loadCHGraph(boost::filesystem::path(std::string(argv[1]) + ".hsgr"))
+                      : makeContractedGridGraph(generator);
+        std::uniform_int_distribution<NodeID> node_distribution(0, graph.number_of_nodes - 1);
+        const auto traces =
+            recordSearches(graph, number_of_queries, generator, [&](std::mt19937 &generator) {
+                return std::make_pair(node_distribution(generator), node_distribution(generator));
+            });
+
+        std::size_t number_of_operations = 0;
+        for (const auto &trace : traces)
+            number_of_operations += trace.size();
+        util::Log() << "CH: " << traces.size() << " searches with " << number_of_operations
+                    << " heap operations on " << graph.number_of_nodes << " nodes";
+
+        consistent &= benchmarkPolicies<util::UnorderedMapStorage<NodeID, int>>(
+            traces, "unordered map", graph.number_of_nodes);
+        consistent &= benchmarkPolicies<util::GenerationArrayStorage<NodeID, int>>(
+            traces, "generation array", graph.number_of_nodes);
+        consistent &= benchmarkPolicies<util::ArrayStorage<NodeID, int>>(
+            traces, "array", graph.number_of_nodes);
+    }
+
+    {
+        const auto graph = makeGridGraph(GRID_SIZE, generator);
+        // searches stay close to the source like the base graph searches of MLD do
+        std::uniform_int_distribution<std::size_t> coordinate_distribution(0, GRID_SIZE - 1);
+        std::uniform_int_distribution<std::size_t> offset_distribution(0, 2 * GRID_QUERY_RADIUS);
+        // the offsets are shifted by the radius to stay unsigned
+        const auto clamp = [](const std::size_t shifted_coordinate) {
+            return std::min(std::max(shifted_coordinate, GRID_QUERY_RADIUS) - GRID_QUERY_RADIUS,
+                            GRID_SIZE - 1);
+        };
+        const auto traces =
+            recordSearches(graph, number_of_queries, generator, [&](std::mt19937 &generator) {
+                const auto x = coordinate_distribution(generator);
+                const auto y = coordinate_distribution(generator);
+                const auto target_x = clamp(x + offset_distribution(generator));
+                const auto target_y = clamp(y + offset_distribution(generator));
+                return std::make_pair(static_cast<NodeID>(y * GRID_SIZE + x),
+                                      static_cast<NodeID>(target_y * GRID_SIZE + target_x));
+            });
+
+        std::size_t number_of_operations = 0;
+        for (const auto &trace : traces)
+            number_of_operations += trace.size();
+        util::Log() << "MLD (grid): " << traces.size() << " searches with "
+                    << number_of_operations << " heap operations on " << graph.number_of_nodes
+                    << " nodes";
+
+        const std::size_t number_of_border_nodes = graph.number_of_nodes / GRID_BORDER_NODE_RATIO;
+        consistent &= benchmarkPolicies<util::TwoLevelStorage<NodeID, int>>(
+            traces, "two level", graph.number_of_nodes, number_of_border_nodes);
+        consistent &= benchmarkPolicies<util::GenerationArrayStorage<NodeID, int>>(
+            traces, "generation array", graph.number_of_nodes);
+    }
+
+    if (!consistent)
+    {
+        util::Log(logERROR) << "Heap policies settled different weights";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
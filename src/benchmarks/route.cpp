@@ -0,0 +1,95 @@
+#include "util/timing_util.hpp"
+
+#include "osrm/route_parameters.hpp"
+
+#include "osrm/coordinate.hpp"
+#include "osrm/engine_config.hpp"
+#include "osrm/json_container.hpp"
+
+#include "osrm/osrm.hpp"
+#include "osrm/status.hpp"
+
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cstdlib>
+
+int main(int argc, const char *argv[])
+try
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " data.osrm\n";
+        return EXIT_FAILURE;
+    }
+
+    using namespace osrm;
+
+    // Configure based on a .osrm base path, and no datasets in shared mem from osrm-datastore
+    EngineConfig config;
+    config.storage_config = {argv[1]};
+    config.use_shared_memory = false;
+
+    OSRM osrm{config};
+
+    using osrm::util::FloatCoordinate;
+    using osrm::util::FloatLatitude;
+    using osrm::util::FloatLongitude;
+
+    // Long routes across monaco, with many steps and intersections to assemble
+    const std::vector<std::pair<FloatCoordinate, FloatCoordinate>> routes = {
+        {{FloatLongitude{7.410582}, FloatLatitude{43.730862}},
+         {FloatLongitude{7.437906}, FloatLatitude{43.749451}}},
+        {{FloatLongitude{7.419758}, FloatLatitude{43.731142}},
+         {FloatLongitude{7.432427}, FloatLatitude{43.747853}}},
+        {{FloatLongitude{7.413821}, FloatLatitude{43.725916}},
+         {FloatLongitude{7.428619}, FloatLatitude{43.739863}}},
+        {{FloatLongitude{7.436011}, FloatLatitude{43.744832}},
+         {FloatLongitude{7.416401}, FloatLatitude{43.733107}}},
+        {{FloatLongitude{7.425049}, FloatLatitude{43.735463}},
+         {FloatLongitude{7.409541}, FloatLatitude{43.727671}}}};
+
+    const auto benchmark = [&](const bool steps) {
+        RouteParameters params;
+        params.steps = steps;
+        params.overview = RouteParameters::OverviewType::Full;
+        params.coordinates.resize(2);
+
+        const auto NUM = 100;
+        TIMER_START(routes);
+        for (int i = 0; i < NUM; ++i)
+        {
+            for (const auto &route : routes)
+            {
+                params.coordinates[0] = route.first;
+                params.coordinates[1] = route.second;
+
+                engine::api::ResultT result = json::Object();
+                if (osrm.Route(params, result) != Status::Ok)
+                {
+                    throw std::runtime_error("route request failed");
+                }
+            }
+        }
+        TIMER_STOP(routes);
+        return TIMER_MSEC(routes) / NUM / routes.size();
+    };
+
+    // the difference between both runs is the cost of assembling and rendering the steps
+    const auto without_steps = benchmark(false);
+    const auto with_steps = benchmark(true);
+    std::cout << without_steps << "ms/route without steps" << std::endl;
+    std::cout << with_steps << "ms/route with steps" << std::endl;
+    std::cout << (with_steps - without_steps) << "ms/route for the steps" << std::endl;
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
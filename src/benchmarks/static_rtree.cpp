@@ -7,11 +7,18 @@
 #include "mocks/mock_datafacade.hpp"
 #include "storage/io.hpp"
 #include "engine/geospatial_query.hpp"
+#include "util/compressed_leaves.hpp"
 #include "util/coordinate.hpp"
+#include "util/hilbert_value.hpp"
+#include "util/mmap_file.hpp"
 #include "util/serialization.hpp"
 #include "util/timing_util.hpp"
+#include "util/vectorized_distance.hpp"
 
+#include <algorithm>
+#include <array>
 #include <iostream>
+#include <numeric>
 #include <random>
 
 #include <boost/filesystem/fstream.hpp>
@@ -55,6 +62,96 @@ void benchmarkQuery(const std::vector<util::Coordinate> &queries,
               << ")" << std::endl;
 }
 
+template <typename KernelT>
+void benchmarkKernel(const std::vector<util::Coordinate> &queries,
+                     const std::string &name,
+                     KernelT kernel)
+{
+    std::cout << "Running " << name << " with " << queries.size() << " coordinates: " << std::flush;
+
+    std::uint64_t checksum = 0;
+    TIMER_START(kernel);
+    for (const auto &q : queries)
+    {
+        checksum += kernel(q);
+    }
+    TIMER_STOP(kernel);
+
+    std::cout << "Took " << TIMER_MSEC(kernel) << "ms (checksum " << checksum << ")"
+              << std::endl;
+}
+
+// Compares the vectorized node and leaf distance kernels against their scalar versions
+void benchmarkDistanceKernels(const std::vector<util::Coordinate> &queries)
+{
+    std::mt19937 mt_rand(RANDOM_SEED);
+    std::uniform_int_distribution<> lat_udist(WORLD_MIN_LAT, WORLD_MAX_LAT);
+    std::uniform_int_distribution<> lon_udist(WORLD_MIN_LON, WORLD_MAX_LON);
+
+    // the default branching factor of the tree
+    constexpr std::size_t NUMBER_OF_CHILDREN = 64;
+    std::array<util::RectangleInt2D, NUMBER_OF_CHILDREN> rectangles;
+    for (auto &rectangle : rectangles)
+    {
+        const util::Coordinate first{util::FixedLongitude{lon_udist(mt_rand)},
+                                     util::FixedLatitude{lat_udist(mt_rand)}};
+        const util::Coordinate second{util::FixedLongitude{lon_udist(mt_rand)},
+                                      util::FixedLatitude{lat_udist(mt_rand)}};
+        rectangle.min_lon = std::min(first.lon, second.lon);
+        rectangle.max_lon = std::max(first.lon, second.lon);
+        rectangle.min_lat = std::min(first.lat, second.lat);
+        rectangle.max_lat = std::max(first.lat, second.lat);
+    }
+
+    constexpr std::size_t NUMBER_OF_SEGMENTS = BenchStaticRTree::LEAF_NODE_SIZE;
+    util::vectorized::ProjectedSegments segments;
+    for (std::size_t index = 0; index < NUMBER_OF_SEGMENTS; ++index)
+    {
+        const util::Coordinate source{util::FixedLongitude{lon_udist(mt_rand)},
+                                      util::FixedLatitude{lat_udist(mt_rand) / 2}};
+        const util::Coordinate target{util::FixedLongitude{lon_udist(mt_rand)},
+                                      util::FixedLatitude{lat_udist(mt_rand) / 2}};
+        segments.push_back(util::web_mercator::fromWGS84(source),
+                           util::web_mercator::fromWGS84(target));
+    }
+
+    std::array<std::uint64_t, NUMBER_OF_CHILDREN> squared_distances;
+    const auto rectangle_kernel = [&](const auto &distances) {
+        return [&](const util::Coordinate &q) {
+            distances(rectangles.data(),
+                      sizeof(util::RectangleInt2D),
+                      rectangles.size(),
+                      q,
+                      squared_distances.data());
+            return std::accumulate(
+                squared_distances.begin(), squared_distances.end(), std::uint64_t{0});
+        };
+    };
+    benchmarkKernel(queries,
+                    "scalar tree node distances",
+                    rectangle_kernel(util::vectorized::squaredRectangleDistancesScalar));
+    benchmarkKernel(queries,
+                    "vectorized tree node distances",
+                    rectangle_kernel(util::vectorized::squaredRectangleDistances));
+
+    util::vectorized::SegmentDistances segment_distances;
+    const auto segment_kernel = [&](const auto &project) {
+        return [&](const util::Coordinate &q) {
+            const auto projected = util::web_mercator::fromWGS84(util::Coordinate{
+                q.lon, util::FixedLatitude{static_cast<std::int32_t>(q.lat) / 2}});
+            project(segments, projected, util::Coordinate{projected}, segment_distances);
+            return *std::min_element(segment_distances.squared_distances.begin(),
+                                     segment_distances.squared_distances.end());
+        };
+    };
+    benchmarkKernel(queries,
+                    "scalar leaf segment projections",
+                    segment_kernel(util::vectorized::projectOnSegmentsScalar));
+    benchmarkKernel(queries,
+                    "vectorized leaf segment projections",
+                    segment_kernel(util::vectorized::projectOnSegments));
+}
+
 void benchmark(BenchStaticRTree &rtree, unsigned num_queries)
 {
     std::mt19937 mt_rand(RANDOM_SEED);
@@ -73,6 +170,19 @@ void benchmark(BenchStaticRTree &rtree, unsigned num_queries)
     benchmarkQuery(queries, "raw RTree queries (10 results)", [&rtree](const util::Coordinate &q) {
         return rtree.Nearest(q, 10);
     });
+
+    benchmarkDistanceKernels(queries);
+
+    // nearby queries share the projected leaves in the query cache
+    std::sort(queries.begin(), queries.end(), [](const auto lhs, const auto rhs) {
+        return util::GetHilbertCode(lhs) < util::GetHilbertCode(rhs);
+    });
+    benchmarkQuery(queries,
+                   "Hilbert sorted RTree queries (1 result)",
+                   [&rtree](const util::Coordinate &q) { return rtree.Nearest(q, 1); });
+    benchmarkQuery(queries,
+                   "Hilbert sorted RTree queries (10 results)",
+                   [&rtree](const util::Coordinate &q) { return rtree.Nearest(q, 10); });
 }
 } // namespace benchmarks
 } // namespace osrm
@@ -98,5 +208,27 @@ int main(int argc, char **argv)
 
     osrm::benchmarks::benchmark(rtree, 10000);
 
+    // the same queries with the leaves compressed in memory
+    boost::iostreams::mapped_file_source objects_region;
+    const auto objects =
+        osrm::util::mmapFile<osrm::benchmarks::RTreeLeaf>(file_path, objects_region);
+    std::vector<std::uint64_t> page_offsets;
+    const auto size =
+        osrm::benchmarks::BenchStaticRTree::GetCompressedLeafOffsets(objects, page_offsets);
+    std::vector<std::uint8_t> pages(size);
+    osrm::benchmarks::BenchStaticRTree::CompressLeaves(objects, page_offsets, pages.data());
+    std::cout << "Compressed leaves from " << objects.size() * sizeof(osrm::benchmarks::RTreeLeaf)
+              << " to " << size << " bytes" << std::endl;
+
+    osrm::benchmarks::BenchStaticRTree compressed_rtree(
+        osrm::util::CompressedLeaves<osrm::benchmarks::RTreeLeaf>{
+            osrm::util::vector_view<const std::uint64_t>(page_offsets.data(), page_offsets.size()),
+            osrm::util::vector_view<const std::uint8_t>(pages.data(), pages.size()),
+            objects.size()},
+        coords);
+    osrm::extractor::files::readRamIndex(ram_path, compressed_rtree);
+
+    osrm::benchmarks::benchmark(compressed_rtree, 10000);
+
     return 0;
 }
@@ -4,6 +4,7 @@
 #include "customizer/customizer.hpp"
 #include "customizer/edge_based_graph.hpp"
 #include "customizer/files.hpp"
+#include "customizer/landmark_customizer.hpp"
 
 #include "partitioner/cell_statistics.hpp"
 #include "partitioner/cell_storage.hpp"
@@ -20,6 +21,7 @@
 #include "util/timing_util.hpp"
 
 #include <boost/assert.hpp>
+#include <boost/filesystem/operations.hpp>
 
 #if TBB_VERSION_MAJOR == 2020
 #include <tbb/global_control.h>
@@ -118,6 +120,34 @@ std::vector<CellMetric> customizeFilteredMetrics(const partitioner::MultiLevelEd
 
     return metrics;
 }
+
+// Reuses the landmarks of an earlier customization, selecting them again is sequential and
+// their quality does not depend much on the current weights.
+std::vector<NodeID> LoadLandmarkSelection(const CustomizationConfig &config,
+                                          const std::size_t number_of_nodes,
+                                          const std::uint32_t connectivity_checksum)
+{
+    const auto path = config.GetPath(".osrm.landmarks");
+    std::vector<NodeID> selection;
+    if (!boost::filesystem::exists(path))
+        return selection;
+
+    Landmarks landmarks;
+    std::uint32_t landmarks_connectivity_checksum = 0;
+    files::readLandmarks(path, landmarks, landmarks_connectivity_checksum);
+    if (landmarks_connectivity_checksum != connectivity_checksum ||
+        landmarks.GetNumberOfLandmarks() != config.num_landmarks)
+        return selection;
+
+    for (std::size_t index = 0; index < landmarks.GetNumberOfLandmarks(); ++index)
+    {
+        if (landmarks.GetLandmark(index) >= number_of_nodes)
+            return {};
+        selection.push_back(landmarks.GetLandmark(index));
+    }
+
+    return selection;
+}
 } // namespace
 
 int Customizer::Run(const CustomizationConfig &config)
@@ -170,6 +200,30 @@ int Customizer::Run(const CustomizationConfig &config)
         printUnreachableStatistics(mlp, storage, metric);
     }
 
+    // The landmark weights are only valid for the weights they were computed with. Without
+    // landmarks a stale file has to go away, it would give wrong bounds for the new weights.
+    if (config.num_landmarks > 0)
+    {
+        TIMER_START(landmark_customize);
+        const LandmarkCustomizer landmark_customizer;
+        auto selection =
+            LoadLandmarkSelection(config, graph.GetNumberOfNodes(), connectivity_checksum);
+        if (selection.empty())
+        {
+            selection = landmark_customizer.Select(graph, config.num_landmarks);
+        }
+        const auto landmarks = landmark_customizer.Customize(graph, std::move(selection));
+        files::writeLandmarks(config.GetPath(".osrm.landmarks"), landmarks, connectivity_checksum);
+        TIMER_STOP(landmark_customize);
+        util::Log() << "Computing " << landmarks.GetNumberOfLandmarks() << " landmarks took "
+                    << TIMER_SEC(landmark_customize) << " seconds";
+    }
+    else if (boost::filesystem::exists(config.GetPath(".osrm.landmarks")))
+    {
+        util::Log() << "Removing outdated landmarks " << config.GetPath(".osrm.landmarks");
+        boost::filesystem::remove(config.GetPath(".osrm.landmarks"));
+    }
+
     TIMER_START(writing_mld_data);
     std::unordered_map<std::string, std::vector<CellMetric>> metric_exclude_classes = {
         {properties.GetWeightName(), std::move(metrics)},
@@ -1,15 +1,20 @@
 #include "engine/datafacade/mmap_memory_allocator.hpp"
 
 #include "storage/block.hpp"
+#include "storage/block_reader.hpp"
+#include "storage/huge_pages.hpp"
 #include "storage/io.hpp"
 #include "storage/serialization.hpp"
 #include "storage/storage.hpp"
+#include "storage/tar.hpp"
 
 #include "util/log.hpp"
 #include "util/mmap_file.hpp"
 
 #include <boost/assert.hpp>
 
+#include <iterator>
+
 namespace osrm
 {
 namespace engine
@@ -54,9 +59,48 @@ MMapMemoryAllocator::MMapMemoryAllocator(const storage::StorageConfig &config)
                 std::make_unique<storage::TarDataLayout>();
             boost::iostreams::mapped_file_source mapped_memory_file;
             auto data = util::mmapFile<char>(file.second, mapped_memory_file).data();
+            // reserved huge pages can't back regular files, but transparent ones can back
+            // read-only file mappings on kernels with CONFIG_READ_ONLY_THP_FOR_FS
+            if (config.huge_pages != storage::HugePages::Off)
+            {
+                storage::adviseHugePages(const_cast<char *>(data), mapped_memory_file.size());
+            }
             mapped_memory_files.push_back(std::move(mapped_memory_file));
             storage::populateLayoutFromFile(file.second, *layout);
+
+            // compressed entries can't be mapped, so their blocks are decompressed into memory
+            // that follows the mapped file and replaces its blocks of the same name
+            auto decompressed_layout = std::make_unique<storage::ContiguousDataLayout>();
+            std::vector<storage::tar::FileReader::FileEntry> entries;
+            storage::tar::FileReader reader(file.second,
+                                            storage::tar::FileReader::VerifyFingerprint);
+            reader.List(std::back_inserter(entries));
+            for (const auto &entry : entries)
+            {
+                if (entry.compressed)
+                {
+                    decompressed_layout->SetBlock(
+                        entry.name,
+                        storage::Block{layout->GetBlockEntries(entry.name), entry.size});
+                }
+            }
             allocated_regions.push_back({const_cast<char *>(data), std::move(layout)});
+
+            if (decompressed_layout->GetSizeOfLayout() > 0)
+            {
+                decompressed_memory.push_back(std::make_unique<storage::AnonymousMemory>(
+                    decompressed_layout->GetSizeOfLayout(), config.huge_pages));
+                const auto decompressed_data = decompressed_memory.back()->Ptr();
+
+                std::vector<storage::SharedDataIndex::AllocatedRegion> regions;
+                regions.push_back({decompressed_data,
+                                   std::make_unique<storage::ContiguousDataLayout>(
+                                       *decompressed_layout)});
+                storage::BlockReader block_reader{config.io_threads, config.direct_io};
+                block_reader.Read(file.second, storage::SharedDataIndex{std::move(regions)});
+
+                allocated_regions.push_back({decompressed_data, std::move(decompressed_layout)});
+            }
         }
     }
 
@@ -1,8 +1,15 @@
 #include "engine/datafacade/process_memory_allocator.hpp"
 #include "storage/storage.hpp"
+#include "util/log.hpp"
+#include "util/numa.hpp"
 
 #include "boost/assert.hpp"
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <cstring>
+
 namespace osrm
 {
 namespace engine
@@ -10,7 +17,24 @@ namespace engine
 namespace datafacade
 {
 
-ProcessMemoryAllocator::ProcessMemoryAllocator(const storage::StorageConfig &config)
+namespace
+{
+void bindToNumaNode(const storage::AnonymousMemory &memory,
+                    const std::uint64_t size,
+                    const unsigned numa_node)
+{
+    // binding before the pages are touched places them on the node, whichever CPU writes them
+    if (!util::bindMemoryToNumaNode(memory.Ptr(), size, numa_node))
+    {
+        util::Log(logWARNING) << "The dataset for NUMA node " << numa_node
+                              << " may be placed on any node";
+    }
+}
+} // namespace
+
+ProcessMemoryAllocator::ProcessMemoryAllocator(const storage::StorageConfig &config,
+                                               const boost::optional<unsigned> numa_node)
+    : huge_pages(config.huge_pages)
 {
     storage::Storage storage(config);
 
@@ -22,18 +46,51 @@ ProcessMemoryAllocator::ProcessMemoryAllocator(const storage::StorageConfig &con
     storage.PopulateLayoutWithRTree(*layout);
     storage.PopulateLayout(*layout, static_files);
     storage.PopulateLayout(*layout, updatable_files);
+    this->layout = static_cast<const storage::ContiguousDataLayout &>(*layout);
 
     // Allocate the memory block, then load data from files into it
-    internal_memory = std::make_unique<char[]>(layout->GetSizeOfLayout());
+    internal_memory =
+        std::make_unique<storage::AnonymousMemory>(layout->GetSizeOfLayout(), config.huge_pages);
+    if (numa_node)
+    {
+        bindToNumaNode(*internal_memory, layout->GetSizeOfLayout(), *numa_node);
+    }
 
     std::vector<storage::SharedDataIndex::AllocatedRegion> regions;
-    regions.push_back({internal_memory.get(), std::move(layout)});
+    regions.push_back({internal_memory->Ptr(), std::move(layout)});
     index = {std::move(regions)};
 
     storage.PopulateStaticData(index);
     storage.PopulateUpdatableData(index);
 }
 
+ProcessMemoryAllocator::ProcessMemoryAllocator(const ProcessMemoryAllocator &source,
+                                               const unsigned numa_node)
+    : layout(source.layout), huge_pages(source.huge_pages)
+{
+    const auto size = layout.GetSizeOfLayout();
+    internal_memory = std::make_unique<storage::AnonymousMemory>(size, huge_pages);
+    bindToNumaNode(*internal_memory, size, numa_node);
+
+    const auto source_ptr = source.internal_memory->Ptr();
+    const auto target_ptr = internal_memory->Ptr();
+    const std::uint64_t chunk_size = 64 * 1024 * 1024;
+    tbb::parallel_for(tbb::blocked_range<std::uint64_t>(0, (size + chunk_size - 1) / chunk_size),
+                      [&](const tbb::blocked_range<std::uint64_t> &range) {
+                          for (auto chunk = range.begin(); chunk != range.end(); ++chunk)
+                          {
+                              const auto offset = chunk * chunk_size;
+                              std::memcpy(target_ptr + offset,
+                                          source_ptr + offset,
+                                          std::min(chunk_size, size - offset));
+                          }
+                      });
+
+    std::vector<storage::SharedDataIndex::AllocatedRegion> regions;
+    regions.push_back({target_ptr, std::make_unique<storage::ContiguousDataLayout>(layout)});
+    index = {std::move(regions)};
+}
+
 ProcessMemoryAllocator::~ProcessMemoryAllocator() {}
 
 const storage::SharedDataIndex &ProcessMemoryAllocator::GetIndex() { return index; }
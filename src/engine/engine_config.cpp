@@ -18,14 +18,20 @@ bool EngineConfig::IsValid() const
     const bool limits_valid = unlimited_or_more_than(max_locations_distance_table, 2) &&
                               unlimited_or_more_than(max_locations_map_matching, 2) &&
                               unlimited_or_more_than(max_radius_map_matching, 0) &&
+                              max_matching_sessions >= 0 && matching_session_timeout > 0 &&
                               unlimited_or_more_than(max_locations_trip, 2) &&
+                              unlimited_or_more_than(max_trip_optimization_time, 0) &&
                               unlimited_or_more_than(max_locations_viaroute, 2) &&
                               unlimited_or_more_than(max_results_nearest, 0) &&
+                              unlimited_or_more_than(max_duration_isochrone, 0) &&
                               max_alternatives >= 0;
 
+    // only process memory can be replicated per NUMA node
+    const bool replication_valid = !numa_replication || (!use_shared_memory && !use_mmap);
+
     return ((use_shared_memory && all_path_are_empty) || (use_mmap && storage_config.IsValid()) ||
             storage_config.IsValid()) &&
-           limits_valid;
+           limits_valid && replication_valid;
 }
 } // namespace engine
 } // namespace osrm
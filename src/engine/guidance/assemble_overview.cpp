@@ -1,6 +1,11 @@
 #include "engine/douglas_peucker.hpp"
 #include "engine/guidance/leg_geometry.hpp"
+#include "util/coordinate_calculation.hpp"
+#include "util/integer_range.hpp"
 #include "util/viewport.hpp"
+#include "util/web_mercator.hpp"
+
+#include <boost/assert.hpp>
 
 #include <iterator>
 #include <limits>
@@ -39,6 +44,45 @@ unsigned calculateOverviewZoomLevel(const std::vector<LegGeometry> &leg_geometri
 
     return util::viewport::getFittedZoom(south_west, north_east);
 }
+
+// Keeps the coordinates that are needed on the zoom level according to their precomputed
+// simplification rank. The ranks are computed for every compressed geometry on its own, so
+// their end points always have rank 0. Coordinates closer than the threshold of the zoom level
+// to the previously kept one are dropped as well, which takes care of the many end points of
+// streets with a lot of intersections.
+std::vector<util::Coordinate> filterByRank(const LegGeometry &geometry, const unsigned zoom_level)
+{
+    BOOST_ASSERT(zoom_level < detail::DOUGLAS_PEUCKER_THRESHOLDS_SIZE);
+    BOOST_ASSERT(geometry.simplification_ranks.size() == geometry.locations.size());
+
+    std::vector<util::Coordinate> simplified_geometry;
+    if (geometry.locations.size() < 2)
+    {
+        return simplified_geometry;
+    }
+
+    const auto threshold = detail::DOUGLAS_PEUCKER_THRESHOLDS[zoom_level];
+    const auto last = geometry.locations.size() - 1;
+    simplified_geometry.push_back(geometry.locations.front());
+    auto previous = util::web_mercator::fromWGS84(geometry.locations.front());
+    for (const auto idx : util::irange<std::size_t>(1, last))
+    {
+        if (geometry.simplification_ranks[idx] > zoom_level)
+        {
+            continue;
+        }
+
+        const auto projected = util::web_mercator::fromWGS84(geometry.locations[idx]);
+        if (util::coordinate_calculation::squaredEuclideanDistance(previous, projected) > threshold)
+        {
+            simplified_geometry.push_back(geometry.locations[idx]);
+            previous = projected;
+        }
+    }
+    simplified_geometry.push_back(geometry.locations.back());
+
+    return simplified_geometry;
+}
 } // namespace
 
 std::vector<util::Coordinate> assembleOverview(const std::vector<LegGeometry> &leg_geometries,
@@ -74,9 +118,18 @@ std::vector<util::Coordinate> assembleOverview(const std::vector<LegGeometry> &l
         const auto zoom_level = std::min(18u, calculateOverviewZoomLevel(leg_geometries));
         for (const auto &geometry : leg_geometries)
         {
-            const auto simplified =
-                douglasPeucker(geometry.locations.begin(), geometry.locations.end(), zoom_level);
-            insert_without_overlap(simplified.begin(), simplified.end());
+            // geometries that were not assembled from the data facade have no ranks
+            if (geometry.simplification_ranks.size() != geometry.locations.size())
+            {
+                const auto simplified = douglasPeucker(
+                    geometry.locations.begin(), geometry.locations.end(), zoom_level);
+                insert_without_overlap(simplified.begin(), simplified.end());
+            }
+            else
+            {
+                const auto simplified = filterByRank(geometry, zoom_level);
+                insert_without_overlap(simplified.begin(), simplified.end());
+            }
         }
     }
     else
@@ -1,5 +1,6 @@
 #include "util/for_each_pair.hpp"
 #include "util/group_by.hpp"
+#include "util/monotonic_arena.hpp"
 
 #include "guidance/turn_instruction.hpp"
 #include "engine/guidance/collapsing_utility.hpp"
@@ -17,8 +18,7 @@ namespace guidance
 {
 using namespace osrm::guidance;
 
-std::vector<RouteStep> anticipateLaneChange(std::vector<RouteStep> steps,
-                                            const double min_distance_needed_for_lane_change)
+RouteSteps anticipateLaneChange(RouteSteps steps, const double min_distance_needed_for_lane_change)
 {
     // Lane anticipation works on contiguous ranges of short steps that have lane information
     const auto is_short_has_lanes = [&](const RouteStep &step) {
@@ -47,7 +47,7 @@ std::vector<RouteStep> anticipateLaneChange(std::vector<RouteStep> steps,
     using StepIter = decltype(steps)::iterator;
     using StepIterRange = std::pair<StepIter, StepIter>;
 
-    std::vector<StepIterRange> quick_lanes_ranges;
+    util::ArenaVector<StepIterRange> quick_lanes_ranges;
 
     const auto range_back_inserter = [&](StepIterRange range) {
         if (std::distance(range.first, range.second) > 1)
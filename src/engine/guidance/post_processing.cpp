@@ -31,7 +31,7 @@ namespace guidance
 {
 using namespace osrm::guidance;
 
-using RouteStepIterator = std::vector<osrm::engine::guidance::RouteStep>::iterator;
+using RouteStepIterator = osrm::engine::guidance::RouteSteps::iterator;
 
 namespace
 {
@@ -177,7 +177,7 @@ void processRoundaboutGroups(const std::pair<RouteStepIterator, RouteStepIterato
 // They are required for maintenance purposes. We can calculate the number
 // of exits to pass in a roundabout and the number of intersections
 // that we come across.
-std::vector<RouteStep> handleRoundabouts(std::vector<RouteStep> steps)
+RouteSteps handleRoundabouts(RouteSteps steps)
 {
     // check if a step has roundabout type
     const auto has_roundabout_type = [](auto const &step) {
@@ -241,7 +241,7 @@ std::vector<RouteStep> handleRoundabouts(std::vector<RouteStep> steps)
 // As a direct implication, we have to keep the time of the initial/final turns (which adds a
 // few seconds of inaccuracy at both ends. This is acceptable, however, since the turn should
 // usually not be as relevant.
-void trimShortSegments(std::vector<RouteStep> &steps, LegGeometry &geometry)
+void trimShortSegments(RouteSteps &steps, LegGeometry &geometry)
 {
     if (steps.size() < 2 || geometry.locations.size() <= 2)
         return;
@@ -281,6 +281,10 @@ void trimShortSegments(std::vector<RouteStep> &steps, LegGeometry &geometry)
                                        geometry.annotations.begin() + offset);
             geometry.osm_node_ids.erase(geometry.osm_node_ids.begin(),
                                         geometry.osm_node_ids.begin() + offset);
+            if (!geometry.simplification_ranks.empty())
+                geometry.simplification_ranks.erase(geometry.simplification_ranks.begin(),
+                                                    geometry.simplification_ranks.begin() +
+                                                        offset);
         }
 
         auto const first_bearing = steps.front().maneuver.bearing_after;
@@ -415,6 +419,8 @@ void trimShortSegments(std::vector<RouteStep> &steps, LegGeometry &geometry)
         geometry.locations.pop_back();
         geometry.annotations.pop_back();
         geometry.osm_node_ids.pop_back();
+        if (!geometry.simplification_ranks.empty())
+            geometry.simplification_ranks.pop_back();
         geometry.segment_offsets.back()--;
         // since the last geometry includes the location of arrival, the arrival instruction
         // geometry overlaps with the previous segment
@@ -453,10 +459,10 @@ void trimShortSegments(std::vector<RouteStep> &steps, LegGeometry &geometry)
 }
 
 // assign relative locations to depart/arrive instructions
-std::vector<RouteStep> assignRelativeLocations(std::vector<RouteStep> steps,
-                                               const LegGeometry &leg_geometry,
-                                               const PhantomNode &source_node,
-                                               const PhantomNode &target_node)
+RouteSteps assignRelativeLocations(RouteSteps steps,
+                                   const LegGeometry &leg_geometry,
+                                   const PhantomNode &source_node,
+                                   const PhantomNode &target_node)
 {
     // We report the relative position of source/target to the road only within a range that is
     // sufficiently different but not full of the path
@@ -499,7 +505,7 @@ std::vector<RouteStep> assignRelativeLocations(std::vector<RouteStep> steps,
     return steps;
 }
 
-LegGeometry resyncGeometry(LegGeometry leg_geometry, const std::vector<RouteStep> &steps)
+LegGeometry resyncGeometry(LegGeometry leg_geometry, const RouteSteps &steps)
 {
     // The geometry uses an adjacency array-like structure for representation.
     // To sync it back up with the steps, we cann add a segment for every step.
@@ -522,7 +528,7 @@ LegGeometry resyncGeometry(LegGeometry leg_geometry, const std::vector<RouteStep
     return leg_geometry;
 }
 
-std::vector<RouteStep> buildIntersections(std::vector<RouteStep> steps)
+RouteSteps buildIntersections(RouteSteps steps)
 {
     std::size_t last_valid_instruction = 0;
     for (std::size_t step_index = 0; step_index < steps.size(); ++step_index)
@@ -577,7 +583,7 @@ std::vector<RouteStep> buildIntersections(std::vector<RouteStep> steps)
 }
 
 void applyOverrides(const datafacade::BaseDataFacade &facade,
-                    std::vector<RouteStep> &steps,
+                    RouteSteps &steps,
                     const LegGeometry &leg_geometry)
 {
     // Find overrides that match, and apply them
@@ -12,7 +12,7 @@ namespace guidance
 {
 using namespace osrm::guidance;
 
-std::vector<RouteStep> suppressShortNameSegments(std::vector<RouteStep> steps)
+RouteSteps suppressShortNameSegments(RouteSteps steps)
 {
     // guard against empty routes, even though they shouldn't happen
     if (steps.empty())
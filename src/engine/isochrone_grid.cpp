@@ -0,0 +1,309 @@
+#include "engine/isochrone_grid.hpp"
+#include "util/coordinate_calculation.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <tuple>
+#include <utility>
+
+namespace osrm
+{
+namespace engine
+{
+
+namespace
+{
+// Empty cells around the box: one for growing the reached area and one to flood fill around it
+const constexpr std::size_t PADDING = 2;
+
+const constexpr double METERS_PER_DEGREE =
+    util::coordinate_calculation::detail::EARTH_RADIUS * M_PI / 180.;
+
+// Lowest cosine of the latitude used for the longitudinal cell size, to stay finite at the poles
+const constexpr double MIN_LATITUDE_SCALE = 0.01;
+
+template <typename PointT> double cross(const PointT &origin, const PointT &lhs, const PointT &rhs)
+{
+    return (lhs.x - origin.x) * (rhs.y - origin.y) - (lhs.y - origin.y) * (rhs.x - origin.x);
+}
+} // namespace
+
+IsochroneGrid::IsochroneGrid(const util::Coordinate south_west,
+                             const util::Coordinate north_east,
+                             const double cell_size)
+{
+    BOOST_ASSERT(cell_size > 0);
+
+    const auto south = static_cast<double>(util::toFloating(south_west.lat));
+    const auto west = static_cast<double>(util::toFloating(south_west.lon));
+    const auto north = static_cast<double>(util::toFloating(north_east.lat));
+    const auto east = static_cast<double>(util::toFloating(north_east.lon));
+    BOOST_ASSERT(south <= north && west <= east);
+
+    const auto latitude_scale =
+        std::max(std::cos(util::coordinate_calculation::detail::degToRad((south + north) / 2.)),
+                 MIN_LATITUDE_SCALE);
+    cell_lat = cell_size / METERS_PER_DEGREE;
+    cell_lon = cell_lat / latitude_scale;
+    origin_lon = west - PADDING * cell_lon;
+    origin_lat = south - PADDING * cell_lat;
+    width = static_cast<std::size_t>((east - west) / cell_lon) + 1 + 2 * PADDING;
+    height = static_cast<std::size_t>((north - south) / cell_lat) + 1 + 2 * PADDING;
+    durations.resize(width * height, MAXIMAL_EDGE_DURATION);
+}
+
+IsochroneGrid::Point IsochroneGrid::ToGrid(const util::Coordinate coordinate) const
+{
+    return {(static_cast<double>(util::toFloating(coordinate.lon)) - origin_lon) / cell_lon,
+            (static_cast<double>(util::toFloating(coordinate.lat)) - origin_lat) / cell_lat};
+}
+
+util::Coordinate IsochroneGrid::FromGrid(const std::size_t x, const std::size_t y) const
+{
+    return util::Coordinate{util::FloatLongitude{origin_lon + x * cell_lon},
+                            util::FloatLatitude{origin_lat + y * cell_lat}};
+}
+
+void IsochroneGrid::Mark(const Point point, const EdgeDuration duration)
+{
+    // keep rounding errors at the edges of the box out of the padding
+    const auto clamp = [](const double value, const std::size_t size) {
+        return static_cast<std::size_t>(std::min(std::max(value, static_cast<double>(PADDING)),
+                                                 static_cast<double>(size - 1 - PADDING)));
+    };
+    auto &cell = durations[clamp(point.y, height) * width + clamp(point.x, width)];
+    cell = std::min(cell, duration);
+}
+
+void IsochroneGrid::Draw(const Point from,
+                         const Point to,
+                         const EdgeDuration from_duration,
+                         const EdgeDuration to_duration)
+{
+    // sample twice per cell so that no cell along the segment is skipped
+    const auto length = std::max(std::abs(to.x - from.x), std::abs(to.y - from.y));
+    const auto number_of_samples = std::max(static_cast<int>(std::ceil(2 * length)), 1);
+
+    for (int sample = 0; sample <= number_of_samples; ++sample)
+    {
+        const auto ratio = static_cast<double>(sample) / number_of_samples;
+        const auto duration = static_cast<EdgeDuration>(
+            std::round(from_duration + ratio * (to_duration - from_duration)));
+        if (duration < 0)
+            continue;
+
+        Mark({from.x + ratio * (to.x - from.x), from.y + ratio * (to.y - from.y)}, duration);
+    }
+}
+
+void IsochroneGrid::AddSegment(const util::Coordinate from,
+                               const util::Coordinate to,
+                               const EdgeDuration from_duration,
+                               const EdgeDuration to_duration)
+{
+    Draw(ToGrid(from), ToGrid(to), from_duration, to_duration);
+}
+
+void IsochroneGrid::AddConvexHull(const std::vector<util::Coordinate> &coordinates,
+                                  const EdgeDuration duration)
+{
+    if (coordinates.empty())
+        return;
+
+    std::vector<Point> points;
+    points.reserve(coordinates.size());
+    for (const auto coordinate : coordinates)
+        points.push_back(ToGrid(coordinate));
+
+    const auto less = [](const Point &lhs, const Point &rhs) {
+        return std::tie(lhs.x, lhs.y) < std::tie(rhs.x, rhs.y);
+    };
+    std::sort(points.begin(), points.end(), less);
+
+    // Andrew's monotone chain, the hull is counter-clockwise without collinear points
+    std::vector<Point> hull(2 * points.size());
+    std::size_t size = 0;
+    for (std::size_t index = 0; index < points.size(); ++index)
+    {
+        while (size >= 2 && cross(hull[size - 2], hull[size - 1], points[index]) <= 0)
+            --size;
+        hull[size++] = points[index];
+    }
+    for (std::size_t index = points.size() - 1, lower_size = size + 1; index-- > 0;)
+    {
+        while (size >= lower_size && cross(hull[size - 2], hull[size - 1], points[index]) <= 0)
+            --size;
+        hull[size++] = points[index];
+    }
+    hull.resize(size > 1 ? size - 1 : size);
+
+    // the outline marks the cells of degenerated and very thin hulls
+    for (std::size_t index = 0; index < hull.size(); ++index)
+        Draw(hull[index], hull[(index + 1) % hull.size()], duration, duration);
+
+    if (hull.size() < 3)
+        return;
+
+    const auto x_range = std::minmax_element(
+        hull.begin(), hull.end(), [](const auto &lhs, const auto &rhs) { return lhs.x < rhs.x; });
+    const auto y_range = std::minmax_element(
+        hull.begin(), hull.end(), [](const auto &lhs, const auto &rhs) { return lhs.y < rhs.y; });
+
+    for (auto y = std::floor(y_range.first->y); y <= y_range.second->y; ++y)
+    {
+        for (auto x = std::floor(x_range.first->x); x <= x_range.second->x; ++x)
+        {
+            const Point center{x + 0.5, y + 0.5};
+            bool inside = true;
+            for (std::size_t index = 0; inside && index < hull.size(); ++index)
+                inside = cross(hull[index], hull[(index + 1) % hull.size()], center) >= 0;
+
+            if (inside)
+                Mark(center, duration);
+        }
+    }
+}
+
+std::vector<std::vector<util::Coordinate>>
+IsochroneGrid::GetContour(const EdgeDuration duration) const
+{
+    const auto index = [this](const std::size_t x, const std::size_t y) { return y * width + x; };
+
+    // grow the reached cells by one cell to close the gaps between neighbouring roads
+    std::vector<bool> area(durations.size(), false);
+    for (std::size_t y = 1; y + 1 < height; ++y)
+    {
+        for (std::size_t x = 1; x + 1 < width; ++x)
+        {
+            if (durations[index(x, y)] > duration)
+                continue;
+
+            for (auto neighbour_y = y - 1; neighbour_y <= y + 1; ++neighbour_y)
+                for (auto neighbour_x = x - 1; neighbour_x <= x + 1; ++neighbour_x)
+                    area[index(neighbour_x, neighbour_y)] = true;
+        }
+    }
+
+    // everything that can't be reached from the border without crossing the area is inside,
+    // this fills all holes of the area
+    std::vector<bool> outside(durations.size(), false);
+    std::vector<std::pair<std::size_t, std::size_t>> stack{{0, 0}};
+    outside[index(0, 0)] = true;
+    while (!stack.empty())
+    {
+        const auto cell = stack.back();
+        stack.pop_back();
+
+        const auto visit = [&](const std::size_t x, const std::size_t y) {
+            if (!area[index(x, y)] && !outside[index(x, y)])
+            {
+                outside[index(x, y)] = true;
+                stack.emplace_back(x, y);
+            }
+        };
+        if (cell.first > 0)
+            visit(cell.first - 1, cell.second);
+        if (cell.first + 1 < width)
+            visit(cell.first + 1, cell.second);
+        if (cell.second > 0)
+            visit(cell.first, cell.second - 1);
+        if (cell.second + 1 < height)
+            visit(cell.first, cell.second + 1);
+    }
+
+    // Boundary edges between the cells inside and outside, directed such that the inside is on
+    // their left. Vertices are the corners of the cells.
+    const auto vertex = [this](const std::size_t x, const std::size_t y) {
+        return y * (width + 1) + x;
+    };
+    std::vector<std::pair<std::size_t, std::size_t>> edges;
+    for (std::size_t y = 1; y + 1 < height; ++y)
+    {
+        for (std::size_t x = 1; x + 1 < width; ++x)
+        {
+            if (outside[index(x, y)])
+                continue;
+
+            if (outside[index(x, y - 1)])
+                edges.emplace_back(vertex(x, y), vertex(x + 1, y));
+            if (outside[index(x + 1, y)])
+                edges.emplace_back(vertex(x + 1, y), vertex(x + 1, y + 1));
+            if (outside[index(x, y + 1)])
+                edges.emplace_back(vertex(x + 1, y + 1), vertex(x, y + 1));
+            if (outside[index(x - 1, y)])
+                edges.emplace_back(vertex(x, y + 1), vertex(x, y));
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    struct VertexPoint
+    {
+        long x;
+        long y;
+    };
+    const auto point = [this](const std::size_t vertex_id) {
+        return VertexPoint{static_cast<long>(vertex_id % (width + 1)),
+                           static_cast<long>(vertex_id / (width + 1))};
+    };
+
+    // Two edges leave a vertex where two inside cells touch diagonally. Taking the left turn
+    // there keeps the cells in separate rings, so every edge has exactly one successor.
+    const auto successor = [&](const std::size_t edge) {
+        const auto from = point(edges[edge].first);
+        const auto to = point(edges[edge].second);
+        const auto begin = std::lower_bound(
+            edges.begin(), edges.end(), std::make_pair(edges[edge].second, std::size_t{0}));
+        BOOST_ASSERT(begin != edges.end() && begin->first == edges[edge].second);
+
+        auto next = begin;
+        if (std::next(begin) != edges.end() && std::next(begin)->first == begin->first)
+        {
+            const VertexPoint origin{0, 0};
+            const VertexPoint incoming{to.x - from.x, to.y - from.y};
+            const auto target = point(begin->second);
+            const VertexPoint outgoing{target.x - to.x, target.y - to.y};
+            if (cross(origin, incoming, outgoing) < 0)
+                next = std::next(begin);
+        }
+        return static_cast<std::size_t>(std::distance(edges.begin(), next));
+    };
+
+    std::vector<std::vector<util::Coordinate>> rings;
+    std::vector<bool> used(edges.size(), false);
+    for (std::size_t start = 0; start < edges.size(); ++start)
+    {
+        if (used[start])
+            continue;
+
+        std::vector<VertexPoint> ring;
+        auto edge = start;
+        do
+        {
+            used[edge] = true;
+            ring.push_back(point(edges[edge].first));
+            edge = successor(edge);
+        } while (edge != start);
+
+        // only keep the corners of the ring
+        std::vector<util::Coordinate> coordinates;
+        for (std::size_t position = 0; position < ring.size(); ++position)
+        {
+            const auto &previous = ring[(position + ring.size() - 1) % ring.size()];
+            const auto &current = ring[position];
+            const auto &next = ring[(position + 1) % ring.size()];
+            if (cross(previous, current, next) != 0)
+                coordinates.push_back(FromGrid(current.x, current.y));
+        }
+        BOOST_ASSERT(coordinates.size() >= 4);
+        coordinates.push_back(coordinates.front());
+        rings.push_back(std::move(coordinates));
+    }
+
+    return rings;
+}
+
+} // namespace engine
+} // namespace osrm
@@ -0,0 +1,80 @@
+#include "engine/map_matching/matching_session.hpp"
+
+#include <utility>
+
+namespace osrm
+{
+namespace engine
+{
+namespace map_matching
+{
+
+MatchingSessionStore::MatchingSessionStore(const std::size_t capacity,
+                                           const Clock::duration timeout)
+    : capacity(capacity), timeout(timeout)
+{
+}
+
+MatchingSession MatchingSessionStore::Find(const std::string &id, const Clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    EvictExpired(now);
+
+    const auto position = positions.find(id);
+    if (position == positions.end())
+    {
+        return {};
+    }
+
+    position->second->last_used = now;
+    entries.splice(entries.begin(), entries, position->second);
+    return position->second->session;
+}
+
+void MatchingSessionStore::Store(const std::string &id,
+                                 MatchingSession session,
+                                 const Clock::time_point now)
+{
+    if (capacity == 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    EvictExpired(now);
+
+    const auto position = positions.find(id);
+    if (position != positions.end())
+    {
+        position->second->session = std::move(session);
+        position->second->last_used = now;
+        entries.splice(entries.begin(), entries, position->second);
+        return;
+    }
+
+    if (entries.size() >= capacity)
+    {
+        positions.erase(entries.back().id);
+        entries.pop_back();
+    }
+
+    entries.push_front(Entry{id, std::move(session), now});
+    positions.emplace(id, entries.begin());
+}
+
+std::size_t MatchingSessionStore::GetSize() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+void MatchingSessionStore::EvictExpired(const Clock::time_point now)
+{
+    while (!entries.empty() && now - entries.back().last_used > timeout)
+    {
+        positions.erase(entries.back().id);
+        entries.pop_back();
+    }
+}
+
+} // namespace map_matching
+} // namespace engine
+} // namespace osrm
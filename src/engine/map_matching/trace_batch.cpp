@@ -0,0 +1,356 @@
+#include "engine/map_matching/trace_batch.hpp"
+
+#include "storage/tar.hpp"
+
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
+#include "util/integer_range.hpp"
+
+#include <boost/assert.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/optional.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace map_matching
+{
+
+namespace
+{
+struct CSVTracePoint
+{
+    std::uint64_t id;
+    util::FloatCoordinate coordinate;
+    boost::optional<unsigned> timestamp;
+    boost::optional<double> radius;
+};
+
+// Parses a complete field as a number, returns none on trailing garbage or overflows
+template <typename T, typename Parse>
+boost::optional<T> parseCSVField(const std::string &field, Parse parse)
+{
+    const char *begin = field.c_str();
+    char *end = nullptr;
+    errno = 0;
+    const auto value = parse(begin, &end);
+    while (*end == ' ' || *end == '\r')
+        ++end;
+    if (end == begin || *end != '\0' || errno != 0)
+        return boost::none;
+    return static_cast<T>(value);
+}
+
+// Parses `trace_id,longitude,latitude[,timestamp[,radius]]`, returns none on malformed lines
+boost::optional<CSVTracePoint> parseCSVTracePoint(const std::string &line)
+{
+    std::vector<std::string> fields;
+    std::size_t begin = 0;
+    while (fields.size() < 6)
+    {
+        const auto end = line.find(',', begin);
+        fields.push_back(line.substr(begin, end - begin));
+        if (end == std::string::npos)
+            break;
+        begin = end + 1;
+    }
+    if (fields.size() < 3 || fields.size() > 5)
+        return boost::none;
+
+    const auto parse_integer = [](const char *begin, char **end) {
+        return std::strtoull(begin, end, 10);
+    };
+    const auto parse_double = [](const char *begin, char **end) { return std::strtod(begin, end); };
+
+    const auto id = parseCSVField<std::uint64_t>(fields[0], parse_integer);
+    const auto longitude = parseCSVField<double>(fields[1], parse_double);
+    const auto latitude = parseCSVField<double>(fields[2], parse_double);
+    if (!id || !longitude || !latitude)
+        return boost::none;
+
+    CSVTracePoint point{*id,
+                        util::FloatCoordinate{util::FloatLongitude{*longitude},
+                                              util::FloatLatitude{*latitude}},
+                        boost::none,
+                        boost::none};
+    if (!point.coordinate.IsValid())
+        return boost::none;
+
+    if (fields.size() > 3)
+    {
+        point.timestamp = parseCSVField<unsigned>(fields[3], parse_integer);
+        if (!point.timestamp)
+            return boost::none;
+    }
+    if (fields.size() > 4)
+    {
+        point.radius = parseCSVField<double>(fields[4], parse_double);
+        if (!point.radius)
+            return boost::none;
+    }
+
+    return point;
+}
+} // namespace
+
+CSVTraceReader::CSVTraceReader(std::istream &input) : input(input), line_number(0) {}
+
+std::size_t CSVTraceReader::Read(const std::size_t max_traces, std::vector<Trace> &traces)
+{
+    std::size_t number_of_traces = 0;
+    boost::optional<Trace> trace;
+
+    const auto finish_trace = [&] {
+        if (!trace->timestamps.empty() && trace->timestamps.size() != trace->coordinates.size())
+            throw util::exception("Trace " + std::to_string(trace->id) +
+                                  " has timestamps only for some of its points" + SOURCE_REF);
+        if (!trace->radiuses.empty() && trace->radiuses.size() != trace->coordinates.size())
+            throw util::exception("Trace " + std::to_string(trace->id) +
+                                  " has radiuses only for some of its points" + SOURCE_REF);
+        traces.push_back(std::move(*trace));
+        trace = boost::none;
+        ++number_of_traces;
+    };
+
+    std::string line;
+    while (number_of_traces < max_traces)
+    {
+        if (!pending_line.empty())
+        {
+            line.swap(pending_line);
+            pending_line.clear();
+        }
+        else if (std::getline(input, line))
+        {
+            ++line_number;
+            if (line.empty() || line == "\r")
+                continue;
+        }
+        else
+        {
+            break;
+        }
+
+        const auto point = parseCSVTracePoint(line);
+        if (!point)
+        {
+            // the first line may be a header
+            if (line_number == 1)
+                continue;
+            throw util::exception("Malformed trace point on line " +
+                                  std::to_string(line_number) + ": " + line + SOURCE_REF);
+        }
+
+        if (trace && trace->id != point->id)
+        {
+            pending_line = std::move(line);
+            finish_trace();
+            continue;
+        }
+
+        if (!trace)
+        {
+            trace = Trace{point->id, {}, {}, {}};
+        }
+        trace->coordinates.push_back(util::Coordinate{point->coordinate});
+        if (point->timestamp)
+            trace->timestamps.push_back(*point->timestamp);
+        if (point->radius)
+            trace->radiuses.push_back(*point->radius);
+    }
+
+    if (trace)
+    {
+        finish_trace();
+    }
+
+    return number_of_traces;
+}
+
+BinaryTraceReader::BinaryTraceReader(std::istream &input) : input(input) {}
+
+std::size_t BinaryTraceReader::Read(const std::size_t max_traces, std::vector<Trace> &traces)
+{
+    struct BinaryTracePoint
+    {
+        std::int32_t longitude;
+        std::int32_t latitude;
+        std::uint32_t timestamp;
+    };
+    static_assert(sizeof(BinaryTracePoint) == 12, "binary trace points are packed");
+
+    std::vector<BinaryTracePoint> points;
+    std::size_t number_of_traces = 0;
+    while (number_of_traces < max_traces)
+    {
+        std::uint64_t id;
+        std::uint32_t number_of_points;
+        if (!input.read(reinterpret_cast<char *>(&id), sizeof(id)))
+            break;
+        if (!input.read(reinterpret_cast<char *>(&number_of_points), sizeof(number_of_points)))
+            throw util::exception("Truncated header of trace " + std::to_string(id) +
+                                  SOURCE_REF);
+
+        points.resize(number_of_points);
+        if (!input.read(reinterpret_cast<char *>(points.data()),
+                        number_of_points * sizeof(BinaryTracePoint)))
+            throw util::exception("Truncated points of trace " + std::to_string(id) +
+                                  SOURCE_REF);
+
+        Trace trace{id, {}, {}, {}};
+        trace.coordinates.reserve(number_of_points);
+        trace.timestamps.reserve(number_of_points);
+        for (const auto &point : points)
+        {
+            trace.coordinates.push_back(util::Coordinate{util::FixedLongitude{point.longitude},
+                                                         util::FixedLatitude{point.latitude}});
+            trace.timestamps.push_back(point.timestamp);
+        }
+        traces.push_back(std::move(trace));
+        ++number_of_traces;
+    }
+
+    return number_of_traces;
+}
+
+void MatchedTraces::Append(const MatchedTraces &other)
+{
+    const auto append = [](auto &to, const auto &from) {
+        to.insert(to.end(), from.begin(), from.end());
+    };
+    const auto append_offsets = [](auto &to, const auto &from) {
+        const auto base = to.back();
+        std::transform(std::next(from.begin()),
+                       from.end(),
+                       std::back_inserter(to),
+                       [base](const auto offset) { return base + offset; });
+    };
+
+    append(trace_ids, other.trace_ids);
+    append_offsets(matching_offsets, other.matching_offsets);
+    append(confidences, other.confidences);
+    append_offsets(segment_offsets, other.segment_offsets);
+    append(from_osm_node_ids, other.from_osm_node_ids);
+    append(to_osm_node_ids, other.to_osm_node_ids);
+    append(durations, other.durations);
+}
+
+MatchedTracesWriter::MatchedTracesWriter(const boost::filesystem::path &path_)
+    : path(path_), matching_offset(0), segment_offset(0)
+{
+    const std::array<const char *, NUMBER_OF_COLUMNS> names = {
+        {"/match/traces/ids",
+         "/match/traces/matching_offsets",
+         "/match/matchings/confidences",
+         "/match/matchings/segment_offsets",
+         "/match/segments/from_osm_node_ids",
+         "/match/segments/to_osm_node_ids",
+         "/match/segments/durations"}};
+    for (const auto index : util::irange<std::size_t>(0, NUMBER_OF_COLUMNS))
+    {
+        auto &column = columns[index];
+        column.name = names[index];
+        column.path = path;
+        column.path += "." + std::to_string(index) + ".tmp";
+        column.stream.open(column.path.string(), std::ios::binary | std::ios::trunc);
+        if (!column.stream)
+        {
+            throw util::exception("Could not open " + column.path.string() + SOURCE_REF);
+        }
+        column.count = 0;
+    }
+
+    Write(MATCHING_OFFSETS, &matching_offset, 1);
+    Write(SEGMENT_OFFSETS, &segment_offset, 1);
+}
+
+MatchedTracesWriter::~MatchedTracesWriter()
+{
+    for (auto &column : columns)
+    {
+        column.stream.close();
+        boost::system::error_code error;
+        boost::filesystem::remove(column.path, error);
+    }
+}
+
+template <typename T>
+void MatchedTracesWriter::Write(const ColumnIndex index, const T *data, const std::size_t count)
+{
+    auto &column = columns[index];
+    column.stream.write(reinterpret_cast<const char *>(data), count * sizeof(T));
+    if (!column.stream)
+    {
+        throw util::exception("Could not write " + column.path.string() + SOURCE_REF);
+    }
+    column.count += count;
+}
+
+void MatchedTracesWriter::Append(const MatchedTraces &traces)
+{
+    // the offsets continue behind the ones already written, without their leading zero
+    const auto write_offsets = [this](const ColumnIndex index,
+                                      const std::vector<std::uint64_t> &offsets,
+                                      std::uint64_t &base) {
+        BOOST_ASSERT(!offsets.empty() && offsets.front() == 0);
+        std::vector<std::uint64_t> shifted;
+        shifted.reserve(offsets.size() - 1);
+        std::transform(std::next(offsets.begin()),
+                       offsets.end(),
+                       std::back_inserter(shifted),
+                       [base](const auto offset) { return base + offset; });
+        Write(index, shifted.data(), shifted.size());
+        base += offsets.back();
+    };
+
+    Write(TRACE_IDS, traces.trace_ids.data(), traces.trace_ids.size());
+    write_offsets(MATCHING_OFFSETS, traces.matching_offsets, matching_offset);
+    Write(CONFIDENCES, traces.confidences.data(), traces.confidences.size());
+    write_offsets(SEGMENT_OFFSETS, traces.segment_offsets, segment_offset);
+    Write(FROM_OSM_NODE_IDS, traces.from_osm_node_ids.data(), traces.from_osm_node_ids.size());
+    Write(TO_OSM_NODE_IDS, traces.to_osm_node_ids.data(), traces.to_osm_node_ids.size());
+    Write(DURATIONS, traces.durations.data(), traces.durations.size());
+}
+
+void MatchedTracesWriter::Finish()
+{
+    // the columns are copied in chunks, each one is the last entry of the file while it is written
+    const constexpr std::size_t CHUNK_SIZE = 16 * 1024 * 1024;
+    std::vector<char> buffer(CHUNK_SIZE);
+
+    storage::tar::FileWriter writer{path, storage::tar::FileWriter::GenerateFingerprint};
+    for (auto &column : columns)
+    {
+        column.stream.close();
+        if (!column.stream)
+        {
+            throw util::exception("Could not write " + column.path.string() + SOURCE_REF);
+        }
+
+        std::ifstream input(column.path.string(), std::ios::binary);
+        if (!input)
+        {
+            throw util::exception("Could not open " + column.path.string() + SOURCE_REF);
+        }
+        writer.WriteElementCount64(column.name, column.count);
+        writer.WriteFrom(column.name, buffer.data(), 0);
+        while (input.read(buffer.data(), buffer.size()) || input.gcount() > 0)
+        {
+            writer.ContinueFrom(column.name, buffer.data(), input.gcount());
+        }
+    }
+}
+
+} // namespace map_matching
+} // namespace engine
+} // namespace osrm
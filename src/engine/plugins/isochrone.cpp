@@ -0,0 +1,218 @@
+#include "engine/plugins/isochrone.hpp"
+#include "engine/api/isochrone_api.hpp"
+#include "engine/api/isochrone_parameters.hpp"
+#include "engine/isochrone_grid.hpp"
+#include "engine/phantom_node.hpp"
+
+#include "util/coordinate_calculation.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace plugins
+{
+
+namespace
+{
+// The grid has at most this many cells along its longer side, which bounds the work spent on
+// the polygons independently of the size of the area
+const constexpr double MAX_GRID_SIZE = 256;
+// Smallest cell size in meters, finer grids don't add detail to the road geometries
+const constexpr double MIN_CELL_SIZE = 25;
+
+struct ReachedSegment
+{
+    util::Coordinate from;
+    util::Coordinate to;
+    EdgeDuration from_duration;
+    EdgeDuration to_duration;
+};
+
+struct ReachedArea
+{
+    std::vector<util::Coordinate> coordinates;
+    EdgeDuration duration;
+};
+
+template <typename GeometryRange, typename DurationRange>
+void addSegments(const datafacade::BaseDataFacade &facade,
+                 const GeometryRange &geometry,
+                 const DurationRange &durations,
+                 EdgeDuration duration,
+                 const EdgeDuration max_duration,
+                 std::vector<ReachedSegment> &segments)
+{
+    BOOST_ASSERT(std::distance(geometry.begin(), geometry.end()) ==
+                 std::distance(durations.begin(), durations.end()) + 1);
+
+    auto from = geometry.begin();
+    auto to = std::next(from);
+    for (const auto segment_duration : durations)
+    {
+        if (duration > max_duration)
+            break;
+
+        segments.push_back({facade.GetCoordinateOfNode(*from),
+                            facade.GetCoordinateOfNode(*to),
+                            duration,
+                            duration + static_cast<EdgeDuration>(segment_duration)});
+        duration += segment_duration;
+        ++from;
+        ++to;
+    }
+}
+} // namespace
+
+IsochronePlugin::IsochronePlugin(const double max_duration_) : max_duration(max_duration_) {}
+
+Status IsochronePlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
+                                      const api::IsochroneParameters &params,
+                                      osrm::engine::api::ResultT &result) const
+{
+    if (!algorithms.HasIsochroneSearch())
+    {
+        return Error("NotImplemented",
+                     "Isochrone search is not implemented for the chosen search algorithm.",
+                     result);
+    }
+
+    BOOST_ASSERT(params.IsValid());
+
+    if (!result.is<util::json::Object>())
+    {
+        return Error("NotImplemented", "The isochrone service only supports JSON output.", result);
+    }
+
+    const auto max_contour = *std::max_element(params.contours.begin(), params.contours.end());
+    if (max_duration > 0 && max_contour > max_duration)
+    {
+        return Error("TooBig",
+                     "Contour " + std::to_string(max_contour) +
+                         " is higher than current maximum (" + std::to_string(max_duration) + ")",
+                     result);
+    }
+
+    if (!CheckAllCoordinates(params.coordinates))
+        return Error("InvalidOptions", "Coordinates are invalid", result);
+
+    if (params.coordinates.size() != 1)
+    {
+        return Error("InvalidOptions", "Only one input coordinate is supported", result);
+    }
+
+    if (!CheckAlgorithms(params, algorithms, result))
+        return Status::Error;
+
+    const auto &facade = algorithms.GetFacade();
+    auto phantom_nodes = GetPhantomNodes(facade, params);
+
+    if (phantom_nodes.size() != params.coordinates.size())
+    {
+        return Error(
+            "NoSegment", MissingPhantomErrorMessage(phantom_nodes, params.coordinates), result);
+    }
+
+    const auto source_phantom = SnapPhantomNodes(phantom_nodes).front();
+
+    // contours in deciseconds, the search needs them sorted
+    std::vector<EdgeDuration> contours;
+    for (const auto contour : params.contours)
+        contours.push_back(static_cast<EdgeDuration>(std::round(contour * 10.)));
+    std::vector<EdgeDuration> sorted_contours = contours;
+    std::sort(sorted_contours.begin(), sorted_contours.end());
+    sorted_contours.erase(std::unique(sorted_contours.begin(), sorted_contours.end()),
+                          sorted_contours.end());
+    const auto max_contour_duration = sorted_contours.back();
+
+    const auto search_space = algorithms.IsochroneSearch(source_phantom, sorted_contours);
+
+    std::vector<ReachedSegment> segments;
+    for (const auto &reached : search_space.nodes)
+    {
+        const auto geometry_index = facade.GetGeometryIndex(reached.node);
+        if (geometry_index.forward)
+        {
+            addSegments(facade,
+                        facade.GetUncompressedForwardGeometry(geometry_index.id),
+                        facade.GetUncompressedForwardDurations(geometry_index.id),
+                        reached.duration,
+                        max_contour_duration,
+                        segments);
+        }
+        else
+        {
+            addSegments(facade,
+                        facade.GetUncompressedReverseGeometry(geometry_index.id),
+                        facade.GetUncompressedReverseDurations(geometry_index.id),
+                        reached.duration,
+                        max_contour_duration,
+                        segments);
+        }
+    }
+
+    std::vector<ReachedArea> areas;
+    for (const auto &reached : search_space.cells)
+    {
+        ReachedArea area{{}, reached.duration};
+        for (const auto node : reached.border_nodes)
+        {
+            // both directions of a segment share the geometry, only the order differs
+            const auto geometry_index = facade.GetGeometryIndex(node);
+            const auto geometry = facade.GetUncompressedForwardGeometry(geometry_index.id);
+            area.coordinates.push_back(facade.GetCoordinateOfNode(geometry.front()));
+            area.coordinates.push_back(facade.GetCoordinateOfNode(geometry.back()));
+        }
+        areas.push_back(std::move(area));
+    }
+
+    util::Coordinate south_west = source_phantom.location;
+    util::Coordinate north_east = source_phantom.location;
+    const auto extend = [&](const util::Coordinate coordinate) {
+        south_west.lon = std::min(south_west.lon, coordinate.lon);
+        south_west.lat = std::min(south_west.lat, coordinate.lat);
+        north_east.lon = std::max(north_east.lon, coordinate.lon);
+        north_east.lat = std::max(north_east.lat, coordinate.lat);
+    };
+    for (const auto &segment : segments)
+    {
+        extend(segment.from);
+        extend(segment.to);
+    }
+    for (const auto &area : areas)
+        std::for_each(area.coordinates.begin(), area.coordinates.end(), extend);
+
+    const auto width = util::coordinate_calculation::haversineDistance(
+        south_west, util::Coordinate{north_east.lon, south_west.lat});
+    const auto height = util::coordinate_calculation::haversineDistance(
+        south_west, util::Coordinate{south_west.lon, north_east.lat});
+    const auto cell_size = std::max(std::max(width, height) / MAX_GRID_SIZE, MIN_CELL_SIZE);
+
+    IsochroneGrid grid(south_west, north_east, cell_size);
+    for (const auto &segment : segments)
+        grid.AddSegment(segment.from, segment.to, segment.from_duration, segment.to_duration);
+    for (const auto &area : areas)
+        grid.AddConvexHull(area.coordinates, area.duration);
+
+    std::vector<std::vector<api::IsochroneAPI::Ring>> contour_rings;
+    contour_rings.reserve(contours.size());
+    for (const auto contour : contours)
+        contour_rings.push_back(grid.GetContour(contour));
+
+    api::IsochroneAPI isochrone_api(facade, params);
+    isochrone_api.MakeResponse(source_phantom, contour_rings, result.get<util::json::Object>());
+
+    return Status::Ok;
+}
+
+} // namespace plugins
+} // namespace engine
+} // namespace osrm
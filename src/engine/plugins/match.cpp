@@ -110,6 +110,39 @@ void filterCandidates(const std::vector<util::Coordinate> &coordinates,
     }
 }
 
+// assuming radius is the standard deviation of a normal distribution
+// that models GPS noise (in this model), x3 should give us the correct
+// search radius with > 99% confidence
+std::vector<double> getSearchRadiuses(const api::MatchParameters &parameters)
+{
+    std::vector<double> search_radiuses;
+    if (parameters.radiuses.empty())
+    {
+        search_radiuses.resize(parameters.coordinates.size(),
+                               routing_algorithms::DEFAULT_GPS_PRECISION *
+                                   MatchPlugin::RADIUS_MULTIPLIER);
+    }
+    else
+    {
+        search_radiuses.resize(parameters.coordinates.size());
+        std::transform(parameters.radiuses.begin(),
+                       parameters.radiuses.end(),
+                       search_radiuses.begin(),
+                       [](const boost::optional<double> &maybe_radius) {
+                           if (maybe_radius)
+                           {
+                               return *maybe_radius * MatchPlugin::RADIUS_MULTIPLIER;
+                           }
+                           else
+                           {
+                               return routing_algorithms::DEFAULT_GPS_PRECISION *
+                                      MatchPlugin::RADIUS_MULTIPLIER;
+                           }
+                       });
+    }
+    return search_radiuses;
+}
+
 Status MatchPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
                                   const api::MatchParameters &parameters,
                                   osrm::engine::api::ResultT &result) const
@@ -161,6 +194,11 @@ Status MatchPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
         return Error("InvalidValue", "Timestamps need to be monotonically increasing.", result);
     }
 
+    if (!parameters.session.empty())
+    {
+        return HandleSessionRequest(algorithms, parameters, result);
+    }
+
     SubMatchingList sub_matchings;
     api::tidy::Result tidied;
     if (parameters.tidy)
@@ -183,33 +221,7 @@ Status MatchPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
             "InvalidValue", "First and last coordinates must be specified as waypoints.", result);
     }
 
-    // assuming radius is the standard deviation of a normal distribution
-    // that models GPS noise (in this model), x3 should give us the correct
-    // search radius with > 99% confidence
-    std::vector<double> search_radiuses;
-    if (tidied.parameters.radiuses.empty())
-    {
-        search_radiuses.resize(tidied.parameters.coordinates.size(),
-                               routing_algorithms::DEFAULT_GPS_PRECISION * RADIUS_MULTIPLIER);
-    }
-    else
-    {
-        search_radiuses.resize(tidied.parameters.coordinates.size());
-        std::transform(tidied.parameters.radiuses.begin(),
-                       tidied.parameters.radiuses.end(),
-                       search_radiuses.begin(),
-                       [](const boost::optional<double> &maybe_radius) {
-                           if (maybe_radius)
-                           {
-                               return *maybe_radius * RADIUS_MULTIPLIER;
-                           }
-                           else
-                           {
-                               return routing_algorithms::DEFAULT_GPS_PRECISION * RADIUS_MULTIPLIER;
-                           }
-                       });
-    }
-
+    const auto search_radiuses = getSearchRadiuses(tidied.parameters);
     auto candidates_lists =
         GetPhantomNodesInRange(facade, tidied.parameters, search_radiuses, true);
 
@@ -313,6 +325,101 @@ Status MatchPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
 
     return Status::Ok;
 }
+Status MatchPlugin::HandleSessionRequest(const RoutingAlgorithmsInterface &algorithms,
+                                         const api::MatchParameters &parameters,
+                                         osrm::engine::api::ResultT &result) const
+{
+    if (sessions.GetCapacity() == 0)
+    {
+        return Error("NotImplemented", "Matching sessions are disabled.", result);
+    }
+
+    if (parameters.tidy || !parameters.waypoints.empty())
+    {
+        return Error("InvalidValue",
+                     "The tidy and waypoints parameters are not supported with sessions.",
+                     result);
+    }
+
+    const auto &facade = algorithms.GetFacade();
+
+    auto session = sessions.Find(parameters.session);
+    // the candidates of the session were snapped on another dataset
+    if (session.checksum != facade.GetCheckSum())
+    {
+        session.Clear();
+        session.checksum = facade.GetCheckSum();
+    }
+
+    if (!parameters.timestamps.empty() && session.timestamp &&
+        parameters.timestamps.front() < *session.timestamp)
+    {
+        return Error("InvalidValue", "Timestamps need to be monotonically increasing.", result);
+    }
+
+    auto candidates_lists =
+        GetPhantomNodesInRange(facade, parameters, getSearchRadiuses(parameters), true);
+    filterCandidates(parameters.coordinates, candidates_lists);
+
+    // The previous point of the session is the start of the first matching and is reported as
+    // the first tracepoint
+    auto response_parameters = parameters;
+    if (!session.Empty())
+    {
+        const auto prepend = [](auto &values, auto value) {
+            if (!values.empty())
+                values.insert(values.begin(), value);
+        };
+        prepend(response_parameters.coordinates, session.coordinate);
+        if (!parameters.timestamps.empty())
+            prepend(response_parameters.timestamps,
+                    session.timestamp.value_or(parameters.timestamps.front()));
+        prepend(response_parameters.hints, boost::none);
+        prepend(response_parameters.bearings, boost::none);
+        prepend(response_parameters.radiuses, boost::none);
+        prepend(response_parameters.approaches, boost::none);
+    }
+
+    const auto sub_matchings =
+        algorithms.MapMatchingSession(session,
+                                      candidates_lists,
+                                      parameters.coordinates,
+                                      parameters.timestamps,
+                                      parameters.radiuses,
+                                      parameters.gaps == api::MatchParameters::GapsType::Split);
+    sessions.Store(parameters.session, std::move(session));
+
+    if (sub_matchings.empty())
+    {
+        return Error("NoMatch", "Could not match the trace.", result);
+    }
+
+    std::vector<InternalRouteResult> sub_routes(sub_matchings.size());
+    for (auto index : util::irange<std::size_t>(0UL, sub_matchings.size()))
+    {
+        const auto &nodes = sub_matchings[index].nodes;
+        BOOST_ASSERT(!nodes.empty());
+
+        // the first point of a session is matched on its own
+        std::vector<PhantomNodes> segment_end_coordinates;
+        if (nodes.size() == 1)
+        {
+            segment_end_coordinates.push_back({nodes.front(), nodes.front()});
+        }
+        for (unsigned i = 0; i + 1 < nodes.size(); ++i)
+        {
+            segment_end_coordinates.push_back({nodes[i], nodes[i + 1]});
+        }
+        sub_routes[index] = algorithms.ShortestPathSearch(segment_end_coordinates, {false});
+        BOOST_ASSERT(sub_routes[index].shortest_path_weight != INVALID_EDGE_WEIGHT);
+    }
+
+    const auto tidied = api::tidy::keep_all(response_parameters);
+    api::MatchAPI match_api{facade, response_parameters, tidied};
+    match_api.MakeResponse(sub_matchings, sub_routes, result);
+
+    return Status::Ok;
+}
 } // namespace plugins
 } // namespace engine
 } // namespace osrm
@@ -0,0 +1,190 @@
+#include "engine/plugins/poi.hpp"
+#include "engine/api/poi_api.hpp"
+#include "engine/api/poi_parameters.hpp"
+#include "engine/phantom_node.hpp"
+
+#include "util/log.hpp"
+#include "util/timing_util.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include <boost/assert.hpp>
+#include <boost/numeric/conversion/cast.hpp>
+
+namespace osrm
+{
+namespace engine
+{
+namespace plugins
+{
+
+POIPlugin::POIPlugin(std::unordered_map<std::string, std::vector<util::Coordinate>> poi_sets_,
+                     const int max_results_)
+    : poi_sets{std::move(poi_sets_)}, max_results{max_results_}
+{
+}
+
+Status POIPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
+                                const api::POIParameters &params,
+                                osrm::engine::api::ResultT &result) const
+{
+    if (!algorithms.HasManyToManySearch())
+    {
+        return Error("NotImplemented",
+                     "POI search is not implemented for the chosen search algorithm.",
+                     result);
+    }
+
+    BOOST_ASSERT(params.IsValid());
+
+    if (!result.is<util::json::Object>())
+    {
+        return Error("NotImplemented", "The POI service only supports JSON output.", result);
+    }
+
+    if (max_results > 0 &&
+        (boost::numeric_cast<std::int64_t>(params.number_of_results) > max_results))
+    {
+        return Error("TooBig",
+                     "Number of results " + std::to_string(params.number_of_results) +
+                         " is higher than current maximum (" + std::to_string(max_results) + ")",
+                     result);
+    }
+
+    if (!CheckAllCoordinates(params.coordinates))
+        return Error("InvalidOptions", "Coordinates are invalid", result);
+
+    if (params.coordinates.size() != 1)
+    {
+        return Error("InvalidOptions", "Only one input coordinate is supported", result);
+    }
+
+    const auto poi_set = poi_sets.find(params.set);
+    if (poi_set == poi_sets.end())
+    {
+        return Error("InvalidValue", "POI set " + params.set + " is not registered", result);
+    }
+
+    if (!CheckAlgorithms(params, algorithms, result))
+        return Status::Error;
+
+    const auto &facade = algorithms.GetFacade();
+    auto phantom_nodes = GetPhantomNodes(facade, params);
+
+    if (phantom_nodes.size() != params.coordinates.size())
+    {
+        return Error(
+            "NoSegment", MissingPhantomErrorMessage(phantom_nodes, params.coordinates), result);
+    }
+
+    const auto snapped_phantoms = SnapPhantomNodes(phantom_nodes);
+
+    const auto indexed_set = GetIndexedPOISet(algorithms, poi_set->first, poi_set->second);
+    const auto nearest_pois = algorithms.NearestPOISearch(
+        snapped_phantoms.front(), indexed_set->index, params.number_of_results);
+
+    api::POIAPI poi_api(facade, params);
+    poi_api.MakeResponse(snapped_phantoms.front(),
+                         indexed_set->phantom_nodes,
+                         nearest_pois,
+                         result.get<util::json::Object>());
+
+    return Status::Ok;
+}
+
+std::shared_ptr<const POIPlugin::IndexedPOISet>
+POIPlugin::GetIndexedPOISet(const RoutingAlgorithmsInterface &algorithms,
+                            const std::string &name,
+                            const std::vector<util::Coordinate> &coordinates) const
+{
+    // Every exclude flag combination has its own facade. Holding it keeps its address from
+    // being reused by a reloaded facade while the cache is searched.
+    const auto facade = algorithms.GetSharedFacade();
+    const auto is_requested_set = [&](const CachedPOISet &cached) {
+        return cached.name == name && cached.facade.lock() == facade;
+    };
+
+    std::shared_future<std::shared_ptr<const IndexedPOISet>> cached_set;
+    std::promise<std::shared_ptr<const IndexedPOISet>> promise;
+    {
+        std::lock_guard<std::mutex> lock(indexed_sets_mutex);
+
+        // sets of facades that were replaced by reloaded data are dropped
+        indexed_sets.erase(
+            std::remove_if(indexed_sets.begin(),
+                           indexed_sets.end(),
+                           [](const CachedPOISet &cached) { return cached.facade.expired(); }),
+            indexed_sets.end());
+
+        const auto cached =
+            std::find_if(indexed_sets.begin(), indexed_sets.end(), is_requested_set);
+        if (cached != indexed_sets.end())
+            cached_set = cached->indexed_set;
+        else
+            indexed_sets.push_back({facade, name, promise.get_future().share()});
+    }
+
+    if (cached_set.valid())
+        return cached_set.get();
+
+    try
+    {
+        auto indexed_set = IndexPOISet(algorithms, name, coordinates);
+        promise.set_value(indexed_set);
+        return indexed_set;
+    }
+    catch (...)
+    {
+        // the waiting queries fail as well, the next one indexes the set again
+        {
+            std::lock_guard<std::mutex> lock(indexed_sets_mutex);
+            indexed_sets.erase(
+                std::remove_if(indexed_sets.begin(), indexed_sets.end(), is_requested_set),
+                indexed_sets.end());
+        }
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+}
+
+std::shared_ptr<const POIPlugin::IndexedPOISet>
+POIPlugin::IndexPOISet(const RoutingAlgorithmsInterface &algorithms,
+                       const std::string &name,
+                       const std::vector<util::Coordinate> &coordinates) const
+{
+    const auto &facade = algorithms.GetFacade();
+
+    TIMER_START(index_poi_set);
+    auto indexed_set = std::make_shared<IndexedPOISet>();
+
+    // POIs are snapped like the coordinates of a query, unsnappable ones are never found
+    indexed_set->phantom_nodes.reserve(coordinates.size());
+    for (const auto &coordinate : coordinates)
+    {
+        const auto phantom_node_pair = facade.NearestPhantomNodeWithAlternativeFromBigComponent(
+            coordinate, Approach::UNRESTRICTED, false);
+        if (phantom_node_pair.first.component.is_tiny && phantom_node_pair.second.IsValid() &&
+            !phantom_node_pair.second.component.is_tiny)
+            indexed_set->phantom_nodes.push_back(phantom_node_pair.second);
+        else
+            indexed_set->phantom_nodes.push_back(phantom_node_pair.first);
+    }
+
+    indexed_set->index = algorithms.BuildPOIIndex(indexed_set->phantom_nodes);
+    TIMER_STOP(index_poi_set);
+
+    util::Log() << "Indexed " << coordinates.size() << " POIs of set " << name << " with "
+                << indexed_set->index.buckets.GetNumberOfEntries() << " bucket entries in "
+                << TIMER_MSEC(index_poi_set) << "ms";
+
+    return indexed_set;
+}
+
+} // namespace plugins
+} // namespace engine
+} // namespace osrm
@@ -8,6 +8,7 @@
 #include "util/json_container.hpp"
 #include "util/string_util.hpp"
 
+#include <cmath>
 #include <cstdlib>
 
 #include <algorithm>
@@ -84,8 +85,22 @@ Status TablePlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
     bool request_distance = params.annotations & api::TableParameters::AnnotationsType::Distance;
     bool request_duration = params.annotations & api::TableParameters::AnnotationsType::Duration;
 
-    auto result_tables_pair = algorithms.ManyToManySearch(
-        snapped_phantoms, params.sources, params.destinations, request_distance);
+    // durations are in deciseconds
+    const auto max_duration =
+        params.max_duration
+            ? static_cast<EdgeDuration>(std::round(
+                  std::min<double>(*params.max_duration * 10, MAXIMAL_EDGE_DURATION - 1)))
+            : MAXIMAL_EDGE_DURATION;
+    const auto max_distance = params.max_distance
+                                  ? static_cast<EdgeDistance>(*params.max_distance)
+                                  : MAXIMAL_EDGE_DISTANCE;
+
+    auto result_tables_pair = algorithms.ManyToManySearch(snapped_phantoms,
+                                                          params.sources,
+                                                          params.destinations,
+                                                          request_distance || params.max_distance,
+                                                          max_duration,
+                                                          max_distance);
 
     if ((request_duration && result_tables_pair.first.empty()) ||
         (request_distance && result_tables_pair.second.empty()))
@@ -93,6 +108,25 @@ Status TablePlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
         return Error("NoTable", "No table found", result);
     }
 
+    // The searches stop expanding at the bounds but can still find entries beyond them
+    if (params.max_duration || params.max_distance)
+    {
+        auto &durations = result_tables_pair.first;
+        auto &distances = result_tables_pair.second;
+        for (std::size_t index = 0; index < durations.size(); ++index)
+        {
+            if (durations[index] > max_duration ||
+                (!distances.empty() && distances[index] > max_distance))
+            {
+                durations[index] = MAXIMAL_EDGE_DURATION;
+                if (!distances.empty())
+                {
+                    distances[index] = INVALID_EDGE_DISTANCE;
+                }
+            }
+        }
+    }
+
     std::vector<api::TableAPI::TableCellRef> estimated_pairs;
 
     // Scan table for null results - if any exist, replace with distance estimates
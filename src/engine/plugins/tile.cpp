@@ -4,6 +4,7 @@
 #include "engine/plugins/tile.hpp"
 
 #include "util/coordinate_calculation.hpp"
+#include "util/log.hpp"
 #include "util/string_view.hpp"
 #include "util/vector_tile.hpp"
 #include "util/web_mercator.hpp"
@@ -662,6 +663,16 @@ void encodeVectorTile(const DataFacadeBase &facade,
 }
 } // namespace
 
+TilePlugin::TilePlugin(const boost::filesystem::path &baked_tiles_path)
+{
+    if (!baked_tiles_path.empty())
+    {
+        baked_tiles = std::make_unique<const TileStore>(baked_tiles_path);
+        util::Log() << "Loaded " << baked_tiles->GetNumberOfTiles() << " baked tiles from "
+                    << baked_tiles_path;
+    }
+}
+
 Status TilePlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
                                  const api::TileParameters &parameters,
                                  osrm::engine::api::ResultT &result) const
@@ -670,6 +681,19 @@ Status TilePlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
 
     auto &pbf_buffer = result.get<std::string>();
     const auto &facade = algorithms.GetFacade();
+
+    // baked tiles of another dataset or metric are ignored, e.g. after osrm-datastore loaded a
+    // new one or osrm-customize and osrm-contract applied new speeds
+    if (baked_tiles && baked_tiles->GetConnectivityChecksum() == facade.GetCheckSum() &&
+        baked_tiles->GetMetricChecksum() == facade.GetMetricCheckSum())
+    {
+        if (const auto tile = baked_tiles->Find(parameters.x, parameters.y, parameters.z))
+        {
+            pbf_buffer.assign(tile->data(), tile->size());
+            return Status::Ok;
+        }
+    }
+
     auto edges = getEdges(facade, parameters.x, parameters.y, parameters.z);
     auto segregated_nodes = getSegregatedNodes(facade, edges);
 
@@ -4,6 +4,7 @@
 #include "engine/api/trip_parameters.hpp"
 #include "engine/trip/trip_brute_force.hpp"
 #include "engine/trip/trip_farthest_insertion.hpp"
+#include "engine/trip/trip_local_search.hpp"
 #include "engine/trip/trip_nearest_neighbour.hpp"
 #include "util/dist_table_wrapper.hpp" // to access the dist table more easily
 #include "util/json_container.hpp"
@@ -11,6 +12,7 @@
 #include <boost/assert.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <iterator>
 #include <limits>
@@ -217,7 +219,14 @@ Status TripPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
 
     // compute the duration table of all phantom nodes
     auto result_duration_table = util::DistTableWrapper<EdgeWeight>(
-        algorithms.ManyToManySearch(snapped_phantoms, {}, {}, /*requestDistance*/ false).first,
+        algorithms
+            .ManyToManySearch(snapped_phantoms,
+                              {},
+                              {},
+                              /*requestDistance*/ false,
+                              MAXIMAL_EDGE_DURATION,
+                              MAXIMAL_EDGE_DISTANCE)
+            .first,
         number_of_locations);
 
     if (result_duration_table.size() == 0)
@@ -248,7 +257,15 @@ Status TripPlugin::HandleRequest(const RoutingAlgorithmsInterface &algorithms,
     }
     else
     {
-        duration_trip = trip::FarthestInsertionTrip(number_of_locations, result_duration_table);
+        auto deadline = trip::TripDeadline::max();
+        if (max_trip_optimization_time >= 0)
+        {
+            deadline = std::chrono::steady_clock::now() +
+                       std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                           std::chrono::duration<double>(max_trip_optimization_time));
+        }
+        duration_trip =
+            trip::LocalSearchTrip(number_of_locations, result_duration_table, deadline);
     }
 
     // rotate result such that roundtrip starts at node with index 0
@@ -714,6 +714,7 @@ makeCandidateVias(SearchEngineData<Algorithm> &search_engine_data,
                                            overlap_weight,
                                            DO_NOT_FORCE_LOOPS,
                                            DO_NOT_FORCE_LOOPS,
+                                           ZeroPotential{},
                                            phantom_node_pair);
 
             if (!forward_heap.Empty())
@@ -740,6 +741,7 @@ makeCandidateVias(SearchEngineData<Algorithm> &search_engine_data,
                                            overlap_weight,
                                            DO_NOT_FORCE_LOOPS,
                                            DO_NOT_FORCE_LOOPS,
+                                           ZeroPotential{},
                                            phantom_node_pair);
 
             if (!reverse_heap.Empty())
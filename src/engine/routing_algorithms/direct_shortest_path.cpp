@@ -79,14 +79,15 @@ InternalRouteResult directShortestPathSearch(SearchEngineData<mld::Algorithm> &e
     EdgeWeight weight = INVALID_EDGE_WEIGHT;
     std::vector<NodeID> unpacked_nodes;
     std::vector<EdgeID> unpacked_edges;
-    std::tie(weight, unpacked_nodes, unpacked_edges) = mld::search(engine_working_data,
-                                                                   facade,
-                                                                   forward_heap,
-                                                                   reverse_heap,
-                                                                   DO_NOT_FORCE_LOOPS,
-                                                                   DO_NOT_FORCE_LOOPS,
-                                                                   INVALID_EDGE_WEIGHT,
-                                                                   phantom_nodes);
+    std::tie(weight, unpacked_nodes, unpacked_edges) =
+        mld::pointToPointSearch(engine_working_data,
+                                facade,
+                                forward_heap,
+                                reverse_heap,
+                                DO_NOT_FORCE_LOOPS,
+                                DO_NOT_FORCE_LOOPS,
+                                INVALID_EDGE_WEIGHT,
+                                phantom_nodes);
 
     return extractRoute(facade, weight, phantom_nodes, unpacked_nodes, unpacked_edges);
 }
@@ -0,0 +1,287 @@
+#include "engine/routing_algorithms/isochrone.hpp"
+#include "engine/routing_algorithms/routing_base.hpp"
+#include "engine/routing_algorithms/routing_base_mld.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <tuple>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace routing_algorithms
+{
+
+namespace mld
+{
+namespace
+{
+using QueryHeap = SearchEngineData<Algorithm>::ManyToManyQueryHeap;
+
+struct SettledBorderNode
+{
+    NodeID node;
+    EdgeWeight weight;
+    EdgeDuration duration;
+    EdgeDistance distance;
+};
+
+// Border nodes settled on a level above the base graph, keyed by the level and cell they were
+// settled in. The cells were crossed using shortcuts only.
+using CrossedCells = std::map<std::pair<LevelID, CellID>, std::vector<SettledBorderNode>>;
+using CrossedCell = std::pair<std::pair<LevelID, CellID>, std::vector<SettledBorderNode>>;
+
+// Cells with fewer border nodes are always descended into, the convex hull of their border
+// nodes is a bad approximation of the area they cover.
+const constexpr std::size_t MIN_ACCEPTED_CELL_BORDER_NODES = 3;
+
+inline void relaxNode(QueryHeap &query_heap,
+                      const NodeID parent,
+                      const NodeID to,
+                      const EdgeWeight to_weight,
+                      const EdgeDuration to_duration,
+                      const EdgeDistance to_distance,
+                      const bool from_clique_arc)
+{
+    const auto toHeapNode = query_heap.GetHeapNodeIfWasInserted(to);
+    if (!toHeapNode)
+    {
+        query_heap.Insert(to, to_weight, {parent, from_clique_arc, to_duration, to_distance});
+    }
+    else if (std::tie(to_weight, to_duration) <
+             std::tie(toHeapNode->weight, toHeapNode->data.duration))
+    {
+        toHeapNode->data = {parent, from_clique_arc, to_duration, to_distance};
+        toHeapNode->weight = to_weight;
+        query_heap.DecreaseKey(*toHeapNode);
+    }
+}
+
+// Settles all nodes in the heap up to max_duration. Nodes on the base graph are added to the
+// search space, nodes settled on a higher level are collected per crossed cell.
+template <typename QueryLevel, typename Scope>
+void isochroneRoutingSteps(const DataFacade<Algorithm> &facade,
+                           QueryHeap &query_heap,
+                           const EdgeDuration max_duration,
+                           const QueryLevel &query_level,
+                           const Scope &in_scope,
+                           IsochroneSearchSpace &search_space,
+                           CrossedCells &crossed_cells)
+{
+    const auto &partition = facade.GetMultiLevelPartition();
+    const auto &cells = facade.GetCellStorage();
+    const auto &metric = facade.GetCellMetric();
+
+    while (!query_heap.Empty())
+    {
+        const auto heapNode = query_heap.DeleteMinGetHeapNode();
+        if (heapNode.data.duration > max_duration)
+            continue;
+
+        const auto level = query_level(heapNode.node);
+        if (level == 0)
+        {
+            search_space.nodes.push_back({heapNode.node, heapNode.data.duration});
+        }
+        else
+        {
+            crossed_cells[{level, partition.GetCell(level, heapNode.node)}].push_back(
+                {heapNode.node, heapNode.weight, heapNode.data.duration, heapNode.data.distance});
+        }
+
+        if (level >= 1 && !heapNode.data.from_clique_arc)
+        {
+            const auto &cell =
+                cells.GetCell(metric, level, partition.GetCell(level, heapNode.node));
+            auto destination = cell.GetDestinationNodes().begin();
+            auto shortcut_durations = cell.GetOutDuration(heapNode.node);
+            auto shortcut_distances = cell.GetOutDistance(heapNode.node);
+            for (auto shortcut_weight : cell.GetOutWeight(heapNode.node))
+            {
+                BOOST_ASSERT(!shortcut_durations.empty());
+                BOOST_ASSERT(!shortcut_distances.empty());
+                const NodeID to = *destination;
+                if (shortcut_weight != INVALID_EDGE_WEIGHT && heapNode.node != to)
+                {
+                    relaxNode(query_heap,
+                              heapNode.node,
+                              to,
+                              heapNode.weight + shortcut_weight,
+                              heapNode.data.duration + shortcut_durations.front(),
+                              heapNode.data.distance + shortcut_distances.front(),
+                              true);
+                }
+                ++destination;
+                shortcut_durations.advance_begin(1);
+                shortcut_distances.advance_begin(1);
+            }
+        }
+
+        for (const auto edge : facade.GetBorderEdgeRange(level, heapNode.node))
+        {
+            if (!facade.IsForwardEdge(edge))
+                continue;
+
+            const NodeID to = facade.GetTarget(edge);
+            if (facade.ExcludeNode(to) || !in_scope(to))
+                continue;
+
+            const auto turn_id = facade.GetEdgeData(edge).turn_id;
+            const auto turn_weight =
+                facade.GetNodeWeight(heapNode.node) + facade.GetWeightPenaltyForEdgeID(turn_id);
+            const auto turn_duration = facade.GetNodeDuration(heapNode.node) +
+                                       facade.GetDurationPenaltyForEdgeID(turn_id);
+
+            relaxNode(query_heap,
+                      heapNode.node,
+                      to,
+                      heapNode.weight + turn_weight,
+                      heapNode.data.duration + turn_duration,
+                      heapNode.data.distance + facade.GetNodeDistance(heapNode.node),
+                      false);
+        }
+    }
+}
+
+// A crossed cell is accepted as a whole if all of its border nodes were settled and every node
+// on a shortest path through the cell between two of them is known to lie in the same contour
+// band. The cell does not contain the source, so such a node is reached no earlier than the
+// first border node, and no later than the last border node plus the longest duration between
+// two border nodes in the cell metric. Dead ends of the cell off these paths are not bounded.
+template <typename CellType>
+bool acceptCell(const CellType &cell,
+                const std::vector<SettledBorderNode> &settled,
+                const std::vector<EdgeDuration> &contours)
+{
+    std::unordered_set<NodeID> border_nodes;
+    for (const auto node : cell.GetSourceNodes())
+        border_nodes.insert(node);
+    for (const auto node : cell.GetDestinationNodes())
+        border_nodes.insert(node);
+
+    if (border_nodes.size() < MIN_ACCEPTED_CELL_BORDER_NODES ||
+        settled.size() != border_nodes.size())
+        return false;
+
+    const auto band = [&contours](const EdgeDuration duration) {
+        return std::lower_bound(contours.begin(), contours.end(), duration) - contours.begin();
+    };
+
+    const auto minmax = std::minmax_element(
+        settled.begin(), settled.end(), [](const auto &lhs, const auto &rhs) {
+            return lhs.duration < rhs.duration;
+        });
+    const auto first_band = band(minmax.first->duration);
+    if (first_band != band(minmax.second->duration))
+        return false;
+
+    EdgeDuration max_shortcut_duration = 0;
+    for (const auto source : cell.GetSourceNodes())
+    {
+        auto shortcut_durations = cell.GetOutDuration(source);
+        for (const auto shortcut_weight : cell.GetOutWeight(source))
+        {
+            BOOST_ASSERT(!shortcut_durations.empty());
+            if (shortcut_weight != INVALID_EDGE_WEIGHT)
+                max_shortcut_duration = std::max(max_shortcut_duration, shortcut_durations.front());
+            shortcut_durations.advance_begin(1);
+        }
+    }
+
+    return first_band == band(minmax.second->duration + max_shortcut_duration);
+}
+} // namespace
+} // namespace mld
+
+// The search first runs on the overlay graph as seen from the source: cells that do not contain
+// the source are crossed on shortcuts. Every crossed cell is then either accepted as a whole or
+// searched again one level below, restricted to the cell and seeded with its settled border
+// nodes, until all reached nodes are either on the base graph or inside an accepted cell.
+template <>
+IsochroneSearchSpace isochroneSearch(SearchEngineData<mld::Algorithm> &engine_working_data,
+                                     const DataFacade<mld::Algorithm> &facade,
+                                     const PhantomNode &source_phantom,
+                                     const std::vector<EdgeDuration> &contours)
+{
+    BOOST_ASSERT(!contours.empty());
+    BOOST_ASSERT(std::is_sorted(contours.begin(), contours.end()));
+
+    const auto &partition = facade.GetMultiLevelPartition();
+    const auto &cells = facade.GetCellStorage();
+    const auto &metric = facade.GetCellMetric();
+    const auto max_duration = contours.back();
+
+    engine_working_data.InitializeOrClearManyToManyThreadLocalStorage(
+        facade.GetNumberOfNodes(), facade.GetMaxBorderNodeID() + 1);
+    auto &query_heap = *(engine_working_data.many_to_many_heap);
+
+    IsochroneSearchSpace search_space;
+    mld::CrossedCells crossed_cells;
+
+    insertSourceInHeap(query_heap, source_phantom);
+    mld::isochroneRoutingSteps(
+        facade,
+        query_heap,
+        max_duration,
+        [&](const NodeID node) { return mld::getNodeQueryLevel(partition, node, source_phantom); },
+        [](const NodeID) { return true; },
+        search_space,
+        crossed_cells);
+
+    std::vector<mld::CrossedCell> pending(crossed_cells.begin(), crossed_cells.end());
+    while (!pending.empty())
+    {
+        const auto level = pending.back().first.first;
+        const auto cell_id = pending.back().first.second;
+        const auto settled = std::move(pending.back().second);
+        pending.pop_back();
+
+        const auto cell = cells.GetCell(metric, level, cell_id);
+        if (mld::acceptCell(cell, settled, contours))
+        {
+            IsochroneCell accepted{level, cell_id, 0, {}};
+            for (const auto &border_node : settled)
+            {
+                accepted.duration = std::max(accepted.duration, border_node.duration);
+                accepted.border_nodes.push_back(border_node.node);
+            }
+            search_space.cells.push_back(std::move(accepted));
+            continue;
+        }
+
+        query_heap.Clear();
+        for (const auto &border_node : settled)
+        {
+            query_heap.Insert(
+                border_node.node,
+                border_node.weight,
+                {border_node.node, false, border_node.duration, border_node.distance});
+        }
+
+        mld::CrossedCells crossed_subcells;
+        const LevelID sublevel = level - 1;
+        mld::isochroneRoutingSteps(
+            facade,
+            query_heap,
+            max_duration,
+            [sublevel](const NodeID) { return sublevel; },
+            [&](const NodeID node) { return partition.GetCell(level, node) == cell_id; },
+            search_space,
+            crossed_subcells);
+
+        std::move(crossed_subcells.begin(), crossed_subcells.end(), std::back_inserter(pending));
+    }
+
+    return search_space;
+}
+
+} // namespace routing_algorithms
+} // namespace engine
+} // namespace osrm
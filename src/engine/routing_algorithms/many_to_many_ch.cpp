@@ -1,8 +1,8 @@
 #include "engine/routing_algorithms/many_to_many.hpp"
+#include "engine/routing_algorithms/node_bucket_index.hpp"
 #include "engine/routing_algorithms/routing_base_ch.hpp"
 
 #include <boost/assert.hpp>
-#include <boost/range/iterator_range_core.hpp>
 
 #include <limits>
 #include <memory>
@@ -94,29 +94,37 @@ void forwardRoutingStep(const DataFacade<Algorithm> &facade,
                         const std::size_t row_index,
                         const std::size_t number_of_targets,
                         typename SearchEngineData<Algorithm>::ManyToManyQueryHeap &query_heap,
-                        const std::vector<NodeBucket> &search_space_with_buckets,
+                        const NodeBucketIndex &bucket_index,
                         std::vector<EdgeWeight> &weights_table,
                         std::vector<EdgeDuration> &durations_table,
                         std::vector<EdgeDistance> &distances_table,
                         std::vector<NodeID> &middle_nodes_table,
+                        const ManyToManyBounds &bounds,
                         const PhantomNode &phantom_node)
 {
     // Take a copy of the extracted node because otherwise could be modified later if toHeapNode is
     // the same
     const auto heapNode = query_heap.DeleteMinGetHeapNode();
 
+    // Paths via this node exceed the bounds, the bucket entries only add to them
+    if (bounds.IsPruned(heapNode.weight, heapNode.data.duration, heapNode.data.distance))
+    {
+        return;
+    }
+
     // Check if each encountered node has an entry
-    const auto &bucket_list = std::equal_range(search_space_with_buckets.begin(),
-                                               search_space_with_buckets.end(),
-                                               heapNode.node,
-                                               NodeBucket::Compare());
-    for (const auto &current_bucket : boost::make_iterator_range(bucket_list))
+    const auto bucket_range = bucket_index.Find(heapNode.node);
+    const auto &bucket_columns = bucket_index.GetColumns();
+    const auto &bucket_weights = bucket_index.GetWeights();
+    const auto &bucket_durations = bucket_index.GetDurations();
+    const auto &bucket_distances = bucket_index.GetDistances();
+    for (auto bucket = bucket_range.first; bucket < bucket_range.second; ++bucket)
     {
         // Get target id from bucket entry
-        const auto column_index = current_bucket.column_index;
-        const auto target_weight = current_bucket.weight;
-        const auto target_duration = current_bucket.duration;
-        const auto target_distance = current_bucket.distance;
+        const auto column_index = bucket_columns[bucket];
+        const auto target_weight = bucket_weights[bucket];
+        const auto target_duration = bucket_durations[bucket];
+        const auto target_distance = bucket_distances[bucket];
 
         auto &current_weight = weights_table[row_index * number_of_targets + column_index];
 
@@ -157,34 +165,67 @@ void forwardRoutingStep(const DataFacade<Algorithm> &facade,
 void backwardRoutingStep(const DataFacade<Algorithm> &facade,
                          const unsigned column_index,
                          typename SearchEngineData<Algorithm>::ManyToManyQueryHeap &query_heap,
-                         std::vector<NodeBucket> &search_space_with_buckets,
+                         NodeBucketIndex &bucket_index,
+                         const ManyToManyBounds &bounds,
                          const PhantomNode &phantom_node)
 {
     // Take a copy (no ref &) of the extracted node because otherwise could be modified later if
     // toHeapNode is the same
     const auto heapNode = query_heap.DeleteMinGetHeapNode();
 
+    if (bounds.IsPruned(heapNode.weight, heapNode.data.duration, heapNode.data.distance))
+    {
+        return;
+    }
+
     // Store settled nodes in search space bucket
-    search_space_with_buckets.emplace_back(heapNode.node,
-                                           heapNode.data.parent,
-                                           column_index,
-                                           heapNode.weight,
-                                           heapNode.data.duration,
-                                           heapNode.data.distance);
+    bucket_index.Insert(heapNode.node,
+                        column_index,
+                        heapNode.weight,
+                        heapNode.data.duration,
+                        heapNode.data.distance);
 
     relaxOutgoingEdges<REVERSE_DIRECTION>(facade, heapNode, query_heap, phantom_node);
 }
 
+void nearestPOIRoutingStep(const DataFacade<Algorithm> &facade,
+                           typename SearchEngineData<Algorithm>::ManyToManyQueryHeap &query_heap,
+                           const NodeBucketIndex &bucket_index,
+                           NearestPOIResults &results,
+                           const PhantomNode &phantom_node)
+{
+    const auto heapNode = query_heap.DeleteMinGetHeapNode();
+
+    const auto bucket_range = bucket_index.Find(heapNode.node);
+    for (auto bucket = bucket_range.first; bucket < bucket_range.second; ++bucket)
+    {
+        auto new_weight = heapNode.weight + bucket_index.GetWeights()[bucket];
+        auto new_duration = heapNode.data.duration + bucket_index.GetDurations()[bucket];
+        auto new_distance = heapNode.data.distance + bucket_index.GetDistances()[bucket];
+
+        if (new_weight < 0 &&
+            !addLoopWeight(facade, heapNode.node, new_weight, new_duration, new_distance))
+        {
+            continue;
+        }
+
+        results.Update(bucket_index.GetColumns()[bucket], new_weight, new_duration, new_distance);
+    }
+
+    relaxOutgoingEdges<FORWARD_DIRECTION>(facade, heapNode, query_heap, phantom_node);
+}
+
 } // namespace ch
 
 template <>
-std::pair<std::vector<EdgeDuration>, std::vector<EdgeDistance>>
+ManyToManyTables
 manyToManySearch(SearchEngineData<ch::Algorithm> &engine_working_data,
                  const DataFacade<ch::Algorithm> &facade,
                  const std::vector<PhantomNode> &phantom_nodes,
                  const std::vector<std::size_t> &source_indices,
                  const std::vector<std::size_t> &target_indices,
-                 const bool calculate_distance)
+                 const bool calculate_distance,
+                 const ManyToManyBounds &bounds)
 {
     const auto number_of_sources = source_indices.size();
     const auto number_of_targets = target_indices.size();
@@ -196,7 +237,7 @@ manyToManySearch(SearchEngineData<ch::Algorithm> &engine_working_data,
                                               MAXIMAL_EDGE_DISTANCE);
     std::vector<NodeID> middle_nodes_table(number_of_entries, SPECIAL_NODEID);
 
-    std::vector<NodeBucket> search_space_with_buckets;
+    NodeBucketIndex bucket_index;
 
     // Populate buckets with paths from all accessible nodes to destinations via backward searches
     for (std::uint32_t column_index = 0; column_index < target_indices.size(); ++column_index)
@@ -212,13 +253,12 @@ manyToManySearch(SearchEngineData<ch::Algorithm> &engine_working_data,
         // Explore search space
         while (!query_heap.Empty())
         {
-            backwardRoutingStep(
-                facade, column_index, query_heap, search_space_with_buckets, phantom);
+            backwardRoutingStep(facade, column_index, query_heap, bucket_index, bounds, phantom);
         }
     }
 
-    // Order lookup buckets
-    std::sort(search_space_with_buckets.begin(), search_space_with_buckets.end());
+    // Group lookup buckets by middle node
+    bucket_index.Build();
 
     // Find shortest paths from sources to all accessible nodes
     for (std::uint32_t row_index = 0; row_index < source_indices.size(); ++row_index)
@@ -239,16 +279,74 @@ manyToManySearch(SearchEngineData<ch::Algorithm> &engine_working_data,
                                row_index,
                                number_of_targets,
                                query_heap,
-                               search_space_with_buckets,
+                               bucket_index,
                                weights_table,
                                durations_table,
                                distances_table,
                                middle_nodes_table,
+                               bounds,
                                source_phantom);
         }
     }
 
-    return std::make_pair(std::move(durations_table), std::move(distances_table));
+    return {std::move(weights_table), std::move(durations_table), std::move(distances_table)};
+}
+
+template <>
+POIIndex buildPOIIndex(SearchEngineData<ch::Algorithm> &engine_working_data,
+                       const DataFacade<ch::Algorithm> &facade,
+                       const std::vector<PhantomNode> &pois)
+{
+    POIIndex poi_index;
+    const ManyToManyBounds unbounded;
+
+    // The backward search spaces do not depend on the query, so they are computed only once
+    for (std::uint32_t column_index = 0; column_index < pois.size(); ++column_index)
+    {
+        const auto &phantom = pois[column_index];
+        if (!phantom.IsValid())
+            continue;
+
+        engine_working_data.InitializeOrClearManyToManyThreadLocalStorage(
+            facade.GetNumberOfNodes());
+        auto &query_heap = *(engine_working_data.many_to_many_heap);
+        insertTargetInHeap(query_heap, phantom);
+
+        while (!query_heap.Empty())
+        {
+            ch::backwardRoutingStep(
+                facade, column_index, query_heap, poi_index.buckets, unbounded, phantom);
+        }
+    }
+
+    poi_index.buckets.Build();
+
+    return poi_index;
+}
+
+template <>
+std::vector<NearestPOI> nearestPOISearch(SearchEngineData<ch::Algorithm> &engine_working_data,
+                                         const DataFacade<ch::Algorithm> &facade,
+                                         const PhantomNode &source_phantom,
+                                         const POIIndex &poi_index,
+                                         const std::size_t number_of_results)
+{
+    NearestPOIResults results(number_of_results);
+
+    engine_working_data.InitializeOrClearManyToManyThreadLocalStorage(facade.GetNumberOfNodes());
+    auto &query_heap = *(engine_working_data.many_to_many_heap);
+    insertSourceInHeap(query_heap, source_phantom);
+
+    while (!query_heap.Empty())
+    {
+        results.Settle(query_heap.MinKey());
+        if (results.Done())
+            break;
+
+        ch::nearestPOIRoutingStep(facade, query_heap, poi_index.buckets, results, source_phantom);
+    }
+
+    return results.Finish();
 }
 
 } // namespace routing_algorithms
@@ -36,6 +36,25 @@ inline LevelID getNodeQueryLevel(const MultiLevelPartition &partition,
     return node_level;
 }
 
+// Query level of a node in a search towards all POIs of an index: the highest different level
+// to a POI is one below the lowest level on which the node shares a cell with any POI
+template <typename MultiLevelPartition>
+inline LevelID getNodeQueryLevel(const MultiLevelPartition &partition,
+                                 const NodeID node,
+                                 const PhantomNode &phantom_node,
+                                 const POIIndex &poi_index)
+{
+    const auto node_level = getNodeQueryLevel(partition, node, phantom_node);
+
+    for (LevelID level = 1; level <= node_level && level < poi_index.cells.size(); ++level)
+    {
+        if (poi_index.cells[level][partition.GetCell(level, node)])
+            return level - 1;
+    }
+
+    return node_level;
+}
+
 template <bool DIRECTION>
 void relaxBorderEdges(const DataFacade<mld::Algorithm> &facade,
                       const NodeID node,
@@ -211,13 +230,14 @@ void relaxOutgoingEdges(
 // Unidirectional multi-layer Dijkstra search for 1-to-N and N-to-1 matrices
 //
 template <bool DIRECTION>
-std::pair<std::vector<EdgeDuration>, std::vector<EdgeDistance>>
+ManyToManyTables
 oneToManySearch(SearchEngineData<Algorithm> &engine_working_data,
                 const DataFacade<Algorithm> &facade,
                 const std::vector<PhantomNode> &phantom_nodes,
                 std::size_t phantom_index,
                 const std::vector<std::size_t> &phantom_indices,
-                const bool calculate_distance)
+                const bool calculate_distance,
+                const ManyToManyBounds &bounds)
 {
     std::vector<EdgeWeight> weights_table(phantom_indices.size(), INVALID_EDGE_WEIGHT);
     std::vector<EdgeDuration> durations_table(phantom_indices.size(), MAXIMAL_EDGE_DURATION);
@@ -383,6 +403,10 @@ oneToManySearch(SearchEngineData<Algorithm> &engine_working_data,
         // if toHeapNode is the same
         const auto heapNode = query_heap.DeleteMinGetHeapNode();
 
+        // Paths via this node exceed the bounds
+        if (bounds.IsPruned(heapNode.weight, heapNode.data.duration, heapNode.data.distance))
+            continue;
+
         // Update values
         update_values(
             heapNode.node, heapNode.weight, heapNode.data.duration, heapNode.data.distance);
@@ -392,7 +416,7 @@ oneToManySearch(SearchEngineData<Algorithm> &engine_working_data,
             facade, heapNode, query_heap, phantom_nodes, phantom_index, phantom_indices);
     }
 
-    return std::make_pair(std::move(durations_table), std::move(distances_table));
+    return {std::move(weights_table), std::move(durations_table), std::move(distances_table)};
 }
 
 //
@@ -409,12 +433,17 @@ void forwardRoutingStep(const DataFacade<Algorithm> &facade,
                         std::vector<EdgeDuration> &durations_table,
                         std::vector<EdgeDistance> &distances_table,
                         std::vector<NodeID> &middle_nodes_table,
+                        const ManyToManyBounds &bounds,
                         const PhantomNode &phantom_node)
 {
     // Take a copy of the extracted node because otherwise could be modified later if toHeapNode is
     // the same
     const auto heapNode = query_heap.DeleteMinGetHeapNode();
 
+    // Paths via this node exceed the bounds, the bucket entries only add to them
+    if (bounds.IsPruned(heapNode.weight, heapNode.data.duration, heapNode.data.distance))
+        return;
+
     // Check if each encountered node has an entry
     const auto &bucket_list = std::equal_range(search_space_with_buckets.begin(),
                                                search_space_with_buckets.end(),
@@ -463,12 +492,16 @@ void backwardRoutingStep(const DataFacade<Algorithm> &facade,
                          const unsigned column_idx,
                          typename SearchEngineData<Algorithm>::ManyToManyQueryHeap &query_heap,
                          std::vector<NodeBucket> &search_space_with_buckets,
+                         const ManyToManyBounds &bounds,
                          const PhantomNode &phantom_node)
 {
     // Take a copy of the extracted node because otherwise could be modified later if toHeapNode is
     // the same
     const auto heapNode = query_heap.DeleteMinGetHeapNode();
 
+    if (bounds.IsPruned(heapNode.weight, heapNode.data.duration, heapNode.data.distance))
+        return;
+
     // Store settled nodes in search space bucket
     search_space_with_buckets.emplace_back(heapNode.node,
                                            heapNode.data.parent,
@@ -521,13 +554,14 @@ void retrievePackedPathFromSearchSpace(NodeID middle_node_id,
 }
 
 template <bool DIRECTION>
-std::pair<std::vector<EdgeDuration>, std::vector<EdgeDistance>>
+ManyToManyTables
 manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
                  const DataFacade<Algorithm> &facade,
                  const std::vector<PhantomNode> &phantom_nodes,
                  const std::vector<std::size_t> &source_indices,
                  const std::vector<std::size_t> &target_indices,
-                 const bool calculate_distance)
+                 const bool calculate_distance,
+                 const ManyToManyBounds &bounds)
 {
     const auto number_of_sources = source_indices.size();
     const auto number_of_targets = target_indices.size();
@@ -560,7 +594,7 @@ manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
         while (!query_heap.Empty())
         {
             backwardRoutingStep<DIRECTION>(
-                facade, column_idx, query_heap, search_space_with_buckets, target_phantom);
+                facade, column_idx, query_heap, search_space_with_buckets, bounds, target_phantom);
         }
     }
 
@@ -597,15 +631,150 @@ manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
                                           durations_table,
                                           distances_table,
                                           middle_nodes_table,
+                                          bounds,
                                           source_phantom);
         }
     }
 
-    return std::make_pair(std::move(durations_table), std::move(distances_table));
+    return {std::move(weights_table), std::move(durations_table), std::move(distances_table)};
 }
 
 } // namespace mld
 
+template <>
+POIIndex buildPOIIndex(SearchEngineData<mld::Algorithm> &,
+                       const DataFacade<mld::Algorithm> &facade,
+                       const std::vector<PhantomNode> &pois)
+{
+    const auto &partition = facade.GetMultiLevelPartition();
+
+    POIIndex poi_index;
+    poi_index.cells.resize(partition.GetNumberOfLevels());
+    for (LevelID level = 1; level < partition.GetNumberOfLevels(); ++level)
+    {
+        poi_index.cells[level].resize(partition.GetNumberOfCells(level), false);
+    }
+
+    auto insert_segment = [&](const unsigned column_index,
+                              const NodeID node,
+                              const EdgeWeight weight,
+                              const EdgeDuration duration,
+                              const EdgeDistance distance) {
+        poi_index.buckets.Insert(node, column_index, weight, duration, distance);
+        for (LevelID level = 1; level < partition.GetNumberOfLevels(); ++level)
+        {
+            poi_index.cells[level][partition.GetCell(level, node)] = true;
+        }
+    };
+
+    for (std::uint32_t column_index = 0; column_index < pois.size(); ++column_index)
+    {
+        const auto &phantom = pois[column_index];
+
+        if (phantom.IsValidForwardTarget())
+            insert_segment(column_index,
+                           phantom.forward_segment_id.id,
+                           phantom.GetForwardWeightPlusOffset(),
+                           phantom.GetForwardDuration(),
+                           phantom.GetForwardDistance());
+        if (phantom.IsValidReverseTarget())
+            insert_segment(column_index,
+                           phantom.reverse_segment_id.id,
+                           phantom.GetReverseWeightPlusOffset(),
+                           phantom.GetReverseDuration(),
+                           phantom.GetReverseDistance());
+    }
+
+    poi_index.buckets.Build();
+
+    return poi_index;
+}
+
+// Unidirectional multi-layer Dijkstra search like the one-to-many search above, the query level
+// of a node is looked up in the POI cells instead of being computed over all targets
+template <>
+std::vector<NearestPOI> nearestPOISearch(SearchEngineData<mld::Algorithm> &engine_working_data,
+                                         const DataFacade<mld::Algorithm> &facade,
+                                         const PhantomNode &source_phantom,
+                                         const POIIndex &poi_index,
+                                         const std::size_t number_of_results)
+{
+    const auto &buckets = poi_index.buckets;
+    NearestPOIResults results(number_of_results);
+
+    engine_working_data.InitializeOrClearManyToManyThreadLocalStorage(
+        facade.GetNumberOfNodes(), facade.GetMaxBorderNodeID() + 1);
+    auto &query_heap = *(engine_working_data.many_to_many_heap);
+
+    auto update_results =
+        [&](NodeID node, EdgeWeight weight, EdgeDuration duration, EdgeDistance distance) {
+            const auto bucket_range = buckets.Find(node);
+            for (auto bucket = bucket_range.first; bucket < bucket_range.second; ++bucket)
+            {
+                const auto path_weight = weight + buckets.GetWeights()[bucket];
+                if (path_weight >= 0)
+                {
+                    results.Update(buckets.GetColumns()[bucket],
+                                   path_weight,
+                                   duration + buckets.GetDurations()[bucket],
+                                   distance + buckets.GetDistances()[bucket]);
+                }
+            }
+        };
+
+    auto insert_node = [&](NodeID node,
+                           EdgeWeight initial_weight,
+                           EdgeDuration initial_duration,
+                           EdgeDistance initial_distance) {
+        const auto bucket_range = buckets.Find(node);
+        if (bucket_range.first != bucket_range.second)
+        {
+            // Source and POI on the same edge node, the node must stay reachable for POIs
+            // before the source on the segment (see oneToManySearch)
+            update_results(node, initial_weight, initial_duration, initial_distance);
+            mld::relaxBorderEdges<FORWARD_DIRECTION>(
+                facade, node, initial_weight, initial_duration, initial_distance, query_heap, 0);
+        }
+        else
+        {
+            query_heap.Insert(node, initial_weight, {node, initial_duration, initial_distance});
+        }
+    };
+
+    if (source_phantom.IsValidForwardSource())
+    {
+        insert_node(source_phantom.forward_segment_id.id,
+                    -source_phantom.GetForwardWeightPlusOffset(),
+                    -source_phantom.GetForwardDuration(),
+                    -source_phantom.GetForwardDistance());
+    }
+
+    if (source_phantom.IsValidReverseSource())
+    {
+        insert_node(source_phantom.reverse_segment_id.id,
+                    -source_phantom.GetReverseWeightPlusOffset(),
+                    -source_phantom.GetReverseDuration(),
+                    -source_phantom.GetReverseDistance());
+    }
+
+    while (!query_heap.Empty())
+    {
+        results.Settle(query_heap.MinKey());
+        if (results.Done())
+            break;
+
+        const auto heapNode = query_heap.DeleteMinGetHeapNode();
+
+        update_results(
+            heapNode.node, heapNode.weight, heapNode.data.duration, heapNode.data.distance);
+
+        mld::relaxOutgoingEdges<FORWARD_DIRECTION, const PhantomNode &, const POIIndex &>(
+            facade, heapNode, query_heap, source_phantom, poi_index);
+    }
+
+    return results.Finish();
+}
+
 // Dispatcher function for one-to-many and many-to-one tasks that can be handled by MLD differently:
 //
 // * one-to-many (many-to-one) tasks use a unidirectional forward (backward) Dijkstra search
@@ -619,13 +788,14 @@ manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
 //   then search is performed on a reversed graph with phantom nodes with flipped roles and
 //   returning a transposed matrix.
 template <>
-std::pair<std::vector<EdgeDuration>, std::vector<EdgeDistance>>
+ManyToManyTables
 manyToManySearch(SearchEngineData<mld::Algorithm> &engine_working_data,
                  const DataFacade<mld::Algorithm> &facade,
                  const std::vector<PhantomNode> &phantom_nodes,
                  const std::vector<std::size_t> &source_indices,
                  const std::vector<std::size_t> &target_indices,
-                 const bool calculate_distance)
+                 const bool calculate_distance,
+                 const ManyToManyBounds &bounds)
 {
     if (source_indices.size() == 1)
     { // TODO: check if target_indices.size() == 1 and do a bi-directional search
@@ -634,7 +804,8 @@ manyToManySearch(SearchEngineData<mld::Algorithm> &engine_working_data,
                                                        phantom_nodes,
                                                        source_indices.front(),
                                                        target_indices,
-                                                       calculate_distance);
+                                                       calculate_distance,
+                                                       bounds);
     }
 
     if (target_indices.size() == 1)
@@ -644,7 +815,8 @@ manyToManySearch(SearchEngineData<mld::Algorithm> &engine_working_data,
                                                        phantom_nodes,
                                                        target_indices.front(),
                                                        source_indices,
-                                                       calculate_distance);
+                                                       calculate_distance,
+                                                       bounds);
     }
 
     if (target_indices.size() < source_indices.size())
@@ -654,7 +826,8 @@ manyToManySearch(SearchEngineData<mld::Algorithm> &engine_working_data,
                                                         phantom_nodes,
                                                         target_indices,
                                                         source_indices,
-                                                        calculate_distance);
+                                                        calculate_distance,
+                                                        bounds);
     }
 
     return mld::manyToManySearch<FORWARD_DIRECTION>(engine_working_data,
@@ -662,7 +835,8 @@ manyToManySearch(SearchEngineData<mld::Algorithm> &engine_working_data,
                                                     phantom_nodes,
                                                     source_indices,
                                                     target_indices,
-                                                    calculate_distance);
+                                                    calculate_distance,
+                                                    bounds);
 }
 
 } // namespace routing_algorithms
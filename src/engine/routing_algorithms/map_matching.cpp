@@ -1,4 +1,5 @@
 #include "engine/routing_algorithms/map_matching.hpp"
+#include "engine/routing_algorithms/many_to_many.hpp"
 #include "engine/routing_algorithms/routing_base_ch.hpp"
 #include "engine/routing_algorithms/routing_base_mld.hpp"
 
@@ -13,6 +14,7 @@
 #include <cstddef>
 #include <deque>
 #include <iomanip>
+#include <limits>
 #include <memory>
 #include <numeric>
 #include <utility>
@@ -47,26 +49,141 @@ unsigned getMedianSampleTime(const std::vector<unsigned> &timestamps)
     return *median;
 }
 
+// One step of the Viterbi recursion: updates the candidates of the current trace point from the
+// unpruned candidates of the previous one. The network distances of all transitions come from a
+// single many-to-many search that shares the search spaces of the candidates, instead of a
+// point-to-point search per pair. Returns false if no candidate can be reached.
 template <typename Algorithm>
-inline void initializeHeap(SearchEngineData<Algorithm> &engine_working_data,
-                           const DataFacade<Algorithm> &facade)
+bool viterbiStep(SearchEngineData<Algorithm> &engine_working_data,
+                 const DataFacade<Algorithm> &facade,
+                 const CandidateList &prev_candidates,
+                 const std::vector<double> &prev_viterbi,
+                 const std::vector<bool> &prev_pruned,
+                 const util::Coordinate prev_coordinate,
+                 const CandidateList &current_candidates,
+                 const std::vector<double> &emission_log_probabilities,
+                 const util::Coordinate current_coordinate,
+                 const double max_distance_delta,
+                 std::vector<double> &current_viterbi,
+                 std::vector<bool> &current_pruned,
+                 std::vector<std::size_t> &current_parents,
+                 std::vector<float> &current_lengths)
 {
+    const map_matching::TransitionLogProbability transition_log_probability(MATCHING_BETA);
+
+    const auto haversine_distance =
+        util::coordinate_calculation::haversineDistance(prev_coordinate, current_coordinate);
+    // assumes minumum of 4 m/s
+    const EdgeWeight weight_upper_bound =
+        ((haversine_distance + max_distance_delta) / 4.) * facade.GetWeightMultiplier();
+
+    std::vector<std::size_t> source_indices;
+    std::vector<PhantomNode> sources;
+    std::vector<PhantomNode> targets;
+    for (const auto s : util::irange<std::size_t>(0UL, prev_candidates.size()))
+    {
+        if (!prev_pruned[s])
+        {
+            source_indices.push_back(s);
+            sources.push_back(prev_candidates[s].phantom_node);
+        }
+    }
+    for (const auto &candidate : current_candidates)
+    {
+        targets.push_back(candidate.phantom_node);
+    }
 
-    const auto nodes_number = facade.GetNumberOfNodes();
-    engine_working_data.InitializeOrClearFirstThreadLocalStorage(nodes_number);
-}
+    if (sources.empty())
+    {
+        return false;
+    }
 
-template <>
-inline void initializeHeap<mld::Algorithm>(SearchEngineData<mld::Algorithm> &engine_working_data,
-                                           const DataFacade<mld::Algorithm> &facade)
-{
+    const auto network_distances =
+        getTransitionDistances(engine_working_data, facade, sources, targets, weight_upper_bound);
+
+    bool reachable = false;
+    for (const auto row : util::irange<std::size_t>(0UL, source_indices.size()))
+    {
+        const auto s = source_indices[row];
+
+        for (const auto s_prime : util::irange<std::size_t>(0UL, current_candidates.size()))
+        {
+            const double emission_pr = emission_log_probabilities[s_prime];
+            double new_value = prev_viterbi[s] + emission_pr;
+            if (current_viterbi[s_prime] > new_value)
+            {
+                continue;
+            }
+
+            const auto network_distance =
+                network_distances[row * current_candidates.size() + s_prime];
+
+            // get distance diff between loc1/2 and locs/s_prime
+            const auto d_t = std::abs(network_distance - haversine_distance);
+
+            // very low probability transition -> prune
+            if (d_t >= max_distance_delta)
+            {
+                continue;
+            }
+
+            const double transition_pr = transition_log_probability(d_t);
+            new_value += transition_pr;
+
+            if (new_value > current_viterbi[s_prime])
+            {
+                current_viterbi[s_prime] = new_value;
+                current_parents[s_prime] = s;
+                current_lengths[s_prime] = network_distance;
+                current_pruned[s_prime] = false;
+                reachable = true;
+            }
+        }
+    }
 
-    const auto nodes_number = facade.GetNumberOfNodes();
-    const auto border_nodes_number = facade.GetMaxBorderNodeID() + 1;
-    engine_working_data.InitializeOrClearFirstThreadLocalStorage(nodes_number, border_nodes_number);
+    return reachable;
 }
+
 } // namespace
 
+template <typename Algorithm>
+std::vector<double> getTransitionDistances(SearchEngineData<Algorithm> &engine_working_data,
+                                           const DataFacade<Algorithm> &facade,
+                                           const std::vector<PhantomNode> &sources,
+                                           const std::vector<PhantomNode> &targets,
+                                           const EdgeWeight weight_upper_bound)
+{
+    std::vector<PhantomNode> phantom_nodes(sources);
+    phantom_nodes.insert(phantom_nodes.end(), targets.begin(), targets.end());
+    std::vector<std::size_t> source_indices(sources.size());
+    std::iota(source_indices.begin(), source_indices.end(), 0);
+    std::vector<std::size_t> target_indices(targets.size());
+    std::iota(target_indices.begin(), target_indices.end(), sources.size());
+
+    const ManyToManyBounds bounds(weight_upper_bound,
+                                  MAXIMAL_EDGE_DURATION,
+                                  MAXIMAL_EDGE_DISTANCE,
+                                  phantom_nodes,
+                                  source_indices);
+    const auto tables = manyToManySearch(engine_working_data,
+                                         facade,
+                                         phantom_nodes,
+                                         source_indices,
+                                         target_indices,
+                                         /*calculate_distance*/ true,
+                                         bounds);
+
+    // the bounds only stop the expansion of nodes, entries above them can still be found
+    std::vector<double> network_distances(tables.weights.size());
+    for (const auto entry : util::irange<std::size_t>(0UL, network_distances.size()))
+    {
+        network_distances[entry] = tables.weights[entry] >= weight_upper_bound
+                                       ? std::numeric_limits<double>::max()
+                                       : tables.distances[entry];
+    }
+    return network_distances;
+}
+
 template <typename Algorithm>
 SubMatchingList mapMatching(SearchEngineData<Algorithm> &engine_working_data,
                             const DataFacade<Algorithm> &facade,
@@ -78,7 +195,6 @@ SubMatchingList mapMatching(SearchEngineData<Algorithm> &engine_working_data,
 {
     map_matching::MatchingConfidence confidence;
     map_matching::EmissionLogProbability default_emission_log_probability(DEFAULT_GPS_PRECISION);
-    map_matching::TransitionLogProbability transition_log_probability(MATCHING_BETA);
 
     SubMatchingList sub_matchings;
 
@@ -150,10 +266,6 @@ SubMatchingList mapMatching(SearchEngineData<Algorithm> &engine_working_data,
         return sub_matchings;
     }
 
-    initializeHeap(engine_working_data, facade);
-    auto &forward_heap = *engine_working_data.forward_heap_1;
-    auto &reverse_heap = *engine_working_data.reverse_heap_1;
-
     std::size_t breakage_begin = map_matching::INVALID_STATE;
     std::vector<std::size_t> split_points;
     std::vector<std::size_t> prev_unbroken_timestamps;
@@ -214,58 +326,27 @@ SubMatchingList mapMatching(SearchEngineData<Algorithm> &engine_working_data,
             const auto &current_timestamps_list = candidates_list[t];
             const auto &current_coordinate = trace_coordinates[t];
 
-            const auto haversine_distance = util::coordinate_calculation::haversineDistance(
-                prev_coordinate, current_coordinate);
-            // assumes minumum of 4 m/s
-            const EdgeWeight weight_upper_bound =
-                ((haversine_distance + max_distance_delta) / 4.) * facade.GetWeightMultiplier();
-
-            // compute d_t for this timestamp and the next one
-            for (const auto s : util::irange<std::size_t>(0UL, prev_viterbi.size()))
+            std::vector<std::size_t> parent_candidates(current_viterbi.size());
+            model.breakage[t] = !viterbiStep(engine_working_data,
+                                             facade,
+                                             prev_unbroken_timestamps_list,
+                                             prev_viterbi,
+                                             prev_pruned,
+                                             prev_coordinate,
+                                             current_timestamps_list,
+                                             emission_log_probabilities[t],
+                                             current_coordinate,
+                                             max_distance_delta,
+                                             current_viterbi,
+                                             current_pruned,
+                                             parent_candidates,
+                                             current_lengths);
+            for (const auto s_prime : util::irange<std::size_t>(0UL, current_viterbi.size()))
             {
-                if (prev_pruned[s])
-                {
-                    continue;
-                }
-
-                for (const auto s_prime : util::irange<std::size_t>(0UL, current_viterbi.size()))
+                if (!current_pruned[s_prime])
                 {
-                    const double emission_pr = emission_log_probabilities[t][s_prime];
-                    double new_value = prev_viterbi[s] + emission_pr;
-                    if (current_viterbi[s_prime] > new_value)
-                    {
-                        continue;
-                    }
-
-                    double network_distance =
-                        getNetworkDistance(engine_working_data,
-                                           facade,
-                                           forward_heap,
-                                           reverse_heap,
-                                           prev_unbroken_timestamps_list[s].phantom_node,
-                                           current_timestamps_list[s_prime].phantom_node,
-                                           weight_upper_bound);
-
-                    // get distance diff between loc1/2 and locs/s_prime
-                    const auto d_t = std::abs(network_distance - haversine_distance);
-
-                    // very low probability transition -> prune
-                    if (d_t >= max_distance_delta)
-                    {
-                        continue;
-                    }
-
-                    const double transition_pr = transition_log_probability(d_t);
-                    new_value += transition_pr;
-
-                    if (new_value > current_viterbi[s_prime])
-                    {
-                        current_viterbi[s_prime] = new_value;
-                        current_parents[s_prime] = std::make_pair(prev_unbroken_timestamp, s);
-                        current_lengths[s_prime] = network_distance;
-                        current_pruned[s_prime] = false;
-                        model.breakage[t] = false;
-                    }
+                    current_parents[s_prime] =
+                        std::make_pair(prev_unbroken_timestamp, parent_candidates[s_prime]);
                 }
             }
 
@@ -437,6 +518,225 @@ SubMatchingList mapMatching(SearchEngineData<Algorithm> &engine_working_data,
     return sub_matchings;
 }
 
+template <typename Algorithm>
+SubMatchingList mapMatchingSession(SearchEngineData<Algorithm> &engine_working_data,
+                                   const DataFacade<Algorithm> &facade,
+                                   map_matching::MatchingSession &session,
+                                   const CandidateLists &candidates_list,
+                                   const std::vector<util::Coordinate> &trace_coordinates,
+                                   const std::vector<unsigned> &trace_timestamps,
+                                   const std::vector<boost::optional<double>> &trace_gps_precision,
+                                   const bool allow_splitting)
+{
+    map_matching::MatchingConfidence confidence;
+    map_matching::EmissionLogProbability default_emission_log_probability(DEFAULT_GPS_PRECISION);
+
+    SubMatchingList sub_matchings;
+
+    BOOST_ASSERT(candidates_list.size() == trace_coordinates.size());
+    BOOST_ASSERT(trace_timestamps.empty() || trace_timestamps.size() == trace_coordinates.size());
+
+    // Matched trace points of this request, a new sub matching starts at first_layer
+    struct Layer
+    {
+        std::size_t index;
+        CandidateList candidates;
+        std::vector<double> viterbi;
+        std::vector<bool> pruned;
+        // candidates of the previous layer on the most likely paths
+        std::vector<std::size_t> parents;
+    };
+    std::vector<Layer> layers;
+    std::size_t first_layer = 0;
+
+    const std::size_t index_offset = session.Empty() ? 0 : 1;
+    if (!session.Empty())
+    {
+        layers.push_back({0, session.candidates, session.viterbi, session.pruned, {}});
+    }
+
+    // Reconstructs the most likely path of the current sub matching if it has new trace points
+    const auto finish_sub_matching = [&]() {
+        if (layers.size() <= first_layer || layers.back().index < index_offset)
+        {
+            return;
+        }
+
+        const auto &last = layers.back();
+        const auto best = std::distance(last.viterbi.begin(),
+                                        std::max_element(last.viterbi.begin(), last.viterbi.end()));
+
+        // candidates on a most likely path to any candidate of the last layer
+        std::vector<std::vector<bool>> reachable;
+        for (const auto layer : util::irange(first_layer, layers.size()))
+        {
+            reachable.emplace_back(layers[layer].candidates.size(), false);
+        }
+        for (const auto s_last : util::irange<std::size_t>(0UL, last.candidates.size()))
+        {
+            if (last.pruned[s_last])
+                continue;
+
+            auto candidate = s_last;
+            for (auto layer = layers.size() - 1; layer >= first_layer; --layer)
+            {
+                if (reachable[layer - first_layer][candidate])
+                    break;
+                reachable[layer - first_layer][candidate] = true;
+                if (layer == first_layer)
+                    break;
+                candidate = layers[layer].parents[candidate];
+            }
+        }
+
+        map_matching::SubMatching matching;
+        std::size_t candidate = best;
+        for (auto layer = layers.size() - 1;; --layer)
+        {
+            const auto routes_count = std::accumulate(
+                reachable[layer - first_layer].begin(), reachable[layer - first_layer].end(), 0);
+            BOOST_ASSERT(routes_count > 0);
+            matching.nodes.push_back(layers[layer].candidates[candidate].phantom_node);
+            matching.indices.push_back(layers[layer].index);
+            // we don't count the current route in the "alternatives_count" parameter
+            matching.alternatives_count.push_back(routes_count - 1);
+            if (layer == first_layer)
+                break;
+            candidate = layers[layer].parents[candidate];
+        }
+        std::reverse(matching.nodes.begin(), matching.nodes.end());
+        std::reverse(matching.indices.begin(), matching.indices.end());
+        std::reverse(matching.alternatives_count.begin(), matching.alternatives_count.end());
+
+        matching.confidence = confidence(session.trace_distance, session.matched_distances[best]);
+        sub_matchings.push_back(std::move(matching));
+    };
+
+    // Makes the layer the last matched point of the session
+    const auto advance = [&](Layer layer,
+                             const util::Coordinate coordinate,
+                             const boost::optional<unsigned> timestamp,
+                             std::vector<double> matched_distances) {
+        // keep the probabilities of long sessions in range
+        const auto max_viterbi = *std::max_element(layer.viterbi.begin(), layer.viterbi.end());
+        for (auto &value : layer.viterbi)
+            value -= max_viterbi;
+
+        session.candidates = layer.candidates;
+        session.viterbi = layer.viterbi;
+        session.pruned = layer.pruned;
+        session.matched_distances = std::move(matched_distances);
+        session.coordinate = coordinate;
+        session.timestamp = timestamp;
+        session.broken_points = 0;
+        layers.push_back(std::move(layer));
+    };
+
+    for (const auto t : util::irange<std::size_t>(0UL, candidates_list.size()))
+    {
+        const auto &candidates = candidates_list[t];
+        const auto &coordinate = trace_coordinates[t];
+        const auto timestamp = trace_timestamps.empty()
+                                   ? boost::optional<unsigned>{}
+                                   : boost::optional<unsigned>{trace_timestamps[t]};
+
+        std::vector<double> emission_log_probabilities(candidates.size());
+        const auto emission_log_probability =
+            trace_gps_precision.empty() || !trace_gps_precision[t]
+                ? default_emission_log_probability
+                : map_matching::EmissionLogProbability(*trace_gps_precision[t]);
+        std::transform(candidates.begin(),
+                       candidates.end(),
+                       emission_log_probabilities.begin(),
+                       [&emission_log_probability](const PhantomNodeWithDistance &candidate) {
+                           return emission_log_probability(candidate.distance);
+                       });
+
+        Layer layer{t + index_offset,
+                    candidates,
+                    std::vector<double>(candidates.size(), map_matching::IMPOSSIBLE_LOG_PROB),
+                    std::vector<bool>(candidates.size(), true),
+                    std::vector<std::size_t>(candidates.size(), 0)};
+
+        if (!session.Empty())
+        {
+            const bool use_timestamps = timestamp && session.timestamp;
+            const auto step_time = use_timestamps ? *timestamp - *session.timestamp : 1u;
+            const auto max_distance_delta =
+                use_timestamps ? step_time * facade.GetMapMatchingMaxSpeed() : MAX_DISTANCE_DELTA;
+            const bool gap_in_trace = use_timestamps && allow_splitting
+                                          ? step_time > session.sample_time * MAX_BROKEN_STATES
+                                          : session.broken_points >= MAX_BROKEN_STATES;
+
+            if (!gap_in_trace)
+            {
+                const auto &prev = layers.back();
+                std::vector<float> lengths(candidates.size());
+                const bool matched = viterbiStep(engine_working_data,
+                                                 facade,
+                                                 prev.candidates,
+                                                 prev.viterbi,
+                                                 prev.pruned,
+                                                 session.coordinate,
+                                                 candidates,
+                                                 emission_log_probabilities,
+                                                 coordinate,
+                                                 max_distance_delta,
+                                                 layer.viterbi,
+                                                 layer.pruned,
+                                                 layer.parents,
+                                                 lengths);
+                if (!matched)
+                {
+                    ++session.broken_points;
+                    continue;
+                }
+
+                std::vector<double> matched_distances(candidates.size(), 0);
+                for (const auto s : util::irange<std::size_t>(0UL, candidates.size()))
+                {
+                    if (!layer.pruned[s])
+                        matched_distances[s] =
+                            session.matched_distances[layer.parents[s]] + lengths[s];
+                }
+                session.trace_distance +=
+                    util::coordinate_calculation::haversineDistance(session.coordinate, coordinate);
+                session.sample_time = std::max(1u, step_time);
+                advance(std::move(layer), coordinate, timestamp, std::move(matched_distances));
+                continue;
+            }
+
+            // the trace is split, the session starts over at this point
+            finish_sub_matching();
+            first_layer = layers.size();
+            const auto checksum = session.checksum;
+            session.Clear();
+            session.checksum = checksum;
+        }
+
+        for (const auto s : util::irange<std::size_t>(0UL, candidates.size()))
+        {
+            layer.viterbi[s] = emission_log_probabilities[s];
+            layer.parents[s] = s;
+            layer.pruned[s] = layer.viterbi[s] < map_matching::MINIMAL_LOG_PROB;
+        }
+        if (std::all_of(layer.pruned.begin(), layer.pruned.end(), [](bool pruned) {
+                return pruned;
+            }))
+        {
+            continue;
+        }
+        advance(std::move(layer),
+                coordinate,
+                timestamp,
+                std::vector<double>(candidates.size(), 0));
+    }
+
+    finish_sub_matching();
+
+    return sub_matchings;
+}
+
 // CH
 template SubMatchingList
 mapMatching(SearchEngineData<ch::Algorithm> &engine_working_data,
@@ -457,6 +757,42 @@ mapMatching(SearchEngineData<mld::Algorithm> &engine_working_data,
             const std::vector<boost::optional<double>> &trace_gps_precision,
             const bool allow_splitting);
 
+// CH
+template std::vector<double>
+getTransitionDistances(SearchEngineData<ch::Algorithm> &engine_working_data,
+                       const DataFacade<ch::Algorithm> &facade,
+                       const std::vector<PhantomNode> &sources,
+                       const std::vector<PhantomNode> &targets,
+                       const EdgeWeight weight_upper_bound);
+
+template SubMatchingList
+mapMatchingSession(SearchEngineData<ch::Algorithm> &engine_working_data,
+                   const DataFacade<ch::Algorithm> &facade,
+                   map_matching::MatchingSession &session,
+                   const CandidateLists &candidates_list,
+                   const std::vector<util::Coordinate> &trace_coordinates,
+                   const std::vector<unsigned> &trace_timestamps,
+                   const std::vector<boost::optional<double>> &trace_gps_precision,
+                   const bool allow_splitting);
+
+// MLD
+template std::vector<double>
+getTransitionDistances(SearchEngineData<mld::Algorithm> &engine_working_data,
+                       const DataFacade<mld::Algorithm> &facade,
+                       const std::vector<PhantomNode> &sources,
+                       const std::vector<PhantomNode> &targets,
+                       const EdgeWeight weight_upper_bound);
+
+template SubMatchingList
+mapMatchingSession(SearchEngineData<mld::Algorithm> &engine_working_data,
+                   const DataFacade<mld::Algorithm> &facade,
+                   map_matching::MatchingSession &session,
+                   const CandidateLists &candidates_list,
+                   const std::vector<util::Coordinate> &trace_coordinates,
+                   const std::vector<unsigned> &trace_timestamps,
+                   const std::vector<boost::optional<double>> &trace_gps_precision,
+                   const bool allow_splitting);
+
 } // namespace routing_algorithms
 } // namespace engine
 } // namespace osrm
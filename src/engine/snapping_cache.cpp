@@ -0,0 +1,39 @@
+#include "engine/snapping_cache.hpp"
+
+#include <boost/functional/hash.hpp>
+
+namespace osrm
+{
+namespace engine
+{
+
+constexpr std::size_t SnappingCache::ENTRY_SIZE;
+
+std::size_t SnappingCache::KeyHash::operator()(const Key &key) const
+{
+    std::size_t seed = 0;
+    boost::hash_combine(seed, static_cast<std::int32_t>(key.coordinate.lon));
+    boost::hash_combine(seed, static_cast<std::int32_t>(key.coordinate.lat));
+    if (key.bearing)
+    {
+        boost::hash_combine(seed, key.bearing->bearing);
+        boost::hash_combine(seed, key.bearing->range);
+    }
+    if (key.radius)
+    {
+        boost::hash_combine(seed, *key.radius);
+    }
+    boost::hash_combine(seed, static_cast<std::uint8_t>(key.approach));
+    boost::hash_combine(seed, key.use_all_edges);
+    return seed;
+}
+
+// the budget is split evenly between the shards and never exceeded
+SnappingCache::SnappingCache(const std::size_t byte_budget)
+    : cache(byte_budget / ENTRY_SIZE / decltype(cache)::NUMBER_OF_SHARDS *
+            decltype(cache)::NUMBER_OF_SHARDS)
+{
+}
+
+} // namespace engine
+} // namespace osrm
@@ -0,0 +1,121 @@
+#include "engine/tile_store.hpp"
+
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
+#include "util/mmap_tar.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace osrm
+{
+namespace engine
+{
+
+namespace
+{
+// tiles are written in chunks of about this many bytes
+constexpr std::size_t FLUSH_SIZE = 16 * 1024 * 1024;
+
+template <typename T>
+util::vector_view<const T> getEntry(const util::DataMap &entries,
+                                    const boost::filesystem::path &path,
+                                    const std::string &name)
+{
+    const auto entry = entries.find(name);
+    if (entry == entries.end())
+    {
+        throw util::exception("Tile store " + path.string() + " has no " + name + SOURCE_REF);
+    }
+    const auto begin = reinterpret_cast<const T *>(entry->second.first);
+    const auto end = reinterpret_cast<const T *>(entry->second.second);
+    return util::vector_view<const T>(begin, end - begin);
+}
+} // namespace
+
+TileStore::TileStore(const boost::filesystem::path &path)
+{
+    const auto entries = util::mmapTarFile(path, region);
+
+    connectivity_checksum =
+        getEntry<std::uint32_t>(entries, path, "/tiles/connectivity_checksum")[0];
+    metric_checksum = getEntry<std::uint32_t>(entries, path, "/tiles/metric_checksum")[0];
+    keys = getEntry<std::uint64_t>(entries, path, "/tiles/keys");
+    offsets = getEntry<std::uint64_t>(entries, path, "/tiles/offsets");
+    data = getEntry<char>(entries, path, "/tiles/data").data();
+
+    if (offsets.size() != keys.size() + 1)
+    {
+        throw util::exception("Tile store " + path.string() + " has an invalid index" +
+                              SOURCE_REF);
+    }
+}
+
+boost::optional<util::StringView>
+TileStore::Find(const unsigned x, const unsigned y, const unsigned z) const
+{
+    const auto key = GetTileKey(x, y, z);
+    const auto position = std::lower_bound(keys.begin(), keys.end(), key);
+    if (position == keys.end() || *position != key)
+    {
+        return boost::none;
+    }
+
+    const auto index = std::distance(keys.begin(), position);
+    return util::StringView(data + offsets[index], offsets[index + 1] - offsets[index]);
+}
+
+TileStoreWriter::TileStoreWriter(const boost::filesystem::path &path,
+                                 const std::uint32_t connectivity_checksum,
+                                 const std::uint32_t metric_checksum)
+    : writer(std::make_unique<storage::tar::FileWriter>(
+          path, storage::tar::FileWriter::GenerateFingerprint)),
+      connectivity_checksum(connectivity_checksum), metric_checksum(metric_checksum), offsets{0}
+{
+    // the data is the last entry until all tiles are written, so it can be continued
+    writer->WriteFrom("/tiles/data", pending.data(), 0);
+}
+
+void TileStoreWriter::Append(const unsigned x,
+                             const unsigned y,
+                             const unsigned z,
+                             const std::string &tile)
+{
+    BOOST_ASSERT(writer);
+    const auto key = GetTileKey(x, y, z);
+    BOOST_ASSERT(keys.empty() || keys.back() < key);
+
+    keys.push_back(key);
+    offsets.push_back(offsets.back() + tile.size());
+    pending += tile;
+
+    if (pending.size() >= FLUSH_SIZE)
+    {
+        Flush();
+    }
+}
+
+void TileStoreWriter::Flush()
+{
+    if (!pending.empty())
+    {
+        writer->ContinueFrom("/tiles/data", pending.data(), pending.size());
+        pending.clear();
+    }
+}
+
+void TileStoreWriter::Finish()
+{
+    BOOST_ASSERT(writer);
+    Flush();
+
+    writer->WriteFrom("/tiles/keys", keys.data(), keys.size());
+    writer->WriteFrom("/tiles/offsets", offsets.data(), offsets.size());
+    writer->WriteFrom("/tiles/connectivity_checksum", connectivity_checksum);
+    writer->WriteFrom("/tiles/metric_checksum", metric_checksum);
+    writer.reset();
+}
+} // namespace engine
+} // namespace osrm
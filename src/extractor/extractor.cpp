@@ -17,6 +17,7 @@
 #include "extractor/restriction_graph.hpp"
 #include "extractor/restriction_parser.hpp"
 #include "extractor/scripting_environment.hpp"
+#include "extractor/simplification_ranks.hpp"
 #include "extractor/tarjan_scc.hpp"
 #include "extractor/way_restriction_map.hpp"
 
@@ -318,8 +319,18 @@ int Extractor::run(ScriptingEnvironment &scripting_environment)
 
     // output the geometry of the node-based graph, needs to be done after the last usage, since it
     // destroys internal containers
-    files::writeSegmentData(config.GetPath(".osrm.geometry"),
-                            *node_based_graph_factory.GetCompressedEdges().ToSegmentData());
+    {
+        auto segment_data = node_based_graph_factory.GetCompressedEdges().ToSegmentData();
+
+        util::Log() << "Ranking geometry coordinates for simplification ...";
+        TIMER_START(simplification_ranks);
+        segment_data->SetSimplificationRanks(
+            computeSimplificationRanks(*segment_data, coordinates));
+        TIMER_STOP(simplification_ranks);
+        util::Log() << "ok, after " << TIMER_SEC(simplification_ranks) << "s";
+
+        files::writeSegmentData(config.GetPath(".osrm.geometry"), *segment_data);
+    }
 
     util::Log() << "Saving edge-based node weights to file.";
     TIMER_START(timer_write_node_weights);
@@ -0,0 +1,155 @@
+#include "extractor/simplification_ranks.hpp"
+#include "engine/douglas_peucker.hpp"
+#include "util/coordinate_calculation.hpp"
+#include "util/web_mercator.hpp"
+
+#include <boost/assert.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+#include <utility>
+
+namespace osrm
+{
+namespace extractor
+{
+
+namespace
+{
+const constexpr std::uint8_t NEVER_NEEDED = engine::detail::DOUGLAS_PEUCKER_THRESHOLDS_SIZE;
+
+// Same metric as engine::douglasPeucker, normed to the thresholds table
+std::uint64_t perpendicularDistance(const util::FloatCoordinate &projected_start,
+                                    const util::FloatCoordinate &projected_target,
+                                    const util::FloatCoordinate &projected)
+{
+    util::FloatCoordinate projected_point_on_segment;
+    std::tie(std::ignore, projected_point_on_segment) =
+        util::coordinate_calculation::projectPointOnSegment(
+            projected_start, projected_target, projected);
+    return util::coordinate_calculation::squaredEuclideanDistance(projected,
+                                                                  projected_point_on_segment);
+}
+
+// Lowest zoom level whose threshold is exceeded by the distance
+std::uint8_t getZoomLevel(const std::uint64_t distance)
+{
+    const auto begin = std::begin(engine::detail::DOUGLAS_PEUCKER_THRESHOLDS);
+    const auto end = std::end(engine::detail::DOUGLAS_PEUCKER_THRESHOLDS);
+    return std::distance(
+        begin, std::find_if(begin, end, [distance](const auto threshold) {
+            return distance > threshold;
+        }));
+}
+
+// Douglas-Peucker always splits a range at the farthest coordinate, independent of the zoom level.
+// The zoom level only decides where the recursion stops, so a single pass with the split points
+// ranked by the smallest distance on their path to the root is enough for all zoom levels.
+void rankGeometry(const std::vector<util::FloatCoordinate> &projected_coordinates,
+                  std::vector<std::pair<std::size_t, std::size_t>> &recursion_stack,
+                  std::uint8_t *ranks)
+{
+    const auto size = projected_coordinates.size();
+    std::fill(ranks, ranks + size, NEVER_NEEDED);
+    if (size == 0)
+    {
+        return;
+    }
+    ranks[0] = 0;
+    ranks[size - 1] = 0;
+
+    recursion_stack.clear();
+    recursion_stack.emplace_back(0, size - 1);
+    while (!recursion_stack.empty())
+    {
+        std::size_t first, last;
+        std::tie(first, last) = recursion_stack.back();
+        recursion_stack.pop_back();
+
+        std::uint64_t max_distance = 0;
+        auto farthest_entry_index = last;
+        for (auto idx = first + 1; idx < last; ++idx)
+        {
+            const auto distance = perpendicularDistance(projected_coordinates[first],
+                                                        projected_coordinates[last],
+                                                        projected_coordinates[idx]);
+            if (distance > max_distance)
+            {
+                farthest_entry_index = idx;
+                max_distance = distance;
+            }
+        }
+
+        // a coordinate is only needed on zoom levels on which the borders of its range are
+        const auto rank = std::max({ranks[first], ranks[last], getZoomLevel(max_distance)});
+        if (rank < NEVER_NEEDED)
+        {
+            ranks[farthest_entry_index] = rank;
+            recursion_stack.emplace_back(first, farthest_entry_index);
+            recursion_stack.emplace_back(farthest_entry_index, last);
+        }
+    }
+}
+} // namespace
+
+std::vector<std::uint8_t> computeSimplificationRanks(const std::vector<util::Coordinate> &geometry)
+{
+    std::vector<util::FloatCoordinate> projected_coordinates(geometry.size());
+    std::transform(geometry.begin(),
+                   geometry.end(),
+                   projected_coordinates.begin(),
+                   [](const util::Coordinate coordinate) {
+                       return util::web_mercator::fromWGS84(coordinate);
+                   });
+
+    std::vector<std::uint8_t> ranks(geometry.size());
+    std::vector<std::pair<std::size_t, std::size_t>> recursion_stack;
+    rankGeometry(projected_coordinates, recursion_stack, ranks.data());
+    return ranks;
+}
+
+std::vector<std::uint8_t>
+computeSimplificationRanks(const SegmentDataContainer &segment_data,
+                           const std::vector<util::Coordinate> &coordinates)
+{
+    using DirectionalGeometryID = SegmentDataContainer::DirectionalGeometryID;
+
+    // every node has a forward weight, the first one is invalid
+    std::vector<std::uint8_t> ranks(segment_data.GetNumberOfSegments());
+    if (ranks.empty())
+    {
+        return ranks;
+    }
+    const auto nodes_begin = segment_data.GetForwardGeometry(0).begin();
+
+    tbb::parallel_for(
+        tbb::blocked_range<DirectionalGeometryID>(0, segment_data.GetNumberOfGeometries()),
+        [&](const auto &range) {
+            std::vector<util::FloatCoordinate> projected_coordinates;
+            std::vector<std::pair<std::size_t, std::size_t>> recursion_stack;
+            for (auto id = range.begin(); id != range.end(); ++id)
+            {
+                const auto geometry = segment_data.GetForwardGeometry(id);
+                projected_coordinates.resize(geometry.size());
+                std::transform(geometry.begin(),
+                               geometry.end(),
+                               projected_coordinates.begin(),
+                               [&coordinates](const NodeID node) {
+                                   BOOST_ASSERT(node < coordinates.size());
+                                   return util::web_mercator::fromWGS84(coordinates[node]);
+                               });
+
+                rankGeometry(projected_coordinates,
+                             recursion_stack,
+                             ranks.data() + (geometry.begin() - nodes_begin));
+            }
+        });
+
+    return ranks;
+}
+} // namespace extractor
+} // namespace osrm
@@ -385,6 +385,9 @@ NAN_METHOD(Engine::nearest) //
  * @param {Number} [options.fallback_speed] Replace `null` responses in result with as-the-crow-flies estimates based on `fallback_speed`.  Value is in metres/second.
  * @param {String} [options.fallback_coordinate] Either `input` (default) or `snapped`.  If using a `fallback_speed`, use either the user-supplied coordinate (`input`), or the snapped coordinate (`snapped`) for calculating the as-the-crow-flies distance between two points.
  * @param {Number} [options.scale_factor] Multiply the table duration values in the table by this number for more controlled input into a route optimization solver.
+ * @param {Number} [options.max_duration] Only report pairs with a duration of at most `max_duration` seconds, longer pairs are `null`. The searches are not expanded beyond the bound. Can not be combined with `fallback_speed`.
+ * @param {Number} [options.max_distance] Only report pairs with a distance of at most `max_distance` meters, longer pairs are `null`. The searches are not expanded beyond the bound. Can not be combined with `fallback_speed`.
+ * @param {Boolean} [options.sparse=false] List only the pairs that have a route instead of returning full matrices.
  * @param {String} [options.snapping] Which edges can be snapped to, either `default`, or `any`.  `default` only snaps to edges marked by the profile as `is_startpoint`, `any` will allow snapping to any edge in the routing graph.
  * @param {Array} [options.annotations] Return the requested table or tables in response. Can be `['duration']` (return the duration matrix, default), `[distance']` (return the distance matrix), or `['duration', distance']` (return both the duration matrix and the distance matrix).
 
@@ -398,6 +401,8 @@ NAN_METHOD(Engine::nearest) //
  * **`sources`**: array of [`Ẁaypoint`](#waypoint) objects describing all sources in order.
  * **`destinations`**: array of [`Ẁaypoint`](#waypoint) objects describing all destinations in order.
  * **`fallback_speed_cells`**: (optional) if `fallback_speed` is used, will be an array of arrays of `row,column` values, indicating which cells contain estimated values.
+ * **`sparse_cells`**: (optional) if `sparse` is used, will be an array of arrays of `row,column` values of all pairs that have a route.
+ *                  `durations` and `distances` are then flat arrays with the values of these pairs in the same order.
  *
  * @example
  * var osrm = new OSRM('network.osrm');
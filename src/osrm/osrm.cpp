@@ -1,8 +1,10 @@
 #include "osrm/osrm.hpp"
 
 #include "engine/algorithm.hpp"
+#include "engine/api/isochrone_parameters.hpp"
 #include "engine/api/match_parameters.hpp"
 #include "engine/api/nearest_parameters.hpp"
+#include "engine/api/poi_parameters.hpp"
 #include "engine/api/route_parameters.hpp"
 #include "engine/api/table_parameters.hpp"
 #include "engine/api/trip_parameters.hpp"
@@ -95,6 +97,33 @@ Status OSRM::Nearest(const NearestParameters &params, engine::api::ResultT &resu
     return engine_->Nearest(params, result);
 }
 
+Status OSRM::POI(const engine::api::POIParameters &params, json::Object &json_result) const
+{
+    osrm::engine::api::ResultT result = json::Object();
+    auto status = engine_->POI(params, result);
+    json_result = std::move(result.get<json::Object>());
+    return status;
+}
+
+Status OSRM::POI(const POIParameters &params, engine::api::ResultT &result) const
+{
+    return engine_->POI(params, result);
+}
+
+Status OSRM::Isochrone(const engine::api::IsochroneParameters &params,
+                       json::Object &json_result) const
+{
+    osrm::engine::api::ResultT result = json::Object();
+    auto status = engine_->Isochrone(params, result);
+    json_result = std::move(result.get<json::Object>());
+    return status;
+}
+
+Status OSRM::Isochrone(const IsochroneParameters &params, engine::api::ResultT &result) const
+{
+    return engine_->Isochrone(params, result);
+}
+
 Status OSRM::Trip(const engine::api::TripParameters &params, json::Object &json_result) const
 {
     osrm::engine::api::ResultT result = json::Object();
@@ -1,7 +1,9 @@
 #include "server/api/parameters_parser.hpp"
 
+#include "server/api/isochrone_parameter_grammar.hpp"
 #include "server/api/match_parameter_grammar.hpp"
 #include "server/api/nearest_parameter_grammar.hpp"
+#include "server/api/poi_parameter_grammar.hpp"
 #include "server/api/route_parameters_grammar.hpp"
 #include "server/api/table_parameter_grammar.hpp"
 #include "server/api/tile_parameter_grammar.hpp"
@@ -24,6 +26,8 @@ using is_grammar_t =
                            std::is_same<RouteParametersGrammar<>, T>::value ||
                                std::is_same<TableParametersGrammar<>, T>::value ||
                                std::is_same<NearestParametersGrammar<>, T>::value ||
+                               std::is_same<POIParametersGrammar<>, T>::value ||
+                               std::is_same<IsochroneParametersGrammar<>, T>::value ||
                                std::is_same<TripParametersGrammar<>, T>::value ||
                                std::is_same<MatchParametersGrammar<>, T>::value ||
                                std::is_same<TileParametersGrammar<>, T>::value>;
@@ -88,6 +92,21 @@ boost::optional<engine::api::NearestParameters> parseParameters(std::string::ite
                                                                                                end);
 }
 
+template <>
+boost::optional<engine::api::POIParameters> parseParameters(std::string::iterator &iter,
+                                                            const std::string::iterator end)
+{
+    return detail::parseParameters<engine::api::POIParameters, POIParametersGrammar<>>(iter, end);
+}
+
+template <>
+boost::optional<engine::api::IsochroneParameters>
+parseParameters(std::string::iterator &iter, const std::string::iterator end)
+{
+    return detail::parseParameters<engine::api::IsochroneParameters,
+                                   IsochroneParametersGrammar<>>(iter, end);
+}
+
 template <>
 boost::optional<engine::api::TripParameters> parseParameters(std::string::iterator &iter,
                                                              const std::string::iterator end)
@@ -7,6 +7,7 @@
 
 #include "util/json_renderer.hpp"
 #include "util/log.hpp"
+#include "util/monotonic_arena.hpp"
 #include "util/string_util.hpp"
 #include "util/timing_util.hpp"
 #include "util/typedefs.hpp"
@@ -53,6 +54,8 @@ void RequestHandler::HandleRequest(const http::request &current_request, http::r
     try
     {
         TIMER_START(request_duration);
+        // route steps are allocated from the arena of this thread, it is reset after the reply
+        util::ArenaScope arena_scope;
         std::string request_string;
         util::URIDecode(current_request.uri, request_string);
 
@@ -136,6 +139,7 @@ void RequestHandler::HandleRequest(const http::request &current_request, http::r
         current_reply.headers.emplace_back("Content-Length",
                                            std::to_string(current_reply.content.size()));
 
+        TIMER_STOP(request_duration);
         if (!std::getenv("DISABLE_ACCESS_LOGGING"))
         {
             // deactivated as GCC apparently does not implement that, not even in 4.9
@@ -150,7 +154,6 @@ void RequestHandler::HandleRequest(const http::request &current_request, http::r
 
             time_t ltime;
             struct tm *time_stamp;
-            TIMER_STOP(request_duration);
 
             ltime = time(nullptr);
             time_stamp = localtime(&ltime);
@@ -169,6 +172,9 @@ void RequestHandler::HandleRequest(const http::request &current_request, http::r
                         << current_reply.status << " " //
                         << request_string;
         }
+        util::Log(logDEBUG) << "[req][" << tid << "] " << TIMER_MSEC(request_duration) << "ms, "
+                            << arena_scope.GetArena().GetNumberOfAllocations()
+                            << " arena allocations";
     }
     catch (const std::exception &e)
     {
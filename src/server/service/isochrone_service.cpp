@@ -0,0 +1,91 @@
+#include "server/service/isochrone_service.hpp"
+#include "server/service/utils.hpp"
+
+#include "server/api/parameters_parser.hpp"
+#include "engine/api/isochrone_parameters.hpp"
+
+#include "util/json_container.hpp"
+
+#include <boost/format.hpp>
+
+#include <algorithm>
+
+namespace osrm
+{
+namespace server
+{
+namespace service
+{
+
+namespace
+{
+std::string getWrongOptionHelp(const engine::api::IsochroneParameters &parameters)
+{
+    std::string help;
+
+    const auto coord_size = parameters.coordinates.size();
+
+    constrainParamSize(PARAMETER_SIZE_MISMATCH_MSG, "hints", parameters.hints, coord_size, help);
+    constrainParamSize(
+        PARAMETER_SIZE_MISMATCH_MSG, "bearings", parameters.bearings, coord_size, help);
+    constrainParamSize(
+        PARAMETER_SIZE_MISMATCH_MSG, "radiuses", parameters.radiuses, coord_size, help);
+    constrainParamSize(
+        PARAMETER_SIZE_MISMATCH_MSG, "approaches", parameters.approaches, coord_size, help);
+
+    if (help.empty() && parameters.contours.empty())
+    {
+        help = "At least one contour is required";
+    }
+    else if (help.empty() &&
+             std::any_of(parameters.contours.begin(),
+                         parameters.contours.end(),
+                         [](const double contour) { return contour <= 0; }))
+    {
+        help = "Contours must be positive durations in seconds";
+    }
+
+    return help;
+}
+} // namespace
+
+engine::Status IsochroneService::RunQuery(std::size_t prefix_length,
+                                    std::string &query,
+                                    osrm::engine::api::ResultT &result)
+{
+    result = util::json::Object();
+    auto &json_result = result.get<util::json::Object>();
+
+    auto query_iterator = query.begin();
+    auto parameters =
+        api::parseParameters<engine::api::IsochroneParameters>(query_iterator, query.end());
+    if (!parameters || query_iterator != query.end())
+    {
+        const auto position = std::distance(query.begin(), query_iterator);
+        json_result.values["code"] = "InvalidQuery";
+        json_result.values["message"] =
+            "Query string malformed close to position " + std::to_string(prefix_length + position);
+        return engine::Status::Error;
+    }
+    BOOST_ASSERT(parameters);
+
+    if (!parameters->IsValid())
+    {
+        json_result.values["code"] = "InvalidOptions";
+        json_result.values["message"] = getWrongOptionHelp(*parameters);
+        return engine::Status::Error;
+    }
+    BOOST_ASSERT(parameters->IsValid());
+
+    if (parameters->format)
+    {
+        if (parameters->format == engine::api::BaseParameters::OutputFormatType::FLATBUFFERS)
+        {
+            result = flatbuffers::FlatBufferBuilder();
+        }
+    }
+    return BaseService::routing_machine.Isochrone(*parameters, result);
+}
+} // namespace service
+} // namespace server
+} // namespace osrm
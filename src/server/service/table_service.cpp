@@ -66,6 +66,22 @@ std::string getWrongOptionHelp(const engine::api::TableParameters &parameters)
         help = "scale_factor must be > 0";
     }
 
+    if (parameters.max_duration && *parameters.max_duration <= 0)
+    {
+        help = "max_duration must be > 0";
+    }
+
+    if (parameters.max_distance && *parameters.max_distance <= 0)
+    {
+        help = "max_distance must be > 0";
+    }
+
+    if (parameters.fallback_speed != INVALID_FALLBACK_SPEED &&
+        (parameters.max_duration || parameters.max_distance))
+    {
+        help = "fallback_speed can not be combined with max_duration or max_distance";
+    }
+
     return help;
 }
 } // namespace
@@ -1,7 +1,9 @@
 #include "server/service_handler.hpp"
 
+#include "server/service/isochrone_service.hpp"
 #include "server/service/match_service.hpp"
 #include "server/service/nearest_service.hpp"
+#include "server/service/poi_service.hpp"
 #include "server/service/route_service.hpp"
 #include "server/service/table_service.hpp"
 #include "server/service/tile_service.hpp"
@@ -16,11 +18,28 @@ namespace osrm
 {
 namespace server
 {
-ServiceHandler::ServiceHandler(osrm::EngineConfig &config) : routing_machine(config)
+ServiceHandler::ServiceHandler(osrm::EngineConfig &config) { AddDataset("", config); }
+
+ServiceHandler::ServiceHandler(std::unordered_map<std::string, osrm::EngineConfig> &profile_configs)
+{
+    for (auto &profile_config : profile_configs)
+    {
+        AddDataset(profile_config.first, profile_config.second);
+    }
+}
+
+void ServiceHandler::AddDataset(const std::string &profile, osrm::EngineConfig &config)
 {
+    auto &dataset = datasets[profile];
+    dataset.routing_machine = std::make_unique<OSRM>(config);
+    auto &routing_machine = *dataset.routing_machine;
+    auto &service_map = dataset.service_map;
+
     service_map["route"] = std::make_unique<service::RouteService>(routing_machine);
     service_map["table"] = std::make_unique<service::TableService>(routing_machine);
     service_map["nearest"] = std::make_unique<service::NearestService>(routing_machine);
+    service_map["poi"] = std::make_unique<service::POIService>(routing_machine);
+    service_map["isochrone"] = std::make_unique<service::IsochroneService>(routing_machine);
     service_map["trip"] = std::make_unique<service::TripService>(routing_machine);
     service_map["match"] = std::make_unique<service::MatchService>(routing_machine);
     service_map["tile"] = std::make_unique<service::TileService>(routing_machine);
@@ -29,6 +48,21 @@ ServiceHandler::ServiceHandler(osrm::EngineConfig &config) : routing_machine(con
 engine::Status ServiceHandler::RunQuery(api::ParsedURL parsed_url,
                                         osrm::engine::api::ResultT &result)
 {
+    auto dataset_iter = datasets.find(parsed_url.profile);
+    if (dataset_iter == datasets.end())
+    {
+        dataset_iter = datasets.find("");
+    }
+    if (dataset_iter == datasets.end())
+    {
+        result = util::json::Object();
+        auto &json_result = result.get<util::json::Object>();
+        json_result.values["code"] = "InvalidProfile";
+        json_result.values["message"] = "Profile " + parsed_url.profile + " not found!";
+        return engine::Status::Error;
+    }
+    auto &service_map = dataset_iter->second.service_map;
+
     const auto &service_iter = service_map.find(parsed_url.service);
     if (service_iter == service_map.end())
     {
@@ -0,0 +1,512 @@
+#include "storage/block_reader.hpp"
+#include "storage/tar.hpp"
+
+#include "util/block_compression.hpp"
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
+#include "util/integer_range.hpp"
+#include "util/log.hpp"
+
+#include <boost/assert.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace osrm
+{
+namespace storage
+{
+
+namespace
+{
+// large enough for sequential throughput, small enough to spread big entries over all threads
+constexpr std::uint64_t CHUNK_SIZE = 32 * 1024 * 1024;
+
+struct Chunk
+{
+    // of the stored data in the file
+    std::uint64_t offset;
+    std::uint64_t size;
+    char *destination;
+    // index of the tar entry the chunk belongs to
+    std::size_t entry;
+    // chunks of compressed entries consist of whole frames, none for other entries
+    std::uint64_t first_frame;
+    std::uint64_t number_of_frames;
+};
+
+struct CompressedEntry
+{
+    util::CompressedBlockHeader header;
+    std::vector<util::CompressedFrame> frames;
+};
+
+// The entries of a file and the frame tables of the compressed ones
+struct FileEntries
+{
+    std::vector<tar::FileReader::FileEntry> entries;
+    std::vector<CompressedEntry> compressed;
+};
+
+#ifdef __linux__
+// O_DIRECT needs offsets, sizes and buffers aligned to the logical block size of the device
+constexpr std::uint64_t DIRECT_IO_ALIGNMENT = 4096;
+
+class RawReader
+{
+  public:
+    RawReader(const boost::filesystem::path &path, const bool direct_io) : path(path)
+    {
+        if (direct_io)
+        {
+            // not all file systems support O_DIRECT, e.g. tmpfs
+            fd = ::open(path.c_str(), O_RDONLY | O_DIRECT);
+            if (fd >= 0)
+            {
+                void *pointer = nullptr;
+                if (::posix_memalign(
+                        &pointer, DIRECT_IO_ALIGNMENT, CHUNK_SIZE + 2 * DIRECT_IO_ALIGNMENT) != 0)
+                {
+                    ::close(fd);
+                    throw std::bad_alloc();
+                }
+                buffer.reset(static_cast<char *>(pointer));
+            }
+        }
+        if (fd < 0)
+        {
+            fd = ::open(path.c_str(), O_RDONLY);
+        }
+        if (fd < 0)
+        {
+            throw util::exception("Could not open " + path.string() + ": " +
+                                  std::strerror(errno) + SOURCE_REF);
+        }
+        if (!buffer)
+        {
+            // doubles the readahead window of the kernel
+            ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        }
+    }
+
+    ~RawReader() { ::close(fd); }
+
+    RawReader(const RawReader &) = delete;
+    RawReader &operator=(const RawReader &) = delete;
+
+    void Read(const std::uint64_t offset, const std::uint64_t size, char *destination)
+    {
+        if (!buffer)
+        {
+            if (ReadAt(offset, size, destination) != size)
+            {
+                throw util::exception("Unexpected end of " + path.string() + SOURCE_REF);
+            }
+            return;
+        }
+
+        const auto begin = offset / DIRECT_IO_ALIGNMENT * DIRECT_IO_ALIGNMENT;
+        const auto end =
+            (offset + size + DIRECT_IO_ALIGNMENT - 1) / DIRECT_IO_ALIGNMENT * DIRECT_IO_ALIGNMENT;
+        BOOST_ASSERT(end - begin <= CHUNK_SIZE + 2 * DIRECT_IO_ALIGNMENT);
+
+        // the aligned range may end behind the end of the file
+        const auto bytes_read = ReadAt(begin, end - begin, buffer.get());
+        if (bytes_read < offset + size - begin)
+        {
+            throw util::exception("Unexpected end of " + path.string() + SOURCE_REF);
+        }
+        std::memcpy(destination, buffer.get() + (offset - begin), size);
+    }
+
+  private:
+    std::uint64_t ReadAt(const std::uint64_t offset, const std::uint64_t size, char *destination)
+    {
+        std::uint64_t bytes_read = 0;
+        while (bytes_read < size)
+        {
+            const auto result =
+                ::pread(fd, destination + bytes_read, size - bytes_read, offset + bytes_read);
+            if (result < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (result < 0)
+            {
+                throw util::exception("Could not read " + path.string() + ": " +
+                                      std::strerror(errno) + SOURCE_REF);
+            }
+            if (result == 0)
+            {
+                break;
+            }
+            bytes_read += result;
+        }
+        return bytes_read;
+    }
+
+    struct FreeDeleter
+    {
+        void operator()(char *pointer) const { std::free(pointer); }
+    };
+
+    const boost::filesystem::path path;
+    int fd = -1;
+    std::unique_ptr<char, FreeDeleter> buffer;
+};
+#else
+class RawReader
+{
+  public:
+    RawReader(const boost::filesystem::path &path, const bool /*direct_io*/)
+        : path(path), stream(path, std::ios::binary)
+    {
+        if (!stream)
+        {
+            throw util::exception("Could not open " + path.string() + SOURCE_REF);
+        }
+    }
+
+    void Read(const std::uint64_t offset, const std::uint64_t size, char *destination)
+    {
+        stream.seekg(offset);
+        stream.read(destination, size);
+        if (static_cast<std::uint64_t>(stream.gcount()) != size)
+        {
+            throw util::exception("Unexpected end of " + path.string() + SOURCE_REF);
+        }
+    }
+
+  private:
+    const boost::filesystem::path path;
+    boost::filesystem::ifstream stream;
+};
+#endif
+
+// Returns the size of the chunk in memory
+std::uint64_t getLoadedSize(const std::vector<CompressedEntry> &compressed, const Chunk &chunk)
+{
+    if (chunk.number_of_frames == 0)
+    {
+        return chunk.size;
+    }
+    const auto &header = compressed[chunk.entry].header;
+    const auto begin = chunk.first_frame * header.frame_size;
+    const auto end = std::min(header.uncompressed_size,
+                              (chunk.first_frame + chunk.number_of_frames) * header.frame_size);
+    return end - begin;
+}
+
+// Reads chunks to their destination, decompressing the frames of compressed entries
+class ChunkReader
+{
+  public:
+    ChunkReader(const boost::filesystem::path &path,
+                const bool direct_io,
+                const std::vector<CompressedEntry> &compressed)
+        : path(path), raw(path, direct_io), compressed(compressed)
+    {
+    }
+
+    void Read(const Chunk &chunk)
+    {
+        if (chunk.number_of_frames == 0)
+        {
+            raw.Read(chunk.offset, chunk.size, chunk.destination);
+        }
+        else
+        {
+            Decompress(chunk, chunk.destination);
+        }
+    }
+
+    // Compares the chunk in the file with the memory at its destination
+    bool Equals(const Chunk &chunk)
+    {
+        if (chunk.number_of_frames == 0)
+        {
+            scratch.resize(chunk.size);
+            raw.Read(chunk.offset, chunk.size, scratch.data());
+        }
+        else
+        {
+            scratch.resize(getLoadedSize(compressed, chunk));
+            Decompress(chunk, scratch.data());
+        }
+        return std::memcmp(scratch.data(), chunk.destination, scratch.size()) == 0;
+    }
+
+  private:
+    void Decompress(const Chunk &chunk, char *destination)
+    {
+        stored.resize(chunk.size);
+        raw.Read(chunk.offset, chunk.size, stored.data());
+
+        const auto &entry = compressed[chunk.entry];
+        const auto chunk_begin = entry.frames[chunk.first_frame].offset;
+        for (const auto frame_index : util::irange<std::uint64_t>(
+                 chunk.first_frame, chunk.first_frame + chunk.number_of_frames))
+        {
+            const auto &frame = entry.frames[frame_index];
+            try
+            {
+                util::decompressFrame(entry.header,
+                                      frame_index,
+                                      frame,
+                                      stored.data() + (frame.offset - chunk_begin),
+                                      destination + (frame_index - chunk.first_frame) *
+                                                        entry.header.frame_size);
+            }
+            catch (const util::exception &error)
+            {
+                throw util::exception(path.string() + ": " + error.what() + SOURCE_REF);
+            }
+        }
+    }
+
+    const boost::filesystem::path path;
+    RawReader raw;
+    const std::vector<CompressedEntry> &compressed;
+    std::vector<char> stored;
+    std::vector<char> scratch;
+};
+} // namespace
+
+BlockReader::BlockReader(const unsigned io_threads, const bool direct_io)
+    : io_threads(std::max(1u, io_threads)), direct_io(direct_io)
+{
+}
+
+namespace
+{
+// Splits the entries of the file that have a block of the same size in the index into chunks
+// pointing into their blocks. Entries without a block or of another size are passed to mismatch.
+template <typename MismatchFn>
+std::vector<Chunk>
+splitIntoChunks(const FileEntries &file, const SharedDataIndex &index, MismatchFn &&mismatch)
+{
+    std::vector<Chunk> chunks;
+    for (const auto entry_index : util::irange<std::size_t>(0, file.entries.size()))
+    {
+        const auto &entry = file.entries[entry_index];
+        if (entry.name.rfind(".meta") != std::string::npos)
+        {
+            continue;
+        }
+        if (!index.HasBlock(entry.name) || index.GetBlockSize(entry.name) != entry.size)
+        {
+            mismatch(entry);
+            continue;
+        }
+
+        auto destination = index.GetBlockPtr<char>(entry.name);
+        if (!entry.compressed)
+        {
+            for (std::uint64_t offset = 0; offset < entry.size; offset += CHUNK_SIZE)
+            {
+                const auto size = std::min<std::uint64_t>(CHUNK_SIZE, entry.size - offset);
+                chunks.push_back(
+                    {entry.offset + offset, size, destination + offset, entry_index, 0, 0});
+            }
+            continue;
+        }
+
+        // as many whole frames as fit into a chunk, the frames are stored in order
+        const auto &compressed = file.compressed[entry_index];
+        const auto &frames = compressed.frames;
+        for (std::uint64_t first_frame = 0; first_frame < frames.size();)
+        {
+            auto end_frame = first_frame + 1;
+            while (end_frame < frames.size() &&
+                   frames[end_frame].offset + frames[end_frame].stored_size -
+                           frames[first_frame].offset <=
+                       CHUNK_SIZE)
+            {
+                ++end_frame;
+            }
+            const auto &last = frames[end_frame - 1];
+            chunks.push_back({entry.offset + frames[first_frame].offset,
+                              last.offset + last.stored_size - frames[first_frame].offset,
+                              destination + first_frame * compressed.header.frame_size,
+                              entry_index,
+                              first_frame,
+                              end_frame - first_frame});
+            first_frame = end_frame;
+        }
+    }
+
+    // the largest chunks first, so no thread is left with a big one at the end
+    std::stable_sort(chunks.begin(), chunks.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.size > rhs.size;
+    });
+    return chunks;
+}
+
+// Calls process(reader, chunk) for all chunks from io_threads threads with a reader each
+template <typename ProcessFn>
+void processChunks(const boost::filesystem::path &path,
+                   const FileEntries &file,
+                   const std::vector<Chunk> &chunks,
+                   const unsigned io_threads,
+                   const bool direct_io,
+                   ProcessFn &&process)
+{
+    std::atomic<std::size_t> next_chunk{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    const auto process_chunks = [&] {
+        try
+        {
+            ChunkReader reader(path, direct_io, file.compressed);
+            for (auto chunk = next_chunk++; chunk < chunks.size(); chunk = next_chunk++)
+            {
+                process(reader, chunks[chunk]);
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+            // let the other threads run out of chunks
+            next_chunk = chunks.size();
+        }
+    };
+
+    const auto number_of_threads =
+        std::min<std::size_t>(io_threads, std::max<std::size_t>(1, chunks.size()));
+    std::vector<std::thread> threads;
+    for (std::size_t thread = 1; thread < number_of_threads; ++thread)
+    {
+        threads.emplace_back(process_chunks);
+    }
+    process_chunks();
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+FileEntries listEntries(const boost::filesystem::path &path)
+{
+    FileEntries file;
+    tar::FileReader reader(path, tar::FileReader::VerifyFingerprint);
+    reader.List(std::back_inserter(file.entries));
+
+    file.compressed.resize(file.entries.size());
+    for (const auto entry_index : util::irange<std::size_t>(0, file.entries.size()))
+    {
+        const auto &entry = file.entries[entry_index];
+        if (entry.compressed)
+        {
+            auto &compressed = file.compressed[entry_index];
+            reader.ReadCompressedBlockHeader(entry.name, compressed.header, compressed.frames);
+        }
+    }
+    return file;
+}
+} // namespace
+
+std::uint64_t BlockReader::Read(const boost::filesystem::path &path,
+                                const SharedDataIndex &index) const
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    const auto file = listEntries(path);
+    const auto chunks = splitIntoChunks(file, index, [&](const tar::FileReader::FileEntry &entry) {
+        if (index.HasBlock(entry.name))
+        {
+            throw util::exception("Block " + entry.name + " has a size of " +
+                                  std::to_string(index.GetBlockSize(entry.name)) + " bytes, but " +
+                                  path.string() + " contains " + std::to_string(entry.size) +
+                                  " bytes" + SOURCE_REF);
+        }
+    });
+
+    processChunks(
+        path, file, chunks, io_threads, direct_io, [](ChunkReader &reader, const Chunk &chunk) {
+            reader.Read(chunk);
+        });
+
+    std::uint64_t total_size = 0;
+    std::uint64_t stored_size = 0;
+    for (const auto &chunk : chunks)
+    {
+        total_size += getLoadedSize(file.compressed, chunk);
+        stored_size += chunk.size;
+    }
+
+    const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+    const auto megabytes = total_size / (1024. * 1024.);
+    util::Log() << "Loaded " << path.string() << ": " << megabytes << " MiB in "
+                << duration.count() << "s (" << megabytes / std::max(duration.count(), 1e-6)
+                << " MiB/s)";
+    if (stored_size != total_size)
+    {
+        util::Log() << "Decompressed " << stored_size / (1024. * 1024.) << " MiB of "
+                    << path.string();
+    }
+
+    return total_size;
+}
+
+std::vector<std::string> BlockReader::FindChangedEntries(const boost::filesystem::path &path,
+                                                         const SharedDataIndex &index) const
+{
+    const auto file = listEntries(path);
+    const auto &entries = file.entries;
+    std::unique_ptr<std::atomic<bool>[]> changed(new std::atomic<bool>[entries.size()]);
+    for (const auto entry_index : util::irange<std::size_t>(0, entries.size()))
+    {
+        changed[entry_index] = false;
+    }
+
+    const auto chunks = splitIntoChunks(file, index, [&](const tar::FileReader::FileEntry &entry) {
+        changed[&entry - entries.data()] = true;
+    });
+
+    processChunks(
+        path, file, chunks, io_threads, direct_io, [&](ChunkReader &reader, const Chunk &chunk) {
+            // one changed chunk is enough to replace the whole block
+            if (!changed[chunk.entry] && !reader.Equals(chunk))
+            {
+                changed[chunk.entry] = true;
+            }
+        });
+
+    std::vector<std::string> changed_entries;
+    for (const auto entry_index : util::irange<std::size_t>(0, entries.size()))
+    {
+        if (changed[entry_index])
+        {
+            changed_entries.push_back(entries[entry_index].name);
+        }
+    }
+    return changed_entries;
+}
+} // namespace storage
+} // namespace osrm
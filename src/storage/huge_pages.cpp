@@ -0,0 +1,187 @@
+#include "storage/huge_pages.hpp"
+
+#include "util/log.hpp"
+
+#ifdef __linux__
+#include <sys/ipc.h>
+#include <sys/mman.h>
+#include <sys/shm.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+namespace osrm
+{
+namespace storage
+{
+
+namespace
+{
+#ifdef __linux__
+// MAP_HUGETLB and SHM_HUGETLB select the size of the pages by its logarithm at this shift
+constexpr int HUGE_PAGE_SIZE_SHIFT = 26;
+
+int getHugePageSizeFlags(const HugePages huge_pages)
+{
+    switch (huge_pages)
+    {
+    case HugePages::Size2MiB:
+        return 21 << HUGE_PAGE_SIZE_SHIFT;
+    case HugePages::Size1GiB:
+        return 30 << HUGE_PAGE_SIZE_SHIFT;
+    default:
+        return 0;
+    }
+}
+
+std::uint64_t roundUp(const std::uint64_t size, const std::uint64_t page_size)
+{
+    return (size + page_size - 1) / page_size * page_size;
+}
+#endif
+
+const char *getName(const HugePages huge_pages)
+{
+    return huge_pages == HugePages::Size1GiB ? "1 GiB" : "2 MiB";
+}
+} // namespace
+
+boost::optional<HugePages> parseHugePages(const std::string &name)
+{
+    if (name == "off")
+        return HugePages::Off;
+    if (name == "transparent")
+        return HugePages::Transparent;
+    if (name == "2M")
+        return HugePages::Size2MiB;
+    if (name == "1G")
+        return HugePages::Size1GiB;
+    return boost::none;
+}
+
+std::uint64_t getHugePageSize(const HugePages huge_pages)
+{
+    switch (huge_pages)
+    {
+    case HugePages::Size2MiB:
+        return std::uint64_t{1} << 21;
+    case HugePages::Size1GiB:
+        return std::uint64_t{1} << 30;
+    default:
+        return 0;
+    }
+}
+
+#ifdef __linux__
+void adviseHugePages(void *address, const std::uint64_t size)
+{
+#ifdef MADV_HUGEPAGE
+    const std::uint64_t page_size = ::sysconf(_SC_PAGESIZE);
+    const auto begin = reinterpret_cast<std::uintptr_t>(address) / page_size * page_size;
+    const auto end = reinterpret_cast<std::uintptr_t>(address) + size;
+    if (size > 0 && ::madvise(reinterpret_cast<void *>(begin), end - begin, MADV_HUGEPAGE) != 0)
+    {
+        // e.g. transparent huge pages are disabled in the kernel
+        util::Log(logDEBUG) << "Could not advise transparent huge pages: "
+                            << std::strerror(errno);
+    }
+#else
+    (void)address;
+    (void)size;
+#endif
+}
+
+bool createHugePageSegment(const int key, const std::uint64_t size, const HugePages huge_pages)
+{
+    const auto page_size = getHugePageSize(huge_pages);
+    if (page_size == 0)
+    {
+        return false;
+    }
+
+    const auto flags =
+        IPC_CREAT | IPC_EXCL | 0644 | SHM_HUGETLB | getHugePageSizeFlags(huge_pages);
+    if (::shmget(key, roundUp(size, page_size), flags) < 0)
+    {
+        // ENOMEM if not enough pages are reserved, EPERM if the user is not in the
+        // vm.hugetlb_shm_group and lacks CAP_IPC_LOCK
+        util::Log(logWARNING) << "Could not allocate shared memory with " << getName(huge_pages)
+                              << " huge pages: " << std::strerror(errno)
+                              << ", falling back to transparent huge pages";
+        return false;
+    }
+    util::Log() << "Backing shared memory with " << getName(huge_pages) << " huge pages";
+    return true;
+}
+
+AnonymousMemory::AnonymousMemory(const std::uint64_t size, const HugePages huge_pages)
+{
+    const auto page_size = getHugePageSize(huge_pages);
+    if (page_size > 0)
+    {
+        mapped_size = roundUp(std::max<std::uint64_t>(size, 1), page_size);
+        // without MAP_NORESERVE the pages are reserved here instead of failing on first access
+        auto result = ::mmap(nullptr,
+                             mapped_size,
+                             PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB |
+                                 getHugePageSizeFlags(huge_pages),
+                             -1,
+                             0);
+        if (result != MAP_FAILED)
+        {
+            util::Log() << "Backing memory with " << getName(huge_pages) << " huge pages";
+            address = static_cast<char *>(result);
+            return;
+        }
+        util::Log(logWARNING) << "Could not allocate memory with " << getName(huge_pages)
+                              << " huge pages: " << std::strerror(errno)
+                              << ", falling back to transparent huge pages";
+    }
+
+    mapped_size = std::max<std::uint64_t>(size, 1);
+    auto result = ::mmap(
+        nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (result == MAP_FAILED)
+    {
+        throw std::bad_alloc();
+    }
+    address = static_cast<char *>(result);
+    if (huge_pages != HugePages::Off)
+    {
+        adviseHugePages(address, mapped_size);
+    }
+}
+
+AnonymousMemory::~AnonymousMemory() { ::munmap(address, mapped_size); }
+#else
+void adviseHugePages(void *, const std::uint64_t) {}
+
+bool createHugePageSegment(const int, const std::uint64_t, const HugePages huge_pages)
+{
+    if (getHugePageSize(huge_pages) > 0)
+    {
+        util::Log(logWARNING) << "Huge pages of " << getName(huge_pages)
+                              << " are not supported on this platform";
+    }
+    return false;
+}
+
+AnonymousMemory::AnonymousMemory(const std::uint64_t size, const HugePages huge_pages)
+    : address(new char[size]()), mapped_size(size)
+{
+    if (getHugePageSize(huge_pages) > 0)
+    {
+        util::Log(logWARNING) << "Huge pages of " << getName(huge_pages)
+                              << " are not supported on this platform";
+    }
+}
+
+AnonymousMemory::~AnonymousMemory() { delete[] address; }
+#endif
+} // namespace storage
+} // namespace osrm
@@ -1,5 +1,6 @@
 #include "storage/storage.hpp"
 
+#include "storage/block_reader.hpp"
 #include "storage/io.hpp"
 #include "storage/shared_datatype.hpp"
 #include "storage/shared_memory.hpp"
@@ -7,16 +8,11 @@
 #include "storage/shared_monitor.hpp"
 #include "storage/view_factory.hpp"
 
-#include "contractor/files.hpp"
-#include "customizer/files.hpp"
-#include "extractor/files.hpp"
-#include "guidance/files.hpp"
-#include "partitioner/files.hpp"
-
 #include "util/exception.hpp"
 #include "util/exception_utils.hpp"
 #include "util/fingerprint.hpp"
 #include "util/log.hpp"
+#include "util/mmap_file.hpp"
 
 #ifdef __linux__
 #include <sys/mman.h>
@@ -35,6 +31,7 @@
 #include <iterator>
 #include <new>
 #include <string>
+#include <unordered_set>
 
 namespace osrm
 {
@@ -43,6 +40,8 @@ namespace storage
 namespace
 {
 using Monitor = SharedMonitor<SharedRegionRegister>;
+using RTreeLeaf = extractor::EdgeBasedNodeSegment;
+using RTree = util::StaticRTree<RTreeLeaf, storage::Ownership::View>;
 
 struct RegionHandle
 {
@@ -52,7 +51,8 @@ struct RegionHandle
 };
 
 RegionHandle setupRegion(SharedRegionRegister &shared_register,
-                         const storage::BaseDataLayout &layout)
+                         const storage::BaseDataLayout &layout,
+                         const HugePages huge_pages)
 {
     // This is safe because we have an exclusive lock for all osrm-datastore processes.
     auto shm_key = shared_register.ReserveKey();
@@ -76,7 +76,7 @@ RegionHandle setupRegion(SharedRegionRegister &shared_register,
     auto regions_size = encoded_static_layout.size() + layout.GetSizeOfLayout();
     util::Log() << "Data layout has a size of " << encoded_static_layout.size() << " bytes";
     util::Log() << "Allocating shared memory of " << regions_size << " bytes";
-    auto memory = makeSharedMemory(shm_key, regions_size);
+    auto memory = makeSharedMemory(shm_key, regions_size, huge_pages);
 
     // Copy memory static_layout to shared memory and populate data
     char *shared_memory_ptr = static_cast<char *>(memory->Ptr());
@@ -86,10 +86,25 @@ RegionHandle setupRegion(SharedRegionRegister &shared_register,
     return RegionHandle{std::move(memory), data_ptr, shm_key};
 }
 
+// Reads the layout at the start of an existing region
+SharedDataIndex::AllocatedRegion readRegion(const SharedMemory &memory)
+{
+    std::unique_ptr<storage::BaseDataLayout> layout =
+        std::make_unique<storage::ContiguousDataLayout>();
+    io::BufferReader reader(reinterpret_cast<char *>(memory.Ptr()), memory.Size());
+    serialization::read(reader, *layout);
+    auto layout_size = reader.GetPosition();
+    return {reinterpret_cast<char *>(memory.Ptr()) + layout_size, std::move(layout)};
+}
+
+// Registers the regions of the handles, replacing regions of the same name. The removed regions
+// are unregistered and only the timestamps of the touched regions change, so clients reload them.
 bool swapData(Monitor &monitor,
               SharedRegionRegister &shared_register,
               const std::map<std::string, RegionHandle> &handles,
-              int max_wait)
+              int max_wait,
+              const std::vector<std::string> &removed_regions,
+              const std::vector<std::string> &touched_regions)
 {
     std::vector<RegionHandle> old_handles;
 
@@ -135,6 +150,25 @@ bool swapData(Monitor &monitor,
                 shared_region.timestamp++;
             }
         }
+
+        for (const auto &name : removed_regions)
+        {
+            auto region_id = shared_register.Find(name);
+            if (region_id != SharedRegionRegister::INVALID_REGION_ID)
+            {
+                auto &shared_region = shared_register.GetRegion(region_id);
+                old_handles.push_back(RegionHandle{
+                    makeSharedMemory(shared_region.shm_key), nullptr, shared_region.shm_key});
+                shared_register.Deregister(region_id);
+            }
+        }
+
+        for (const auto &name : touched_regions)
+        {
+            auto region_id = shared_register.Find(name);
+            BOOST_ASSERT(region_id != SharedRegionRegister::INVALID_REGION_ID);
+            shared_register.GetRegion(region_id).timestamp++;
+        }
     }
 
     util::Log() << "All data loaded. Notify all client about new data in:";
@@ -165,6 +199,152 @@ bool swapData(Monitor &monitor,
 
     return true;
 }
+
+// the graphs and landmarks need to be built from the same edge-based graph as the turns
+void checkConnectivityChecksums(const SharedDataIndex &index, const StorageConfig &config)
+{
+    const auto turns_connectivity_checksum =
+        *index.GetBlockPtr<std::uint32_t>("/common/connectivity_checksum");
+    const auto check_connectivity_checksum = [&](const std::string &block_name,
+                                                 const std::string &extension) {
+        if (!index.HasBlock(block_name))
+        {
+            return;
+        }
+
+        const auto connectivity_checksum = *index.GetBlockPtr<std::uint32_t>(block_name);
+        if (turns_connectivity_checksum != connectivity_checksum)
+        {
+            throw util::exception(
+                "Connectivity checksum " + std::to_string(connectivity_checksum) + " in " +
+                config.GetPath(extension).string() + " does not equal to checksum " +
+                std::to_string(turns_connectivity_checksum) + " in " +
+                config.GetPath(".osrm.edges").string());
+        }
+    };
+    check_connectivity_checksum("/ch/connectivity_checksum", ".osrm.hsgr");
+    check_connectivity_checksum("/mld/connectivity_checksum", ".osrm.mldgr");
+    check_connectivity_checksum("/mld/landmarks/connectivity_checksum", ".osrm.landmarks");
+}
+
+std::string getDeltaRegionName(const std::string &dataset_name)
+{
+    return dataset_name + "/updatable_delta";
+}
+
+// Loads only the blocks of the updatable files that differ from the updatable region into a
+// delta region, whose blocks replace the ones of the updatable region in the clients. XSI
+// segments can only be attached as a whole, so unchanged parts of a changed block can't be
+// shared between both regions. Returns false if the changes can't be expressed as a delta.
+bool updateChangedBlocks(Storage &storage,
+                         const StorageConfig &config,
+                         Monitor &monitor,
+                         SharedRegionRegister &shared_register,
+                         const std::string &dataset_name,
+                         int max_wait)
+{
+    const auto static_region_id = shared_register.Find(dataset_name + "/static");
+    const auto updatable_region_id = shared_register.Find(dataset_name + "/updatable");
+    if (static_region_id == storage::SharedRegionRegister::INVALID_REGION_ID ||
+        updatable_region_id == storage::SharedRegionRegister::INVALID_REGION_ID)
+    {
+        throw util::exception("Cannot update the metric to a dataset that does not exist yet.");
+    }
+    auto static_memory = makeSharedMemory(shared_register.GetRegion(static_region_id).shm_key);
+    auto updatable_memory =
+        makeSharedMemory(shared_register.GetRegion(updatable_region_id).shm_key);
+
+    std::vector<SharedDataIndex::AllocatedRegion> updatable_regions;
+    updatable_regions.push_back(readRegion(*updatable_memory));
+    const SharedDataIndex updatable_index{std::move(updatable_regions)};
+
+    // deltas are always taken against the updatable region, never against the previous delta
+    BlockReader reader{config.io_threads, config.direct_io};
+    auto delta_layout = std::make_unique<ContiguousDataLayout>();
+    std::vector<boost::filesystem::path> changed_files;
+    std::unordered_set<std::string> file_blocks;
+    for (const auto &file : storage.GetUpdatableFiles())
+    {
+        if (!boost::filesystem::exists(file.second))
+        {
+            continue;
+        }
+
+        ContiguousDataLayout file_layout;
+        populateLayoutFromFile(file.second, file_layout);
+        file_layout.List("", std::inserter(file_blocks, file_blocks.end()));
+
+        const auto changed_blocks = reader.FindChangedEntries(file.second, updatable_index);
+        for (const auto &name : changed_blocks)
+        {
+            delta_layout->SetBlock(
+                name, Block{file_layout.GetBlockEntries(name), file_layout.GetBlockSize(name)});
+        }
+        if (!changed_blocks.empty())
+        {
+            changed_files.push_back(file.second);
+        }
+    }
+
+    std::vector<std::string> updatable_blocks;
+    updatable_index.List("", std::back_inserter(updatable_blocks));
+    for (const auto &name : updatable_blocks)
+    {
+        if (file_blocks.count(name) == 0)
+        {
+            util::Log() << "Block " << name << " was removed from the data files";
+            return false;
+        }
+    }
+
+    // a large delta saves little and doubles the memory of the replaced blocks
+    const auto delta_size = delta_layout->GetSizeOfLayout();
+    util::Log() << "Changed blocks have a size of " << delta_size << " of "
+                << updatable_memory->Size() << " bytes";
+    if (delta_size > updatable_memory->Size() / 2)
+    {
+        return false;
+    }
+
+    std::vector<SharedDataIndex::AllocatedRegion> regions;
+    regions.push_back(readRegion(*static_memory));
+    regions.push_back(readRegion(*updatable_memory));
+
+    std::map<std::string, RegionHandle> handles;
+    std::vector<std::string> removed_regions;
+    if (changed_files.empty())
+    {
+        removed_regions.push_back(getDeltaRegionName(dataset_name));
+    }
+    else
+    {
+        auto delta_handle = setupRegion(shared_register, *delta_layout, config.huge_pages);
+
+        // the other regions are mapped read-only, so only the delta can be written
+        std::vector<SharedDataIndex::AllocatedRegion> delta_regions;
+        delta_regions.push_back(
+            {delta_handle.data_ptr, std::make_unique<ContiguousDataLayout>(*delta_layout)});
+        const SharedDataIndex delta_index{std::move(delta_regions)};
+        for (const auto &file : changed_files)
+        {
+            reader.Read(file, delta_index);
+        }
+
+        regions.push_back({delta_handle.data_ptr, std::move(delta_layout)});
+        handles[getDeltaRegionName(dataset_name)] = std::move(delta_handle);
+    }
+
+    checkConnectivityChecksums(SharedDataIndex{std::move(regions)}, config);
+
+    swapData(monitor,
+             shared_register,
+             handles,
+             max_wait,
+             removed_regions,
+             {dataset_name + "/updatable"});
+
+    return true;
+}
 } // namespace
 
 void populateLayoutFromFile(const boost::filesystem::path &path, storage::BaseDataLayout &layout)
@@ -187,7 +367,10 @@ void populateLayoutFromFile(const boost::filesystem::path &path, storage::BaseDa
 
 Storage::Storage(StorageConfig config_) : config(std::move(config_)) {}
 
-int Storage::Run(int max_wait, const std::string &dataset_name, bool only_metric)
+int Storage::Run(int max_wait,
+                 const std::string &dataset_name,
+                 bool only_metric,
+                 bool only_changed_blocks)
 {
     BOOST_ASSERT_MSG(config.IsValid(), "Invalid storage config");
 
@@ -234,6 +417,16 @@ int Storage::Run(int max_wait, const std::string &dataset_name, bool only_metric
     // data when loading it
     std::vector<RegionHandle> readonly_handles;
 
+    if (only_changed_blocks)
+    {
+        if (updateChangedBlocks(*this, config, monitor, shared_register, dataset_name, max_wait))
+        {
+            return EXIT_SUCCESS;
+        }
+        util::Log() << "Falling back to loading the full metric";
+        only_metric = true;
+    }
+
     if (only_metric)
     {
         auto region_id = shared_register.Find(dataset_name + "/static");
@@ -244,15 +437,10 @@ int Storage::Run(int max_wait, const std::string &dataset_name, bool only_metric
         auto static_region = shared_register.GetRegion(region_id);
         auto static_memory = makeSharedMemory(static_region.shm_key);
 
-        std::unique_ptr<storage::BaseDataLayout> static_layout =
-            std::make_unique<storage::ContiguousDataLayout>();
-        io::BufferReader reader(reinterpret_cast<char *>(static_memory->Ptr()),
-                                static_memory->Size());
-        serialization::read(reader, *static_layout);
-        auto layout_size = reader.GetPosition();
-        auto *data_ptr = reinterpret_cast<char *>(static_memory->Ptr()) + layout_size;
+        auto static_allocated_region = readRegion(*static_memory);
+        auto *data_ptr = static_cast<char *>(static_allocated_region.memory_ptr);
 
-        regions.push_back({data_ptr, std::move(static_layout)});
+        regions.push_back(std::move(static_allocated_region));
         readonly_handles.push_back({std::move(static_memory), data_ptr, static_region.shm_key});
     }
     else
@@ -262,7 +450,7 @@ int Storage::Run(int max_wait, const std::string &dataset_name, bool only_metric
         Storage::PopulateLayoutWithRTree(*static_layout);
         std::vector<std::pair<bool, boost::filesystem::path>> files = Storage::GetStaticFiles();
         Storage::PopulateLayout(*static_layout, files);
-        auto static_handle = setupRegion(shared_register, *static_layout);
+        auto static_handle = setupRegion(shared_register, *static_layout, config.huge_pages);
         regions.push_back({static_handle.data_ptr, std::move(static_layout)});
         handles[dataset_name + "/static"] = std::move(static_handle);
     }
@@ -271,7 +459,7 @@ int Storage::Run(int max_wait, const std::string &dataset_name, bool only_metric
         std::make_unique<storage::ContiguousDataLayout>();
     std::vector<std::pair<bool, boost::filesystem::path>> files = Storage::GetUpdatableFiles();
     Storage::PopulateLayout(*updatable_layout, files);
-    auto updatable_handle = setupRegion(shared_register, *updatable_layout);
+    auto updatable_handle = setupRegion(shared_register, *updatable_layout, config.huge_pages);
     regions.push_back({updatable_handle.data_ptr, std::move(updatable_layout)});
     handles[dataset_name + "/updatable"] = std::move(updatable_handle);
 
@@ -283,7 +471,9 @@ int Storage::Run(int max_wait, const std::string &dataset_name, bool only_metric
     }
     PopulateUpdatableData(index);
 
-    swapData(monitor, shared_register, handles, max_wait);
+    // a full update of the updatable region also replaces its delta
+    swapData(
+        monitor, shared_register, handles, max_wait, {getDeltaRegionName(dataset_name)}, {});
 
     return EXIT_SUCCESS;
 }
@@ -327,6 +517,7 @@ std::vector<std::pair<bool, boost::filesystem::path>> Storage::GetUpdatableFiles
     std::vector<std::pair<bool, boost::filesystem::path>> files = {
         {OPTIONAL, config.GetPath(".osrm.mldgr")},
         {OPTIONAL, config.GetPath(".osrm.cell_metrics")},
+        {OPTIONAL, config.GetPath(".osrm.landmarks")},
         {OPTIONAL, config.GetPath(".osrm.hsgr")},
         {REQUIRED, config.GetPath(".osrm.datasource_names")},
         {REQUIRED, config.GetPath(".osrm.geometry")},
@@ -357,6 +548,34 @@ std::string Storage::PopulateLayoutWithRTree(storage::BaseDataLayout &layout)
     // The important bit here is that the "offset" is set to zero
     layout.SetBlock("/common/rtree/file_index_path", make_block<char>(rtree_filename.length() + 1));
 
+    switch (config.rtree_leaf_storage)
+    {
+    case RTreeLeafStorage::MMap:
+        break;
+    case RTreeLeafStorage::Memory:
+    {
+        const auto number_of_objects =
+            boost::filesystem::file_size(absolute_file_index_path) / sizeof(RTreeLeaf);
+        layout.SetBlock("/common/rtree/leaves", make_block<RTreeLeaf>(number_of_objects));
+        break;
+    }
+    case RTreeLeafStorage::Compressed:
+    {
+        boost::iostreams::mapped_file_source objects_region;
+        const auto objects = util::mmapFile<RTreeLeaf>(absolute_file_index_path, objects_region);
+        std::vector<std::uint64_t> page_offsets;
+        const auto size = RTree::GetCompressedLeafOffsets(objects, page_offsets);
+        layout.SetBlock("/common/rtree/compressed_leaves/page_offsets",
+                        make_block<std::uint64_t>(page_offsets.size()));
+        layout.SetBlock("/common/rtree/compressed_leaves/pages", make_block<std::uint8_t>(size));
+        layout.SetBlock("/common/rtree/compressed_leaves/number_of_objects",
+                        make_block<std::uint64_t>(1));
+        util::Log() << "Compressed R-tree leaves from " << objects.size() * sizeof(RTreeLeaf)
+                    << " to " << size << " bytes";
+        break;
+    }
+    }
+
     return rtree_filename;
 }
 
@@ -396,196 +615,59 @@ void Storage::PopulateStaticData(const SharedDataIndex &index)
             absolute_file_index_path.begin(), absolute_file_index_path.end(), file_index_path_ptr);
     }
 
-    // Name data
-    {
-        auto name_table = make_name_table_view(index, "/common/names");
-        extractor::files::readNames(config.GetPath(".osrm.names"), name_table);
-    }
-
-    // Timestamp mark
-    {
-        auto timestamp_ref = make_timestamp_view(index, "/common/timestamp");
-        std::string ts;
-        extractor::files::readTimestamp(config.GetPath(".osrm.timestamp"), ts);
-        if (!ts.empty())
-        {
-            memcpy(const_cast<char *>(timestamp_ref.data()), ts.data(), ts.size());
-        }
-    }
-
-    // Turn lane data
+    // load the leaves of the RTree if they are kept in memory
+    if (index.HasBlock("/common/rtree/leaves"))
     {
-        auto turn_lane_data = make_lane_data_view(index, "/common/turn_lanes");
-        extractor::files::readTurnLaneData(config.GetPath(".osrm.tld"), turn_lane_data);
+        boost::iostreams::mapped_file_source objects_region;
+        const auto objects =
+            util::mmapFile<RTreeLeaf>(config.GetPath(".osrm.fileIndex"), objects_region);
+        auto leaves = make_vector_view<RTreeLeaf>(index, "/common/rtree/leaves");
+        BOOST_ASSERT(leaves.size() == objects.size());
+        std::copy(objects.begin(), objects.end(), leaves.begin());
     }
-
-    // Turn lane descriptions
+    if (index.HasBlock("/common/rtree/compressed_leaves/pages"))
     {
-        auto views = make_turn_lane_description_views(index, "/common/turn_lanes");
-        extractor::files::readTurnLaneDescriptions(
-            config.GetPath(".osrm.tls"), std::get<0>(views), std::get<1>(views));
-    }
+        boost::iostreams::mapped_file_source objects_region;
+        const auto objects =
+            util::mmapFile<RTreeLeaf>(config.GetPath(".osrm.fileIndex"), objects_region);
+        std::vector<std::uint64_t> page_offsets;
+        RTree::GetCompressedLeafOffsets(objects, page_offsets);
+        BOOST_ASSERT(page_offsets.back() ==
+                     index.GetBlockSize("/common/rtree/compressed_leaves/pages"));
 
-    // Load edge-based nodes data
-    {
-        auto node_data = make_ebn_data_view(index, "/common/ebg_node_data");
-        extractor::files::readNodeData(config.GetPath(".osrm.ebg_nodes"), node_data);
+        std::copy(page_offsets.begin(),
+                  page_offsets.end(),
+                  index.GetBlockPtr<std::uint64_t>("/common/rtree/compressed_leaves/page_offsets"));
+        *index.GetBlockPtr<std::uint64_t>("/common/rtree/compressed_leaves/number_of_objects") =
+            objects.size();
+        RTree::CompressLeaves(
+            objects,
+            page_offsets,
+            index.GetBlockPtr<std::uint8_t>("/common/rtree/compressed_leaves/pages"));
     }
 
-    // Load original edge data
+    BlockReader reader{config.io_threads, config.direct_io};
+    for (const auto &file : GetStaticFiles())
     {
-        auto turn_data = make_turn_data_view(index, "/common/turn_data");
-
-        auto connectivity_checksum_ptr =
-            index.GetBlockPtr<std::uint32_t>("/common/connectivity_checksum");
-
-        guidance::files::readTurnData(
-            config.GetPath(".osrm.edges"), turn_data, *connectivity_checksum_ptr);
-    }
-
-    // Loading list of coordinates
-    {
-        auto views = make_nbn_data_view(index, "/common/nbn_data");
-        extractor::files::readNodes(
-            config.GetPath(".osrm.nbg_nodes"), std::get<0>(views), std::get<1>(views));
-    }
-
-    // store search tree portion of rtree
-    {
-        auto rtree = make_search_tree_view(index, "/common/rtree");
-        extractor::files::readRamIndex(config.GetPath(".osrm.ramIndex"), rtree);
-    }
-
-    // FIXME we only need to get the weight name
-    std::string metric_name;
-    // load profile properties
-    {
-        const auto profile_properties_ptr =
-            index.GetBlockPtr<extractor::ProfileProperties>("/common/properties");
-        extractor::files::readProfileProperties(config.GetPath(".osrm.properties"),
-                                                *profile_properties_ptr);
-
-        metric_name = profile_properties_ptr->GetWeightName();
-    }
-
-    // Load intersection data
-    {
-        auto intersection_bearings_view =
-            make_intersection_bearings_view(index, "/common/intersection_bearings");
-        auto entry_classes = make_entry_classes_view(index, "/common/entry_classes");
-        extractor::files::readIntersections(
-            config.GetPath(".osrm.icd"), intersection_bearings_view, entry_classes);
-    }
-
-    if (boost::filesystem::exists(config.GetPath(".osrm.partition")))
-    {
-        auto mlp = make_partition_view(index, "/mld/multilevelpartition");
-        partitioner::files::readPartition(config.GetPath(".osrm.partition"), mlp);
-    }
-
-    if (boost::filesystem::exists(config.GetPath(".osrm.cells")))
-    {
-        auto storage = make_cell_storage_view(index, "/mld/cellstorage");
-        partitioner::files::readCells(config.GetPath(".osrm.cells"), storage);
-    }
-
-    // load maneuver overrides
-    {
-        auto views = make_maneuver_overrides_views(index, "/common/maneuver_overrides");
-        extractor::files::readManeuverOverrides(
-            config.GetPath(".osrm.maneuver_overrides"), std::get<0>(views), std::get<1>(views));
+        if (boost::filesystem::exists(file.second))
+        {
+            reader.Read(file.second, index);
+        }
     }
 }
 
 void Storage::PopulateUpdatableData(const SharedDataIndex &index)
 {
-    // load compressed geometry
-    {
-        auto segment_data = make_segment_data_view(index, "/common/segment_data");
-        extractor::files::readSegmentData(config.GetPath(".osrm.geometry"), segment_data);
-    }
-
-    {
-        const auto datasources_names_ptr =
-            index.GetBlockPtr<extractor::Datasources>("/common/data_sources_names");
-        extractor::files::readDatasources(config.GetPath(".osrm.datasource_names"),
-                                          *datasources_names_ptr);
-    }
-
-    // load turn weight penalties
-    {
-        auto turn_duration_penalties = make_turn_weight_view(index, "/common/turn_penalty");
-        extractor::files::readTurnWeightPenalty(config.GetPath(".osrm.turn_weight_penalties"),
-                                                turn_duration_penalties);
-    }
-
-    // load turn duration penalties
-    {
-        auto turn_duration_penalties = make_turn_duration_view(index, "/common/turn_penalty");
-        extractor::files::readTurnDurationPenalty(config.GetPath(".osrm.turn_duration_penalties"),
-                                                  turn_duration_penalties);
-    }
-
-    // FIXME we only need to get the weight name
-    std::string metric_name;
-    // load profile properties
-    {
-        extractor::ProfileProperties properties;
-        extractor::files::readProfileProperties(config.GetPath(".osrm.properties"), properties);
-
-        metric_name = properties.GetWeightName();
-    }
-
-    if (boost::filesystem::exists(config.GetPath(".osrm.hsgr")))
+    BlockReader reader{config.io_threads, config.direct_io};
+    for (const auto &file : GetUpdatableFiles())
     {
-        const std::string metric_prefix = "/ch/metrics/" + metric_name;
-        auto contracted_metric = make_contracted_metric_view(index, metric_prefix);
-        std::unordered_map<std::string, contractor::ContractedMetricView> metrics = {
-            {metric_name, std::move(contracted_metric)}};
-
-        std::uint32_t graph_connectivity_checksum = 0;
-        contractor::files::readGraph(
-            config.GetPath(".osrm.hsgr"), metrics, graph_connectivity_checksum);
-
-        auto turns_connectivity_checksum =
-            *index.GetBlockPtr<std::uint32_t>("/common/connectivity_checksum");
-        if (turns_connectivity_checksum != graph_connectivity_checksum)
+        if (boost::filesystem::exists(file.second))
         {
-            throw util::exception(
-                "Connectivity checksum " + std::to_string(graph_connectivity_checksum) + " in " +
-                config.GetPath(".osrm.hsgr").string() + " does not equal to checksum " +
-                std::to_string(turns_connectivity_checksum) + " in " +
-                config.GetPath(".osrm.edges").string());
+            reader.Read(file.second, index);
         }
     }
 
-    if (boost::filesystem::exists(config.GetPath(".osrm.cell_metrics")))
-    {
-        auto exclude_metrics = make_cell_metric_view(index, "/mld/metrics/" + metric_name);
-        std::unordered_map<std::string, std::vector<customizer::CellMetricView>> metrics = {
-            {metric_name, std::move(exclude_metrics)},
-        };
-        customizer::files::readCellMetrics(config.GetPath(".osrm.cell_metrics"), metrics);
-    }
-
-    if (boost::filesystem::exists(config.GetPath(".osrm.mldgr")))
-    {
-        auto graph_view = make_multi_level_graph_view(index, "/mld/multilevelgraph");
-        std::uint32_t graph_connectivity_checksum = 0;
-        customizer::files::readGraph(
-            config.GetPath(".osrm.mldgr"), graph_view, graph_connectivity_checksum);
-
-        auto turns_connectivity_checksum =
-            *index.GetBlockPtr<std::uint32_t>("/common/connectivity_checksum");
-        if (turns_connectivity_checksum != graph_connectivity_checksum)
-        {
-            throw util::exception(
-                "Connectivity checksum " + std::to_string(graph_connectivity_checksum) + " in " +
-                config.GetPath(".osrm.hsgr").string() + " does not equal to checksum " +
-                std::to_string(turns_connectivity_checksum) + " in " +
-                config.GetPath(".osrm.edges").string());
-        }
-    }
+    checkConnectivityChecksums(index, config);
 }
 } // namespace storage
 } // namespace osrm
@@ -0,0 +1,186 @@
+#include "storage/warmup.hpp"
+
+#include "util/log.hpp"
+#include "util/timing_util.hpp"
+
+#include <boost/algorithm/string/split.hpp>
+#include <boost/assert.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+
+namespace osrm
+{
+namespace storage
+{
+
+namespace
+{
+struct GroupInfo
+{
+    WarmupGroup group;
+    const char *name;
+    std::vector<std::string> prefixes;
+};
+
+const std::vector<GroupInfo> &getGroups()
+{
+    static const std::vector<GroupInfo> groups = {
+        {WarmupGroup::RTree,
+         "rtree",
+         {"/common/rtree/search_tree", "/common/rtree/leaves", "/common/rtree/compressed_leaves"}},
+        {WarmupGroup::Cells, "cells", {"/mld/multilevelpartition", "/mld/cellstorage"}},
+        {WarmupGroup::Graph,
+         "graph",
+         {"/ch/metrics", "/mld/multilevelgraph", "/mld/metrics", "/common/ebg_node_data"}},
+        {WarmupGroup::Geometry, "geometry", {"/common/segment_data", "/common/nbn_data"}},
+        {WarmupGroup::Names, "names", {"/common/names"}}};
+    return groups;
+}
+
+const GroupInfo &getGroup(const WarmupGroup group)
+{
+    for (const auto &info : getGroups())
+    {
+        if (info.group == group)
+        {
+            return info;
+        }
+    }
+    BOOST_ASSERT_MSG(false, "unknown warmup group");
+    return getGroups().front();
+}
+
+std::uint64_t getPageSize()
+{
+#ifndef _WIN32
+    return ::sysconf(_SC_PAGESIZE);
+#else
+    return 4096;
+#endif
+}
+
+// Reads one byte of every page, so the kernel maps all of them into the process
+void touchPages(const char *begin, const std::uint64_t size)
+{
+    const auto page_size = getPageSize();
+    const auto number_of_pages = (size + page_size - 1) / page_size;
+    // the sum keeps the compiler from dropping the reads
+    std::atomic<std::uint8_t> sink{0};
+    tbb::parallel_for(tbb::blocked_range<std::uint64_t>(0, number_of_pages, 256),
+                      [&](const tbb::blocked_range<std::uint64_t> &range) {
+                          std::uint8_t sum = 0;
+                          for (auto page = range.begin(); page != range.end(); ++page)
+                          {
+                              sum += static_cast<std::uint8_t>(begin[page * page_size]);
+                          }
+                          sink += sum;
+                      });
+}
+
+void adviseWillNeed(const char *begin, const std::uint64_t size)
+{
+#ifndef _WIN32
+    const auto page_size = getPageSize();
+    const auto aligned_begin = reinterpret_cast<std::uintptr_t>(begin) / page_size * page_size;
+    const auto end = reinterpret_cast<std::uintptr_t>(begin) + size;
+    // starts the readahead of file backed mappings, which the touching then waits for
+    ::madvise(reinterpret_cast<void *>(aligned_begin), end - aligned_begin, MADV_WILLNEED);
+#else
+    (void)begin;
+    (void)size;
+#endif
+}
+} // namespace
+
+boost::optional<std::vector<WarmupGroup>> parseWarmupOrder(const std::string &order)
+{
+    std::vector<WarmupGroup> groups;
+    if (order.empty())
+    {
+        return groups;
+    }
+
+    std::vector<std::string> names;
+    boost::algorithm::split(names, order, [](const char c) { return c == ','; });
+    for (const auto &name : names)
+    {
+        const auto info = std::find_if(getGroups().begin(),
+                                       getGroups().end(),
+                                       [&](const GroupInfo &info) { return name == info.name; });
+        if (info == getGroups().end())
+        {
+            return boost::none;
+        }
+        groups.push_back(info->group);
+    }
+    return groups;
+}
+
+PageFaults getPageFaults()
+{
+#ifndef _WIN32
+    ::rusage usage;
+    if (::getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+        return {static_cast<std::uint64_t>(usage.ru_minflt),
+                static_cast<std::uint64_t>(usage.ru_majflt)};
+    }
+#endif
+    return {0, 0};
+}
+
+void warmupBlocks(const SharedDataIndex &index, const std::vector<WarmupGroup> &order)
+{
+    for (const auto group : order)
+    {
+        const auto &info = getGroup(group);
+
+        std::vector<std::string> blocks;
+        for (const auto &prefix : info.prefixes)
+        {
+            index.List(prefix, std::back_inserter(blocks));
+        }
+
+        const auto faults_before = getPageFaults();
+        TIMER_START(warmup);
+
+        std::uint64_t total_size = 0;
+        for (const auto &name : blocks)
+        {
+            const auto size = index.GetBlockSize(name);
+            if (size > 0)
+            {
+                adviseWillNeed(index.GetBlockPtr<char>(name), size);
+            }
+        }
+        for (const auto &name : blocks)
+        {
+            const auto size = index.GetBlockSize(name);
+            if (size > 0)
+            {
+                touchPages(index.GetBlockPtr<char>(name), size);
+                total_size += size;
+            }
+        }
+
+        TIMER_STOP(warmup);
+        const auto faults_after = getPageFaults();
+        util::Log() << "Warmed up " << info.name << ": " << total_size / (1024. * 1024.)
+                    << " MiB in " << TIMER_SEC(warmup) << "s with "
+                    << faults_after.major - faults_before.major << " major and "
+                    << faults_after.minor - faults_before.minor << " minor page faults";
+    }
+}
+} // namespace storage
+} // namespace osrm
@@ -0,0 +1,224 @@
+#include "storage/storage.hpp"
+#include "storage/storage_config.hpp"
+#include "storage/tar.hpp"
+
+#include "util/log.hpp"
+#include "util/meminfo.hpp"
+#include "util/timing_util.hpp"
+#include "util/version.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <cstdlib>
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace osrm;
+
+namespace
+{
+enum class return_code : unsigned
+{
+    ok,
+    fail,
+    exit
+};
+
+return_code parseArguments(int argc,
+                           char *argv[],
+                           std::string &verbosity,
+                           boost::filesystem::path &base_path,
+                           bool &decompress)
+{
+    using boost::program_options::value;
+
+    // declare a group of options that will be allowed only on command line
+    boost::program_options::options_description generic_options("Options");
+    generic_options.add_options() //
+        ("version,v", "Show version")("help,h", "Show this help message")(
+            "verbosity,l",
+            value<std::string>(&verbosity)->default_value("INFO"),
+            std::string("Log verbosity level: " + util::LogPolicy::GetLevels()).c_str());
+
+    // declare a group of options that will be allowed on command line
+    boost::program_options::options_description config_options("Configuration");
+    config_options.add_options() //
+        ("decompress,d",
+         value<bool>(&decompress)->implicit_value(true)->default_value(false),
+         "Store the entries of the data files uncompressed again");
+
+    // hidden options, will be allowed on command line, but will not be
+    // shown to the user
+    boost::program_options::options_description hidden_options("Hidden options");
+    hidden_options.add_options()("base,b",
+                                 value<boost::filesystem::path>(&base_path)->required(),
+                                 "base path to .osrm file");
+
+    // positional option
+    boost::program_options::positional_options_description positional_options;
+    positional_options.add("base", 1);
+
+    // combine above options for parsing
+    boost::program_options::options_description cmdline_options;
+    cmdline_options.add(generic_options).add(config_options).add(hidden_options);
+
+    const auto *executable = argv[0];
+    boost::program_options::options_description visible_options(
+        boost::filesystem::path(executable).filename().string() + " <base.osrm> [options]");
+    visible_options.add(generic_options).add(config_options);
+
+    // parse command line options
+    boost::program_options::variables_map option_variables;
+    try
+    {
+        boost::program_options::store(boost::program_options::command_line_parser(argc, argv)
+                                          .options(cmdline_options)
+                                          .positional(positional_options)
+                                          .run(),
+                                      option_variables);
+    }
+    catch (const boost::program_options::error &e)
+    {
+        util::Log(logERROR) << e.what();
+        return return_code::fail;
+    }
+
+    if (option_variables.count("version"))
+    {
+        std::cout << OSRM_VERSION << std::endl;
+        return return_code::exit;
+    }
+
+    if (option_variables.count("help"))
+    {
+        std::cout << visible_options;
+        return return_code::exit;
+    }
+
+    try
+    {
+        boost::program_options::notify(option_variables);
+    }
+    catch (const boost::program_options::error &e)
+    {
+        util::Log(logERROR) << e.what();
+        return return_code::fail;
+    }
+
+    return return_code::ok;
+}
+
+// Rewrites all entries of the file with or without compression. The file is replaced once it
+// was written completely, so a failure leaves the original file.
+void rewriteFile(const boost::filesystem::path &path, const bool decompress)
+{
+    std::vector<storage::tar::FileReader::FileEntry> entries;
+    storage::tar::FileReader reader(path, storage::tar::FileReader::VerifyFingerprint);
+    reader.List(std::back_inserter(entries));
+
+    const auto is_compressed = std::any_of(
+        entries.begin(), entries.end(), [](const auto &entry) { return entry.compressed; });
+    if (is_compressed != decompress)
+    {
+        util::Log() << path.string() << " is already " << (decompress ? "un" : "")
+                    << "compressed";
+        return;
+    }
+
+    auto tmp_path = path;
+    tmp_path += ".tmp";
+    {
+        // copies the fingerprint of the file like any other entry
+        storage::tar::FileWriter writer(tmp_path,
+                                        storage::tar::FileWriter::HasNoFingerprint,
+                                        decompress
+                                            ? storage::tar::FileWriter::NoCompression
+                                            : storage::tar::FileWriter::CompressEntries);
+        std::vector<char> data;
+        for (const auto &entry : entries)
+        {
+            data.resize(entry.size);
+            reader.ReadInto(entry.name, data.data(), data.size());
+            writer.WriteFrom(entry.name, data.data(), data.size());
+        }
+    }
+
+    const auto old_size = boost::filesystem::file_size(path);
+    const auto new_size = boost::filesystem::file_size(tmp_path);
+    boost::filesystem::rename(tmp_path, path);
+    util::Log() << path.string() << ": " << old_size / (1024. * 1024.) << " MiB -> "
+                << new_size / (1024. * 1024.) << " MiB";
+}
+} // namespace
+
+int main(int argc, char *argv[])
+try
+{
+    util::LogPolicy::GetInstance().Unmute();
+
+    std::string verbosity;
+    boost::filesystem::path base_path;
+    bool decompress = false;
+    const auto result = parseArguments(argc, argv, verbosity, base_path, decompress);
+
+    if (return_code::fail == result)
+    {
+        return EXIT_FAILURE;
+    }
+
+    if (return_code::exit == result)
+    {
+        return EXIT_SUCCESS;
+    }
+
+    util::LogPolicy::GetInstance().SetLevel(verbosity);
+
+    storage::StorageConfig config(base_path);
+    if (!config.IsValid())
+    {
+        util::Log(logERROR) << "Required files are missing, cannot continue";
+        return EXIT_FAILURE;
+    }
+
+    // only the files that osrm-datastore loads, files that are mapped by other tools like the
+    // turn penalty index of the updater stay uncompressed
+    storage::Storage storage(config);
+    auto files = storage.GetStaticFiles();
+    const auto updatable_files = storage.GetUpdatableFiles();
+    files.insert(files.end(), updatable_files.begin(), updatable_files.end());
+
+    TIMER_START(compress);
+    for (const auto &file : files)
+    {
+        if (boost::filesystem::exists(file.second))
+        {
+            rewriteFile(file.second, decompress);
+        }
+    }
+    TIMER_STOP(compress);
+
+    util::Log() << (decompress ? "Decompressed" : "Compressed") << " the data files in "
+                << TIMER_SEC(compress) << " seconds";
+    util::DumpMemoryStats();
+
+    return EXIT_SUCCESS;
+}
+catch (const std::bad_alloc &e)
+{
+    util::DumpMemoryStats();
+    util::Log(logERROR) << "[exception] " << e.what();
+    util::Log(logERROR) << "Please provide more memory or consider using a larger swapfile";
+    return EXIT_FAILURE;
+}
+catch (const std::exception &e)
+{
+    util::Log(logERROR) << "[exception] " << e.what();
+    return EXIT_FAILURE;
+}
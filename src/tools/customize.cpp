@@ -40,6 +40,11 @@ return_code parseArguments(int argc,
          boost::program_options::value<unsigned int>(&customization_config.requested_num_threads)
              ->default_value(std::thread::hardware_concurrency()),
          "Number of threads to use")(
+            "landmarks",
+            boost::program_options::value<unsigned int>(&customization_config.num_landmarks)
+                ->default_value(0),
+            "Number of landmarks used to speed up long queries, 0 disables them. "
+            "Each landmark needs 8 bytes of memory per edge-based node")(
             "segment-speed-file",
             boost::program_options::value<std::vector<std::string>>(
                 &customization_config.updater_config.segment_speed_lookup_paths)
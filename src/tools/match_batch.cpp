@@ -0,0 +1,417 @@
+#include "engine/map_matching/trace_batch.hpp"
+
+#include "util/exception_utils.hpp"
+#include "util/log.hpp"
+#include "util/meminfo.hpp"
+#include "util/timing_util.hpp"
+#include "util/version.hpp"
+
+#include "osrm/engine_config.hpp"
+#include "osrm/exception.hpp"
+#include "osrm/json_container.hpp"
+#include "osrm/match_parameters.hpp"
+#include "osrm/osrm.hpp"
+#include "osrm/status.hpp"
+#include "osrm/storage_config.hpp"
+
+#include <boost/algorithm/string/case_conv.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <tbb/global_control.h>
+#include <tbb/parallel_for.h>
+
+#include <cstdlib>
+
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace osrm;
+
+namespace osrm
+{
+namespace engine
+{
+std::istream &operator>>(std::istream &in, EngineConfig::Algorithm &algorithm)
+{
+    std::string token;
+    in >> token;
+    boost::to_lower(token);
+
+    if (token == "ch" || token == "corech")
+        algorithm = EngineConfig::Algorithm::CH;
+    else if (token == "mld")
+        algorithm = EngineConfig::Algorithm::MLD;
+    else
+        throw util::RuntimeError(token, ErrorCode::UnknownAlgorithm, SOURCE_REF);
+    return in;
+}
+} // namespace engine
+} // namespace osrm
+
+namespace
+{
+enum class return_code : unsigned
+{
+    ok,
+    fail,
+    exit
+};
+
+enum class InputFormat
+{
+    CSV,
+    Binary
+};
+
+struct BatchConfig
+{
+    boost::filesystem::path base_path;
+    boost::filesystem::path input_path;
+    boost::filesystem::path output_path;
+    std::string input_format;
+    unsigned requested_num_threads;
+    std::size_t batch_size;
+    double gps_precision;
+    bool split_gaps;
+};
+
+return_code parseArguments(int argc,
+                           char *argv[],
+                           std::string &verbosity,
+                           EngineConfig &config,
+                           BatchConfig &batch_config)
+{
+    using boost::program_options::value;
+
+    // declare a group of options that will be allowed only on command line
+    boost::program_options::options_description generic_options("Options");
+    generic_options.add_options() //
+        ("version,v", "Show version")("help,h", "Show this help message")(
+            "verbosity,l",
+            value<std::string>(&verbosity)->default_value("INFO"),
+            std::string("Log verbosity level: " + util::LogPolicy::GetLevels()).c_str());
+
+    // declare a group of options that will be allowed on command line
+    boost::program_options::options_description config_options("Configuration");
+    config_options.add_options() //
+        ("traces",
+         value<boost::filesystem::path>(&batch_config.input_path)->required(),
+         "Traces to match, `-` reads them from stdin") //
+        ("output,o",
+         value<boost::filesystem::path>(&batch_config.output_path)->required(),
+         "Output file for the matched segments") //
+        ("format",
+         value<std::string>(&batch_config.input_format)->default_value(""),
+         "Format of the traces: csv or binary, guessed from the file extension by default") //
+        ("threads,t",
+         value<unsigned int>(&batch_config.requested_num_threads)
+             ->default_value(std::thread::hardware_concurrency()),
+         "Number of threads to use") //
+        ("batch-size",
+         value<std::size_t>(&batch_config.batch_size)->default_value(10000),
+         "Number of traces read and matched at once") //
+        ("radius",
+         value<double>(&batch_config.gps_precision)->default_value(5.0),
+         "GPS precision in meters used for traces without radiuses") //
+        ("split-gaps",
+         value<bool>(&batch_config.split_gaps)->default_value(true),
+         "Split traces at large timestamp gaps") //
+        ("shared-memory,s",
+         value<bool>(&config.use_shared_memory)->implicit_value(true)->default_value(false),
+         "Load data from shared memory") //
+        ("mmap,m",
+         value<bool>(&config.use_mmap)->implicit_value(true)->default_value(false),
+         "Map datafiles directly, do not use any additional memory.") //
+        ("dataset-name",
+         value<std::string>(&config.dataset_name),
+         "Name of the shared memory dataset to connect to.") //
+        ("algorithm,a",
+         value<EngineConfig::Algorithm>(&config.algorithm)
+             ->default_value(EngineConfig::Algorithm::CH, "CH"),
+         "Algorithm to use for the data. Can be CH, CoreCH, MLD.");
+
+    // hidden options, will be allowed on command line, but will not be
+    // shown to the user
+    boost::program_options::options_description hidden_options("Hidden options");
+    hidden_options.add_options()(
+        "base,b",
+        value<boost::filesystem::path>(&batch_config.base_path),
+        "base path to .osrm file");
+
+    // positional option
+    boost::program_options::positional_options_description positional_options;
+    positional_options.add("base", 1);
+
+    // combine above options for parsing
+    boost::program_options::options_description cmdline_options;
+    cmdline_options.add(generic_options).add(config_options).add(hidden_options);
+
+    const auto *executable = argv[0];
+    boost::program_options::options_description visible_options(
+        boost::filesystem::path(executable).filename().string() +
+        " <base.osrm> --traces <traces> --output <matched.tar> [options]");
+    visible_options.add(generic_options).add(config_options);
+
+    // parse command line options
+    boost::program_options::variables_map option_variables;
+    try
+    {
+        boost::program_options::store(boost::program_options::command_line_parser(argc, argv)
+                                          .options(cmdline_options)
+                                          .positional(positional_options)
+                                          .run(),
+                                      option_variables);
+    }
+    catch (const boost::program_options::error &e)
+    {
+        util::Log(logERROR) << e.what();
+        return return_code::fail;
+    }
+
+    if (option_variables.count("version"))
+    {
+        std::cout << OSRM_VERSION << std::endl;
+        return return_code::exit;
+    }
+
+    if (option_variables.count("help"))
+    {
+        std::cout << visible_options;
+        return return_code::exit;
+    }
+
+    try
+    {
+        boost::program_options::notify(option_variables);
+    }
+    catch (const boost::program_options::error &e)
+    {
+        util::Log(logERROR) << e.what();
+        return return_code::fail;
+    }
+
+    return return_code::ok;
+}
+
+// Collects the segments of the matchings of one trace from the annotations of the response
+engine::map_matching::MatchedTraces toMatchedTrace(const std::uint64_t trace_id,
+                                                   const json::Object &result)
+{
+    engine::map_matching::MatchedTraces matched;
+    matched.trace_ids.push_back(trace_id);
+
+    const auto matchings = result.values.find("matchings");
+    if (matchings != result.values.end())
+    {
+        for (const auto &matching : matchings->second.get<json::Array>().values)
+        {
+            const auto &matching_object = matching.get<json::Object>();
+            matched.confidences.push_back(
+                matching_object.values.at("confidence").get<json::Number>().value);
+
+            for (const auto &leg : matching_object.values.at("legs").get<json::Array>().values)
+            {
+                const auto &annotation =
+                    leg.get<json::Object>().values.at("annotation").get<json::Object>();
+                const auto &nodes = annotation.values.at("nodes").get<json::Array>().values;
+                const auto &durations =
+                    annotation.values.at("duration").get<json::Array>().values;
+                BOOST_ASSERT(nodes.size() == durations.size() + 1);
+
+                for (std::size_t index = 0; index < durations.size(); ++index)
+                {
+                    matched.from_osm_node_ids.push_back(
+                        static_cast<std::uint64_t>(nodes[index].get<json::Number>().value));
+                    matched.to_osm_node_ids.push_back(
+                        static_cast<std::uint64_t>(nodes[index + 1].get<json::Number>().value));
+                    matched.durations.push_back(durations[index].get<json::Number>().value);
+                }
+            }
+            matched.segment_offsets.push_back(matched.from_osm_node_ids.size());
+        }
+    }
+    matched.matching_offsets.push_back(matched.confidences.size());
+
+    return matched;
+}
+} // namespace
+
+int main(int argc, char *argv[])
+try
+{
+    util::LogPolicy::GetInstance().Unmute();
+
+    std::string verbosity;
+    EngineConfig config;
+    BatchConfig batch_config;
+    const auto result = parseArguments(argc, argv, verbosity, config, batch_config);
+
+    if (return_code::fail == result)
+    {
+        return EXIT_FAILURE;
+    }
+
+    if (return_code::exit == result)
+    {
+        return EXIT_SUCCESS;
+    }
+
+    util::LogPolicy::GetInstance().SetLevel(verbosity);
+
+    if (!batch_config.base_path.empty())
+    {
+        config.storage_config = storage::StorageConfig(batch_config.base_path);
+    }
+    if (!config.use_shared_memory && !config.storage_config.IsValid())
+    {
+        util::Log(logERROR) << "Required files are missing, cannot continue";
+        return EXIT_FAILURE;
+    }
+    if (!config.IsValid())
+    {
+        return EXIT_FAILURE;
+    }
+
+    if (1 > batch_config.requested_num_threads)
+    {
+        util::Log(logERROR) << "Number of threads must be 1 or larger";
+        return EXIT_FAILURE;
+    }
+
+    if (1 > batch_config.batch_size)
+    {
+        util::Log(logERROR) << "Batch size must be 1 or larger";
+        return EXIT_FAILURE;
+    }
+
+    InputFormat input_format = batch_config.input_path.extension() == ".csv"
+                                   ? InputFormat::CSV
+                                   : InputFormat::Binary;
+    if (batch_config.input_format == "csv")
+        input_format = InputFormat::CSV;
+    else if (batch_config.input_format == "binary")
+        input_format = InputFormat::Binary;
+    else if (!batch_config.input_format.empty())
+    {
+        util::Log(logERROR) << "Unknown trace format " << batch_config.input_format;
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream input_file;
+    if (batch_config.input_path != "-")
+    {
+        input_file.open(batch_config.input_path.string(), std::ios::binary);
+        if (!input_file)
+        {
+            util::Log(logERROR) << "Could not open " << batch_config.input_path;
+            return EXIT_FAILURE;
+        }
+    }
+    std::istream &input = batch_config.input_path == "-" ? std::cin : input_file;
+
+    engine::map_matching::CSVTraceReader csv_reader{input};
+    engine::map_matching::BinaryTraceReader binary_reader{input};
+    const auto read_traces = [&](std::vector<engine::map_matching::Trace> &traces) {
+        traces.clear();
+        return input_format == InputFormat::CSV
+                   ? csv_reader.Read(batch_config.batch_size, traces)
+                   : binary_reader.Read(batch_config.batch_size, traces);
+    };
+
+    tbb::global_control gc(tbb::global_control::max_allowed_parallelism,
+                           batch_config.requested_num_threads);
+
+    // Each thread gets its own query heaps through the engine's thread local search data
+    const OSRM osrm{config};
+
+    MatchParameters prototype;
+    prototype.steps = false;
+    prototype.overview = RouteParameters::OverviewType::False;
+    prototype.annotations = true;
+    prototype.annotations_type =
+        RouteParameters::AnnotationsType::Nodes | RouteParameters::AnnotationsType::Duration;
+    prototype.gaps = batch_config.split_gaps ? MatchParameters::GapsType::Split
+                                             : MatchParameters::GapsType::Ignore;
+
+    util::Log() << "Matching traces with " << batch_config.requested_num_threads << " threads";
+    TIMER_START(matching);
+
+    // the results of every batch are written out before the next batch is read
+    engine::map_matching::MatchedTracesWriter writer{batch_config.output_path};
+    std::vector<engine::map_matching::Trace> traces;
+    std::vector<engine::map_matching::MatchedTraces> batch_results;
+    std::size_t number_of_unmatched = 0;
+    while (read_traces(traces) > 0)
+    {
+        batch_results.clear();
+        batch_results.resize(traces.size());
+
+        tbb::parallel_for(std::size_t{0}, traces.size(), [&](const std::size_t index) {
+            auto &trace = traces[index];
+
+            MatchParameters parameters = prototype;
+            parameters.coordinates = std::move(trace.coordinates);
+            parameters.timestamps = std::move(trace.timestamps);
+            if (trace.radiuses.empty())
+                parameters.radiuses.resize(parameters.coordinates.size(),
+                                           batch_config.gps_precision);
+            else
+                parameters.radiuses.assign(trace.radiuses.begin(), trace.radiuses.end());
+
+            json::Object result;
+            if (parameters.coordinates.size() > 1 &&
+                osrm.Match(parameters, result) == Status::Ok)
+                batch_results[index] = toMatchedTrace(trace.id, result);
+            else
+                batch_results[index] = toMatchedTrace(trace.id, json::Object{});
+        });
+
+        for (const auto &batch_result : batch_results)
+        {
+            number_of_unmatched += batch_result.confidences.empty();
+            writer.Append(batch_result);
+        }
+        util::Log(logDEBUG) << "Matched " << writer.GetNumberOfTraces() << " traces";
+    }
+
+    TIMER_STOP(matching);
+
+    const auto number_of_traces = writer.GetNumberOfTraces();
+    util::Log() << "Matched " << number_of_traces << " traces (" << number_of_unmatched
+                << " without a matching) in " << TIMER_SEC(matching) << " seconds: "
+                << number_of_traces / std::max(TIMER_SEC(matching), 1e-6) << " traces/s";
+
+    writer.Finish();
+    util::Log() << "Wrote " << writer.GetNumberOfSegments() << " matched segments to "
+                << batch_config.output_path;
+
+    util::DumpMemoryStats();
+
+    return EXIT_SUCCESS;
+}
+catch (const osrm::RuntimeError &e)
+{
+    util::DumpMemoryStats();
+    util::Log(logERROR) << e.what();
+    return e.GetCode();
+}
+catch (const std::bad_alloc &e)
+{
+    util::DumpMemoryStats();
+    util::Log(logERROR) << "[exception] " << e.what();
+    util::Log(logERROR) << "Please provide more memory or consider using a larger swapfile";
+    return EXIT_FAILURE;
+}
+catch (const std::exception &e)
+{
+    util::Log(logERROR) << "[exception] " << e.what();
+    return EXIT_FAILURE;
+}
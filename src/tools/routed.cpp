@@ -1,7 +1,12 @@
+#include "server/api/url_parser.hpp"
 #include "server/server.hpp"
+#include "server/service_handler.hpp"
+#include "storage/warmup.hpp"
+#include "util/coordinate.hpp"
 #include "util/exception_utils.hpp"
 #include "util/log.hpp"
 #include "util/meminfo.hpp"
+#include "util/timing_util.hpp"
 #include "util/version.hpp"
 
 #include "osrm/engine_config.hpp"
@@ -14,18 +19,26 @@
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
 #include <cstdlib>
 
 #include <signal.h>
 
 #include <chrono>
+#include <atomic>
 #include <exception>
+#include <fstream>
 #include <future>
 #include <iostream>
 #include <memory>
 #include <new>
+#include <sstream>
 #include <string>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 #ifdef _WIN32
 boost::function0<void> console_ctrl_function;
@@ -73,6 +86,115 @@ std::istream &operator>>(std::istream &in, EngineConfig::Algorithm &algorithm)
 } // namespace engine
 } // namespace osrm
 
+// Reads a POI set file with one "lon,lat" coordinate per line, empty lines and lines starting
+// with # are skipped
+std::vector<util::Coordinate> loadPOISet(const boost::filesystem::path &path)
+{
+    std::ifstream input(path.string());
+    if (!input)
+        throw util::exception("Could not open POI set " + path.string());
+
+    std::vector<util::Coordinate> coordinates;
+    std::string line;
+    std::size_t line_number = 0;
+    while (std::getline(input, line))
+    {
+        ++line_number;
+        if (line.empty() || line.front() == '#')
+            continue;
+
+        std::istringstream fields(line);
+        double lon = 0, lat = 0;
+        char separator = 0;
+        fields >> lon >> separator >> lat;
+
+        const util::Coordinate coordinate{util::FloatLongitude{lon}, util::FloatLatitude{lat}};
+        if (fields.fail() || separator != ',' || !coordinate.IsValid())
+            throw util::exception("Invalid coordinate in POI set " + path.string() + " line " +
+                                  std::to_string(line_number));
+        coordinates.push_back(coordinate);
+    }
+    return coordinates;
+}
+
+// Reads a file of sample request URLs like "/route/v1/driving/7.41,43.73;7.42,43.74", one per
+// line, empty lines and lines starting with # are skipped
+std::vector<std::string> loadWarmupQueries(const boost::filesystem::path &path)
+{
+    std::ifstream input(path.string());
+    if (!input)
+        throw util::exception("Could not open warm-up queries " + path.string());
+
+    std::vector<std::string> queries;
+    std::string line;
+    while (std::getline(input, line))
+    {
+        if (line.empty() || line.front() == '#')
+            continue;
+        queries.push_back(line);
+    }
+    return queries;
+}
+
+// Runs the sample queries before the server accepts traffic, so the pages they touch are mapped
+// and the caches are filled like under real load
+void replayWarmupQueries(server::ServiceHandler &service_handler,
+                         const std::vector<std::string> &queries,
+                         const int thread_num)
+{
+    const auto faults_before = storage::getPageFaults();
+    TIMER_START(replay);
+
+    std::atomic<std::size_t> failed{0};
+    tbb::task_arena arena(thread_num);
+    arena.execute([&] {
+        tbb::parallel_for(std::size_t{0}, queries.size(), [&](const std::size_t index) {
+            auto query = queries[index];
+            auto iter = query.begin();
+            auto parsed_url = server::api::parseURL(iter, query.end());
+            server::ServiceHandler::ResultT result;
+            if (!parsed_url || iter != query.end() ||
+                service_handler.RunQuery(*std::move(parsed_url), result) != engine::Status::Ok)
+            {
+                ++failed;
+            }
+        });
+    });
+
+    TIMER_STOP(replay);
+    const auto faults_after = storage::getPageFaults();
+    util::Log() << "Replayed " << queries.size() << " warm-up queries (" << failed
+                << " failed) in " << TIMER_SEC(replay) << "s with "
+                << faults_after.major - faults_before.major << " major and "
+                << faults_after.minor - faults_before.minor << " minor page faults";
+}
+
+// Points the config to the files of the base path, or leaves it at the shared memory dataset.
+// Returns false if the dataset cannot be served.
+bool configureDataset(EngineConfig &config, const boost::filesystem::path &base_path)
+{
+    if (!base_path.empty())
+    {
+        const auto huge_pages = config.storage_config.huge_pages;
+        config.storage_config = storage::StorageConfig(base_path);
+        config.storage_config.huge_pages = huge_pages;
+    }
+    if (!config.use_shared_memory && !config.storage_config.IsValid())
+    {
+        util::Log(logERROR) << "Required files are missing, cannot continue";
+        return false;
+    }
+    if (!config.IsValid())
+    {
+        if (base_path.empty() != config.use_shared_memory)
+        {
+            util::Log(logWARNING) << "Path settings and shared memory conflicts.";
+        }
+        return false;
+    }
+    return true;
+}
+
 // generate boost::program_options object for the routing part
 inline unsigned generateServerProgramOptions(const int argc,
                                              const char *argv[],
@@ -81,11 +203,19 @@ inline unsigned generateServerProgramOptions(const int argc,
                                              int &ip_port,
                                              bool &trial,
                                              EngineConfig &config,
-                                             int &requested_thread_num)
+                                             int &requested_thread_num,
+                                             boost::filesystem::path &warmup_queries_path,
+                                             std::unordered_map<std::string, std::string> &datasets)
 {
     using boost::filesystem::path;
     using boost::program_options::value;
 
+    std::vector<std::string> poi_sets;
+    std::vector<std::string> profile_datasets;
+    std::size_t snapping_cache_megabytes;
+    std::string huge_pages;
+    std::string warmup_order;
+
     const auto hardware_threads = std::max<int>(1, std::thread::hardware_concurrency());
 
     // declare a group of options that will be allowed only on command line
@@ -123,9 +253,19 @@ inline unsigned generateServerProgramOptions(const int argc,
             "mmap,m",
             value<bool>(&config.use_mmap)->implicit_value(true)->default_value(false),
             "Map datafiles directly, do not use any additional memory.") //
+        ("huge-pages",
+         value<std::string>(&huge_pages)->default_value("off"),
+         "Pages backing the data loaded into memory: off, transparent, 2M or 1G. Falls back to "
+         "transparent huge pages if no pages of the size are reserved. With --mmap only "
+         "transparent huge pages are possible.") //
         ("dataset-name",
          value<std::string>(&config.dataset_name),
          "Name of the shared memory dataset to connect to.") //
+        ("profile",
+         value<std::vector<std::string>>(&profile_datasets)->composing(),
+         "Serve the queries for a {profile} of the URL from its own dataset, given as "
+         "<profile>=<base.osrm> or as <profile>=<dataset name> with --shared-memory. Replaces "
+         "the base path, all datasets share the threads of the server.") //
         ("algorithm,a",
          value<EngineConfig::Algorithm>(&config.algorithm)
              ->default_value(EngineConfig::Algorithm::CH, "CH"),
@@ -136,6 +276,10 @@ inline unsigned generateServerProgramOptions(const int argc,
         ("max-trip-size",
          value<int>(&config.max_locations_trip)->default_value(100),
          "Max. locations supported in trip query") //
+        ("max-trip-optimization-time",
+         value<double>(&config.max_trip_optimization_time)->default_value(1.0),
+         "Max. time in seconds spent improving the order of a trip query with more than 10 "
+         "locations. Default: 1.0, -1 for unlimited.") //
         ("max-table-size",
          value<int>(&config.max_locations_distance_table)->default_value(100),
          "Max. locations supported in distance table query") //
@@ -150,7 +294,41 @@ inline unsigned generateServerProgramOptions(const int argc,
          "Max. number of alternatives supported in the MLD route query") //
         ("max-matching-radius",
          value<double>(&config.max_radius_map_matching)->default_value(-1.0),
-         "Max. radius size supported in map matching query. Default: unlimited.");
+         "Max. radius size supported in map matching query. Default: unlimited.") //
+        ("max-matching-sessions",
+         value<int>(&config.max_matching_sessions)->default_value(1000),
+         "Max. number of map matching sessions kept between requests, 0 to disable them") //
+        ("matching-session-timeout",
+         value<double>(&config.matching_session_timeout)->default_value(300.0),
+         "Seconds after which an unused map matching session is dropped") //
+        ("tiles",
+         value<boost::filesystem::path>(&config.baked_tiles_path),
+         "Serve the vector tiles baked with osrm-tiles from this file") //
+        ("numa-replication",
+         value<bool>(&config.numa_replication)->implicit_value(true)->default_value(false),
+         "Copy the dataset to every NUMA node and pin the server threads round robin to the "
+         "nodes, so queries read the copy of their own node. Needs as much memory per node as "
+         "one dataset and does not work with --shared-memory or --mmap.") //
+        ("snapping-cache-size",
+         value<std::size_t>(&snapping_cache_megabytes)->default_value(32),
+         "Megabytes of snapped coordinates kept per dataset, 0 to disable the cache") //
+        ("unpacking-cache-size",
+         value<std::size_t>(&config.unpacking_cache_size)->default_value(1 << 16),
+         "Number of unpacked CH shortcuts kept per dataset, 0 to disable the cache") //
+        ("warmup",
+         value<std::string>(&warmup_order)->default_value(""),
+         "Touch the pages of these block groups in the given order before serving and after "
+         "every shared memory update: rtree, cells, graph, geometry, names. Empty to disable.") //
+        ("warmup-queries",
+         value<boost::filesystem::path>(&warmup_queries_path),
+         "Replay the request URLs of this file, one per line, before serving") //
+        ("max-isochrone-duration",
+         value<double>(&config.max_duration_isochrone)->default_value(3600.0),
+         "Max. contour duration in seconds supported in isochrone query") //
+        ("poi-set",
+         value<std::vector<std::string>>(&poi_sets)->composing(),
+         "Register a set of points of interest for the POI service as <name>=<file>. The file "
+         "lists one lon,lat coordinate per line.");
 
     // hidden options, will be allowed on command line, but will not be shown to the user
     boost::program_options::options_description hidden_options("Hidden options");
@@ -200,7 +378,82 @@ inline unsigned generateServerProgramOptions(const int argc,
 
     boost::program_options::notify(option_variables);
 
-    if (!config.use_shared_memory && option_variables.count("base"))
+    config.snapping_cache_size = snapping_cache_megabytes * 1024 * 1024;
+
+    if (const auto parsed_huge_pages = storage::parseHugePages(huge_pages))
+    {
+        config.storage_config.huge_pages = *parsed_huge_pages;
+    }
+    else
+    {
+        util::Log(logERROR) << "Unknown huge pages " << huge_pages
+                            << ", use off, transparent, 2M or 1G";
+        return INIT_FAILED;
+    }
+
+    if (const auto parsed_warmup_order = storage::parseWarmupOrder(warmup_order))
+    {
+        config.warmup_order = *parsed_warmup_order;
+    }
+    else
+    {
+        util::Log(logERROR) << "Unknown warm-up order " << warmup_order
+                            << ", use a list of rtree, cells, graph, geometry and names";
+        return INIT_FAILED;
+    }
+
+    if (config.numa_replication &&
+        (config.use_shared_memory || config.use_mmap || !config.memory_file.empty()))
+    {
+        util::Log(logERROR) << "NUMA replication needs the dataset in process memory, it does "
+                               "not work with --shared-memory or --mmap";
+        return INIT_FAILED;
+    }
+
+    for (const auto &poi_set : poi_sets)
+    {
+        const auto separator = poi_set.find('=');
+        if (separator == 0 || separator == std::string::npos)
+        {
+            util::Log(logERROR) << "POI sets must be given as <name>=<file>: " << poi_set;
+            return INIT_FAILED;
+        }
+        try
+        {
+            const auto name = poi_set.substr(0, separator);
+            config.poi_sets[name] = loadPOISet(poi_set.substr(separator + 1));
+        }
+        catch (const util::exception &e)
+        {
+            util::Log(logERROR) << e.what();
+            return INIT_FAILED;
+        }
+    }
+
+    for (const auto &profile_dataset : profile_datasets)
+    {
+        const auto separator = profile_dataset.find('=');
+        if (separator == 0 || separator == std::string::npos ||
+            separator + 1 == profile_dataset.size())
+        {
+            util::Log(logERROR) << "Profiles must be given as <profile>=<dataset>: "
+                                << profile_dataset;
+            return INIT_FAILED;
+        }
+        datasets[profile_dataset.substr(0, separator)] = profile_dataset.substr(separator + 1);
+    }
+
+    if (!datasets.empty())
+    {
+        if (option_variables.count("base") || !config.dataset_name.empty())
+        {
+            util::Log(logERROR) << "Datasets per profile conflict with the base path and the "
+                                   "dataset name";
+            return INIT_FAILED;
+        }
+        return INIT_OK_START_ENGINE;
+    }
+    else if (!config.use_shared_memory && option_variables.count("base"))
     {
         return INIT_OK_START_ENGINE;
     }
@@ -233,8 +486,18 @@ try
     boost::filesystem::path base_path;
 
     int requested_thread_num = 1;
-    const unsigned init_result = generateServerProgramOptions(
-        argc, argv, base_path, ip_address, ip_port, trial_run, config, requested_thread_num);
+    boost::filesystem::path warmup_queries_path;
+    std::unordered_map<std::string, std::string> datasets;
+    const unsigned init_result = generateServerProgramOptions(argc,
+                                                              argv,
+                                                              base_path,
+                                                              ip_address,
+                                                              ip_port,
+                                                              trial_run,
+                                                              config,
+                                                              requested_thread_num,
+                                                              warmup_queries_path,
+                                                              datasets);
     if (init_result == INIT_OK_DO_NOT_START_ENGINE)
     {
         return EXIT_SUCCESS;
@@ -246,22 +509,31 @@ try
 
     util::LogPolicy::GetInstance().SetLevel(config.verbosity);
 
-    if (!base_path.empty())
+    // the empty profile serves the queries of every profile
+    std::unordered_map<std::string, EngineConfig> profile_configs;
+    if (datasets.empty())
     {
-        config.storage_config = storage::StorageConfig(base_path);
-    }
-    if (!config.use_shared_memory && !config.storage_config.IsValid())
-    {
-        util::Log(logERROR) << "Required files are missing, cannot continue";
-        return EXIT_FAILURE;
+        if (!configureDataset(config, base_path))
+        {
+            return EXIT_FAILURE;
+        }
+        profile_configs.emplace("", config);
     }
-    if (!config.IsValid())
+    for (const auto &dataset : datasets)
     {
-        if (base_path.empty() != config.use_shared_memory)
+        auto profile_config = config;
+        if (config.use_shared_memory)
         {
-            util::Log(logWARNING) << "Path settings and shared memory conflicts.";
+            profile_config.dataset_name = dataset.second;
         }
-        return EXIT_FAILURE;
+        if (!configureDataset(profile_config,
+                              config.use_shared_memory ? boost::filesystem::path{}
+                                                       : boost::filesystem::path{dataset.second}))
+        {
+            return EXIT_FAILURE;
+        }
+        util::Log() << "Profile " << dataset.first << ": " << dataset.second;
+        profile_configs.emplace(dataset.first, std::move(profile_config));
     }
 
     util::Log() << "starting up engines, " << OSRM_VERSION;
@@ -285,8 +557,14 @@ try
     pthread_sigmask(SIG_BLOCK, &wait_mask, nullptr); // only block necessary signals
 #endif
 
-    auto service_handler = std::make_unique<server::ServiceHandler>(config);
-    auto routing_server = server::Server::CreateServer(ip_address, ip_port, requested_thread_num);
+    auto service_handler = std::make_unique<server::ServiceHandler>(profile_configs);
+    if (!warmup_queries_path.empty())
+    {
+        replayWarmupQueries(
+            *service_handler, loadWarmupQueries(warmup_queries_path), requested_thread_num);
+    }
+    auto routing_server = server::Server::CreateServer(
+        ip_address, ip_port, requested_thread_num, config.numa_replication);
 
     routing_server->RegisterServiceHandler(std::move(service_handler));
 
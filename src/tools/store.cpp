@@ -100,7 +100,12 @@ bool generateDataStoreOptions(const int argc,
                               std::string &dataset_name,
                               bool &list_datasets,
                               bool &list_blocks,
-                              bool &only_metric)
+                              bool &only_metric,
+                              bool &only_changed_blocks,
+                              std::string &rtree_leaves,
+                              unsigned &io_threads,
+                              bool &direct_io,
+                              std::string &huge_pages)
 {
     // declare a group of options that will be allowed only on command line
     boost::program_options::options_description generic_options("Options");
@@ -141,7 +146,33 @@ bool generateDataStoreOptions(const int argc,
                 ->implicit_value(true),
             "Only reload the metric data without updating the full dataset. This is an "
             "optimization "
-            "for traffic updates.");
+            "for traffic updates.")(
+            "only-changed-blocks",
+            boost::program_options::value<bool>(&only_changed_blocks)
+                ->default_value(false)
+                ->implicit_value(true),
+            "Like --only-metric, but only load the blocks that differ from the loaded metric "
+            "into an additional region. Falls back to --only-metric if more than half of the "
+            "metric changed.")(
+            "rtree-leaves",
+            boost::program_options::value<std::string>(&rtree_leaves)->default_value("mmap"),
+            "Where to keep the leaves of the R-tree: mmap (read from the .fileIndex file on "
+            "demand), memory (load them into the dataset) or compressed (load them into the "
+            "dataset delta compressed)")(
+            "io-threads",
+            boost::program_options::value<unsigned>(&io_threads)->default_value(4),
+            "Number of threads reading the data files. Use more on storage with a high "
+            "queue depth, e.g. NVMe drives.")(
+            "direct-io",
+            boost::program_options::value<bool>(&direct_io)
+                ->default_value(false)
+                ->implicit_value(true),
+            "Read the data files with O_DIRECT, bypassing the page cache where supported")(
+            "huge-pages",
+            boost::program_options::value<std::string>(&huge_pages)->default_value("off"),
+            "Pages backing the shared memory: off, transparent, 2M or 1G. Falls back to "
+            "transparent huge pages if no pages of the size are reserved for the user, see "
+            "vm.nr_hugepages and vm.hugetlb_shm_group");
 
     // hidden options, will be allowed on command line but will not be shown to the user
     boost::program_options::options_description hidden_options("Hidden options");
@@ -239,6 +270,11 @@ try
     bool list_datasets = false;
     bool list_blocks = false;
     bool only_metric = false;
+    bool only_changed_blocks = false;
+    std::string rtree_leaves;
+    unsigned io_threads = 4;
+    bool direct_io = false;
+    std::string huge_pages;
     if (!generateDataStoreOptions(argc,
                                   argv,
                                   verbosity,
@@ -247,7 +283,12 @@ try
                                   dataset_name,
                                   list_datasets,
                                   list_blocks,
-                                  only_metric))
+                                  only_metric,
+                                  only_changed_blocks,
+                                  rtree_leaves,
+                                  io_threads,
+                                  direct_io,
+                                  huge_pages))
     {
         return EXIT_SUCCESS;
     }
@@ -266,9 +307,35 @@ try
         util::Log(logERROR) << "Config contains invalid file paths. Exiting!";
         return EXIT_FAILURE;
     }
+    if (rtree_leaves == "memory")
+    {
+        config.rtree_leaf_storage = storage::RTreeLeafStorage::Memory;
+    }
+    else if (rtree_leaves == "compressed")
+    {
+        config.rtree_leaf_storage = storage::RTreeLeafStorage::Compressed;
+    }
+    else if (rtree_leaves != "mmap")
+    {
+        util::Log(logERROR) << "Unknown R-tree leaf storage " << rtree_leaves
+                            << ", use mmap, memory or compressed. Exiting!";
+        return EXIT_FAILURE;
+    }
+    if (const auto parsed_huge_pages = storage::parseHugePages(huge_pages))
+    {
+        config.huge_pages = *parsed_huge_pages;
+    }
+    else
+    {
+        util::Log(logERROR) << "Unknown huge pages " << huge_pages
+                            << ", use off, transparent, 2M or 1G. Exiting!";
+        return EXIT_FAILURE;
+    }
+    config.io_threads = io_threads;
+    config.direct_io = direct_io;
     storage::Storage storage(std::move(config));
 
-    return storage.Run(max_wait, dataset_name, only_metric);
+    return storage.Run(max_wait, dataset_name, only_metric, only_changed_blocks);
 }
 catch (const osrm::RuntimeError &e)
 {
@@ -0,0 +1,419 @@
+#include "engine/datafacade/mmap_memory_allocator.hpp"
+#include "engine/metric_checksum.hpp"
+#include "engine/tile_store.hpp"
+
+#include "storage/tar.hpp"
+
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
+#include "util/integer_range.hpp"
+#include "util/log.hpp"
+#include "util/meminfo.hpp"
+#include "util/timing_util.hpp"
+#include "util/version.hpp"
+#include "util/web_mercator.hpp"
+
+#include "osrm/engine_config.hpp"
+#include "osrm/exception.hpp"
+#include "osrm/osrm.hpp"
+#include "osrm/status.hpp"
+#include "osrm/storage_config.hpp"
+#include "osrm/tile_parameters.hpp"
+
+#include <boost/algorithm/string/case_conv.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
+#include <boost/program_options.hpp>
+
+#include <tbb/global_control.h>
+#include <tbb/parallel_for.h>
+
+#include <cstdlib>
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace osrm;
+
+namespace osrm
+{
+namespace engine
+{
+std::istream &operator>>(std::istream &in, EngineConfig::Algorithm &algorithm)
+{
+    std::string token;
+    in >> token;
+    boost::to_lower(token);
+
+    if (token == "ch" || token == "corech")
+        algorithm = EngineConfig::Algorithm::CH;
+    else if (token == "mld")
+        algorithm = EngineConfig::Algorithm::MLD;
+    else
+        throw util::RuntimeError(token, ErrorCode::UnknownAlgorithm, SOURCE_REF);
+    return in;
+}
+} // namespace engine
+} // namespace osrm
+
+namespace
+{
+enum class return_code : unsigned
+{
+    ok,
+    fail,
+    exit
+};
+
+// zoom levels supported by the tile service
+const constexpr unsigned MIN_ZOOM = 12;
+const constexpr unsigned MAX_ZOOM = 19;
+
+struct BakeConfig
+{
+    boost::filesystem::path base_path;
+    boost::filesystem::path output_path;
+    std::string bbox;
+    unsigned min_zoom;
+    unsigned max_zoom;
+    unsigned requested_num_threads;
+    std::size_t batch_size;
+};
+
+struct BoundingBox
+{
+    util::FloatLongitude min_lon;
+    util::FloatLatitude min_lat;
+    util::FloatLongitude max_lon;
+    util::FloatLatitude max_lat;
+};
+
+return_code parseArguments(int argc,
+                           char *argv[],
+                           std::string &verbosity,
+                           EngineConfig &config,
+                           BakeConfig &bake_config)
+{
+    using boost::program_options::value;
+
+    // declare a group of options that will be allowed only on command line
+    boost::program_options::options_description generic_options("Options");
+    generic_options.add_options() //
+        ("version,v", "Show version")("help,h", "Show this help message")(
+            "verbosity,l",
+            value<std::string>(&verbosity)->default_value("INFO"),
+            std::string("Log verbosity level: " + util::LogPolicy::GetLevels()).c_str());
+
+    // declare a group of options that will be allowed on command line
+    boost::program_options::options_description config_options("Configuration");
+    config_options.add_options() //
+        ("bbox",
+         value<std::string>(&bake_config.bbox)->required(),
+         "Area to bake as min_lon,min_lat,max_lon,max_lat") //
+        ("output,o",
+         value<boost::filesystem::path>(&bake_config.output_path)->required(),
+         "Output file for the baked tiles, served with osrm-routed --tiles") //
+        ("min-zoom",
+         value<unsigned>(&bake_config.min_zoom)->default_value(13),
+         "Lowest zoom level to bake") //
+        ("max-zoom",
+         value<unsigned>(&bake_config.max_zoom)->default_value(16),
+         "Highest zoom level to bake") //
+        ("threads,t",
+         value<unsigned int>(&bake_config.requested_num_threads)
+             ->default_value(std::thread::hardware_concurrency()),
+         "Number of threads to use") //
+        ("batch-size",
+         value<std::size_t>(&bake_config.batch_size)->default_value(4096),
+         "Number of tiles encoded at once") //
+        ("mmap,m",
+         value<bool>(&config.use_mmap)->implicit_value(true)->default_value(false),
+         "Map datafiles directly, do not use any additional memory.") //
+        ("algorithm,a",
+         value<EngineConfig::Algorithm>(&config.algorithm)
+             ->default_value(EngineConfig::Algorithm::CH, "CH"),
+         "Algorithm to use for the data. Can be CH, CoreCH, MLD.");
+
+    // hidden options, will be allowed on command line, but will not be
+    // shown to the user
+    boost::program_options::options_description hidden_options("Hidden options");
+    hidden_options.add_options()(
+        "base,b",
+        value<boost::filesystem::path>(&bake_config.base_path)->required(),
+        "base path to .osrm file");
+
+    // positional option
+    boost::program_options::positional_options_description positional_options;
+    positional_options.add("base", 1);
+
+    // combine above options for parsing
+    boost::program_options::options_description cmdline_options;
+    cmdline_options.add(generic_options).add(config_options).add(hidden_options);
+
+    const auto *executable = argv[0];
+    boost::program_options::options_description visible_options(
+        boost::filesystem::path(executable).filename().string() +
+        " <base.osrm> --bbox <min_lon,min_lat,max_lon,max_lat> --output <tiles.tar> [options]");
+    visible_options.add(generic_options).add(config_options);
+
+    // parse command line options
+    boost::program_options::variables_map option_variables;
+    try
+    {
+        boost::program_options::store(boost::program_options::command_line_parser(argc, argv)
+                                          .options(cmdline_options)
+                                          .positional(positional_options)
+                                          .run(),
+                                      option_variables);
+    }
+    catch (const boost::program_options::error &e)
+    {
+        util::Log(logERROR) << e.what();
+        return return_code::fail;
+    }
+
+    if (option_variables.count("version"))
+    {
+        std::cout << OSRM_VERSION << std::endl;
+        return return_code::exit;
+    }
+
+    if (option_variables.count("help"))
+    {
+        std::cout << visible_options;
+        return return_code::exit;
+    }
+
+    try
+    {
+        boost::program_options::notify(option_variables);
+    }
+    catch (const boost::program_options::error &e)
+    {
+        util::Log(logERROR) << e.what();
+        return return_code::fail;
+    }
+
+    return return_code::ok;
+}
+
+boost::optional<BoundingBox> parseBoundingBox(const std::string &input)
+{
+    std::vector<std::string> tokens;
+    boost::algorithm::split(tokens, input, [](const char c) { return c == ','; });
+    if (tokens.size() != 4)
+        return boost::none;
+
+    std::vector<double> values;
+    try
+    {
+        std::transform(tokens.begin(),
+                       tokens.end(),
+                       std::back_inserter(values),
+                       [](const std::string &token) { return std::stod(token); });
+    }
+    catch (const std::exception &)
+    {
+        return boost::none;
+    }
+
+    BoundingBox bbox{util::FloatLongitude{values[0]},
+                     util::FloatLatitude{values[1]},
+                     util::FloatLongitude{values[2]},
+                     util::FloatLatitude{values[3]}};
+    if (!(bbox.min_lon < bbox.max_lon && bbox.min_lat < bbox.max_lat))
+        return boost::none;
+
+    return bbox;
+}
+
+// Tile column or row of a pixel coordinate at the given zoom level
+unsigned pixelToTile(const double pixel, const unsigned zoom)
+{
+    const auto tile = std::floor(pixel / util::web_mercator::TILE_SIZE);
+    return static_cast<unsigned>(std::max(0., std::min(tile, (1u << zoom) - 1.)));
+}
+
+// The tiles of all zoom levels covering the bounding box in ascending key order
+std::vector<TileParameters>
+getTiles(const BoundingBox &bbox, const unsigned min_zoom, const unsigned max_zoom)
+{
+    using namespace util::web_mercator;
+
+    std::vector<TileParameters> tiles;
+    for (auto zoom = min_zoom; zoom <= max_zoom; ++zoom)
+    {
+        const auto min_x = pixelToTile(degreeToPixel(clamp(bbox.min_lon), zoom), zoom);
+        const auto max_x = pixelToTile(degreeToPixel(clamp(bbox.max_lon), zoom), zoom);
+        // tile rows start in the north
+        const auto min_y = pixelToTile(degreeToPixel(clamp(bbox.max_lat), zoom), zoom);
+        const auto max_y = pixelToTile(degreeToPixel(clamp(bbox.min_lat), zoom), zoom);
+
+        for (auto x = min_x; x <= max_x; ++x)
+        {
+            for (auto y = min_y; y <= max_y; ++y)
+            {
+                tiles.push_back(TileParameters{x, y, zoom});
+            }
+        }
+    }
+    return tiles;
+}
+
+// Baked tiles are only served for the dataset with the same connectivity and metric checksums
+std::uint32_t readConnectivityChecksum(const storage::StorageConfig &config)
+{
+    storage::tar::FileReader reader{config.GetPath(".osrm.edges"),
+                                    storage::tar::FileReader::VerifyFingerprint};
+    std::uint32_t connectivity_checksum;
+    reader.ReadInto("/common/connectivity_checksum", connectivity_checksum);
+    return connectivity_checksum;
+}
+
+// Checksum of the blocks the tile service sees, a memory map of the files has the same blocks
+std::uint32_t readMetricChecksum(const storage::StorageConfig &config)
+{
+    engine::datafacade::MMapMemoryAllocator allocator{config};
+    return engine::getMetricChecksum(allocator.GetIndex());
+}
+} // namespace
+
+int main(int argc, char *argv[])
+try
+{
+    util::LogPolicy::GetInstance().Unmute();
+
+    std::string verbosity;
+    EngineConfig config;
+    BakeConfig bake_config;
+    const auto result = parseArguments(argc, argv, verbosity, config, bake_config);
+
+    if (return_code::fail == result)
+    {
+        return EXIT_FAILURE;
+    }
+
+    if (return_code::exit == result)
+    {
+        return EXIT_SUCCESS;
+    }
+
+    util::LogPolicy::GetInstance().SetLevel(verbosity);
+
+    config.use_shared_memory = false;
+    config.storage_config = storage::StorageConfig(bake_config.base_path);
+    if (!config.storage_config.IsValid())
+    {
+        util::Log(logERROR) << "Required files are missing, cannot continue";
+        return EXIT_FAILURE;
+    }
+    if (!config.IsValid())
+    {
+        return EXIT_FAILURE;
+    }
+
+    if (1 > bake_config.requested_num_threads)
+    {
+        util::Log(logERROR) << "Number of threads must be 1 or larger";
+        return EXIT_FAILURE;
+    }
+
+    if (1 > bake_config.batch_size)
+    {
+        util::Log(logERROR) << "Batch size must be 1 or larger";
+        return EXIT_FAILURE;
+    }
+
+    if (bake_config.min_zoom < MIN_ZOOM || bake_config.max_zoom > MAX_ZOOM ||
+        bake_config.min_zoom > bake_config.max_zoom)
+    {
+        util::Log(logERROR) << "Zoom levels must be between " << MIN_ZOOM << " and " << MAX_ZOOM;
+        return EXIT_FAILURE;
+    }
+
+    const auto bbox = parseBoundingBox(bake_config.bbox);
+    if (!bbox)
+    {
+        util::Log(logERROR) << "Invalid bounding box " << bake_config.bbox;
+        return EXIT_FAILURE;
+    }
+
+    const auto tiles = getTiles(*bbox, bake_config.min_zoom, bake_config.max_zoom);
+    util::Log() << "Baking " << tiles.size() << " tiles of zoom levels " << bake_config.min_zoom
+                << " to " << bake_config.max_zoom << " with " << bake_config.requested_num_threads
+                << " threads";
+
+    tbb::global_control gc(tbb::global_control::max_allowed_parallelism,
+                           bake_config.requested_num_threads);
+
+    const OSRM osrm{config};
+    engine::TileStoreWriter writer{bake_config.output_path,
+                                   readConnectivityChecksum(config.storage_config),
+                                   readMetricChecksum(config.storage_config)};
+
+    TIMER_START(baking);
+
+    std::vector<std::string> encoded_tiles;
+    std::size_t number_of_bytes = 0;
+    for (std::size_t first = 0; first < tiles.size(); first += bake_config.batch_size)
+    {
+        const auto last = std::min(tiles.size(), first + bake_config.batch_size);
+        encoded_tiles.clear();
+        encoded_tiles.resize(last - first);
+
+        tbb::parallel_for(first, last, [&](const std::size_t index) {
+            if (osrm.Tile(tiles[index], encoded_tiles[index - first]) != Status::Ok)
+            {
+                throw util::exception("Could not encode tile " + std::to_string(tiles[index].z) +
+                                      "/" + std::to_string(tiles[index].x) + "/" +
+                                      std::to_string(tiles[index].y) + SOURCE_REF);
+            }
+        });
+
+        for (const auto index : util::irange(first, last))
+        {
+            const auto &tile = tiles[index];
+            writer.Append(tile.x, tile.y, tile.z, encoded_tiles[index - first]);
+            number_of_bytes += encoded_tiles[index - first].size();
+        }
+        util::Log(logDEBUG) << "Baked " << last << " of " << tiles.size() << " tiles";
+    }
+    writer.Finish();
+
+    TIMER_STOP(baking);
+
+    util::Log() << "Baked " << tiles.size() << " tiles with " << number_of_bytes << " bytes in "
+                << TIMER_SEC(baking) << " seconds: "
+                << tiles.size() / std::max(TIMER_SEC(baking), 1e-6) << " tiles/s";
+    util::Log() << "Wrote the tiles to " << bake_config.output_path;
+
+    util::DumpMemoryStats();
+
+    return EXIT_SUCCESS;
+}
+catch (const osrm::RuntimeError &e)
+{
+    util::DumpMemoryStats();
+    util::Log(logERROR) << e.what();
+    return e.GetCode();
+}
+catch (const std::bad_alloc &e)
+{
+    util::DumpMemoryStats();
+    util::Log(logERROR) << "[exception] " << e.what();
+    util::Log(logERROR) << "Please provide more memory or consider using a larger swapfile";
+    return EXIT_FAILURE;
+}
+catch (const std::exception &e)
+{
+    util::Log(logERROR) << "[exception] " << e.what();
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,456 @@
+#include "util/block_compression.hpp"
+
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
+#include "util/integer_range.hpp"
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace osrm
+{
+namespace util
+{
+
+namespace lz
+{
+namespace
+{
+constexpr std::size_t MIN_MATCH = 4;
+constexpr std::size_t MAX_OFFSET = 0xFFFF;
+// lengths of 15 and more continue in the following bytes
+constexpr std::size_t EXTENDED_LENGTH = 15;
+// 64 KiB of positions stay in the L2 cache
+constexpr unsigned HASH_BITS = 14;
+
+std::uint32_t read32(const unsigned char *position)
+{
+    std::uint32_t value;
+    std::memcpy(&value, position, sizeof(value));
+    return value;
+}
+
+std::uint32_t hash(const std::uint32_t value) { return (value * 2654435761u) >> (32 - HASH_BITS); }
+
+bool writeLength(unsigned char *&out, const unsigned char *out_end, std::size_t length)
+{
+    for (length -= EXTENDED_LENGTH; length >= 255; length -= 255)
+    {
+        if (out == out_end)
+            return false;
+        *out++ = 255;
+    }
+    if (out == out_end)
+        return false;
+    *out++ = static_cast<unsigned char>(length);
+    return true;
+}
+
+// A match_length of 0 writes the last sequence, which only consists of literals
+bool writeSequence(unsigned char *&out,
+                   const unsigned char *out_end,
+                   const unsigned char *literals,
+                   const std::size_t literal_length,
+                   const std::size_t offset,
+                   const std::size_t match_length)
+{
+    if (out == out_end)
+        return false;
+    auto token = out++;
+    *token = std::min(literal_length, EXTENDED_LENGTH) << 4;
+    if (literal_length >= EXTENDED_LENGTH && !writeLength(out, out_end, literal_length))
+        return false;
+    if (static_cast<std::size_t>(out_end - out) < literal_length)
+        return false;
+    std::memcpy(out, literals, literal_length);
+    out += literal_length;
+
+    if (match_length == 0)
+        return true;
+
+    if (out_end - out < 2)
+        return false;
+    *out++ = offset & 0xFF;
+    *out++ = offset >> 8;
+    const auto length = match_length - MIN_MATCH;
+    *token |= std::min(length, EXTENDED_LENGTH);
+    return length < EXTENDED_LENGTH || writeLength(out, out_end, length);
+}
+} // namespace
+
+std::size_t compress(const char *source_,
+                     const std::size_t size,
+                     char *destination,
+                     const std::size_t capacity)
+{
+    const auto source = reinterpret_cast<const unsigned char *>(source_);
+    auto out = reinterpret_cast<unsigned char *>(destination);
+    const auto out_end = out + capacity;
+
+    std::size_t anchor = 0;
+    if (size >= MIN_MATCH)
+    {
+        std::vector<std::uint32_t> table(1u << HASH_BITS, 0);
+        std::size_t position = 0;
+        while (position + MIN_MATCH <= size)
+        {
+            const auto value = read32(source + position);
+            auto &entry = table[hash(value)];
+            const std::size_t candidate = entry;
+            entry = position;
+
+            if (candidate < position && position - candidate <= MAX_OFFSET &&
+                read32(source + candidate) == value)
+            {
+                auto length = MIN_MATCH;
+                while (position + length < size &&
+                       source[candidate + length] == source[position + length])
+                {
+                    ++length;
+                }
+                if (!writeSequence(out,
+                                   out_end,
+                                   source + anchor,
+                                   position - anchor,
+                                   position - candidate,
+                                   length))
+                {
+                    return 0;
+                }
+                position += length;
+                anchor = position;
+            }
+            else
+            {
+                // skip faster through data that doesn't compress
+                position += 1 + ((position - anchor) >> 6);
+            }
+        }
+    }
+
+    if (!writeSequence(out, out_end, source + anchor, size - anchor, 0, 0))
+    {
+        return 0;
+    }
+    return out - reinterpret_cast<unsigned char *>(destination);
+}
+
+bool decompress(const char *source,
+                const std::size_t compressed_size,
+                char *destination,
+                const std::size_t size)
+{
+    auto in = reinterpret_cast<const unsigned char *>(source);
+    const auto in_end = in + compressed_size;
+    const auto out_begin = reinterpret_cast<unsigned char *>(destination);
+    auto out = out_begin;
+    const auto out_end = out + size;
+
+    const auto read_length = [&](std::size_t &length) {
+        if (length != EXTENDED_LENGTH)
+            return true;
+        unsigned char byte;
+        do
+        {
+            if (in == in_end)
+                return false;
+            byte = *in++;
+            length += byte;
+        } while (byte == 255);
+        return true;
+    };
+
+    while (in != in_end)
+    {
+        const auto token = *in++;
+        std::size_t literal_length = token >> 4;
+        if (!read_length(literal_length) ||
+            static_cast<std::size_t>(in_end - in) < literal_length ||
+            static_cast<std::size_t>(out_end - out) < literal_length)
+        {
+            return false;
+        }
+        std::memcpy(out, in, literal_length);
+        in += literal_length;
+        out += literal_length;
+
+        // the last sequence has no match
+        if (in == in_end)
+        {
+            return out == out_end;
+        }
+
+        if (in_end - in < 2)
+            return false;
+        const std::size_t offset = in[0] | (in[1] << 8);
+        in += 2;
+        std::size_t match_length = token & 0xF;
+        if (!read_length(match_length))
+            return false;
+        match_length += MIN_MATCH;
+        if (offset == 0 || offset > static_cast<std::size_t>(out - out_begin) ||
+            static_cast<std::size_t>(out_end - out) < match_length)
+        {
+            return false;
+        }
+
+        const auto match = out - offset;
+        if (offset >= match_length)
+        {
+            std::memcpy(out, match, match_length);
+        }
+        else
+        {
+            // overlapping matches repeat the last offset bytes, so copy byte by byte
+            for (std::size_t index = 0; index < match_length; ++index)
+            {
+                out[index] = match[index];
+            }
+        }
+        out += match_length;
+    }
+    return false;
+}
+} // namespace lz
+
+namespace
+{
+constexpr std::uint64_t PRIME64_1 = 11400714785074694791ULL;
+constexpr std::uint64_t PRIME64_2 = 14029467366897019727ULL;
+constexpr std::uint64_t PRIME64_3 = 1609587929392839161ULL;
+constexpr std::uint64_t PRIME64_4 = 9650029242287828579ULL;
+constexpr std::uint64_t PRIME64_5 = 2870177450012600261ULL;
+
+std::uint64_t rotl(const std::uint64_t value, const int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+std::uint64_t read64(const char *position)
+{
+    std::uint64_t value;
+    std::memcpy(&value, position, sizeof(value));
+    return value;
+}
+
+std::uint64_t round(std::uint64_t accumulator, const std::uint64_t input)
+{
+    accumulator += input * PRIME64_2;
+    return rotl(accumulator, 31) * PRIME64_1;
+}
+
+std::uint64_t mergeRound(std::uint64_t accumulator, const std::uint64_t value)
+{
+    accumulator ^= round(0, value);
+    return accumulator * PRIME64_1 + PRIME64_4;
+}
+} // namespace
+
+std::uint64_t checksum64(const char *data, const std::size_t size, const std::uint64_t seed)
+{
+    const auto end = data + size;
+    std::uint64_t hash;
+
+    if (size >= 32)
+    {
+        std::uint64_t v1 = seed + PRIME64_1 + PRIME64_2;
+        std::uint64_t v2 = seed + PRIME64_2;
+        std::uint64_t v3 = seed;
+        std::uint64_t v4 = seed - PRIME64_1;
+        for (; end - data >= 32; data += 32)
+        {
+            v1 = round(v1, read64(data));
+            v2 = round(v2, read64(data + 8));
+            v3 = round(v3, read64(data + 16));
+            v4 = round(v4, read64(data + 24));
+        }
+        hash = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+        hash = mergeRound(hash, v1);
+        hash = mergeRound(hash, v2);
+        hash = mergeRound(hash, v3);
+        hash = mergeRound(hash, v4);
+    }
+    else
+    {
+        hash = seed + PRIME64_5;
+    }
+    hash += size;
+
+    for (; end - data >= 8; data += 8)
+    {
+        hash ^= round(0, read64(data));
+        hash = rotl(hash, 27) * PRIME64_1 + PRIME64_4;
+    }
+    if (end - data >= 4)
+    {
+        std::uint32_t value;
+        std::memcpy(&value, data, sizeof(value));
+        hash ^= value * PRIME64_1;
+        hash = rotl(hash, 23) * PRIME64_2 + PRIME64_3;
+        data += 4;
+    }
+    for (; data != end; ++data)
+    {
+        hash ^= static_cast<unsigned char>(*data) * PRIME64_5;
+        hash = rotl(hash, 11) * PRIME64_1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= PRIME64_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+namespace
+{
+std::uint64_t getFrameSize(const CompressedBlockHeader &header, const std::uint64_t frame_index)
+{
+    return std::min(header.frame_size,
+                    header.uncompressed_size - frame_index * header.frame_size);
+}
+} // namespace
+
+std::vector<char>
+compressBlock(const char *data, const std::uint64_t size, CompressedBlockHeader &header)
+{
+    header.uncompressed_size = size;
+    header.frame_size = COMPRESSED_FRAME_SIZE;
+    header.number_of_frames = (size + COMPRESSED_FRAME_SIZE - 1) / COMPRESSED_FRAME_SIZE;
+
+    std::vector<CompressedFrame> frames(header.number_of_frames);
+    std::vector<std::vector<char>> stored_frames(header.number_of_frames);
+    tbb::parallel_for(
+        tbb::blocked_range<std::uint64_t>(0, header.number_of_frames),
+        [&](const tbb::blocked_range<std::uint64_t> &range) {
+            for (auto frame_index = range.begin(); frame_index != range.end(); ++frame_index)
+            {
+                const auto frame_data = data + frame_index * header.frame_size;
+                const auto frame_size = getFrameSize(header, frame_index);
+                auto &stored_frame = stored_frames[frame_index];
+
+                // frames that don't get smaller are stored as they are
+                stored_frame.resize(frame_size);
+                const auto compressed_size =
+                    frame_size > 1
+                        ? lz::compress(frame_data, frame_size, stored_frame.data(), frame_size - 1)
+                        : 0;
+                if (compressed_size > 0)
+                {
+                    stored_frame.resize(compressed_size);
+                }
+                else
+                {
+                    std::copy(frame_data, frame_data + frame_size, stored_frame.begin());
+                }
+
+                frames[frame_index].stored_size = stored_frame.size();
+                frames[frame_index].checksum = checksum64(frame_data, frame_size);
+            }
+        });
+
+    std::uint64_t offset = frames.size() * sizeof(CompressedFrame);
+    for (auto &frame : frames)
+    {
+        frame.offset = offset;
+        offset += frame.stored_size;
+    }
+
+    std::vector<char> stored(offset);
+    std::memcpy(stored.data(), frames.data(), frames.size() * sizeof(CompressedFrame));
+    for (const auto frame_index : util::irange<std::size_t>(0, frames.size()))
+    {
+        std::copy(stored_frames[frame_index].begin(),
+                  stored_frames[frame_index].end(),
+                  stored.begin() + frames[frame_index].offset);
+    }
+    return stored;
+}
+
+void checkCompressedBlock(const CompressedBlockHeader &header,
+                          const std::vector<CompressedFrame> &frames,
+                          const std::uint64_t stored_size)
+{
+    const auto corrupt = [](const std::string &reason) {
+        return util::exception("Corrupt compressed block: " + reason + SOURCE_REF);
+    };
+
+    if (header.frame_size == 0 ||
+        header.number_of_frames !=
+            (header.uncompressed_size + header.frame_size - 1) / header.frame_size ||
+        frames.size() != header.number_of_frames)
+    {
+        throw corrupt("invalid number of frames");
+    }
+
+    const auto table_size = frames.size() * sizeof(CompressedFrame);
+    for (const auto frame_index : util::irange<std::size_t>(0, frames.size()))
+    {
+        const auto &frame = frames[frame_index];
+        if (frame.offset < table_size || frame.offset > stored_size ||
+            frame.stored_size > stored_size - frame.offset ||
+            frame.stored_size > getFrameSize(header, frame_index))
+        {
+            throw corrupt("frame " + std::to_string(frame_index) + " out of bounds");
+        }
+    }
+}
+
+void decompressFrame(const CompressedBlockHeader &header,
+                     const std::uint64_t frame_index,
+                     const CompressedFrame &frame,
+                     const char *stored_frame,
+                     char *destination)
+{
+    const auto frame_size = getFrameSize(header, frame_index);
+    if (frame.stored_size == frame_size)
+    {
+        std::memcpy(destination, stored_frame, frame_size);
+    }
+    else if (!lz::decompress(stored_frame, frame.stored_size, destination, frame_size))
+    {
+        throw util::exception("Corrupt compressed block: frame " + std::to_string(frame_index) +
+                              " does not decompress" + SOURCE_REF);
+    }
+
+    if (checksum64(destination, frame_size) != frame.checksum)
+    {
+        throw util::exception("Corrupt compressed block: checksum mismatch in frame " +
+                              std::to_string(frame_index) + SOURCE_REF);
+    }
+}
+
+void decompressBlock(const CompressedBlockHeader &header,
+                     const char *stored,
+                     const std::uint64_t stored_size,
+                     char *destination)
+{
+    if (header.number_of_frames > stored_size / sizeof(CompressedFrame))
+    {
+        throw util::exception("Corrupt compressed block: truncated frame table" + SOURCE_REF);
+    }
+    std::vector<CompressedFrame> frames(header.number_of_frames);
+    std::memcpy(frames.data(), stored, frames.size() * sizeof(CompressedFrame));
+    checkCompressedBlock(header, frames, stored_size);
+
+    tbb::parallel_for(tbb::blocked_range<std::uint64_t>(0, frames.size()),
+                      [&](const tbb::blocked_range<std::uint64_t> &range) {
+                          for (auto frame_index = range.begin(); frame_index != range.end();
+                               ++frame_index)
+                          {
+                              const auto &frame = frames[frame_index];
+                              decompressFrame(header,
+                                              frame_index,
+                                              frame,
+                                              stored + frame.offset,
+                                              destination + frame_index * header.frame_size);
+                          }
+                      });
+}
+} // namespace util
+} // namespace osrm
@@ -0,0 +1,94 @@
+#include "util/monotonic_arena.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+
+namespace osrm
+{
+namespace util
+{
+
+namespace
+{
+thread_local MonotonicArena thread_arena;
+thread_local MonotonicArena *current_arena = nullptr;
+thread_local unsigned scope_depth = 0;
+} // namespace
+
+constexpr std::size_t MonotonicArena::MIN_BLOCK_SIZE;
+constexpr std::size_t MonotonicArena::MAX_RETAINED_CAPACITY;
+
+void *MonotonicArena::Allocate(const std::size_t bytes, const std::size_t alignment)
+{
+    BOOST_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+    while (current_block < blocks.size())
+    {
+        auto &block = blocks[current_block];
+        const auto address = reinterpret_cast<std::uintptr_t>(block.data.get()) + offset;
+        const auto padding = (alignment - address % alignment) % alignment;
+        if (offset + padding + bytes <= block.size)
+        {
+            offset += padding + bytes;
+            ++number_of_allocations;
+            allocated_bytes += bytes;
+            return block.data.get() + offset - bytes;
+        }
+
+        // the rest of the block is wasted, which is fine for the short lived data of a request
+        ++current_block;
+        offset = 0;
+    }
+
+    const auto size = std::max({MIN_BLOCK_SIZE,
+                                blocks.empty() ? std::size_t{0} : 2 * blocks.back().size,
+                                bytes + alignment});
+    blocks.push_back({std::unique_ptr<char[]>(new char[size]), size});
+    current_block = blocks.size() - 1;
+    offset = 0;
+    return Allocate(bytes, alignment);
+}
+
+void MonotonicArena::Reset()
+{
+    std::size_t capacity = 0;
+    const auto retained = std::find_if(blocks.begin(), blocks.end(), [&](const auto &block) {
+        capacity += block.size;
+        return capacity > MAX_RETAINED_CAPACITY;
+    });
+    blocks.erase(retained, blocks.end());
+
+    current_block = 0;
+    offset = 0;
+    number_of_allocations = 0;
+    allocated_bytes = 0;
+}
+
+std::size_t MonotonicArena::GetCapacity() const
+{
+    std::size_t capacity = 0;
+    for (const auto &block : blocks)
+        capacity += block.size;
+    return capacity;
+}
+
+MonotonicArena *MonotonicArena::Current() { return current_arena; }
+
+ArenaScope::ArenaScope() : arena(thread_arena)
+{
+    current_arena = &thread_arena;
+    ++scope_depth;
+}
+
+ArenaScope::~ArenaScope()
+{
+    BOOST_ASSERT(scope_depth > 0);
+    if (--scope_depth == 0)
+    {
+        current_arena = nullptr;
+        arena.Reset();
+    }
+}
+} // namespace util
+} // namespace osrm
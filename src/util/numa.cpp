@@ -0,0 +1,175 @@
+#include "util/numa.hpp"
+
+#include "util/exception.hpp"
+#include "util/log.hpp"
+
+#include <boost/filesystem.hpp>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace osrm
+{
+namespace util
+{
+
+namespace
+{
+const constexpr unsigned NOT_PINNED = -1;
+// set by pinThreadToNumaNode, saves the system call on every lookup
+thread_local unsigned pinned_node = NOT_PINNED;
+
+#ifdef __linux__
+// from linux/mempolicy.h, which is not installed everywhere
+const constexpr int MPOL_BIND_MODE = 2;
+#endif
+} // namespace
+
+std::vector<unsigned> parseCPUList(const std::string &cpu_list)
+{
+    std::vector<unsigned> cpus;
+    std::istringstream ranges(cpu_list);
+    std::string range;
+    while (std::getline(ranges, range, ','))
+    {
+        // the list in sysfs ends with a newline
+        range.erase(std::remove_if(range.begin(), range.end(), ::isspace), range.end());
+        if (range.empty())
+            continue;
+
+        std::istringstream bounds(range);
+        unsigned first = 0, last = 0;
+        char separator = 0;
+        bounds >> first;
+        if (bounds.fail())
+            throw util::exception("Invalid CPU list " + cpu_list);
+        last = first;
+        if (bounds >> separator)
+        {
+            bounds >> last;
+            if (separator != '-' || bounds.fail() || last < first)
+                throw util::exception("Invalid CPU list " + cpu_list);
+        }
+        for (auto cpu = first; cpu <= last; ++cpu)
+            cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+std::vector<NumaNode> getNumaNodes()
+{
+    std::vector<NumaNode> nodes;
+#ifdef __linux__
+    const boost::filesystem::path node_directory("/sys/devices/system/node");
+    boost::system::error_code error;
+    for (boost::filesystem::directory_iterator entry(node_directory, error), end;
+         !error && entry != end;
+         entry.increment(error))
+    {
+        const auto name = entry->path().filename().string();
+        if (name.size() <= 4 || name.compare(0, 4, "node") != 0 ||
+            !std::all_of(name.begin() + 4, name.end(), ::isdigit))
+            continue;
+
+        std::ifstream cpu_list_file((entry->path() / "cpulist").string());
+        std::string cpu_list;
+        std::getline(cpu_list_file, cpu_list);
+        auto cpus = parseCPUList(cpu_list);
+        // nodes of only memory, e.g. persistent memory, have no threads to serve
+        if (!cpus.empty())
+            nodes.push_back({static_cast<unsigned>(std::stoul(name.substr(4))), std::move(cpus)});
+    }
+#endif
+    if (nodes.empty())
+    {
+        nodes.push_back({0, {}});
+    }
+    std::sort(nodes.begin(), nodes.end(), [](const NumaNode &lhs, const NumaNode &rhs) {
+        return lhs.id < rhs.id;
+    });
+    return nodes;
+}
+
+unsigned getCurrentNumaNode()
+{
+    if (pinned_node != NOT_PINNED)
+        return pinned_node;
+#if defined(__linux__) && defined(SYS_getcpu)
+    unsigned cpu = 0, node = 0;
+    if (::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+        return node;
+#endif
+    return 0;
+}
+
+bool pinThreadToNumaNode(const NumaNode &node)
+{
+#ifdef __linux__
+    if (node.cpus.empty())
+        return false;
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (const auto cpu : node.cpus)
+    {
+        if (cpu < CPU_SETSIZE)
+            CPU_SET(cpu, &cpu_set);
+    }
+    const auto result = ::pthread_setaffinity_np(::pthread_self(), sizeof(cpu_set), &cpu_set);
+    if (result != 0)
+    {
+        util::Log(logWARNING) << "Could not pin thread to NUMA node " << node.id << ": "
+                              << std::strerror(result);
+        return false;
+    }
+    pinned_node = node.id;
+    return true;
+#else
+    (void)node;
+    return false;
+#endif
+}
+
+bool bindMemoryToNumaNode(void *address, const std::uint64_t size, const unsigned node)
+{
+#if defined(__linux__) && defined(SYS_mbind)
+    const auto bits_per_word = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> node_mask(node / bits_per_word + 1, 0);
+    node_mask[node / bits_per_word] |= 1UL << (node % bits_per_word);
+
+    const std::uint64_t page_size = ::sysconf(_SC_PAGESIZE);
+    const auto begin = reinterpret_cast<std::uintptr_t>(address) / page_size * page_size;
+    const auto end = reinterpret_cast<std::uintptr_t>(address) + size;
+    // the kernel expects the number of bits plus one
+    if (::syscall(SYS_mbind,
+                  begin,
+                  end - begin,
+                  MPOL_BIND_MODE,
+                  node_mask.data(),
+                  node_mask.size() * bits_per_word + 1,
+                  0) != 0)
+    {
+        util::Log(logWARNING) << "Could not bind memory to NUMA node " << node << ": "
+                              << std::strerror(errno);
+        return false;
+    }
+    return true;
+#else
+    (void)address;
+    (void)size;
+    (void)node;
+    return false;
+#endif
+}
+} // namespace util
+} // namespace osrm
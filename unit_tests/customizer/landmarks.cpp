@@ -0,0 +1,179 @@
+#include "customizer/landmark_customizer.hpp"
+#include "engine/routing_algorithms/landmark_potential.hpp"
+#include "partitioner/multi_level_graph.hpp"
+#include "partitioner/multi_level_partition.hpp"
+#include "util/static_graph.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using namespace osrm;
+using namespace osrm::customizer;
+using namespace osrm::partitioner;
+using namespace osrm::util;
+
+namespace
+{
+struct MockEdge
+{
+    NodeID start;
+    NodeID target;
+    EdgeWeight weight;
+};
+
+auto makeGraph(const MultiLevelPartition &mlp, const std::vector<MockEdge> &mock_edges)
+{
+    struct EdgeData
+    {
+        EdgeWeight weight;
+        EdgeDuration duration;
+        EdgeDistance distance;
+        bool forward;
+        bool backward;
+    };
+    using Edge = static_graph_details::SortableEdgeWithData<EdgeData>;
+    std::vector<Edge> edges;
+    std::size_t max_id = 0;
+    for (const auto &m : mock_edges)
+    {
+        max_id = std::max<std::size_t>(max_id, std::max(m.start, m.target));
+        edges.push_back(Edge{m.start,
+                             m.target,
+                             m.weight,
+                             m.weight,
+                             static_cast<EdgeDistance>(1.0),
+                             true,
+                             false});
+        edges.push_back(Edge{m.target,
+                             m.start,
+                             m.weight,
+                             m.weight,
+                             static_cast<EdgeDistance>(1.0),
+                             false,
+                             true});
+    }
+    std::sort(edges.begin(), edges.end());
+    return partitioner::MultiLevelGraph<EdgeData, osrm::storage::Ownership::Container>(
+        mlp, max_id + 1, edges);
+}
+
+// all pairs shortest paths, INVALID_EDGE_WEIGHT if there is no path
+std::vector<std::vector<EdgeWeight>> makeDistances(const std::size_t number_of_nodes,
+                                                   const std::vector<MockEdge> &edges)
+{
+    std::vector<std::vector<EdgeWeight>> distances(
+        number_of_nodes, std::vector<EdgeWeight>(number_of_nodes, INVALID_EDGE_WEIGHT));
+    for (NodeID node = 0; node < number_of_nodes; ++node)
+        distances[node][node] = 0;
+    for (const auto &edge : edges)
+        distances[edge.start][edge.target] =
+            std::min(distances[edge.start][edge.target], edge.weight);
+
+    for (NodeID via = 0; via < number_of_nodes; ++via)
+        for (NodeID from = 0; from < number_of_nodes; ++from)
+            for (NodeID to = 0; to < number_of_nodes; ++to)
+                if (distances[from][via] != INVALID_EDGE_WEIGHT &&
+                    distances[via][to] != INVALID_EDGE_WEIGHT)
+                    distances[from][to] =
+                        std::min(distances[from][to], distances[from][via] + distances[via][to]);
+    return distances;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(landmarks_tests)
+
+// 0 -> 1 -> 2 -> 3 -> 4 is a one-way road with a slow bypass 0 -> 5 -> 4 and a way back 4 -> 0,
+// 6 <-> 7 is an island
+const std::vector<MockEdge> edges = {{0, 1, 1},
+                                     {1, 2, 2},
+                                     {2, 3, 3},
+                                     {3, 4, 4},
+                                     {0, 5, 10},
+                                     {5, 4, 10},
+                                     {4, 0, 5},
+                                     {6, 7, 1},
+                                     {7, 6, 1}};
+const std::vector<CellID> l1{{0, 0, 0, 1, 1, 1, 2, 2}};
+
+BOOST_AUTO_TEST_CASE(select_landmarks)
+{
+    MultiLevelPartition mlp{{l1}, {3}};
+    const auto graph = makeGraph(mlp, edges);
+
+    LandmarkCustomizer customizer;
+    const auto landmarks = customizer.Select(graph, 2);
+    BOOST_REQUIRE_EQUAL(landmarks.size(), 2);
+    // the island is never selected
+    BOOST_CHECK(landmarks[0] < 6 && landmarks[1] < 6);
+    BOOST_CHECK_NE(landmarks[0], landmarks[1]);
+
+    // there are only six nodes to select from in the largest part of the graph
+    BOOST_CHECK_EQUAL(customizer.Select(graph, 10).size(), 6);
+}
+
+BOOST_AUTO_TEST_CASE(lower_bounds)
+{
+    MultiLevelPartition mlp{{l1}, {3}};
+    const auto graph = makeGraph(mlp, edges);
+    const auto distances = makeDistances(graph.GetNumberOfNodes(), edges);
+
+    LandmarkCustomizer customizer;
+    const auto landmarks = customizer.Customize(graph, {2, 6});
+    BOOST_CHECK_EQUAL(landmarks.GetNumberOfLandmarks(), 2);
+
+    for (NodeID from = 0; from < graph.GetNumberOfNodes(); ++from)
+    {
+        for (NodeID to = 0; to < graph.GetNumberOfNodes(); ++to)
+        {
+            const auto bound = landmarks.GetLowerBound(from, to);
+            if (distances[from][to] == INVALID_EDGE_WEIGHT)
+            {
+                // both landmarks are in a different part of the graph than one of the nodes
+                BOOST_CHECK_EQUAL(bound, INVALID_EDGE_WEIGHT);
+            }
+            else
+            {
+                BOOST_CHECK_LE(bound, distances[from][to]);
+            }
+        }
+    }
+
+    // the landmark is on the shortest path
+    BOOST_CHECK_EQUAL(landmarks.GetLowerBound(2, 4), 7);
+    BOOST_CHECK_EQUAL(landmarks.GetLowerBound(0, 2), 3);
+}
+
+BOOST_AUTO_TEST_CASE(potential_is_consistent)
+{
+    MultiLevelPartition mlp{{l1}, {3}};
+    const auto graph = makeGraph(mlp, edges);
+
+    LandmarkCustomizer customizer;
+    const auto landmarks = customizer.Customize(graph, customizer.Select(graph, 2));
+
+    engine::routing_algorithms::LandmarkPotential<Landmarks> potential(landmarks);
+    potential.AddSource(0, -3);
+    potential.AddTarget(3, 1);
+    potential.AddTarget(2, 4);
+
+    for (const auto &edge : edges)
+    {
+        const auto from_potential = potential(edge.start);
+        const auto to_potential = potential(edge.target);
+        if (edge.start >= 6)
+        {
+            BOOST_CHECK_EQUAL(from_potential, INVALID_EDGE_WEIGHT);
+            BOOST_CHECK_EQUAL(to_potential, INVALID_EDGE_WEIGHT);
+            continue;
+        }
+
+        BOOST_REQUIRE_NE(from_potential, INVALID_EDGE_WEIGHT);
+        BOOST_REQUIRE_NE(to_potential, INVALID_EDGE_WEIGHT);
+        // the backward search uses the negated potential and has the same reduced weights
+        BOOST_CHECK_GE(edge.weight + to_potential - from_potential, 0);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -6,6 +6,7 @@
 #include "engine/guidance/assemble_route.hpp"
 #include "engine/guidance/assemble_steps.hpp"
 #include "engine/guidance/post_processing.hpp"
+#include "util/debug.hpp"
 
 #include <boost/test/unit_test.hpp>
 
@@ -37,7 +38,7 @@ BOOST_AUTO_TEST_CASE(trim_short_segments)
                                            {}};
 
     // Check that duplicated coordinate in the end is removed
-    std::vector<RouteStep> steps = {{0,
+    RouteSteps steps = {{0,
                                      324,
                                      false,
                                      "Central Park West",
@@ -93,6 +94,7 @@ BOOST_AUTO_TEST_CASE(trim_short_segments)
     geometry.segment_offsets = {0, 2};
     geometry.segment_distances = {1.9076601161280742};
     geometry.osm_node_ids = {OSMNodeID{0}, OSMNodeID{1}, OSMNodeID{2}};
+    geometry.simplification_ranks = {0, 0, 0};
     geometry.annotations = {{1.9076601161280742, 0.2, 0.2, 0}, {0, 0, 0, 0}};
 
     trimShortSegments(steps, geometry);
@@ -103,6 +105,38 @@ BOOST_AUTO_TEST_CASE(trim_short_segments)
     BOOST_CHECK_EQUAL(geometry.annotations.size(), 1);
     BOOST_CHECK_EQUAL(geometry.locations.size(), 2);
     BOOST_CHECK_EQUAL(geometry.osm_node_ids.size(), 2);
+    BOOST_CHECK_EQUAL(geometry.simplification_ranks.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(overview_from_simplification_ranks)
+{
+    using namespace osrm::engine::guidance;
+    using namespace osrm::util;
+
+    LegGeometry first_leg;
+    first_leg.locations = {{FloatLongitude{5}, FloatLatitude{5}},
+                           {FloatLongitude{6}, FloatLatitude{6}},
+                           {FloatLongitude{20}, FloatLatitude{20}},
+                           {FloatLongitude{25}, FloatLatitude{5}}};
+    first_leg.simplification_ranks = {0, 9, 0, 0};
+
+    LegGeometry second_leg;
+    second_leg.locations = {{FloatLongitude{25}, FloatLatitude{5}},
+                            {FloatLongitude{25}, FloatLatitude{5.00001}},
+                            {FloatLongitude{30}, FloatLatitude{10}}};
+    // the second coordinate is needed, but too close to the first one on the overview zoom level
+    second_leg.simplification_ranks = {0, 0, 0};
+
+    const auto overview = assembleOverview({first_leg, second_leg}, true);
+    const std::vector<Coordinate> expected = {first_leg.locations[0],
+                                              first_leg.locations[2],
+                                              first_leg.locations[3],
+                                              second_leg.locations[2]};
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        overview.begin(), overview.end(), expected.begin(), expected.end());
+
+    const auto full = assembleOverview({first_leg, second_leg}, false);
+    BOOST_CHECK_EQUAL(full.size(), 6);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
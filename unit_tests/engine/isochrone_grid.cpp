@@ -0,0 +1,116 @@
+#include "engine/isochrone_grid.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(isochrone_grid)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+namespace
+{
+util::Coordinate makeCoordinate(const double lon, const double lat)
+{
+    return util::Coordinate{util::FloatLongitude{lon}, util::FloatLatitude{lat}};
+}
+
+// Twice the signed area in square degrees, positive for counter-clockwise rings
+double signedArea(const std::vector<util::Coordinate> &ring)
+{
+    double area = 0;
+    for (std::size_t index = 0; index + 1 < ring.size(); ++index)
+    {
+        area += static_cast<double>(util::toFloating(ring[index].lon)) *
+                    static_cast<double>(util::toFloating(ring[index + 1].lat)) -
+                static_cast<double>(util::toFloating(ring[index + 1].lon)) *
+                    static_cast<double>(util::toFloating(ring[index].lat));
+    }
+    return area;
+}
+
+double maxLongitude(const std::vector<util::Coordinate> &ring)
+{
+    double max_lon = -180;
+    for (const auto coordinate : ring)
+        max_lon = std::max(max_lon, static_cast<double>(util::toFloating(coordinate.lon)));
+    return max_lon;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(nothing_reached)
+{
+    IsochroneGrid grid(makeCoordinate(13.40, 52.50), makeCoordinate(13.41, 52.51), 50);
+    grid.AddSegment(makeCoordinate(13.40, 52.50), makeCoordinate(13.41, 52.50), 100, 200);
+
+    BOOST_CHECK(grid.GetContour(50).empty());
+}
+
+BOOST_AUTO_TEST_CASE(segment_is_cut_at_contour)
+{
+    IsochroneGrid grid(makeCoordinate(13.40, 52.50), makeCoordinate(13.42, 52.50), 20);
+    grid.AddSegment(makeCoordinate(13.40, 52.50), makeCoordinate(13.42, 52.50), 0, 200);
+
+    const auto half = grid.GetContour(100);
+    BOOST_REQUIRE_EQUAL(half.size(), 1);
+    BOOST_CHECK(half.front().front() == half.front().back());
+    BOOST_CHECK_GT(signedArea(half.front()), 0);
+    BOOST_CHECK_LT(maxLongitude(half.front()), 13.412);
+    BOOST_CHECK_GT(maxLongitude(half.front()), 13.409);
+
+    const auto full = grid.GetContour(200);
+    BOOST_REQUIRE_EQUAL(full.size(), 1);
+    BOOST_CHECK_GT(maxLongitude(full.front()), 13.42);
+}
+
+BOOST_AUTO_TEST_CASE(negative_durations_are_not_reached)
+{
+    IsochroneGrid grid(makeCoordinate(13.40, 52.50), makeCoordinate(13.42, 52.50), 20);
+    grid.AddSegment(makeCoordinate(13.42, 52.50), makeCoordinate(13.40, 52.50), -100, 100);
+
+    const auto contour = grid.GetContour(100);
+    BOOST_REQUIRE_EQUAL(contour.size(), 1);
+    BOOST_CHECK_LT(maxLongitude(contour.front()), 13.412);
+}
+
+BOOST_AUTO_TEST_CASE(separate_areas_and_filled_holes)
+{
+    IsochroneGrid grid(makeCoordinate(13.40, 52.50), makeCoordinate(13.50, 52.51), 50);
+
+    // a closed block of roads and an isolated road far away
+    const auto south_west = makeCoordinate(13.40, 52.50);
+    const auto south_east = makeCoordinate(13.41, 52.50);
+    const auto north_east = makeCoordinate(13.41, 52.51);
+    const auto north_west = makeCoordinate(13.40, 52.51);
+    grid.AddSegment(south_west, south_east, 0, 10);
+    grid.AddSegment(south_east, north_east, 10, 20);
+    grid.AddSegment(north_east, north_west, 20, 30);
+    grid.AddSegment(north_west, south_west, 30, 40);
+    grid.AddSegment(makeCoordinate(13.49, 52.50), makeCoordinate(13.50, 52.51), 50, 60);
+
+    const auto block = grid.GetContour(40);
+    BOOST_REQUIRE_EQUAL(block.size(), 1);
+    // the inner hole of the block is filled: only the corners of the outer square remain
+    BOOST_CHECK_EQUAL(block.front().size(), 5);
+
+    BOOST_CHECK_EQUAL(grid.GetContour(60).size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(convex_hull_is_filled)
+{
+    IsochroneGrid grid(makeCoordinate(13.40, 52.50), makeCoordinate(13.41, 52.51), 25);
+    grid.AddConvexHull({makeCoordinate(13.40, 52.50),
+                        makeCoordinate(13.41, 52.50),
+                        makeCoordinate(13.405, 52.505),
+                        makeCoordinate(13.41, 52.51),
+                        makeCoordinate(13.40, 52.51)},
+                       30);
+
+    BOOST_CHECK(grid.GetContour(20).empty());
+    const auto contour = grid.GetContour(30);
+    BOOST_REQUIRE_EQUAL(contour.size(), 1);
+    BOOST_CHECK_EQUAL(contour.front().size(), 5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
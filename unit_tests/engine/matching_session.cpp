@@ -0,0 +1,85 @@
+#include "engine/map_matching/matching_session.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+
+BOOST_AUTO_TEST_SUITE(matching_session)
+
+using namespace osrm;
+using namespace osrm::engine::map_matching;
+
+namespace
+{
+MatchingSession makeSession(const unsigned timestamp)
+{
+    MatchingSession session;
+    session.candidates.resize(2);
+    session.viterbi = {0., -1.};
+    session.pruned = {false, false};
+    session.matched_distances = {0., 0.};
+    session.timestamp = timestamp;
+    return session;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(find_stored)
+{
+    MatchingSessionStore store(10, std::chrono::seconds(60));
+    const auto now = MatchingSessionStore::Clock::now();
+
+    BOOST_CHECK(store.Find("vehicle", now).Empty());
+
+    store.Store("vehicle", makeSession(5), now);
+    const auto session = store.Find("vehicle", now);
+    BOOST_CHECK(!session.Empty());
+    BOOST_CHECK_EQUAL(*session.timestamp, 5);
+
+    store.Store("vehicle", makeSession(6), now);
+    BOOST_CHECK_EQUAL(*store.Find("vehicle", now).timestamp, 6);
+    BOOST_CHECK_EQUAL(store.GetSize(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(evict_least_recently_used)
+{
+    MatchingSessionStore store(2, std::chrono::seconds(60));
+    const auto now = MatchingSessionStore::Clock::now();
+
+    store.Store("a", makeSession(1), now);
+    store.Store("b", makeSession(2), now);
+    BOOST_CHECK(!store.Find("a", now).Empty());
+
+    // "b" was used longest ago
+    store.Store("c", makeSession(3), now);
+    BOOST_CHECK_EQUAL(store.GetSize(), 2);
+    BOOST_CHECK(!store.Find("a", now).Empty());
+    BOOST_CHECK(store.Find("b", now).Empty());
+    BOOST_CHECK(!store.Find("c", now).Empty());
+}
+
+BOOST_AUTO_TEST_CASE(evict_expired)
+{
+    MatchingSessionStore store(10, std::chrono::seconds(60));
+    const auto now = MatchingSessionStore::Clock::now();
+
+    store.Store("a", makeSession(1), now);
+    store.Store("b", makeSession(2), now + std::chrono::seconds(30));
+
+    // using a session extends its lifetime
+    BOOST_CHECK(!store.Find("b", now + std::chrono::seconds(80)).Empty());
+    BOOST_CHECK_EQUAL(store.GetSize(), 1);
+    BOOST_CHECK(store.Find("a", now + std::chrono::seconds(80)).Empty());
+    BOOST_CHECK(!store.Find("b", now + std::chrono::seconds(130)).Empty());
+    BOOST_CHECK(store.Find("b", now + std::chrono::seconds(200)).Empty());
+    BOOST_CHECK_EQUAL(store.GetSize(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(disabled)
+{
+    MatchingSessionStore store(0, std::chrono::seconds(60));
+    store.Store("a", makeSession(1));
+    BOOST_CHECK(store.Find("a").Empty());
+    BOOST_CHECK_EQUAL(store.GetSize(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,94 @@
+#include "engine/metric_checksum.hpp"
+
+#include "storage/shared_data_index.hpp"
+#include "storage/shared_datatype.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(metric_checksum)
+
+using namespace osrm;
+using namespace osrm::engine;
+using namespace osrm::storage;
+
+namespace
+{
+const std::vector<std::string> BLOCKS = {"/common/names/blocks",
+                                         "/common/segment_data/forward_weights/packed",
+                                         "/common/turn_penalty/weight",
+                                         "/mld/metrics/routability/exclude/0/weights"};
+
+struct Region
+{
+    Region(const std::vector<std::string> &names)
+        : layout(std::make_unique<ContiguousDataLayout>())
+    {
+        for (const auto &name : names)
+        {
+            layout->SetBlock(name, Block{4, 4 * sizeof(int)});
+        }
+        memory = std::make_unique<char[]>(layout->GetSizeOfLayout());
+    }
+
+    int *Get(const std::string &name)
+    {
+        return static_cast<int *>(layout->GetBlockPtr(memory.get(), name));
+    }
+
+    std::unique_ptr<BaseDataLayout> layout;
+    std::unique_ptr<char[]> memory;
+};
+
+std::uint32_t getChecksum(std::vector<Region *> regions)
+{
+    std::vector<SharedDataIndex::AllocatedRegion> allocated_regions;
+    for (const auto region : regions)
+    {
+        // the index takes the layout, keep a copy for the region
+        auto layout = std::make_unique<ContiguousDataLayout>(
+            static_cast<const ContiguousDataLayout &>(*region->layout));
+        allocated_regions.push_back({region->memory.get(), std::move(layout)});
+    }
+    return getMetricChecksum(SharedDataIndex{std::move(allocated_regions)});
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(checksum_changes_with_metric_only)
+{
+    Region region{BLOCKS};
+    const auto checksum = getChecksum({&region});
+    BOOST_CHECK_EQUAL(getChecksum({&region}), checksum);
+
+    // names are not part of the metric
+    region.Get("/common/names/blocks")[0] = 1;
+    BOOST_CHECK_EQUAL(getChecksum({&region}), checksum);
+
+    for (const auto &name : {"/common/segment_data/forward_weights/packed",
+                             "/common/turn_penalty/weight",
+                             "/mld/metrics/routability/exclude/0/weights"})
+    {
+        region.Get(name)[3] = 1;
+        BOOST_CHECK_NE(getChecksum({&region}), checksum);
+        region.Get(name)[3] = 0;
+        BOOST_CHECK_EQUAL(getChecksum({&region}), checksum);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(checksum_of_delta_region)
+{
+    Region base{BLOCKS};
+    const auto checksum = getChecksum({&base});
+
+    // blocks of a delta region replace the ones of the base region
+    Region delta{{"/mld/metrics/routability/exclude/0/weights"}};
+    BOOST_CHECK_EQUAL(getChecksum({&base, &delta}), checksum);
+
+    delta.Get("/mld/metrics/routability/exclude/0/weights")[0] = 1;
+    BOOST_CHECK_NE(getChecksum({&base, &delta}), checksum);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
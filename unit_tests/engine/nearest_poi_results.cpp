@@ -0,0 +1,52 @@
+#include "engine/routing_algorithms/many_to_many.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(nearest_poi_results)
+
+using namespace osrm;
+using namespace osrm::engine::routing_algorithms;
+
+BOOST_AUTO_TEST_CASE(settles_in_weight_order)
+{
+    NearestPOIResults results(2);
+    results.Update(4, 30, 300, 3000.f);
+    results.Update(7, 10, 100, 1000.f);
+    results.Update(2, 20, 200, 2000.f);
+
+    // no path shorter than 15 can be found anymore
+    results.Settle(15);
+    BOOST_CHECK(!results.Done());
+
+    // a shorter path to a tentative result replaces it
+    results.Update(4, 18, 180, 1800.f);
+    results.Settle(25);
+    BOOST_CHECK(results.Done());
+
+    const auto nearest = results.Finish();
+    BOOST_REQUIRE_EQUAL(nearest.size(), 2);
+    BOOST_CHECK_EQUAL(nearest[0].poi_index, 7);
+    BOOST_CHECK_EQUAL(nearest[1].poi_index, 4);
+    BOOST_CHECK_EQUAL(nearest[1].weight, 18);
+    BOOST_CHECK_EQUAL(nearest[1].duration, 180);
+    BOOST_CHECK_EQUAL(nearest[1].distance, 1800.f);
+}
+
+BOOST_AUTO_TEST_CASE(settled_results_are_final)
+{
+    NearestPOIResults results(3);
+    results.Update(1, 10, 100, 1000.f);
+    results.Settle(10);
+
+    results.Update(1, 5, 50, 500.f);
+    results.Update(3, 40, 400, 4000.f);
+
+    // the exhausted search settles the remaining tentative results
+    const auto nearest = results.Finish();
+    BOOST_REQUIRE_EQUAL(nearest.size(), 2);
+    BOOST_CHECK_EQUAL(nearest[0].poi_index, 1);
+    BOOST_CHECK_EQUAL(nearest[0].weight, 10);
+    BOOST_CHECK_EQUAL(nearest[1].poi_index, 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,97 @@
+#include "engine/routing_algorithms/node_bucket_index.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <random>
+#include <tuple>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(node_bucket_index)
+
+using namespace osrm;
+using namespace osrm::engine::routing_algorithms;
+
+BOOST_AUTO_TEST_CASE(empty_index)
+{
+    NodeBucketIndex index;
+    index.Build();
+
+    BOOST_CHECK_EQUAL(index.GetNumberOfNodes(), 0);
+    BOOST_CHECK_EQUAL(index.GetNumberOfEntries(), 0);
+    const auto range = index.Find(42);
+    BOOST_CHECK_EQUAL(range.first, range.second);
+}
+
+BOOST_AUTO_TEST_CASE(grouped_by_node_in_column_order)
+{
+    NodeBucketIndex index;
+    index.Insert(7, 0, 10, 11, 12.f);
+    index.Insert(3, 0, 20, 21, 22.f);
+    index.Insert(7, 1, 30, 31, 32.f);
+    index.Insert(70000, 1, 40, 41, 42.f);
+    index.Insert(3, 2, 50, 51, 52.f);
+    index.Build();
+
+    BOOST_CHECK_EQUAL(index.GetNumberOfNodes(), 3);
+    BOOST_CHECK_EQUAL(index.GetNumberOfEntries(), 5);
+
+    const auto &columns = index.GetColumns();
+    const auto &weights = index.GetWeights();
+    const auto &durations = index.GetDurations();
+    const auto &distances = index.GetDistances();
+
+    auto range = index.Find(3);
+    BOOST_REQUIRE_EQUAL(range.second - range.first, 2);
+    BOOST_CHECK_EQUAL(columns[range.first], 0);
+    BOOST_CHECK_EQUAL(weights[range.first], 20);
+    BOOST_CHECK_EQUAL(columns[range.first + 1], 2);
+    BOOST_CHECK_EQUAL(durations[range.first + 1], 51);
+
+    range = index.Find(7);
+    BOOST_REQUIRE_EQUAL(range.second - range.first, 2);
+    BOOST_CHECK_EQUAL(columns[range.first], 0);
+    BOOST_CHECK_EQUAL(columns[range.first + 1], 1);
+    BOOST_CHECK_EQUAL(distances[range.first + 1], 32.f);
+
+    range = index.Find(70000);
+    BOOST_REQUIRE_EQUAL(range.second - range.first, 1);
+    BOOST_CHECK_EQUAL(weights[range.first], 40);
+
+    range = index.Find(4);
+    BOOST_CHECK_EQUAL(range.first, range.second);
+}
+
+BOOST_AUTO_TEST_CASE(matches_sorted_buckets)
+{
+    std::mt19937 generator(23);
+    std::uniform_int_distribution<NodeID> node_distribution(0, 1u << 30);
+
+    NodeBucketIndex index;
+    std::vector<std::tuple<NodeID, unsigned, EdgeWeight>> reference;
+    for (unsigned column = 0; column < 50; ++column)
+    {
+        for (unsigned entry = 0; entry < 200; ++entry)
+        {
+            // draw from a small pool so that nodes are shared between columns
+            const auto node = node_distribution(generator) % 1000 * 1000003;
+            reference.emplace_back(node, column, entry);
+            index.Insert(node, column, entry, 0, 0);
+        }
+    }
+    index.Build();
+    std::stable_sort(reference.begin(), reference.end(), [](const auto &lhs, const auto &rhs) {
+        return std::get<0>(lhs) < std::get<0>(rhs);
+    });
+
+    BOOST_REQUIRE_EQUAL(index.GetNumberOfEntries(), reference.size());
+    for (std::size_t position = 0; position < reference.size(); ++position)
+    {
+        const auto range = index.Find(std::get<0>(reference[position]));
+        BOOST_REQUIRE(range.first <= position && position < range.second);
+        BOOST_CHECK_EQUAL(index.GetColumns()[position], std::get<1>(reference[position]));
+        BOOST_CHECK_EQUAL(index.GetWeights()[position], std::get<2>(reference[position]));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -112,6 +112,7 @@ class ContiguousInternalMemoryDataFacade<routing_algorithms::offline::Algorithm>
     ExternalMultiLevelPartition external_partition;
     ExternalCellStorage external_cell_storage;
     ExternalCellMetric external_cell_metric;
+    mutable SnappingCache snapping_cache{0};
 
   public:
     using EdgeData = extractor::EdgeBasedEdge::EdgeData;
@@ -146,6 +147,10 @@ class ContiguousInternalMemoryDataFacade<routing_algorithms::offline::Algorithm>
 
     unsigned GetCheckSum() const override { return 0; }
 
+    unsigned GetMetricCheckSum() const override { return 0; }
+
+    SnappingCache &GetSnappingCache() const override { return snapping_cache; }
+
     // node and edge information access
     util::Coordinate GetCoordinateOfNode(const NodeID /*id*/) const override
     {
@@ -206,6 +211,16 @@ class ContiguousInternalMemoryDataFacade<routing_algorithms::offline::Algorithm>
         return DatasourceReverseRange(DatasourceForwardRange());
     }
 
+    RankForwardRange GetUncompressedForwardSimplificationRanks(const EdgeID /*id*/) const override
+    {
+        return {};
+    }
+
+    RankReverseRange GetUncompressedReverseSimplificationRanks(const EdgeID /*id*/) const override
+    {
+        return RankReverseRange(RankForwardRange());
+    }
+
     StringView GetDatasourceName(const DatasourceID /*id*/) const override { return StringView{}; }
 
     guidance::TurnInstruction GetTurnInstructionForEdgeID(const EdgeID /*id*/) const override
@@ -466,6 +481,8 @@ BOOST_AUTO_TEST_CASE(facade_uncompressed_methods)
     BOOST_CHECK_EQUAL(facade.GetUncompressedReverseDurations(0).size(), 0);
     BOOST_CHECK_EQUAL(facade.GetUncompressedForwardDatasources(0).size(), 0);
     BOOST_CHECK_EQUAL(facade.GetUncompressedReverseDatasources(0).size(), 0);
+    BOOST_CHECK_EQUAL(facade.GetUncompressedForwardSimplificationRanks(0).size(), 0);
+    BOOST_CHECK_EQUAL(facade.GetUncompressedReverseSimplificationRanks(0).size(), 0);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,71 @@
+#include "engine/snapping_cache.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(snapping_cache)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+namespace
+{
+SnappingCache::Key makeKey(const double lon, const double lat)
+{
+    return {util::Coordinate{util::FloatLongitude{lon}, util::FloatLatitude{lat}},
+            boost::none,
+            boost::none,
+            Approach::UNRESTRICTED,
+            false};
+}
+
+PhantomNodePair makePair(const unsigned node)
+{
+    PhantomNode phantom;
+    phantom.forward_segment_id = {node, true};
+    return {phantom, phantom};
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(snapping_parameters_are_part_of_the_key)
+{
+    SnappingCache cache(64 * SnappingCache::ENTRY_SIZE);
+
+    const auto key = makeKey(7.41, 43.73);
+    cache.Insert(key, makePair(1));
+
+    auto with_bearing = key;
+    with_bearing.bearing = Bearing{90, 10};
+    auto with_radius = key;
+    with_radius.radius = 25.;
+    auto with_approach = key;
+    with_approach.approach = Approach::CURB;
+    auto with_all_edges = key;
+    with_all_edges.use_all_edges = true;
+    const auto other_coordinate = makeKey(7.410001, 43.73);
+
+    for (const auto &other :
+         {with_bearing, with_radius, with_approach, with_all_edges, other_coordinate})
+    {
+        BOOST_CHECK(!cache.Find(other));
+    }
+    BOOST_CHECK(cache.Find(key));
+}
+
+BOOST_AUTO_TEST_CASE(byte_budget)
+{
+    // one entry per shard
+    SnappingCache cache(16 * SnappingCache::ENTRY_SIZE + SnappingCache::ENTRY_SIZE / 2);
+    BOOST_CHECK_EQUAL(cache.GetCapacity(), 16);
+
+    for (unsigned index = 0; index < 1000; ++index)
+    {
+        cache.Insert(makeKey(7. + index * 1e-4, 43.), makePair(index));
+    }
+    BOOST_CHECK_LE(cache.GetByteSize(), 16 * SnappingCache::ENTRY_SIZE);
+
+    // less than an entry per shard disables the cache
+    SnappingCache disabled(15 * SnappingCache::ENTRY_SIZE);
+    BOOST_CHECK_EQUAL(disabled.GetCapacity(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
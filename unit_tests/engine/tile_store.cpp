@@ -0,0 +1,77 @@
+#include "engine/tile_store.hpp"
+
+#include "../common/temporary_file.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(tile_store)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+BOOST_AUTO_TEST_CASE(tile_keys_are_ordered)
+{
+    BOOST_CHECK_LT(GetTileKey(8191, 8191, 13), GetTileKey(0, 0, 14));
+    BOOST_CHECK_LT(GetTileKey(4, 9, 14), GetTileKey(5, 0, 14));
+    BOOST_CHECK_LT(GetTileKey(5, 0, 14), GetTileKey(5, 1, 14));
+}
+
+BOOST_AUTO_TEST_CASE(write_and_find_tiles)
+{
+    TemporaryFile tmp;
+    {
+        TileStoreWriter writer{tmp.path, 42, 43};
+        writer.Append(4300, 2950, 13, "first");
+        writer.Append(8600, 5900, 14, "");
+        writer.Append(8600, 5901, 14, std::string(1000, 'x'));
+        writer.Finish();
+        BOOST_CHECK_EQUAL(writer.GetNumberOfTiles(), 3);
+    }
+
+    TileStore store{tmp.path};
+    BOOST_CHECK_EQUAL(store.GetConnectivityChecksum(), 42);
+    BOOST_CHECK_EQUAL(store.GetMetricChecksum(), 43);
+    BOOST_CHECK_EQUAL(store.GetNumberOfTiles(), 3);
+
+    const auto first = store.Find(4300, 2950, 13);
+    BOOST_REQUIRE(first);
+    BOOST_CHECK_EQUAL(first->to_string(), "first");
+
+    // tiles without data are baked as well
+    const auto empty = store.Find(8600, 5900, 14);
+    BOOST_REQUIRE(empty);
+    BOOST_CHECK(empty->empty());
+
+    const auto last = store.Find(8600, 5901, 14);
+    BOOST_REQUIRE(last);
+    BOOST_CHECK_EQUAL(last->size(), 1000);
+
+    BOOST_CHECK(!store.Find(4300, 2951, 13));
+    BOOST_CHECK(!store.Find(4300, 2950, 14));
+}
+
+BOOST_AUTO_TEST_CASE(write_tiles_in_chunks)
+{
+    // larger than a chunk, so the tiles are written with several continuations
+    const std::string large(20 * 1024 * 1024, 'x');
+
+    TemporaryFile tmp;
+    {
+        TileStoreWriter writer{tmp.path, 7, 8};
+        writer.Append(0, 0, 12, "a");
+        writer.Append(0, 1, 12, large);
+        writer.Append(0, 2, 12, "b");
+        writer.Append(0, 3, 12, large);
+        writer.Finish();
+    }
+
+    TileStore store{tmp.path};
+    BOOST_CHECK_EQUAL(store.Find(0, 0, 12)->to_string(), "a");
+    BOOST_CHECK_EQUAL(store.Find(0, 1, 12)->size(), large.size());
+    BOOST_CHECK_EQUAL(store.Find(0, 2, 12)->to_string(), "b");
+    BOOST_CHECK(store.Find(0, 3, 12)->to_string() == large);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
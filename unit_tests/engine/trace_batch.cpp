@@ -0,0 +1,209 @@
+#include "engine/map_matching/trace_batch.hpp"
+
+#include "storage/serialization.hpp"
+#include "storage/tar.hpp"
+#include "util/exception.hpp"
+
+#include "../common/range_tools.hpp"
+#include "../common/temporary_file.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(trace_batch)
+
+using namespace osrm;
+using namespace osrm::engine::map_matching;
+
+BOOST_AUTO_TEST_CASE(read_csv_traces)
+{
+    std::istringstream input("trace,lon,lat,timestamp\n"
+                             "7,7.41,43.73,10\n"
+                             "7,7.42,43.74,20\n"
+                             "\n"
+                             "8,7.43,43.75,30\r\n"
+                             "9,7.44,43.76,40\n"
+                             "9,7.45,43.77,50\n");
+    CSVTraceReader reader{input};
+
+    std::vector<Trace> traces;
+    BOOST_CHECK_EQUAL(reader.Read(2, traces), 2);
+    BOOST_REQUIRE_EQUAL(traces.size(), 2);
+    BOOST_CHECK_EQUAL(traces[0].id, 7);
+    BOOST_CHECK_EQUAL(traces[0].coordinates.size(), 2);
+    BOOST_CHECK_EQUAL(traces[0].timestamps.size(), 2);
+    BOOST_CHECK_EQUAL(traces[0].timestamps[1], 20);
+    BOOST_CHECK(traces[0].radiuses.empty());
+    BOOST_CHECK(traces[0].coordinates[1] ==
+                util::Coordinate(util::FloatLongitude{7.42}, util::FloatLatitude{43.74}));
+    BOOST_CHECK_EQUAL(traces[1].id, 8);
+    BOOST_CHECK_EQUAL(traces[1].coordinates.size(), 1);
+
+    // the first point of trace 9 was read ahead and is not lost
+    traces.clear();
+    BOOST_CHECK_EQUAL(reader.Read(2, traces), 1);
+    BOOST_REQUIRE_EQUAL(traces.size(), 1);
+    BOOST_CHECK_EQUAL(traces[0].id, 9);
+    BOOST_CHECK_EQUAL(traces[0].coordinates.size(), 2);
+
+    BOOST_CHECK_EQUAL(reader.Read(2, traces), 0);
+}
+
+BOOST_AUTO_TEST_CASE(read_malformed_csv_traces)
+{
+    std::istringstream input("1,7.41,43.73,10,5\n"
+                             "1,7.42,43.74,20\n");
+    CSVTraceReader reader{input};
+    std::vector<Trace> traces;
+    BOOST_CHECK_THROW(reader.Read(10, traces), util::exception);
+
+    std::istringstream garbage("1,7.41,43.73\n"
+                               "1,7.41,x\n");
+    CSVTraceReader garbage_reader{garbage};
+    BOOST_CHECK_THROW(garbage_reader.Read(10, traces), util::exception);
+}
+
+BOOST_AUTO_TEST_CASE(read_binary_traces)
+{
+    std::ostringstream output;
+    const auto write = [&output](const auto value) {
+        output.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    };
+    write(std::uint64_t{3});
+    write(std::uint32_t{2});
+    write(std::int32_t{7410000});
+    write(std::int32_t{43730000});
+    write(std::uint32_t{10});
+    write(std::int32_t{7420000});
+    write(std::int32_t{43740000});
+    write(std::uint32_t{20});
+    write(std::uint64_t{4});
+    write(std::uint32_t{0});
+
+    std::istringstream input(output.str());
+    BinaryTraceReader reader{input};
+    std::vector<Trace> traces;
+    BOOST_CHECK_EQUAL(reader.Read(10, traces), 2);
+    BOOST_REQUIRE_EQUAL(traces.size(), 2);
+    BOOST_CHECK_EQUAL(traces[0].id, 3);
+    BOOST_CHECK(traces[0].coordinates[1] ==
+                util::Coordinate(util::FloatLongitude{7.42}, util::FloatLatitude{43.74}));
+    BOOST_CHECK_EQUAL(traces[0].timestamps[1], 20);
+    BOOST_CHECK_EQUAL(traces[1].id, 4);
+    BOOST_CHECK(traces[1].coordinates.empty());
+    BOOST_CHECK_EQUAL(reader.Read(10, traces), 0);
+
+    std::istringstream truncated(output.str().substr(0, 20));
+    BinaryTraceReader truncated_reader{truncated};
+    BOOST_CHECK_THROW(truncated_reader.Read(10, traces), util::exception);
+}
+
+BOOST_AUTO_TEST_CASE(append_matched_traces)
+{
+    MatchedTraces first;
+    first.trace_ids = {1};
+    first.matching_offsets = {0, 1};
+    first.confidences = {0.5};
+    first.segment_offsets = {0, 2};
+    first.from_osm_node_ids = {10, 11};
+    first.to_osm_node_ids = {11, 12};
+    first.durations = {1, 2};
+
+    MatchedTraces second;
+    second.trace_ids = {2, 3};
+    second.matching_offsets = {0, 0, 2};
+    second.confidences = {0.7, 0.9};
+    second.segment_offsets = {0, 1, 2};
+    second.from_osm_node_ids = {20, 21};
+    second.to_osm_node_ids = {21, 22};
+    second.durations = {3, 4};
+
+    MatchedTraces all;
+    all.Append(first);
+    all.Append(second);
+
+    BOOST_CHECK_EQUAL(all.GetNumberOfTraces(), 3);
+    const std::vector<std::uint64_t> matching_offsets = {0, 1, 1, 3};
+    BOOST_CHECK_EQUAL_COLLECTIONS(all.matching_offsets.begin(),
+                                  all.matching_offsets.end(),
+                                  matching_offsets.begin(),
+                                  matching_offsets.end());
+    const std::vector<std::uint64_t> segment_offsets = {0, 2, 3, 4};
+    BOOST_CHECK_EQUAL_COLLECTIONS(all.segment_offsets.begin(),
+                                  all.segment_offsets.end(),
+                                  segment_offsets.begin(),
+                                  segment_offsets.end());
+    BOOST_CHECK_EQUAL(all.from_osm_node_ids.back(), 21);
+    BOOST_CHECK_EQUAL(all.durations.size(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(write_matched_traces_per_batch)
+{
+    MatchedTraces first;
+    first.trace_ids = {1};
+    first.matching_offsets = {0, 1};
+    first.confidences = {0.5};
+    first.segment_offsets = {0, 2};
+    first.from_osm_node_ids = {10, 11};
+    first.to_osm_node_ids = {11, 12};
+    first.durations = {1, 2};
+
+    MatchedTraces second;
+    second.trace_ids = {2, 3};
+    second.matching_offsets = {0, 0, 2};
+    second.confidences = {0.7, 0.9};
+    second.segment_offsets = {0, 1, 2};
+    second.from_osm_node_ids = {20, 21};
+    second.to_osm_node_ids = {21, 22};
+    second.durations = {3, 4};
+
+    TemporaryFile tmp;
+    {
+        MatchedTracesWriter writer{tmp.path};
+        writer.Append(first);
+        writer.Append(second);
+        BOOST_CHECK_EQUAL(writer.GetNumberOfTraces(), 3);
+        BOOST_CHECK_EQUAL(writer.GetNumberOfSegments(), 4);
+        writer.Finish();
+    }
+
+    MatchedTraces expected;
+    expected.Append(first);
+    expected.Append(second);
+
+    MatchedTraces written;
+    storage::tar::FileReader reader{tmp.path, storage::tar::FileReader::VerifyFingerprint};
+    storage::serialization::read(reader, "/match/traces/ids", written.trace_ids);
+    storage::serialization::read(
+        reader, "/match/traces/matching_offsets", written.matching_offsets);
+    storage::serialization::read(reader, "/match/matchings/confidences", written.confidences);
+    storage::serialization::read(
+        reader, "/match/matchings/segment_offsets", written.segment_offsets);
+    storage::serialization::read(
+        reader, "/match/segments/from_osm_node_ids", written.from_osm_node_ids);
+    storage::serialization::read(
+        reader, "/match/segments/to_osm_node_ids", written.to_osm_node_ids);
+    storage::serialization::read(reader, "/match/segments/durations", written.durations);
+
+    CHECK_EQUAL_COLLECTIONS(written.trace_ids, expected.trace_ids);
+    CHECK_EQUAL_COLLECTIONS(written.matching_offsets, expected.matching_offsets);
+    CHECK_EQUAL_COLLECTIONS(written.confidences, expected.confidences);
+    CHECK_EQUAL_COLLECTIONS(written.segment_offsets, expected.segment_offsets);
+    CHECK_EQUAL_COLLECTIONS(written.from_osm_node_ids, expected.from_osm_node_ids);
+    CHECK_EQUAL_COLLECTIONS(written.to_osm_node_ids, expected.to_osm_node_ids);
+    CHECK_EQUAL_COLLECTIONS(written.durations, expected.durations);
+
+    // the temporary column files are gone
+    for (const auto index : {0, 1, 2, 3, 4, 5, 6})
+    {
+        auto column_path = tmp.path;
+        column_path += "." + std::to_string(index) + ".tmp";
+        BOOST_CHECK(!boost::filesystem::exists(column_path));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,127 @@
+#include "engine/trip/trip_local_search.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(trip_local_search)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+namespace
+{
+// locations on a circle, the shortest trip visits them in order
+util::DistTableWrapper<EdgeWeight> makeCircleTable(const std::size_t number_of_locations)
+{
+    std::vector<EdgeWeight> table(number_of_locations * number_of_locations);
+    for (std::size_t from = 0; from < number_of_locations; ++from)
+    {
+        for (std::size_t to = 0; to < number_of_locations; ++to)
+        {
+            const auto angle = 2 * M_PI * (static_cast<double>(from) - to) / number_of_locations;
+            table[from * number_of_locations + to] =
+                static_cast<EdgeWeight>(std::round(1000 * std::sqrt(2 - 2 * std::cos(angle))));
+        }
+    }
+    return util::DistTableWrapper<EdgeWeight>(std::move(table), number_of_locations);
+}
+
+util::DistTableWrapper<EdgeWeight> makeRandomTable(const std::size_t number_of_locations,
+                                                   const unsigned seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<EdgeWeight> weights(1, 1000);
+    std::vector<EdgeWeight> table(number_of_locations * number_of_locations, 0);
+    for (std::size_t from = 0; from < number_of_locations; ++from)
+    {
+        for (std::size_t to = 0; to < number_of_locations; ++to)
+        {
+            if (from != to)
+                table[from * number_of_locations + to] = weights(generator);
+        }
+    }
+    return util::DistTableWrapper<EdgeWeight>(std::move(table), number_of_locations);
+}
+
+bool isPermutation(std::vector<NodeID> trip)
+{
+    std::vector<NodeID> identity(trip.size());
+    std::iota(identity.begin(), identity.end(), 0);
+    std::sort(trip.begin(), trip.end());
+    return trip == identity;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(untangles_crossed_trip)
+{
+    const std::size_t number_of_locations = 20;
+    const auto table = makeCircleTable(number_of_locations);
+
+    std::vector<NodeID> ordered(number_of_locations);
+    std::iota(ordered.begin(), ordered.end(), 0);
+    auto trip = ordered;
+    std::shuffle(trip.begin(), trip.end(), std::mt19937(42));
+
+    trip::ImproveTrip(table, trip, trip::TripDeadline::max());
+
+    BOOST_CHECK(isPermutation(trip));
+    BOOST_CHECK_EQUAL(trip::GetTripWeight(table, trip), trip::GetTripWeight(table, ordered));
+}
+
+BOOST_AUTO_TEST_CASE(improves_farthest_insertion)
+{
+    for (unsigned seed = 0; seed < 10; ++seed)
+    {
+        const std::size_t number_of_locations = 25;
+        const auto table = makeRandomTable(number_of_locations, seed);
+
+        const auto insertion_trip = trip::FarthestInsertionTrip(number_of_locations, table);
+        const auto trip =
+            trip::LocalSearchTrip(number_of_locations, table, trip::TripDeadline::max());
+
+        BOOST_CHECK(isPermutation(trip));
+        BOOST_CHECK_LE(trip::GetTripWeight(table, trip),
+                       trip::GetTripWeight(table, insertion_trip));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(respects_invalid_weights)
+{
+    // trip with fixed start and end: only the end location leads back to the start
+    const std::size_t number_of_locations = 15;
+    auto table = makeRandomTable(number_of_locations, 7);
+    const NodeID source = 0;
+    const NodeID destination = number_of_locations - 1;
+    for (NodeID location = 0; location < number_of_locations; ++location)
+    {
+        if (location != source)
+            table.SetValue(location, source, INVALID_EDGE_WEIGHT);
+        if (location != destination)
+            table.SetValue(destination, location, INVALID_EDGE_WEIGHT);
+    }
+    table.SetValue(destination, source, 0);
+
+    const auto trip = trip::LocalSearchTrip(number_of_locations, table, trip::TripDeadline::max());
+
+    BOOST_CHECK(isPermutation(trip));
+    BOOST_CHECK_LT(trip::GetTripWeight(table, trip), INVALID_EDGE_WEIGHT);
+}
+
+BOOST_AUTO_TEST_CASE(expired_deadline)
+{
+    const std::size_t number_of_locations = 30;
+    const auto table = makeRandomTable(number_of_locations, 3);
+
+    // only the farthest insertion trip is computed
+    const auto trip = trip::LocalSearchTrip(
+        number_of_locations, table, std::chrono::steady_clock::now() - std::chrono::seconds(1));
+
+    BOOST_CHECK(trip == trip::FarthestInsertionTrip(number_of_locations, table));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
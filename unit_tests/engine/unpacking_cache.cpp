@@ -0,0 +1,31 @@
+#include "engine/unpacking_cache.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(unpacking_cache)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+BOOST_AUTO_TEST_CASE(direction_is_part_of_the_key)
+{
+    UnpackingCache cache(64);
+
+    const auto forward = UnpackingCache::MakeKey(3, false);
+    const auto backward = UnpackingCache::MakeKey(3, true);
+    BOOST_CHECK_NE(forward, backward);
+
+    BOOST_CHECK(!cache.Find(forward));
+    cache.Insert(forward, {{1, 10}, {2, 11}});
+
+    const auto edges = cache.Find(forward);
+    BOOST_REQUIRE(edges);
+    BOOST_CHECK_EQUAL(edges->size(), 2);
+    BOOST_CHECK_EQUAL(edges->back().first, 2);
+    BOOST_CHECK_EQUAL(edges->back().second, 11);
+
+    // the shortcut unpacks differently in the other direction
+    BOOST_CHECK(!cache.Find(backward));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,89 @@
+#include "extractor/simplification_ranks.hpp"
+#include "engine/douglas_peucker.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(simplification_ranks)
+
+using namespace osrm;
+using namespace osrm::extractor;
+
+BOOST_AUTO_TEST_CASE(zoom_sensitive_ranks)
+{
+    /*
+            x
+           / \
+          x   \
+         /     \
+        x       x
+    */
+    std::vector<util::Coordinate> coordinates = {
+        util::Coordinate{util::FloatLongitude{5}, util::FloatLatitude{5}},
+        util::Coordinate{util::FloatLongitude{6}, util::FloatLatitude{6}},
+        util::Coordinate{util::FloatLongitude{20}, util::FloatLatitude{20}},
+        util::Coordinate{util::FloatLongitude{25}, util::FloatLatitude{5}}};
+
+    // douglasPeucker keeps 6,6 from Z9 on and the peak on all zoom levels
+    const auto ranks = computeSimplificationRanks(coordinates);
+    BOOST_REQUIRE_EQUAL(ranks.size(), 4);
+    BOOST_CHECK_EQUAL(ranks[0], 0);
+    BOOST_CHECK_EQUAL(ranks[1], 9);
+    BOOST_CHECK_EQUAL(ranks[2], 0);
+    BOOST_CHECK_EQUAL(ranks[3], 0);
+}
+
+BOOST_AUTO_TEST_CASE(remove_second_node)
+{
+    const auto delta_pixel_to_delta_degree = [](const int pixel, const unsigned zoom) {
+        const double shift = (1u << zoom) * 256;
+        const double b = shift / 2.0;
+        return pixel * 180. / b;
+    };
+    for (unsigned z = 1; z < engine::detail::DOUGLAS_PEUCKER_THRESHOLDS_SIZE; z++)
+    {
+        /*
+             x
+             | \
+           x-x  x
+                |
+                x
+        */
+        std::vector<util::Coordinate> input = {
+            util::Coordinate{util::FloatLongitude{5}, util::FloatLatitude{5}},
+            util::Coordinate{util::FloatLongitude{5 + delta_pixel_to_delta_degree(2, z)},
+                             util::FloatLatitude{5}},
+            util::Coordinate{util::FloatLongitude{10}, util::FloatLatitude{10}},
+            util::Coordinate{util::FloatLongitude{5}, util::FloatLatitude{15}},
+            util::Coordinate{util::FloatLongitude{5},
+                             util::FloatLatitude{15 + delta_pixel_to_delta_degree(2, z)}}};
+        const auto ranks = computeSimplificationRanks(input);
+        BOOST_REQUIRE_EQUAL(ranks.size(), 5);
+        BOOST_CHECK_EQUAL(ranks[0], 0);
+        BOOST_CHECK_GT(ranks[1], z);
+        BOOST_CHECK_LE(ranks[2], z);
+        BOOST_CHECK_GT(ranks[3], z);
+        BOOST_CHECK_EQUAL(ranks[4], 0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(never_needed)
+{
+    // all coordinates are on a line of constant latitude
+    std::vector<util::Coordinate> coordinates = {
+        util::Coordinate{util::FloatLongitude{5}, util::FloatLatitude{5}},
+        util::Coordinate{util::FloatLongitude{6}, util::FloatLatitude{5}},
+        util::Coordinate{util::FloatLongitude{7}, util::FloatLatitude{5}},
+        util::Coordinate{util::FloatLongitude{8}, util::FloatLatitude{5}}};
+
+    const auto ranks = computeSimplificationRanks(coordinates);
+    const std::vector<std::uint8_t> expected = {
+        0,
+        engine::detail::DOUGLAS_PEUCKER_THRESHOLDS_SIZE,
+        engine::detail::DOUGLAS_PEUCKER_THRESHOLDS_SIZE,
+        0};
+    BOOST_CHECK_EQUAL_COLLECTIONS(ranks.begin(), ranks.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
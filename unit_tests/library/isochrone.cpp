@@ -0,0 +1,191 @@
+#include <boost/test/unit_test.hpp>
+
+#include "coordinates.hpp"
+
+#include "engine/api/base_parameters.hpp"
+#include "engine/datafacade.hpp"
+#include "engine/datafacade/process_memory_allocator.hpp"
+#include "engine/datafacade_factory.hpp"
+#include "engine/routing_algorithms/isochrone.hpp"
+#include "engine/search_engine_data.hpp"
+#include "storage/storage_config.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(isochrone)
+
+using namespace osrm;
+using namespace osrm::engine;
+using namespace osrm::engine::routing_algorithms;
+
+namespace
+{
+struct ReachedNode
+{
+    NodeID parent;
+    EdgeDuration duration;
+};
+
+// Plain Dijkstra on the base graph with the seeds, order and cut-off of the isochrone search.
+// Nodes beyond the cut-off are returned as well, but not expanded.
+std::unordered_map<NodeID, ReachedNode> searchBaseGraph(const DataFacade<mld::Algorithm> &facade,
+                                                        const PhantomNode &source,
+                                                        const EdgeDuration max_duration)
+{
+    using QueueEntry = std::tuple<EdgeWeight, EdgeDuration, NodeID, NodeID>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+    if (source.IsValidForwardSource())
+    {
+        queue.emplace(-source.GetForwardWeightPlusOffset(),
+                      -source.GetForwardDuration(),
+                      source.forward_segment_id.id,
+                      source.forward_segment_id.id);
+    }
+    if (source.IsValidReverseSource())
+    {
+        queue.emplace(-source.GetReverseWeightPlusOffset(),
+                      -source.GetReverseDuration(),
+                      source.reverse_segment_id.id,
+                      source.reverse_segment_id.id);
+    }
+
+    std::unordered_map<NodeID, ReachedNode> reached;
+    while (!queue.empty())
+    {
+        EdgeWeight weight;
+        EdgeDuration duration;
+        NodeID node, parent;
+        std::tie(weight, duration, node, parent) = queue.top();
+        queue.pop();
+
+        if (!reached.insert({node, {parent, duration}}).second || duration > max_duration)
+            continue;
+
+        for (const auto edge : facade.GetAdjacentEdgeRange(node))
+        {
+            if (!facade.IsForwardEdge(edge))
+                continue;
+
+            const NodeID to = facade.GetTarget(edge);
+            if (facade.ExcludeNode(to))
+                continue;
+
+            const auto turn_id = facade.GetEdgeData(edge).turn_id;
+            queue.emplace(weight + facade.GetNodeWeight(node) +
+                              facade.GetWeightPenaltyForEdgeID(turn_id),
+                          duration + facade.GetNodeDuration(node) +
+                              facade.GetDurationPenaltyForEdgeID(turn_id),
+                          to,
+                          node);
+        }
+    }
+    return reached;
+}
+
+// Compares the nodes and accepted cells of the isochrone search with the base graph search and
+// returns the number of accepted cells
+std::size_t checkIsochrone(SearchEngineData<mld::Algorithm> &engine_working_data,
+                           const DataFacade<mld::Algorithm> &facade,
+                           const PhantomNode &source,
+                           const std::vector<EdgeDuration> &contours)
+{
+    const auto max_duration = contours.back();
+    const auto search_space = isochroneSearch(engine_working_data, facade, source, contours);
+    const auto reached = searchBaseGraph(facade, source, max_duration);
+    const auto &partition = facade.GetMultiLevelPartition();
+
+    const auto band = [&contours](const EdgeDuration duration) {
+        return std::lower_bound(contours.begin(), contours.end(), duration) - contours.begin();
+    };
+    const auto reached_within = [&](const NodeID node) {
+        const auto iter = reached.find(node);
+        return iter != reached.end() && iter->second.duration <= max_duration;
+    };
+
+    std::unordered_set<NodeID> covered;
+    for (const auto &node : search_space.nodes)
+    {
+        BOOST_REQUIRE(reached_within(node.node));
+        BOOST_CHECK_EQUAL(band(node.duration), band(reached.at(node.node).duration));
+        covered.insert(node.node);
+    }
+
+    for (const auto &cell : search_space.cells)
+    {
+        const auto cell_band = band(cell.duration);
+        const auto in_cell = [&](const NodeID node) {
+            return partition.GetCell(cell.level, node) == cell.cell;
+        };
+
+        // the nodes the base graph search passes in the cell on its way to a border node are on
+        // paths between border nodes, so they have to be in the band of the cell
+        for (const auto border_node : cell.border_nodes)
+        {
+            BOOST_REQUIRE(reached_within(border_node));
+            for (auto node = border_node; in_cell(node); node = reached.at(node).parent)
+            {
+                BOOST_CHECK_EQUAL(band(reached.at(node).duration), cell_band);
+                if (reached.at(node).parent == node)
+                    break;
+            }
+        }
+
+        // no node of the cell is reached earlier than the band of the cell
+        for (const auto &node : reached)
+        {
+            if (node.second.duration <= max_duration && in_cell(node.first))
+            {
+                BOOST_CHECK_GE(band(node.second.duration), cell_band);
+                covered.insert(node.first);
+            }
+        }
+    }
+
+    // every node reached within the largest contour was either settled or is in an accepted cell
+    for (const auto &node : reached)
+    {
+        if (node.second.duration <= max_duration)
+        {
+            BOOST_CHECK(covered.count(node.first) == 1);
+        }
+    }
+
+    return search_space.cells.size();
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(accepted_cells_mld)
+{
+    auto allocator = std::make_shared<datafacade::ProcessMemoryAllocator>(
+        storage::StorageConfig{OSRM_TEST_DATA_DIR "/mld/monaco.osrm"});
+    const DataFacadeFactory<DataFacade, mld::Algorithm> factory(allocator, 0, 0, 0);
+    const auto facade = factory.Get(api::BaseParameters{});
+    BOOST_REQUIRE(facade);
+    SearchEngineData<mld::Algorithm> engine_working_data;
+
+    std::size_t accepted_cells = 0;
+    for (const auto &location : get_locations_in_big_component())
+    {
+        const auto candidates =
+            facade->NearestPhantomNodesInRange(location, 50, Approach::UNRESTRICTED, false);
+        BOOST_REQUIRE(!candidates.empty());
+        const auto &source = candidates.front().phantom_node;
+
+        // a single band of an hour covers all of Monaco, so cells are accepted there
+        for (const auto &contours : std::vector<std::vector<EdgeDuration>>{
+                 {36000}, {300, 3000}, {600, 1200, 1800}})
+        {
+            accepted_cells += checkIsochrone(engine_working_data, *facade, source, contours);
+        }
+    }
+    BOOST_CHECK_GT(accepted_cells, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,156 @@
+#include <boost/test/unit_test.hpp>
+
+#include "coordinates.hpp"
+
+#include "engine/api/base_parameters.hpp"
+#include "engine/datafacade.hpp"
+#include "engine/datafacade/process_memory_allocator.hpp"
+#include "engine/datafacade_factory.hpp"
+#include "engine/routing_algorithms/map_matching.hpp"
+#include "engine/routing_algorithms/routing_base_ch.hpp"
+#include "engine/routing_algorithms/routing_base_mld.hpp"
+#include "engine/search_engine_data.hpp"
+#include "storage/storage_config.hpp"
+#include "util/coordinate_calculation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(map_matching)
+
+using namespace osrm;
+using namespace osrm::engine;
+using namespace osrm::engine::routing_algorithms;
+
+namespace
+{
+double getPairwiseDistance(SearchEngineData<ch::Algorithm> &engine_working_data,
+                           const DataFacade<ch::Algorithm> &facade,
+                           const PhantomNode &source,
+                           const PhantomNode &target,
+                           const EdgeWeight weight_upper_bound)
+{
+    engine_working_data.InitializeOrClearFirstThreadLocalStorage(facade.GetNumberOfNodes());
+    return ch::getNetworkDistance(engine_working_data,
+                                  facade,
+                                  *engine_working_data.forward_heap_1,
+                                  *engine_working_data.reverse_heap_1,
+                                  source,
+                                  target,
+                                  weight_upper_bound);
+}
+
+double getPairwiseDistance(SearchEngineData<mld::Algorithm> &engine_working_data,
+                           const DataFacade<mld::Algorithm> &facade,
+                           const PhantomNode &source,
+                           const PhantomNode &target,
+                           const EdgeWeight weight_upper_bound)
+{
+    engine_working_data.InitializeOrClearFirstThreadLocalStorage(
+        facade.GetNumberOfNodes(), facade.GetMaxBorderNodeID() + 1);
+    return mld::getNetworkDistance(engine_working_data,
+                                   facade,
+                                   *engine_working_data.forward_heap_1,
+                                   *engine_working_data.reverse_heap_1,
+                                   source,
+                                   target,
+                                   weight_upper_bound);
+}
+
+// The transitions of the many-to-many search must match the point-to-point search up to the
+// same weight bound that map matching ran before, pair by pair, for tight and loose bounds
+template <typename Algorithm> void checkTransitionDistances(const std::string &base_path)
+{
+    auto allocator =
+        std::make_shared<datafacade::ProcessMemoryAllocator>(storage::StorageConfig{base_path});
+    const DataFacadeFactory<DataFacade, Algorithm> factory(allocator, 0, 0, 0);
+    const auto facade = factory.Get(api::BaseParameters{});
+    BOOST_REQUIRE(facade);
+    SearchEngineData<Algorithm> engine_working_data;
+
+    auto trace = get_split_trace_locations();
+    const auto big_component = get_locations_in_big_component();
+    trace.insert(trace.end(), big_component.begin(), big_component.end());
+
+    const auto max_distance = std::numeric_limits<double>::max();
+    std::size_t number_of_transitions = 0;
+    std::size_t pruned_by_bound = 0;
+    for (const auto index : util::irange<std::size_t>(1, trace.size()))
+    {
+        std::vector<PhantomNode> sources, targets;
+        for (const auto &candidate : facade->NearestPhantomNodesInRange(
+                 trace[index - 1], 50, Approach::UNRESTRICTED, false))
+        {
+            sources.push_back(candidate.phantom_node);
+        }
+        for (const auto &candidate :
+             facade->NearestPhantomNodesInRange(trace[index], 50, Approach::UNRESTRICTED, false))
+        {
+            targets.push_back(candidate.phantom_node);
+        }
+        BOOST_REQUIRE(!sources.empty() && !targets.empty());
+
+        const auto haversine_distance =
+            util::coordinate_calculation::haversineDistance(trace[index - 1], trace[index]);
+        for (const double max_distance_delta : {0., 5., 50., 2000.})
+        {
+            // the bound of map matching, assumes a minimum speed of 4 m/s
+            const EdgeWeight weight_upper_bound =
+                ((haversine_distance + max_distance_delta) / 4.) * facade->GetWeightMultiplier();
+            const auto distances = getTransitionDistances(
+                engine_working_data, *facade, sources, targets, weight_upper_bound);
+            BOOST_REQUIRE_EQUAL(distances.size(), sources.size() * targets.size());
+
+            for (const auto row : util::irange<std::size_t>(0, sources.size()))
+            {
+                for (const auto column : util::irange<std::size_t>(0, targets.size()))
+                {
+                    const auto actual = distances[row * targets.size() + column];
+                    const auto expected = getPairwiseDistance(engine_working_data,
+                                                              *facade,
+                                                              sources[row],
+                                                              targets[column],
+                                                              weight_upper_bound);
+                    ++number_of_transitions;
+
+                    BOOST_CHECK_EQUAL(actual == max_distance, expected == max_distance);
+                    if (actual != max_distance && expected != max_distance)
+                    {
+                        BOOST_CHECK_LE(std::abs(actual - expected),
+                                       std::max(1.0, expected * 0.01));
+                    }
+                    else if (expected == max_distance &&
+                             getPairwiseDistance(engine_working_data,
+                                                 *facade,
+                                                 sources[row],
+                                                 targets[column],
+                                                 INVALID_EDGE_WEIGHT) != max_distance)
+                    {
+                        ++pruned_by_bound;
+                    }
+                }
+            }
+        }
+    }
+
+    BOOST_CHECK_GT(number_of_transitions, 0);
+    // the tight bounds have to exclude transitions that exist, otherwise nothing is tested
+    BOOST_CHECK_GT(pruned_by_bound, 0);
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(transition_distances_ch)
+{
+    checkTransitionDistances<ch::Algorithm>(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+}
+
+BOOST_AUTO_TEST_CASE(transition_distances_mld)
+{
+    checkTransitionDistances<mld::Algorithm>(OSRM_TEST_DATA_DIR "/mld/monaco.osrm");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -4,6 +4,15 @@
 #include "fixture.hpp"
 #include "waypoint_check.hpp"
 
+#include "engine/api/base_parameters.hpp"
+#include "engine/datafacade.hpp"
+#include "engine/datafacade/process_memory_allocator.hpp"
+#include "engine/datafacade_factory.hpp"
+#include "engine/plugins/match.hpp"
+#include "engine/routing_algorithms.hpp"
+#include "engine/search_engine_data.hpp"
+#include "storage/storage_config.hpp"
+
 #include "osrm/match_parameters.hpp"
 
 #include "osrm/coordinate.hpp"
@@ -11,6 +20,11 @@
 #include "osrm/osrm.hpp"
 #include "osrm/status.hpp"
 
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
 osrm::Status run_match_json(const osrm::OSRM &osrm,
                             const MatchParameters &params,
                             json::Object &json_result,
@@ -221,4 +235,126 @@ BOOST_AUTO_TEST_CASE(test_match_fb_serialization_skip_waypoints)
     BOOST_CHECK(fb->waypoints() == nullptr);
 }
 
+
+std::vector<double> get_numbers(const json::Value &array)
+{
+    std::vector<double> numbers;
+    for (const auto &value : array.get<json::Array>().values)
+        numbers.push_back(value.get<json::Number>().value);
+    return numbers;
+}
+
+std::vector<double> get_leg_nodes(const json::Value &leg)
+{
+    const auto &annotation = leg.get<json::Object>().values.at("annotation").get<json::Object>();
+    return get_numbers(annotation.values.at("nodes"));
+}
+
+// Feeding a trace point by point to a session gives the legs, tracepoints and confidence of
+// matching the whole trace at once
+BOOST_AUTO_TEST_CASE(test_match_session_equals_offline)
+{
+    using namespace osrm;
+
+    auto osrm = getOSRM(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+    const auto trace = get_split_trace_locations();
+
+    MatchParameters params;
+    params.annotations = true;
+    params.annotations_type = RouteParameters::AnnotationsType::Nodes;
+    params.coordinates = trace;
+
+    json::Object offline;
+    BOOST_REQUIRE(osrm.Match(params, offline) == Status::Ok);
+    const auto &offline_tracepoints = offline.values.at("tracepoints").get<json::Array>().values;
+    const auto &offline_matchings = offline.values.at("matchings").get<json::Array>().values;
+    BOOST_REQUIRE_EQUAL(offline_matchings.size(), 1);
+    const auto &offline_matching = offline_matchings.front().get<json::Object>();
+    const auto &offline_legs = offline_matching.values.at("legs").get<json::Array>().values;
+    BOOST_REQUIRE_EQUAL(offline_legs.size(), trace.size() - 1);
+
+    double confidence = 0;
+    for (std::size_t index = 0; index < trace.size(); ++index)
+    {
+        auto session_params = params;
+        session_params.coordinates = {trace[index]};
+        session_params.session = "session_equals_offline";
+
+        json::Object online;
+        BOOST_REQUIRE(osrm.Match(session_params, online) == Status::Ok);
+
+        // the previous point of the session is reported first
+        const auto &tracepoints = online.values.at("tracepoints").get<json::Array>().values;
+        BOOST_REQUIRE_EQUAL(tracepoints.size(), index == 0 ? 1 : 2);
+        const auto location =
+            get_numbers(tracepoints.back().get<json::Object>().values.at("location"));
+        const auto offline_location =
+            get_numbers(offline_tracepoints[index].get<json::Object>().values.at("location"));
+        BOOST_CHECK_EQUAL_COLLECTIONS(
+            location.begin(), location.end(), offline_location.begin(), offline_location.end());
+
+        const auto &matchings = online.values.at("matchings").get<json::Array>().values;
+        BOOST_REQUIRE_EQUAL(matchings.size(), 1);
+        const auto &matching = matchings.front().get<json::Object>();
+        confidence = matching.values.at("confidence").get<json::Number>().value;
+        if (index > 0)
+        {
+            const auto &legs = matching.values.at("legs").get<json::Array>().values;
+            BOOST_REQUIRE_EQUAL(legs.size(), 1);
+            const auto nodes = get_leg_nodes(legs.front());
+            const auto offline_nodes = get_leg_nodes(offline_legs[index - 1]);
+            BOOST_CHECK_EQUAL_COLLECTIONS(
+                nodes.begin(), nodes.end(), offline_nodes.begin(), offline_nodes.end());
+        }
+    }
+
+    BOOST_CHECK_CLOSE(
+        confidence, offline_matching.values.at("confidence").get<json::Number>().value, 1e-3);
+}
+
+// A session that continues on a dataset with another checksum starts over, its candidates were
+// snapped on the old data
+BOOST_AUTO_TEST_CASE(test_match_session_reset_on_checksum_change)
+{
+    using namespace osrm;
+    using namespace osrm::engine;
+    using Algorithm = routing_algorithms::ch::Algorithm;
+
+    const storage::StorageConfig config{OSRM_TEST_DATA_DIR "/ch/monaco.osrm"};
+    auto allocator = std::make_shared<datafacade::ProcessMemoryAllocator>(config);
+    auto changed_allocator = std::make_shared<datafacade::ProcessMemoryAllocator>(config);
+    // the facade reads the checksum when it is created
+    ++*changed_allocator->GetIndex().GetBlockPtr<std::uint32_t>("/common/connectivity_checksum");
+
+    const DataFacadeFactory<DataFacade, Algorithm> factory(allocator, 0, 0, 0);
+    const DataFacadeFactory<DataFacade, Algorithm> changed_factory(changed_allocator, 0, 0, 0);
+    const auto facade = factory.Get(api::BaseParameters{});
+    const auto changed_facade = changed_factory.Get(api::BaseParameters{});
+    BOOST_REQUIRE(facade && changed_facade);
+    BOOST_REQUIRE_NE(facade->GetCheckSum(), changed_facade->GetCheckSum());
+
+    SearchEngineData<Algorithm> heaps;
+    const RoutingAlgorithms<Algorithm> algorithms{heaps, facade};
+    const RoutingAlgorithms<Algorithm> changed_algorithms{heaps, changed_facade};
+    const plugins::MatchPlugin plugin{-1, -1., 10, 300.};
+
+    const auto trace = get_split_trace_locations();
+    const auto match = [&](const RoutingAlgorithmsInterface &routing_algorithms,
+                           const std::size_t index) {
+        api::MatchParameters params;
+        params.coordinates = {trace[index]};
+        params.session = "session_reset";
+
+        api::ResultT result = json::Object();
+        BOOST_REQUIRE(plugin.HandleRequest(routing_algorithms, params, result) == Status::Ok);
+        return result.get<json::Object>().values.at("tracepoints").get<json::Array>().values.size();
+    };
+
+    BOOST_CHECK_EQUAL(match(algorithms, 0), 1);
+    BOOST_CHECK_EQUAL(match(algorithms, 1), 2);
+    // the previous point is dropped with the session
+    BOOST_CHECK_EQUAL(match(changed_algorithms, 2), 1);
+    BOOST_CHECK_EQUAL(match(changed_algorithms, 3), 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -11,6 +11,11 @@
 #include "osrm/osrm.hpp"
 #include "osrm/status.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <vector>
+
 osrm::Status run_table_json(const osrm::OSRM &osrm,
                             const osrm::TableParameters &params,
                             osrm::json::Object &json_result,
@@ -387,4 +392,153 @@ BOOST_AUTO_TEST_CASE(test_table_serialiaze_fb_no_waypoints)
     BOOST_CHECK(fb->waypoints() == nullptr);
 }
 
+// Row major values of a dense table annotation, unreachable cells are negative
+std::vector<double> get_dense_values(const osrm::json::Object &json_result,
+                                     const std::string &annotation)
+{
+    using namespace osrm;
+
+    std::vector<double> values;
+    for (const auto &row : json_result.values.at(annotation).get<json::Array>().values)
+    {
+        for (const auto &value : row.get<json::Array>().values)
+        {
+            values.push_back(value.is<json::Null>() ? -1. : value.get<json::Number>().value);
+        }
+    }
+    return values;
+}
+
+// A bound in the middle of the reachable off-diagonal values that is far from all of them, so
+// neither the rounding of the output nor the conversion of the bound decides about a cell
+double get_bound_between(const std::vector<double> &values)
+{
+    std::vector<double> reachable;
+    std::copy_if(values.begin(), values.end(), std::back_inserter(reachable), [](double value) {
+        return value > 0;
+    });
+    std::sort(reachable.begin(), reachable.end());
+    for (auto index = reachable.size() / 2; index + 1 < reachable.size(); ++index)
+    {
+        if (reachable[index + 1] - reachable[index] >= 1.)
+        {
+            return (reachable[index] + reachable[index + 1]) / 2.;
+        }
+    }
+    BOOST_FAIL("no gap between the table values to put a bound into");
+    return 0.;
+}
+
+// Computes the unbounded table of spread out locations, then bounds it by durations or distances
+// in the middle of its values. Exactly the cells beyond the bound must be null in the dense
+// output and missing from the sparse output.
+void test_table_bound(const std::string &base_path,
+                      const osrm::EngineConfig::Algorithm algorithm,
+                      const bool bound_by_duration)
+{
+    using namespace osrm;
+
+    auto osrm = getOSRM(base_path, algorithm);
+
+    TableParameters params;
+    params.coordinates = get_split_trace_locations();
+    const auto big_component = get_locations_in_big_component();
+    params.coordinates.insert(params.coordinates.end(), big_component.begin(), big_component.end());
+    params.annotations = TableParameters::AnnotationsType::All;
+    const auto number_of_columns = params.coordinates.size();
+
+    json::Object unbounded_result;
+    BOOST_REQUIRE(osrm.Table(params, unbounded_result) == Status::Ok);
+    const auto durations = get_dense_values(unbounded_result, "durations");
+    const auto distances = get_dense_values(unbounded_result, "distances");
+    const auto &bounded_values = bound_by_duration ? durations : distances;
+    const auto bound = get_bound_between(bounded_values);
+    if (bound_by_duration)
+    {
+        params.max_duration = bound;
+    }
+    else
+    {
+        params.max_distance = bound;
+    }
+
+    std::vector<std::size_t> within_bound;
+    for (std::size_t index = 0; index < bounded_values.size(); ++index)
+    {
+        if (bounded_values[index] >= 0 && bounded_values[index] <= bound)
+        {
+            within_bound.push_back(index);
+        }
+    }
+    BOOST_CHECK_GT(within_bound.size(), number_of_columns);
+    BOOST_CHECK_LT(within_bound.size(), bounded_values.size());
+
+    json::Object dense_result;
+    BOOST_REQUIRE(osrm.Table(params, dense_result) == Status::Ok);
+    const auto dense_durations = get_dense_values(dense_result, "durations");
+    const auto dense_distances = get_dense_values(dense_result, "distances");
+    BOOST_REQUIRE_EQUAL(dense_durations.size(), durations.size());
+    BOOST_REQUIRE_EQUAL(dense_distances.size(), distances.size());
+    for (std::size_t index = 0; index < durations.size(); ++index)
+    {
+        if (std::binary_search(within_bound.begin(), within_bound.end(), index))
+        {
+            BOOST_CHECK_EQUAL(dense_durations[index], durations[index]);
+            BOOST_CHECK_EQUAL(dense_distances[index], distances[index]);
+        }
+        else
+        {
+            BOOST_CHECK_LT(dense_durations[index], 0);
+            BOOST_CHECK_LT(dense_distances[index], 0);
+        }
+    }
+
+    params.sparse = true;
+    json::Object sparse_result;
+    BOOST_REQUIRE(osrm.Table(params, sparse_result) == Status::Ok);
+    const auto &cells = sparse_result.values.at("sparse_cells").get<json::Array>().values;
+    const auto &sparse_durations =
+        sparse_result.values.at("durations").get<json::Array>().values;
+    const auto &sparse_distances =
+        sparse_result.values.at("distances").get<json::Array>().values;
+    BOOST_REQUIRE_EQUAL(cells.size(), within_bound.size());
+    BOOST_REQUIRE_EQUAL(sparse_durations.size(), cells.size());
+    BOOST_REQUIRE_EQUAL(sparse_distances.size(), cells.size());
+    for (std::size_t cell = 0; cell < cells.size(); ++cell)
+    {
+        const auto &row_and_column = cells[cell].get<json::Array>().values;
+        BOOST_REQUIRE_EQUAL(row_and_column.size(), 2);
+        const auto index = row_and_column[0].get<json::Number>().value * number_of_columns +
+                           row_and_column[1].get<json::Number>().value;
+        BOOST_CHECK_EQUAL(index, within_bound[cell]);
+        BOOST_CHECK_EQUAL(sparse_durations[cell].get<json::Number>().value,
+                          durations[within_bound[cell]]);
+        BOOST_CHECK_EQUAL(sparse_distances[cell].get<json::Number>().value,
+                          distances[within_bound[cell]]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_table_max_duration_ch)
+{
+    test_table_bound(OSRM_TEST_DATA_DIR "/ch/monaco.osrm", osrm::EngineConfig::Algorithm::CH, true);
+}
+
+BOOST_AUTO_TEST_CASE(test_table_max_duration_mld)
+{
+    test_table_bound(
+        OSRM_TEST_DATA_DIR "/mld/monaco.osrm", osrm::EngineConfig::Algorithm::MLD, true);
+}
+
+BOOST_AUTO_TEST_CASE(test_table_max_distance_ch)
+{
+    test_table_bound(
+        OSRM_TEST_DATA_DIR "/ch/monaco.osrm", osrm::EngineConfig::Algorithm::CH, false);
+}
+
+BOOST_AUTO_TEST_CASE(test_table_max_distance_mld)
+{
+    test_table_bound(
+        OSRM_TEST_DATA_DIR "/mld/monaco.osrm", osrm::EngineConfig::Algorithm::MLD, false);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,5 +1,6 @@
 #include <boost/test/unit_test.hpp>
 
+#include "../common/temporary_file.hpp"
 #include "fixture.hpp"
 
 #include "osrm/tile_parameters.hpp"
@@ -10,13 +11,20 @@
 #include "osrm/osrm.hpp"
 #include "osrm/status.hpp"
 
+#include "engine/datafacade/mmap_memory_allocator.hpp"
+#include "engine/metric_checksum.hpp"
+#include "engine/tile_store.hpp"
+#include "extractor/files.hpp"
 #include "util/typedefs.hpp"
 #include "util/vector_tile.hpp"
 
+#include <boost/filesystem.hpp>
 #include <boost/variant.hpp>
 #include <vtzero/vector_tile.hpp>
 
 #include <map>
+#include <string>
+#include <vector>
 
 osrm::Status run_tile(const osrm::OSRM &osrm,
                       const osrm::TileParameters &params,
@@ -520,4 +528,62 @@ void test_tile_nodes_mld(bool use_string_only_api)
 BOOST_AUTO_TEST_CASE(test_tile_node_mld_old_api) { test_tile_nodes_mld(true); }
 BOOST_AUTO_TEST_CASE(test_tile_node_mld_new_api) { test_tile_nodes_mld(false); }
 
+// A tile baked for the loaded dataset is served, it is ignored as soon as the metric changes.
+// The metric of a copy of the dataset is changed through one of its turn weight penalties.
+BOOST_AUTO_TEST_CASE(test_baked_tiles_of_another_metric_are_ignored)
+{
+    using namespace osrm;
+    namespace fs = boost::filesystem;
+
+    const fs::path base_path = OSRM_TEST_DATA_DIR "/mld/monaco.osrm";
+    const TileParameters params{17059, 11948, 15};
+
+    TemporaryFile baked_tiles;
+    {
+        engine::datafacade::MMapMemoryAllocator allocator{storage::StorageConfig{base_path}};
+        const auto &index = allocator.GetIndex();
+        const auto connectivity_checksum =
+            *index.GetBlockPtr<std::uint32_t>("/common/connectivity_checksum");
+        engine::TileStoreWriter writer{
+            baked_tiles.path, connectivity_checksum, engine::getMetricChecksum(index)};
+        writer.Append(params.x, params.y, params.z, "baked");
+        writer.Finish();
+    }
+
+    EngineConfig config;
+    config.storage_config = {base_path};
+    config.use_shared_memory = false;
+    config.algorithm = EngineConfig::Algorithm::MLD;
+    config.baked_tiles_path = baked_tiles.path;
+
+    std::string baked_tile;
+    BOOST_CHECK(OSRM{config}.Tile(params, baked_tile) == Status::Ok);
+    BOOST_CHECK_EQUAL(baked_tile, "baked");
+
+    const auto copy_directory = fs::temp_directory_path() / fs::unique_path();
+    fs::create_directories(copy_directory);
+    for (const auto &entry : fs::directory_iterator(base_path.parent_path()))
+    {
+        if (entry.path().filename().string().find(base_path.filename().string()) == 0)
+        {
+            fs::copy_file(entry.path(), copy_directory / entry.path().filename());
+        }
+    }
+    const auto copy_base_path = copy_directory / base_path.filename();
+    const auto penalties_path = copy_base_path.string() + ".turn_weight_penalties";
+    std::vector<TurnPenalty> turn_weight_penalties;
+    extractor::files::readTurnWeightPenalty(penalties_path, turn_weight_penalties);
+    BOOST_REQUIRE(!turn_weight_penalties.empty());
+    turn_weight_penalties.front() += 10;
+    extractor::files::writeTurnWeightPenalty(penalties_path, turn_weight_penalties);
+
+    config.storage_config = {copy_base_path};
+    std::string generated_tile;
+    BOOST_CHECK(OSRM{config}.Tile(params, generated_tile) == Status::Ok);
+    BOOST_CHECK_NE(generated_tile, "baked");
+    BOOST_CHECK(!generated_tile.empty());
+
+    fs::remove_all(copy_directory);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
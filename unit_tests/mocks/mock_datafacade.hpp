@@ -28,6 +28,8 @@ class MockBaseDataFacade : public engine::datafacade::BaseDataFacade
 {
     using StringView = util::StringView;
 
+    mutable engine::SnappingCache snapping_cache{0};
+
   public:
     bool ExcludeNode(const NodeID) const override { return false; };
 
@@ -94,6 +96,14 @@ class MockBaseDataFacade : public engine::datafacade::BaseDataFacade
     {
         return DatasourceReverseRange(DatasourceForwardRange());
     }
+    RankForwardRange GetUncompressedForwardSimplificationRanks(const EdgeID /*id*/) const override
+    {
+        return {};
+    }
+    RankReverseRange GetUncompressedReverseSimplificationRanks(const EdgeID /*id*/) const override
+    {
+        return RankReverseRange(RankForwardRange());
+    }
 
     StringView GetDatasourceName(const DatasourceID) const override final { return {}; }
 
@@ -206,6 +216,10 @@ class MockBaseDataFacade : public engine::datafacade::BaseDataFacade
 
     std::uint32_t GetCheckSum() const override { return 0; }
 
+    std::uint32_t GetMetricCheckSum() const override { return 0; }
+
+    engine::SnappingCache &GetSnappingCache() const override { return snapping_cache; }
+
     extractor::TravelMode GetTravelMode(const NodeID /* id */) const override
     {
         return extractor::TRAVEL_MODE_INACCESSIBLE;
@@ -288,6 +302,7 @@ class MockAlgorithmDataFacade<engine::datafacade::CH>
 {
   private:
     EdgeData foo;
+    mutable engine::UnpackingCache unpacking_cache{0};
 
   public:
     unsigned GetNumberOfNodes() const override { return 0; }
@@ -321,6 +336,8 @@ class MockAlgorithmDataFacade<engine::datafacade::CH>
     {
         return SPECIAL_EDGEID;
     }
+
+    engine::UnpackingCache &GetUnpackingCache() const override { return unpacking_cache; }
 };
 
 template <typename AlgorithmT>
@@ -3,8 +3,10 @@
 #include "parameters_io.hpp"
 
 #include "engine/api/base_parameters.hpp"
+#include "engine/api/isochrone_parameters.hpp"
 #include "engine/api/match_parameters.hpp"
 #include "engine/api/nearest_parameters.hpp"
+#include "engine/api/poi_parameters.hpp"
 #include "engine/api/route_parameters.hpp"
 #include "engine/api/table_parameters.hpp"
 #include "engine/api/tile_parameters.hpp"
@@ -108,6 +110,8 @@ BOOST_AUTO_TEST_CASE(invalid_table_urls)
     BOOST_CHECK_EQUAL(
         testInvalidOptions<TableParameters>("1,2;3,4?annotations=durations&fallback_speed=-1"),
         28UL);
+    BOOST_CHECK_EQUAL(testInvalidOptions<TableParameters>("1,2;3,4?max_duration=foo"), 21UL);
+    BOOST_CHECK_EQUAL(testInvalidOptions<TableParameters>("1,2;3,4?sparse=foo"), 15UL);
     // TODO(danpat): this is only testing invalid grammar which isn't capable of checking
     //               for values that need to reference other things currently.  These
     //               requests are gramatically correct, but semantically incorrect.
@@ -632,6 +636,18 @@ BOOST_AUTO_TEST_CASE(valid_table_urls)
     CHECK_EQUAL_RANGE(reference_1.radiuses, result_11->radiuses);
     CHECK_EQUAL_RANGE(reference_1.approaches, result_11->approaches);
     CHECK_EQUAL_RANGE(reference_1.coordinates, result_11->coordinates);
+
+    auto result_12 = parseParameters<TableParameters>(
+        "1,2;3,4?max_duration=1800&max_distance=2500.5&sparse=true");
+    BOOST_CHECK(result_12);
+    BOOST_CHECK_EQUAL(result_12->max_duration, boost::make_optional(1800.));
+    BOOST_CHECK_EQUAL(result_12->max_distance, boost::make_optional(2500.5));
+    BOOST_CHECK_EQUAL(result_12->sparse, true);
+    BOOST_CHECK(result_12->IsValid());
+
+    auto result_13 = parseParameters<TableParameters>("1,2;3,4?max_duration=600&fallback_speed=10");
+    BOOST_CHECK(result_13);
+    BOOST_CHECK(!result_13->IsValid());
 }
 
 BOOST_AUTO_TEST_CASE(valid_match_urls)
@@ -675,6 +691,16 @@ BOOST_AUTO_TEST_CASE(valid_match_urls)
     CHECK_EQUAL_RANGE(reference_3.radiuses, result_3->radiuses);
     CHECK_EQUAL_RANGE(reference_3.approaches, result_3->approaches);
     CHECK_EQUAL_RANGE(reference_3.coordinates, result_3->coordinates);
+
+    auto result_4 = parseParameters<MatchParameters>("1,2?session=vehicle-17_a&timestamps=5");
+    BOOST_CHECK(result_4);
+    BOOST_CHECK_EQUAL(result_4->session, "vehicle-17_a");
+    BOOST_CHECK(result_4->IsValid());
+
+    auto result_5 = parseParameters<MatchParameters>("1,2");
+    BOOST_CHECK(result_5);
+    BOOST_CHECK(result_5->session.empty());
+    BOOST_CHECK(!result_5->IsValid());
 }
 
 BOOST_AUTO_TEST_CASE(invalid_match_urls)
@@ -728,6 +754,56 @@ BOOST_AUTO_TEST_CASE(valid_nearest_urls)
     CHECK_EQUAL_RANGE(reference_2.coordinates, result_2->coordinates);
 }
 
+BOOST_AUTO_TEST_CASE(valid_poi_urls)
+{
+    std::vector<util::Coordinate> coords_1 = {{util::FloatLongitude{1}, util::FloatLatitude{2}}};
+
+    auto result_1 = parseParameters<POIParameters>("1,2?set=depots");
+    BOOST_CHECK(result_1);
+    BOOST_CHECK_EQUAL(result_1->set, "depots");
+    BOOST_CHECK_EQUAL(result_1->number_of_results, 1);
+    CHECK_EQUAL_RANGE(coords_1, result_1->coordinates);
+    BOOST_CHECK(result_1->IsValid());
+
+    auto result_2 = parseParameters<POIParameters>("1,2?number=10&set=fire-stations_2");
+    BOOST_CHECK(result_2);
+    BOOST_CHECK_EQUAL(result_2->set, "fire-stations_2");
+    BOOST_CHECK_EQUAL(result_2->number_of_results, 10);
+    BOOST_CHECK(result_2->IsValid());
+
+    // the set is required
+    auto result_3 = parseParameters<POIParameters>("1,2?number=10");
+    BOOST_CHECK(result_3);
+    BOOST_CHECK(!result_3->IsValid());
+
+    BOOST_CHECK_EQUAL(testInvalidOptions<POIParameters>("1,2?set=a.b"), 9UL);
+}
+
+BOOST_AUTO_TEST_CASE(valid_isochrone_urls)
+{
+    auto result_1 = parseParameters<IsochroneParameters>("1,2?contours=300");
+    BOOST_CHECK(result_1);
+    std::vector<double> contours_1 = {300};
+    CHECK_EQUAL_RANGE(contours_1, result_1->contours);
+    BOOST_CHECK(result_1->IsValid());
+
+    auto result_2 = parseParameters<IsochroneParameters>("1,2?contours=600;150.5;300&radiuses=10");
+    BOOST_CHECK(result_2);
+    std::vector<double> contours_2 = {600, 150.5, 300};
+    CHECK_EQUAL_RANGE(contours_2, result_2->contours);
+    BOOST_CHECK(result_2->IsValid());
+
+    // contours are required and must be positive
+    auto result_3 = parseParameters<IsochroneParameters>("1,2");
+    BOOST_CHECK(result_3);
+    BOOST_CHECK(!result_3->IsValid());
+    auto result_4 = parseParameters<IsochroneParameters>("1,2?contours=0;300");
+    BOOST_CHECK(result_4);
+    BOOST_CHECK(!result_4->IsValid());
+
+    BOOST_CHECK_EQUAL(testInvalidOptions<IsochroneParameters>("1,2?contours=a"), 13UL);
+}
+
 BOOST_AUTO_TEST_CASE(invalid_tile_urls)
 {
     TileParameters reference_1{1, 2, 3};
@@ -0,0 +1,90 @@
+#include "server/api/parsed_url.hpp"
+#include "server/api/url_parser.hpp"
+#include "server/service_handler.hpp"
+
+#include "osrm/engine_config.hpp"
+#include "osrm/json_container.hpp"
+#include "osrm/status.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <unordered_map>
+
+BOOST_AUTO_TEST_SUITE(service_handler)
+
+using namespace osrm;
+
+namespace
+{
+// The datasets differ in their nearest limit, so the code of a nearest query for 5 results
+// tells which of them answered it
+EngineConfig makeConfig(const std::string &base_path,
+                        const EngineConfig::Algorithm algorithm,
+                        const int max_results_nearest)
+{
+    EngineConfig config;
+    config.storage_config = {base_path};
+    config.use_shared_memory = false;
+    config.use_mmap = false;
+    config.algorithm = algorithm;
+    config.max_results_nearest = max_results_nearest;
+    return config;
+}
+
+std::string runNearest(server::ServiceHandler &handler, const std::string &profile)
+{
+    auto parsed_url =
+        server::api::parseURL("/nearest/v1/" + profile + "/7.437069,43.749249?number=5");
+    BOOST_REQUIRE(parsed_url);
+
+    server::ServiceHandler::ResultT result = util::json::Object();
+    const auto status = handler.RunQuery(*std::move(parsed_url), result);
+    const auto code =
+        result.get<util::json::Object>().values.at("code").get<util::json::String>().value;
+    BOOST_CHECK((status == Status::Ok) == (code == "Ok"));
+    return code;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(dispatch_by_profile)
+{
+    std::unordered_map<std::string, EngineConfig> profile_configs;
+    profile_configs.emplace(
+        "car", makeConfig(OSRM_TEST_DATA_DIR "/ch/monaco.osrm", EngineConfig::Algorithm::CH, 1));
+    profile_configs.emplace(
+        "foot",
+        makeConfig(OSRM_TEST_DATA_DIR "/mld/monaco.osrm", EngineConfig::Algorithm::MLD, 10));
+    server::ServiceHandler handler(profile_configs);
+
+    BOOST_CHECK_EQUAL(runNearest(handler, "car"), "TooBig");
+    BOOST_CHECK_EQUAL(runNearest(handler, "foot"), "Ok");
+    BOOST_CHECK_EQUAL(runNearest(handler, "bike"), "InvalidProfile");
+}
+
+BOOST_AUTO_TEST_CASE(empty_profile_is_fallback)
+{
+    std::unordered_map<std::string, EngineConfig> profile_configs;
+    profile_configs.emplace(
+        "", makeConfig(OSRM_TEST_DATA_DIR "/ch/monaco.osrm", EngineConfig::Algorithm::CH, 1));
+    profile_configs.emplace(
+        "foot",
+        makeConfig(OSRM_TEST_DATA_DIR "/mld/monaco.osrm", EngineConfig::Algorithm::MLD, 10));
+    server::ServiceHandler handler(profile_configs);
+
+    BOOST_CHECK_EQUAL(runNearest(handler, "foot"), "Ok");
+    BOOST_CHECK_EQUAL(runNearest(handler, "bike"), "TooBig");
+    BOOST_CHECK_EQUAL(runNearest(handler, "car"), "TooBig");
+}
+
+BOOST_AUTO_TEST_CASE(single_dataset_serves_every_profile)
+{
+    auto config =
+        makeConfig(OSRM_TEST_DATA_DIR "/mld/monaco.osrm", EngineConfig::Algorithm::MLD, 10);
+    server::ServiceHandler handler(config);
+
+    BOOST_CHECK_EQUAL(runNearest(handler, "car"), "Ok");
+    BOOST_CHECK_EQUAL(runNearest(handler, "anything"), "Ok");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
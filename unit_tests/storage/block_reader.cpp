@@ -0,0 +1,128 @@
+#include "storage/block_reader.hpp"
+#include "storage/shared_datatype.hpp"
+#include "storage/storage.hpp"
+#include "storage/tar.hpp"
+
+#include "../common/range_tools.hpp"
+#include "../common/temporary_file.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <numeric>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(block_reader)
+
+using namespace osrm;
+using namespace osrm::storage;
+
+namespace
+{
+void checkBlocks(const bool direct_io, const tar::FileWriter::CompressionFlag compression)
+{
+    TemporaryFile tmp{TEST_DATA_DIR "/block_reader_test.tar"};
+
+    const std::uint32_t single_32bit_integer = 0xDEADBEEF;
+    std::vector<std::uint64_t> small_vector = {0, 1, 2, 3, 0xFFFFFFFFFFFFFFFF};
+    // spans several chunks
+    std::vector<std::uint32_t> large_vector(20 * 1024 * 1024);
+    std::iota(large_vector.begin(), large_vector.end(), 0);
+
+    {
+        tar::FileWriter writer(tmp.path, tar::FileWriter::GenerateFingerprint, compression);
+        writer.WriteElementCount64("/test/single_32bit_integer", 1);
+        writer.WriteFrom("/test/single_32bit_integer", single_32bit_integer);
+        writer.WriteElementCount64("/test/small_vector", small_vector.size());
+        writer.WriteFrom("/test/small_vector", small_vector.data(), small_vector.size());
+        writer.WriteElementCount64("/test/large_vector", large_vector.size());
+        writer.WriteFrom("/test/large_vector", large_vector.data(), large_vector.size());
+    }
+
+    auto layout = std::make_unique<ContiguousDataLayout>();
+    populateLayoutFromFile(tmp.path, *layout);
+    auto memory = std::make_unique<char[]>(layout->GetSizeOfLayout());
+    std::vector<SharedDataIndex::AllocatedRegion> regions;
+    regions.push_back({memory.get(), std::move(layout)});
+    SharedDataIndex index{std::move(regions)};
+
+    BlockReader reader{4, direct_io};
+    const auto bytes_read = reader.Read(tmp.path, index);
+    BOOST_CHECK_EQUAL(bytes_read,
+                      sizeof(std::uint32_t) + small_vector.size() * sizeof(std::uint64_t) +
+                          large_vector.size() * sizeof(std::uint32_t));
+
+    BOOST_CHECK_EQUAL(*index.GetBlockPtr<std::uint32_t>("/test/single_32bit_integer"),
+                      single_32bit_integer);
+
+    const auto small_ptr = index.GetBlockPtr<std::uint64_t>("/test/small_vector");
+    const std::vector<std::uint64_t> small_result(small_ptr, small_ptr + small_vector.size());
+    CHECK_EQUAL_COLLECTIONS(small_result, small_vector);
+
+    const auto large_ptr = index.GetBlockPtr<std::uint32_t>("/test/large_vector");
+    const std::vector<std::uint32_t> large_result(large_ptr, large_ptr + large_vector.size());
+    BOOST_CHECK(large_result == large_vector);
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(read_blocks) { checkBlocks(false, tar::FileWriter::NoCompression); }
+
+BOOST_AUTO_TEST_CASE(read_blocks_direct_io) { checkBlocks(true, tar::FileWriter::NoCompression); }
+
+BOOST_AUTO_TEST_CASE(read_compressed_blocks)
+{
+    checkBlocks(false, tar::FileWriter::CompressEntries);
+    checkBlocks(true, tar::FileWriter::CompressEntries);
+}
+
+namespace
+{
+void checkChangedEntries(const tar::FileWriter::CompressionFlag compression)
+{
+    TemporaryFile tmp{TEST_DATA_DIR "/block_reader_test.tar"};
+
+    const auto write = [&](const std::vector<std::uint32_t> &weights,
+                           const std::vector<std::uint32_t> &durations) {
+        tar::FileWriter writer(tmp.path, tar::FileWriter::GenerateFingerprint, compression);
+        writer.WriteElementCount64("/test/weights", weights.size());
+        writer.WriteFrom("/test/weights", weights.data(), weights.size());
+        writer.WriteElementCount64("/test/durations", durations.size());
+        writer.WriteFrom("/test/durations", durations.data(), durations.size());
+    };
+
+    // the change is in the last of several chunks
+    std::vector<std::uint32_t> weights(20 * 1024 * 1024, 1);
+    std::vector<std::uint32_t> durations(100, 2);
+    write(weights, durations);
+
+    auto layout = std::make_unique<ContiguousDataLayout>();
+    populateLayoutFromFile(tmp.path, *layout);
+    auto memory = std::make_unique<char[]>(layout->GetSizeOfLayout());
+    std::vector<SharedDataIndex::AllocatedRegion> regions;
+    regions.push_back({memory.get(), std::move(layout)});
+    SharedDataIndex index{std::move(regions)};
+
+    BlockReader reader{4, false};
+    reader.Read(tmp.path, index);
+    BOOST_CHECK(reader.FindChangedEntries(tmp.path, index).empty());
+
+    weights.back() = 3;
+    write(weights, durations);
+    CHECK_EQUAL_RANGE(reader.FindChangedEntries(tmp.path, index), "/test/weights");
+
+    // a block of another size always changed
+    durations.push_back(2);
+    write(weights, durations);
+    CHECK_EQUAL_RANGE(
+        reader.FindChangedEntries(tmp.path, index), "/test/weights", "/test/durations");
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(find_changed_entries) { checkChangedEntries(tar::FileWriter::NoCompression); }
+
+BOOST_AUTO_TEST_CASE(find_changed_compressed_entries)
+{
+    checkChangedEntries(tar::FileWriter::CompressEntries);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
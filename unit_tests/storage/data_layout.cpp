@@ -1,3 +1,4 @@
+#include "storage/shared_data_index.hpp"
 #include "storage/shared_datatype.hpp"
 
 #include "../common/range_tools.hpp"
@@ -114,4 +115,35 @@ BOOST_AUTO_TEST_CASE(layout_list_test)
     CHECK_EQUAL_RANGE(results_6, "/mld/metrics");
 }
 
+BOOST_AUTO_TEST_CASE(replace_blocks_of_earlier_regions)
+{
+    std::unique_ptr<BaseDataLayout> base_layout = std::make_unique<ContiguousDataLayout>();
+    base_layout->SetBlock("/mld/metrics/0/durations", Block{1, sizeof(int)});
+    base_layout->SetBlock("/mld/metrics/0/weights", Block{1, sizeof(int)});
+    std::unique_ptr<BaseDataLayout> delta_layout = std::make_unique<ContiguousDataLayout>();
+    delta_layout->SetBlock("/mld/metrics/0/weights", Block{1, sizeof(int)});
+
+    auto base_memory = std::make_unique<char[]>(base_layout->GetSizeOfLayout());
+    auto delta_memory = std::make_unique<char[]>(delta_layout->GetSizeOfLayout());
+    *static_cast<int *>(base_layout->GetBlockPtr(base_memory.get(), "/mld/metrics/0/weights")) =
+        1;
+    *static_cast<int *>(delta_layout->GetBlockPtr(delta_memory.get(), "/mld/metrics/0/weights")) =
+        2;
+
+    std::vector<SharedDataIndex::AllocatedRegion> regions;
+    regions.push_back({base_memory.get(), std::move(base_layout)});
+    regions.push_back({delta_memory.get(), std::move(delta_layout)});
+    SharedDataIndex index{std::move(regions)};
+
+    BOOST_CHECK_EQUAL(*index.GetBlockPtr<int>("/mld/metrics/0/weights"), 2);
+
+    std::vector<std::string> blocks;
+    index.List("/mld/metrics/0", std::back_inserter(blocks));
+    CHECK_EQUAL_RANGE(blocks, "/mld/metrics/0/durations", "/mld/metrics/0/weights");
+
+    std::vector<std::string> directories;
+    index.List("/mld/metrics/", std::back_inserter(directories));
+    CHECK_EQUAL_RANGE(directories, "/mld/metrics/0");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,43 @@
+#include "storage/huge_pages.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+
+BOOST_AUTO_TEST_SUITE(huge_pages)
+
+using namespace osrm;
+using namespace osrm::storage;
+
+BOOST_AUTO_TEST_CASE(parse_huge_pages)
+{
+    BOOST_CHECK(parseHugePages("off") == HugePages::Off);
+    BOOST_CHECK(parseHugePages("transparent") == HugePages::Transparent);
+    BOOST_CHECK(parseHugePages("2M") == HugePages::Size2MiB);
+    BOOST_CHECK(parseHugePages("1G") == HugePages::Size1GiB);
+    BOOST_CHECK(!parseHugePages("4K"));
+
+    BOOST_CHECK_EQUAL(getHugePageSize(HugePages::Off), 0);
+    BOOST_CHECK_EQUAL(getHugePageSize(HugePages::Transparent), 0);
+    BOOST_CHECK_EQUAL(getHugePageSize(HugePages::Size2MiB), 2 * 1024 * 1024);
+    BOOST_CHECK_EQUAL(getHugePageSize(HugePages::Size1GiB), 1024 * 1024 * 1024);
+}
+
+BOOST_AUTO_TEST_CASE(anonymous_memory)
+{
+    // falls back to regular pages if no huge pages are reserved
+    for (const auto pages :
+         {HugePages::Off, HugePages::Transparent, HugePages::Size2MiB, HugePages::Size1GiB})
+    {
+        const std::size_t size = 3 * 1024 * 1024 + 17;
+        AnonymousMemory memory(size, pages);
+        BOOST_REQUIRE(memory.Ptr() != nullptr);
+        BOOST_CHECK(std::all_of(memory.Ptr(), memory.Ptr() + size, [](const char c) {
+            return c == 0;
+        }));
+        std::fill(memory.Ptr(), memory.Ptr() + size, 'x');
+        BOOST_CHECK_EQUAL(memory.Ptr()[size - 1], 'x');
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -54,6 +54,21 @@ BOOST_AUTO_TEST_CASE(read_tar_file)
     BOOST_CHECK_EQUAL(std::string(result_2, 4), std::string("baz\n"));
 }
 
+BOOST_AUTO_TEST_CASE(has_entry)
+{
+    storage::tar::FileReader reader(TEST_DATA_DIR "/tar_test.tar",
+                                    storage::tar::FileReader::HasNoFingerprint);
+
+    BOOST_CHECK(reader.HasEntry("foo_3.txt"));
+    BOOST_CHECK(reader.HasEntry("bla/foo_2.txt"));
+    BOOST_CHECK(!reader.HasEntry("foo_2.txt"));
+
+    // a missing entry doesn't affect the following reads
+    char result[4];
+    reader.ReadInto("foo_1.txt", result, 4);
+    BOOST_CHECK_EQUAL(std::string(result, 4), std::string("bla\n"));
+}
+
 BOOST_AUTO_TEST_CASE(write_tar_file)
 {
     TemporaryFile tmp{TEST_DATA_DIR "/tar_write_test.tar"};
@@ -94,6 +109,68 @@ BOOST_AUTO_TEST_CASE(write_tar_file)
     CHECK_EQUAL_COLLECTIONS(result_32bit_vector, vector_32bit);
 }
 
+BOOST_AUTO_TEST_CASE(write_compressed_tar_file)
+{
+    TemporaryFile tmp{TEST_DATA_DIR "/tar_compressed_write_test.tar"};
+
+    std::vector<std::uint64_t> large_vector(100000);
+    for (const auto index : util::irange<std::size_t>(0, large_vector.size()))
+    {
+        large_vector[index] = index / 3;
+    }
+    std::vector<std::uint32_t> small_vector = {0, 1, 2, 3, 4, 1 << 30, 0, 1 << 22, 0xFFFFFFFF};
+
+    {
+        storage::tar::FileWriter writer(tmp.path,
+                                        storage::tar::FileWriter::GenerateFingerprint,
+                                        storage::tar::FileWriter::CompressEntries);
+        writer.WriteElementCount64("large_vector", large_vector.size());
+        writer.WriteFrom("large_vector", large_vector.data(), large_vector.size());
+        writer.WriteElementCount64("small_vector", small_vector.size());
+        writer.WriteStreaming<std::uint32_t>(
+            "small_vector", small_vector.begin(), small_vector.size());
+        writer.WriteElementCount64("streamed_vector", large_vector.size());
+        writer.WriteStreaming<std::uint64_t>(
+            "streamed_vector", large_vector.begin(), large_vector.size());
+    }
+
+    storage::tar::FileReader reader(tmp.path, storage::tar::FileReader::VerifyFingerprint);
+
+    std::vector<storage::tar::FileReader::FileEntry> entries;
+    reader.List(std::back_inserter(entries));
+    BOOST_REQUIRE_EQUAL(entries.size(), 7);
+    BOOST_CHECK_EQUAL(entries[2].name, "large_vector");
+    BOOST_CHECK_EQUAL(entries[2].size, large_vector.size() * sizeof(std::uint64_t));
+    BOOST_CHECK(entries[2].compressed);
+    BOOST_CHECK_LT(entries[2].stored_size, entries[2].size / 2);
+    BOOST_CHECK_EQUAL(entries[4].name, "small_vector");
+    BOOST_CHECK(!entries[4].compressed);
+    BOOST_CHECK_EQUAL(entries[4].stored_size, entries[4].size);
+    BOOST_CHECK_EQUAL(entries[6].name, "streamed_vector");
+    BOOST_CHECK(entries[6].compressed);
+
+    std::vector<std::uint64_t> result_large_vector(reader.ReadElementCount64("large_vector"));
+    reader.ReadInto("large_vector", result_large_vector.data(), result_large_vector.size());
+    CHECK_EQUAL_COLLECTIONS(result_large_vector, large_vector);
+
+    std::vector<std::uint32_t> result_small_vector(reader.ReadElementCount64("small_vector"));
+    reader.ReadInto("small_vector", result_small_vector.data(), result_small_vector.size());
+    CHECK_EQUAL_COLLECTIONS(result_small_vector, small_vector);
+
+    std::vector<std::uint64_t> result_streamed_vector;
+    reader.ReadStreaming<std::uint64_t>("streamed_vector",
+                                        std::back_inserter(result_streamed_vector));
+    CHECK_EQUAL_COLLECTIONS(result_streamed_vector, large_vector);
+
+    util::CompressedBlockHeader header;
+    std::vector<util::CompressedFrame> frames;
+    reader.ReadCompressedBlockHeader("large_vector", header, frames);
+    BOOST_CHECK_EQUAL(header.uncompressed_size, entries[2].size);
+    BOOST_CHECK_EQUAL(frames.size(), 1);
+    BOOST_CHECK_THROW(reader.ReadCompressedBlockHeader("small_vector", header, frames),
+                      util::exception);
+}
+
 BOOST_AUTO_TEST_CASE(continue_write_tar_file)
 {
     TemporaryFile tmp{TEST_DATA_DIR "/tar_continue_write_test.tar"};
@@ -0,0 +1,91 @@
+#include "storage/huge_pages.hpp"
+#include "storage/shared_data_index.hpp"
+#include "storage/shared_datatype.hpp"
+#include "storage/warmup.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(warmup)
+
+using namespace osrm;
+using namespace osrm::storage;
+
+BOOST_AUTO_TEST_CASE(parse_warmup_order)
+{
+    const auto order = parseWarmupOrder("rtree,cells,graph,geometry,names");
+    BOOST_REQUIRE(order);
+    BOOST_CHECK(*order == (std::vector<WarmupGroup>{WarmupGroup::RTree,
+                                                    WarmupGroup::Cells,
+                                                    WarmupGroup::Graph,
+                                                    WarmupGroup::Geometry,
+                                                    WarmupGroup::Names}));
+
+    const auto reversed = parseWarmupOrder("names,rtree");
+    BOOST_REQUIRE(reversed);
+    BOOST_CHECK(*reversed == (std::vector<WarmupGroup>{WarmupGroup::Names, WarmupGroup::RTree}));
+
+    const auto none = parseWarmupOrder("");
+    BOOST_REQUIRE(none);
+    BOOST_CHECK(none->empty());
+
+    BOOST_CHECK(!parseWarmupOrder("rtree,turns"));
+    BOOST_CHECK(!parseWarmupOrder("rtree,"));
+}
+
+BOOST_AUTO_TEST_CASE(warmup_blocks)
+{
+    const std::uint64_t block_size = 4 * 1024 * 1024;
+    auto layout = std::make_unique<ContiguousDataLayout>();
+    layout->SetBlock("/common/names/values", Block{block_size, block_size});
+    layout->SetBlock("/common/segment_data/nodes", Block{block_size, block_size});
+
+    // freshly mapped memory faults in on first access
+    AnonymousMemory memory(layout->GetSizeOfLayout(), HugePages::Off);
+    std::vector<SharedDataIndex::AllocatedRegion> regions;
+    regions.push_back({memory.Ptr(), std::move(layout)});
+    SharedDataIndex index{std::move(regions)};
+
+    const auto before = getPageFaults();
+    warmupBlocks(index, {WarmupGroup::Names, WarmupGroup::Cells});
+    const auto after = getPageFaults();
+    BOOST_CHECK_GT(after.minor + after.major, before.minor + before.major);
+
+    // the memory is still zero and readable
+    const auto names = index.GetBlockPtr<char>("/common/names/values");
+    BOOST_CHECK_EQUAL(names[0], 0);
+    BOOST_CHECK_EQUAL(names[block_size - 1], 0);
+}
+
+BOOST_AUTO_TEST_CASE(warmup_rtree_leaves)
+{
+    const std::uint64_t block_size = 4 * 1024 * 1024;
+    auto layout = std::make_unique<ContiguousDataLayout>();
+    layout->SetBlock("/common/rtree/search_tree", Block{block_size, block_size});
+    layout->SetBlock("/common/rtree/leaves", Block{block_size, block_size});
+    layout->SetBlock("/common/rtree/compressed_leaves/pages", Block{block_size, block_size});
+
+    AnonymousMemory memory(layout->GetSizeOfLayout(), HugePages::Off);
+    std::vector<SharedDataIndex::AllocatedRegion> regions;
+    regions.push_back({memory.Ptr(), std::move(layout)});
+    SharedDataIndex index{std::move(regions)};
+
+    warmupBlocks(index, {WarmupGroup::RTree});
+
+    // the pages of the leaves are resident after the warm-up, so reading them barely faults
+    const auto before = getPageFaults();
+    const auto leaves = index.GetBlockPtr<char>("/common/rtree/leaves");
+    const auto pages = index.GetBlockPtr<char>("/common/rtree/compressed_leaves/pages");
+    std::uint8_t sum = 0;
+    for (std::uint64_t offset = 0; offset < block_size; offset += 4096)
+    {
+        sum += leaves[offset] + pages[offset];
+    }
+    const auto after = getPageFaults();
+    BOOST_CHECK_EQUAL(sum, 0);
+    BOOST_CHECK_LT(after.minor + after.major - before.minor - before.major, block_size / 4096);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,144 @@
+#include "util/block_compression.hpp"
+#include "util/exception.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(block_compression)
+
+using namespace osrm;
+using namespace osrm::util;
+
+namespace
+{
+// repetitive like the arrays of a dataset, with some noise
+std::vector<char> makeData(const std::size_t size)
+{
+    std::mt19937 generator(42);
+    std::vector<char> data(size);
+    for (std::size_t index = 0; index < size; ++index)
+    {
+        data[index] = (index % 16 < 12) ? static_cast<char>(index / 64) : generator() % 4;
+    }
+    return data;
+}
+
+std::vector<char> makeNoise(const std::size_t size)
+{
+    std::mt19937 generator(23);
+    std::vector<char> data(size);
+    for (auto &byte : data)
+        byte = generator();
+    return data;
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(checksum)
+{
+    BOOST_CHECK_EQUAL(checksum64("", 0), 0xEF46DB3751D8E999ULL);
+    BOOST_CHECK_EQUAL(checksum64("a", 1), 0xD24EC4F1A98C6E5BULL);
+    BOOST_CHECK_EQUAL(checksum64("abc", 3), 0x44BC2CF5AD770999ULL);
+
+    const std::string long_input = "Nobody inspects the spammish repetition, not even twice";
+    BOOST_CHECK_NE(checksum64(long_input.data(), long_input.size()),
+                   checksum64(long_input.data(), long_input.size() - 1));
+}
+
+BOOST_AUTO_TEST_CASE(lz_round_trip)
+{
+    for (const auto size : {0, 1, 4, 15, 16, 300, 70000})
+    {
+        const auto data = makeData(size);
+        std::vector<char> compressed(size + size / 255 + 16);
+        const auto compressed_size =
+            lz::compress(data.data(), data.size(), compressed.data(), compressed.size());
+        BOOST_REQUIRE_GT(compressed_size, 0);
+
+        std::vector<char> decompressed(size);
+        BOOST_CHECK(lz::decompress(
+            compressed.data(), compressed_size, decompressed.data(), decompressed.size()));
+        BOOST_CHECK(data == decompressed);
+
+        // the size has to match exactly
+        if (size > 0)
+        {
+            BOOST_CHECK(!lz::decompress(
+                compressed.data(), compressed_size, decompressed.data(), size - 1));
+        }
+    }
+
+    // runs are encoded as overlapping matches
+    const std::vector<char> run(10000, 'x');
+    std::vector<char> compressed(run.size());
+    const auto compressed_size =
+        lz::compress(run.data(), run.size(), compressed.data(), compressed.size());
+    BOOST_CHECK_LT(compressed_size, 100);
+    std::vector<char> decompressed(run.size());
+    BOOST_CHECK(
+        lz::decompress(compressed.data(), compressed_size, decompressed.data(), run.size()));
+    BOOST_CHECK(run == decompressed);
+}
+
+BOOST_AUTO_TEST_CASE(block_round_trip)
+{
+    const auto data = makeData(COMPRESSED_FRAME_SIZE * 2 + 12345);
+    CompressedBlockHeader header;
+    const auto stored = compressBlock(data.data(), data.size(), header);
+    BOOST_CHECK_EQUAL(header.uncompressed_size, data.size());
+    BOOST_CHECK_EQUAL(header.number_of_frames, 3);
+    BOOST_CHECK_LT(stored.size(), data.size() / 2);
+
+    std::vector<char> decompressed(data.size());
+    decompressBlock(header, stored.data(), stored.size(), decompressed.data());
+    BOOST_CHECK(data == decompressed);
+}
+
+BOOST_AUTO_TEST_CASE(incompressible_block)
+{
+    const auto data = makeNoise(COMPRESSED_FRAME_SIZE + 1);
+    CompressedBlockHeader header;
+    const auto stored = compressBlock(data.data(), data.size(), header);
+    BOOST_CHECK_EQUAL(stored.size(), data.size() + 2 * sizeof(CompressedFrame));
+
+    std::vector<char> decompressed(data.size());
+    decompressBlock(header, stored.data(), stored.size(), decompressed.data());
+    BOOST_CHECK(data == decompressed);
+}
+
+BOOST_AUTO_TEST_CASE(corrupt_block)
+{
+    const auto data = makeData(100000);
+    CompressedBlockHeader header;
+    const auto stored = compressBlock(data.data(), data.size(), header);
+    std::vector<char> decompressed(data.size());
+
+    // a flipped bit is either rejected by the decoder, caught by the checksum or, e.g. in the
+    // offset of a match into repeated data, still decodes to the same data
+    for (std::size_t position = sizeof(CompressedFrame); position < stored.size(); position += 97)
+    {
+        auto corrupt = stored;
+        corrupt[position] ^= 0x10;
+        try
+        {
+            decompressBlock(header, corrupt.data(), corrupt.size(), decompressed.data());
+            BOOST_CHECK(data == decompressed);
+        }
+        catch (const util::exception &)
+        {
+        }
+    }
+
+    BOOST_CHECK_THROW(
+        decompressBlock(header, stored.data(), stored.size() - 1, decompressed.data()),
+        util::exception);
+    auto wrong_header = header;
+    wrong_header.number_of_frames += 1;
+    BOOST_CHECK_THROW(
+        decompressBlock(wrong_header, stored.data(), stored.size(), decompressed.data()),
+        util::exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
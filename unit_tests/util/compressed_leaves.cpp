@@ -0,0 +1,64 @@
+#include "util/compressed_leaves.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(compressed_leaves_test)
+
+using namespace osrm;
+using namespace osrm::util;
+
+struct TestObject
+{
+    std::uint32_t id;
+    std::int32_t value;
+};
+
+using TestLeaves = CompressedLeaves<TestObject>;
+
+BOOST_AUTO_TEST_CASE(encode_decode_pages)
+{
+    const std::vector<TestObject> objects = {{1000, 7},
+                                             {1001, -7},
+                                             {999, 0},
+                                             {std::numeric_limits<std::uint32_t>::max(), 1},
+                                             {0, std::numeric_limits<std::int32_t>::min()},
+                                             {5, std::numeric_limits<std::int32_t>::max()}};
+
+    // two pages of three objects
+    std::vector<std::uint64_t> page_offsets = {0};
+    std::vector<std::uint8_t> pages(objects.size() * TestLeaves::MAX_ENCODED_OBJECT_SIZE);
+    for (const auto first : {0, 3})
+    {
+        const auto size = TestLeaves::Encode(objects.data() + first, 3, nullptr);
+        BOOST_CHECK_EQUAL(
+            TestLeaves::Encode(objects.data() + first, 3, pages.data() + page_offsets.back()), size);
+        page_offsets.push_back(page_offsets.back() + size);
+    }
+    pages.resize(page_offsets.back());
+
+    // only the first id takes two bytes, small differences take one byte per word
+    BOOST_CHECK_EQUAL(page_offsets[1], 2 + 1 + 1 + 1 + 1 + 1);
+
+    TestLeaves leaves{vector_view<const std::uint64_t>(page_offsets.data(), page_offsets.size()),
+                      vector_view<const std::uint8_t>(pages.data(), pages.size()),
+                      objects.size()};
+    BOOST_CHECK_EQUAL(leaves.GetNumberOfPages(), 2);
+    BOOST_CHECK_EQUAL(leaves.GetNumberOfObjects(), objects.size());
+
+    std::vector<TestObject> decoded(3);
+    for (const auto page : {0, 1})
+    {
+        leaves.Decode(page, decoded.size(), decoded.data());
+        for (const auto index : {0, 1, 2})
+        {
+            BOOST_CHECK_EQUAL(decoded[index].id, objects[page * 3 + index].id);
+            BOOST_CHECK_EQUAL(decoded[index].value, objects[page * 3 + index].value);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,77 @@
+#include "util/monotonic_arena.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(monotonic_arena_test)
+
+using namespace osrm;
+using namespace osrm::util;
+
+BOOST_AUTO_TEST_CASE(aligned_allocations)
+{
+    MonotonicArena arena;
+    for (const std::size_t alignment : {1, 2, 8, 16, 64})
+    {
+        // an odd sized allocation before puts the next one off alignment
+        arena.Allocate(3, 1);
+        const auto pointer = arena.Allocate(24, alignment);
+        BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(pointer) % alignment, 0);
+    }
+    BOOST_CHECK_EQUAL(arena.GetNumberOfAllocations(), 10);
+    BOOST_CHECK_EQUAL(arena.GetAllocatedBytes(), 5 * (3 + 24));
+
+    // larger than a block
+    const auto large = static_cast<char *>(arena.Allocate(1024 * 1024, 8));
+    large[1024 * 1024 - 1] = 1;
+    BOOST_CHECK_GE(arena.GetCapacity(), 1024 * 1024);
+
+    arena.Reset();
+    BOOST_CHECK_EQUAL(arena.GetNumberOfAllocations(), 0);
+    BOOST_CHECK_GE(arena.GetCapacity(), 1024 * 1024);
+}
+
+BOOST_AUTO_TEST_CASE(scoped_vectors)
+{
+    BOOST_CHECK(MonotonicArena::Current() == nullptr);
+
+    std::vector<short> copy;
+    {
+        ArenaScope scope;
+        BOOST_CHECK(MonotonicArena::Current() == &scope.GetArena());
+
+        ArenaVector<short> bearings;
+        ArenaVector<bool> entry;
+        for (short bearing = 0; bearing < 360; bearing += 10)
+        {
+            bearings.push_back(bearing);
+            entry.push_back(bearing % 20 == 0);
+        }
+        BOOST_CHECK_GT(scope.GetArena().GetNumberOfAllocations(), 0);
+
+        {
+            // nested scopes share the arena
+            ArenaScope nested;
+            BOOST_CHECK(&nested.GetArena() == &scope.GetArena());
+        }
+        BOOST_CHECK_GT(scope.GetArena().GetNumberOfAllocations(), 0);
+
+        copy.assign(bearings.begin(), bearings.end());
+        BOOST_CHECK_EQUAL(entry.size(), 36);
+        BOOST_CHECK(entry[2] && !entry[3]);
+    }
+
+    BOOST_CHECK(MonotonicArena::Current() == nullptr);
+    BOOST_CHECK_EQUAL(copy.size(), 36);
+    BOOST_CHECK_EQUAL(copy.back(), 350);
+
+    // outside of a scope the vectors allocate from the heap
+    ArenaVector<std::string> names = {"Avenue de la Costa", "Boulevard Albert 1er"};
+    const auto names_copy = names;
+    BOOST_CHECK_EQUAL(names_copy.back(), "Boulevard Albert 1er");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,47 @@
+#include "util/exception.hpp"
+#include "util/numa.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <sys/mman.h>
+
+#include <cstring>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(numa)
+
+using namespace osrm;
+using namespace osrm::util;
+
+BOOST_AUTO_TEST_CASE(parse_cpu_list)
+{
+    BOOST_CHECK(parseCPUList("0-3,8,10-11\n") == (std::vector<unsigned>{0, 1, 2, 3, 8, 10, 11}));
+    BOOST_CHECK(parseCPUList("5") == (std::vector<unsigned>{5}));
+    BOOST_CHECK(parseCPUList("").empty());
+
+    BOOST_CHECK_THROW(parseCPUList("3-1"), util::exception);
+    BOOST_CHECK_THROW(parseCPUList("a-b"), util::exception);
+    BOOST_CHECK_THROW(parseCPUList("1:2"), util::exception);
+}
+
+BOOST_AUTO_TEST_CASE(pin_and_bind_to_first_node)
+{
+    const auto nodes = getNumaNodes();
+    BOOST_REQUIRE(!nodes.empty());
+
+    // sandboxes may forbid both, only the bookkeeping has to match the outcome
+    if (pinThreadToNumaNode(nodes.front()))
+    {
+        BOOST_CHECK_EQUAL(getCurrentNumaNode(), nodes.front().id);
+    }
+
+    const std::size_t size = 1024 * 1024;
+    auto memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    BOOST_REQUIRE(memory != MAP_FAILED);
+    bindMemoryToNumaNode(memory, size, nodes.front().id);
+    std::memset(memory, 1, size);
+    BOOST_CHECK_EQUAL(static_cast<char *>(memory)[size - 1], 1);
+    ::munmap(memory, size);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
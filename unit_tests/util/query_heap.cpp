@@ -24,8 +24,15 @@ typedef int TestKey;
 typedef int TestWeight;
 typedef boost::mpl::list<ArrayStorage<TestNodeID, TestKey>,
                          MapStorage<TestNodeID, TestKey>,
-                         UnorderedMapStorage<TestNodeID, TestKey>>
+                         UnorderedMapStorage<TestNodeID, TestKey>,
+                         GenerationArrayStorage<TestNodeID, TestKey>>
     storage_types;
+typedef boost::mpl::list<BoostDAryHeapPolicy<4>,
+                         DAryHeapPolicy<2>,
+                         DAryHeapPolicy<4>,
+                         DAryHeapPolicy<8>,
+                         RadixHeapPolicy>
+    heap_policies;
 
 template <unsigned NUM_ELEM> struct RandomDataFixture
 {
@@ -156,4 +163,116 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(decrease_key_test, T, storage_types, RandomData
     }
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(policy_delete_min_test,
+                                 T,
+                                 heap_policies,
+                                 RandomDataFixture<NUM_NODES>)
+{
+    QueryHeap<TestNodeID, TestKey, TestWeight, TestData, ArrayStorage<TestNodeID, TestKey>, T>
+        heap(NUM_NODES);
+
+    for (unsigned idx : order)
+    {
+        heap.Insert(ids[idx], weights[idx], data[idx]);
+    }
+
+    for (auto id : ids)
+    {
+        BOOST_CHECK(!heap.WasRemoved(id));
+        BOOST_CHECK_EQUAL(heap.MinKey(), weights[id]);
+        BOOST_CHECK_EQUAL(id, heap.DeleteMin());
+        BOOST_CHECK(heap.WasRemoved(id));
+    }
+    BOOST_CHECK(heap.Empty());
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(policy_decrease_key_test,
+                                 T,
+                                 heap_policies,
+                                 RandomDataFixture<10>)
+{
+    QueryHeap<TestNodeID, TestKey, TestWeight, TestData, ArrayStorage<TestNodeID, TestKey>, T>
+        heap(10);
+
+    for (unsigned idx : order)
+    {
+        heap.Insert(ids[idx], weights[idx], data[idx]);
+    }
+
+    // through the heap node as done by the searches
+    heap.GetHeapNodeIfWasInserted(9)->weight = 50;
+    heap.DecreaseKey(*heap.GetHeapNodeIfWasInserted(9));
+    BOOST_CHECK_EQUAL(heap.Min(), 9);
+    BOOST_CHECK_EQUAL(heap.MinKey(), 50);
+
+    heap.DecreaseKey(5, 20);
+    BOOST_CHECK_EQUAL(heap.Min(), 5);
+    BOOST_CHECK_EQUAL(heap.GetKey(5), 20);
+
+    BOOST_CHECK_EQUAL(heap.DeleteMin(), 5);
+    BOOST_CHECK_EQUAL(heap.DeleteMin(), 9);
+    BOOST_CHECK_EQUAL(heap.DeleteMin(), 0);
+    BOOST_CHECK_EQUAL(heap.Size(), 7);
+
+    heap.DeleteAll();
+    BOOST_CHECK(heap.Empty());
+    BOOST_CHECK(heap.WasInserted(1));
+    BOOST_CHECK(heap.WasRemoved(1));
+}
+
+// Dijkstra on a random graph settles the same weights with every heap and storage
+BOOST_AUTO_TEST_CASE_TEMPLATE(policy_dijkstra_test, T, heap_policies)
+{
+    constexpr unsigned NUMBER_OF_NODES = 500;
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<TestNodeID> node_distribution(0, NUMBER_OF_NODES - 1);
+    std::uniform_int_distribution<TestWeight> weight_distribution(0, 20);
+
+    std::vector<std::vector<std::pair<TestNodeID, TestWeight>>> adjacency(NUMBER_OF_NODES);
+    for (unsigned edge = 0; edge < 4 * NUMBER_OF_NODES; ++edge)
+    {
+        adjacency[node_distribution(generator)].emplace_back(node_distribution(generator),
+                                                             weight_distribution(generator));
+    }
+
+    const auto dijkstra = [&](auto &heap, const TestNodeID source) {
+        std::vector<TestWeight> settled(NUMBER_OF_NODES, std::numeric_limits<TestWeight>::max());
+        heap.Clear();
+        heap.Insert(source, -10, {0});
+        while (!heap.Empty())
+        {
+            const auto weight = heap.MinKey();
+            const auto node = heap.DeleteMin();
+            settled[node] = weight;
+            for (const auto &edge : adjacency[node])
+            {
+                const auto to_weight = weight + edge.second;
+                if (!heap.WasInserted(edge.first))
+                    heap.Insert(edge.first, to_weight, {0});
+                else if (!heap.WasRemoved(edge.first) && to_weight < heap.GetKey(edge.first))
+                    heap.DecreaseKey(edge.first, to_weight);
+            }
+        }
+        return settled;
+    };
+
+    QueryHeap<TestNodeID, TestKey, TestWeight, TestData, ArrayStorage<TestNodeID, TestKey>>
+        reference(NUMBER_OF_NODES);
+    QueryHeap<TestNodeID,
+              TestKey,
+              TestWeight,
+              TestData,
+              GenerationArrayStorage<TestNodeID, TestKey>,
+              T>
+        heap(NUMBER_OF_NODES);
+
+    for (TestNodeID source = 0; source < 20; ++source)
+    {
+        const auto expected = dijkstra(reference, source);
+        const auto settled = dijkstra(heap, source);
+        BOOST_CHECK_EQUAL_COLLECTIONS(
+            settled.begin(), settled.end(), expected.begin(), expected.end());
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
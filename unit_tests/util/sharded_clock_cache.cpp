@@ -0,0 +1,106 @@
+#include "util/sharded_clock_cache.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(sharded_clock_cache)
+
+using namespace osrm;
+using namespace osrm::util;
+
+using Cache = ShardedClockCache<unsigned, std::string>;
+
+BOOST_AUTO_TEST_CASE(find_inserted)
+{
+    Cache cache(64);
+
+    BOOST_CHECK(!cache.Find(3));
+    cache.Insert(3, "three");
+
+    const auto value = cache.Find(3);
+    BOOST_REQUIRE(value);
+    BOOST_CHECK_EQUAL(*value, "three");
+
+    // the first insert of a key wins
+    cache.Insert(3, "other");
+    BOOST_CHECK_EQUAL(*cache.Find(3), "three");
+
+    BOOST_CHECK_EQUAL(cache.GetHits(), 2);
+    BOOST_CHECK_EQUAL(cache.GetMisses(), 1);
+    BOOST_CHECK_EQUAL(cache.GetSize(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(clock_eviction)
+{
+    // two entries per shard, keys 0, 16 and 32 go into the same one
+    Cache cache(32);
+    BOOST_CHECK_EQUAL(cache.GetCapacity(), 32);
+
+    cache.Insert(0, "first");
+    cache.Insert(16, "second");
+    BOOST_CHECK(cache.Find(0));
+
+    // the first entry was used and gets a second chance
+    cache.Insert(32, "third");
+    BOOST_CHECK(cache.Find(0));
+    BOOST_CHECK(!cache.Find(16));
+    BOOST_CHECK(cache.Find(32));
+    BOOST_CHECK_EQUAL(cache.GetSize(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(bounded_size)
+{
+    Cache cache(100);
+    BOOST_CHECK_EQUAL(cache.GetCapacity(), 112);
+
+    for (unsigned key = 0; key < 1000; ++key)
+        cache.Insert(key, std::to_string(key));
+
+    BOOST_CHECK_EQUAL(cache.GetSize(), cache.GetCapacity());
+    // the most recent entry is always kept
+    BOOST_CHECK_EQUAL(*cache.Find(999), "999");
+}
+
+BOOST_AUTO_TEST_CASE(zero_capacity_disables)
+{
+    Cache cache(0);
+    BOOST_CHECK_EQUAL(cache.GetCapacity(), 0);
+
+    cache.Insert(1, "one");
+    BOOST_CHECK(!cache.Find(1));
+    BOOST_CHECK_EQUAL(cache.GetSize(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_access)
+{
+    Cache cache(256);
+    // Boost.Test assertions are not thread-safe
+    std::atomic<unsigned> wrong_values{0};
+
+    std::vector<std::thread> threads;
+    for (unsigned thread = 0; thread < 4; ++thread)
+    {
+        threads.emplace_back([&cache, &wrong_values] {
+            for (unsigned key = 0; key < 1000; ++key)
+            {
+                const auto value = cache.Find(key);
+                if (!value)
+                    cache.Insert(key, std::to_string(key));
+                else if (*value != std::to_string(key))
+                    ++wrong_values;
+            }
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    BOOST_CHECK_EQUAL(wrong_values, 0);
+    BOOST_CHECK_EQUAL(cache.GetHits() + cache.GetMisses(), 4000);
+    BOOST_CHECK_LE(cache.GetSize(), cache.GetCapacity());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
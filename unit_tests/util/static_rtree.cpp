@@ -1,10 +1,14 @@
 #include "util/static_rtree.hpp"
 #include "extractor/edge_based_node_segment.hpp"
 #include "engine/geospatial_query.hpp"
+#include "storage/tar.hpp"
+#include "util/compressed_leaves.hpp"
 #include "util/coordinate.hpp"
 #include "util/coordinate_calculation.hpp"
 #include "util/exception.hpp"
+#include "util/mmap_file.hpp"
 #include "util/rectangle.hpp"
+#include "util/serialization.hpp"
 #include "util/typedefs.hpp"
 
 #include "../common/temporary_file.hpp"
@@ -298,6 +302,65 @@ BOOST_FIXTURE_TEST_CASE(construct_multiple_levels_test, TestRandomGraphFixture_M
     construction_test("test_5", *this);
 }
 
+BOOST_FIXTURE_TEST_CASE(compressed_leaves_test, TestRandomGraphFixture_MultipleLevels)
+{
+    TemporaryFile leaves_file;
+    TemporaryFile tree_file;
+    auto rtree = make_rtree<TestStaticRTree>(leaves_file.path, *this);
+    {
+        storage::tar::FileWriter writer{tree_file.path, storage::tar::FileWriter::HasNoFingerprint};
+        serialization::write(writer, "/common/rtree", rtree);
+    }
+
+    boost::iostreams::mapped_file_source objects_region;
+    const auto objects = mmapFile<TestData>(leaves_file.path, objects_region);
+    std::vector<std::uint64_t> page_offsets;
+    const auto size = TestStaticRTree::GetCompressedLeafOffsets(objects, page_offsets);
+    BOOST_CHECK_EQUAL(page_offsets.size(),
+                      (objects.size() + TestStaticRTree::LEAF_NODE_SIZE - 1) /
+                              TestStaticRTree::LEAF_NODE_SIZE +
+                          1);
+    BOOST_CHECK_LT(size, objects.size() * sizeof(TestData));
+    std::vector<std::uint8_t> pages(size);
+    TestStaticRTree::CompressLeaves(objects, page_offsets, pages.data());
+
+    TestStaticRTree compressed_rtree{
+        CompressedLeaves<TestData>{vector_view<const std::uint64_t>(page_offsets.data(),
+                                                                    page_offsets.size()),
+                                   vector_view<const std::uint8_t>(pages.data(), pages.size()),
+                                   objects.size()},
+        coords};
+    {
+        storage::tar::FileReader reader{tree_file.path, storage::tar::FileReader::HasNoFingerprint};
+        serialization::read(reader, "/common/rtree", compressed_rtree);
+    }
+
+    const auto same_objects = [](const std::vector<TestData> &lhs,
+                                 const std::vector<TestData> &rhs) {
+        BOOST_REQUIRE_EQUAL(lhs.size(), rhs.size());
+        for (const auto index : irange<std::size_t>(0, lhs.size()))
+        {
+            BOOST_CHECK_EQUAL(lhs[index].u, rhs[index].u);
+            BOOST_CHECK_EQUAL(lhs[index].v, rhs[index].v);
+            BOOST_CHECK_EQUAL(lhs[index].forward_segment_id.id, rhs[index].forward_segment_id.id);
+            BOOST_CHECK_EQUAL(lhs[index].fwd_segment_position, rhs[index].fwd_segment_position);
+        }
+    };
+
+    std::mt19937 g(RANDOM_SEED);
+    std::uniform_int_distribution<> lat_udist(WORLD_MIN_LAT, WORLD_MAX_LAT);
+    std::uniform_int_distribution<> lon_udist(WORLD_MIN_LON, WORLD_MAX_LON);
+    for (unsigned i = 0; i < 100; i++)
+    {
+        const Coordinate q{FixedLongitude{lon_udist(g)}, FixedLatitude{lat_udist(g)}};
+        same_objects(rtree.Nearest(q, 10), compressed_rtree.Nearest(q, 10));
+    }
+
+    const RectangleInt2D bbox{
+        FloatLongitude{-20.}, FloatLongitude{20.}, FloatLatitude{-20.}, FloatLatitude{20.}};
+    same_objects(rtree.SearchInBox(bbox), compressed_rtree.SearchInBox(bbox));
+}
+
 // Bug: If you querry a point that lies between two BBs that have a gap,
 // one BB will be pruned, even if it could contain a nearer match.
 BOOST_AUTO_TEST_CASE(regression_test)
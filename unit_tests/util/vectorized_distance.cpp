@@ -0,0 +1,146 @@
+#include "util/vectorized_distance.hpp"
+
+#include "util/coordinate.hpp"
+#include "util/coordinate_calculation.hpp"
+#include "util/rectangle.hpp"
+#include "util/web_mercator.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(vectorized_distance)
+
+using namespace osrm;
+using namespace osrm::util;
+
+namespace
+{
+// Choosen by a fair W20 dice roll (this value is completely arbitrary)
+constexpr unsigned RANDOM_SEED = 11;
+
+// Coordinates of a small area so that nearby and far away points are both covered
+FixedLongitude randomLongitude(std::mt19937 &generator)
+{
+    return FixedLongitude{std::uniform_int_distribution<>(7000000, 7100000)(generator)};
+}
+
+FixedLatitude randomLatitude(std::mt19937 &generator)
+{
+    return FixedLatitude{std::uniform_int_distribution<>(43000000, 43100000)(generator)};
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(rectangle_distances)
+{
+    std::mt19937 generator(RANDOM_SEED);
+
+    std::vector<RectangleInt2D> rectangles;
+    for (int index = 0; index < 67; ++index)
+    {
+        const auto lon_1 = randomLongitude(generator), lon_2 = randomLongitude(generator);
+        const auto lat_1 = randomLatitude(generator), lat_2 = randomLatitude(generator);
+        rectangles.push_back(RectangleInt2D{std::min(lon_1, lon_2),
+                                            std::max(lon_1, lon_2),
+                                            std::min(lat_1, lat_2),
+                                            std::max(lat_1, lat_2)});
+    }
+
+    std::vector<std::uint64_t> distances(rectangles.size());
+    std::vector<std::uint64_t> scalar_distances(rectangles.size());
+    for (int query = 0; query < 100; ++query)
+    {
+        const Coordinate location{randomLongitude(generator), randomLatitude(generator)};
+        vectorized::squaredRectangleDistances(rectangles.data(),
+                                              sizeof(RectangleInt2D),
+                                              rectangles.size(),
+                                              location,
+                                              distances.data());
+        vectorized::squaredRectangleDistancesScalar(rectangles.data(),
+                                                    sizeof(RectangleInt2D),
+                                                    rectangles.size(),
+                                                    location,
+                                                    scalar_distances.data());
+
+        for (std::size_t index = 0; index < rectangles.size(); ++index)
+        {
+            const auto expected = rectangles[index].GetMinSquaredDist(location);
+            BOOST_CHECK_EQUAL(distances[index], expected);
+            BOOST_CHECK_EQUAL(scalar_distances[index], expected);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(segment_projections)
+{
+    std::mt19937 generator(RANDOM_SEED);
+
+    std::vector<std::pair<FloatCoordinate, FloatCoordinate>> segments;
+    vectorized::ProjectedSegments projected_segments;
+    for (int index = 0; index < 131; ++index)
+    {
+        const auto source = web_mercator::fromWGS84(
+            Coordinate{randomLongitude(generator), randomLatitude(generator)});
+        // every tenth segment is degenerated
+        const auto target = index % 10 == 0 ? source
+                                            : web_mercator::fromWGS84(Coordinate{
+                                                  randomLongitude(generator),
+                                                  randomLatitude(generator)});
+        segments.emplace_back(source, target);
+        projected_segments.push_back(source, target);
+    }
+
+    vectorized::SegmentDistances distances;
+    vectorized::SegmentDistances scalar_distances;
+    for (int query = 0; query < 100; ++query)
+    {
+        const auto location = web_mercator::fromWGS84(
+            Coordinate{randomLongitude(generator), randomLatitude(generator)});
+        const Coordinate fixed_location{location};
+        vectorized::projectOnSegments(projected_segments, location, fixed_location, distances);
+        vectorized::projectOnSegmentsScalar(
+            projected_segments, location, fixed_location, scalar_distances);
+
+        for (std::size_t index = 0; index < segments.size(); ++index)
+        {
+            const auto nearest = Coordinate{
+                coordinate_calculation::projectPointOnSegment(
+                    segments[index].first, segments[index].second, location)
+                    .second};
+            const auto expected =
+                coordinate_calculation::squaredEuclideanDistance(fixed_location, nearest);
+
+            BOOST_CHECK_EQUAL(distances.squared_distances[index], expected);
+            BOOST_CHECK_EQUAL(distances.nearest_lon[index], static_cast<std::int32_t>(nearest.lon));
+            BOOST_CHECK_EQUAL(distances.nearest_lat[index], static_cast<std::int32_t>(nearest.lat));
+            BOOST_CHECK_EQUAL(scalar_distances.squared_distances[index], expected);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(round_halfway_away_from_zero)
+{
+    // degenerated segments project onto their source which is exactly between two fixed values
+    vectorized::ProjectedSegments projected_segments;
+    for (const auto value : {-3.5, -2.5, -0.5, 0.5, 1.5, 2.5, 1000000.5, -1000000.5})
+    {
+        const FloatCoordinate source{FloatLongitude{value / COORDINATE_PRECISION},
+                                     FloatLatitude{-value / COORDINATE_PRECISION}};
+        projected_segments.push_back(source, source);
+    }
+
+    const FloatCoordinate location{FloatLongitude{0.}, FloatLatitude{0.}};
+    vectorized::SegmentDistances distances;
+    vectorized::projectOnSegments(projected_segments, location, Coordinate{location}, distances);
+    for (std::size_t index = 0; index < projected_segments.size(); ++index)
+    {
+        const auto lon = toFixed(FloatLongitude{projected_segments.source_lon[index]});
+        const auto lat = toFixed(FloatLatitude{projected_segments.source_lat[index]});
+        BOOST_CHECK_EQUAL(distances.nearest_lon[index], static_cast<std::int32_t>(lon));
+        BOOST_CHECK_EQUAL(distances.nearest_lat[index], static_cast<std::int32_t>(lat));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()